@@ -95,6 +95,7 @@ namespace flatbuffers {
 
 
 namespace jay {
+  enum Codec : uint8_t;
   struct Frame;
   struct Column;
   struct Buffer;
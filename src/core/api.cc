@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
 #include "../datatable/include/datatable.h"
+#include "arrow/arrow.h"
 #include "frame/py_frame.h"
 #include "datatable.h"
 #include "ltype.h"
@@ -42,7 +43,7 @@ static DataTable* _extract_dt(PyObject* pydt) {
 }
 
 size_t DtABIVersion() {
-  return 2;
+  return 3;
 }
 
 
@@ -128,5 +129,36 @@ const char* DtFrame_ColumnStringDataR(PyObject* pydt, size_t i) {
 }
 
 
+int DtFrame_ToArrow(PyObject* pydt, ArrowSchema* schema, ArrowArray* array) {
+  auto dt = _extract_dt(pydt);
+  try {
+    ArrowSchema tmp;
+    dt::arrow::export_schema(dt, &tmp);
+    try {
+      dt::arrow::export_array(dt, array);
+    } catch (...) {
+      tmp.release(&tmp);
+      throw;
+    }
+    *schema = tmp;
+    return 0;
+  } catch (const std::exception& e) {
+    exception_to_python(e);
+    return -1;
+  }
+}
+
+
+PyObject* DtFrame_FromArrow(const ArrowSchema* schema, ArrowArray* array) {
+  try {
+    DataTable* dt = dt::arrow::import_array(schema, array);
+    return py::Frame::oframe(dt).release();
+  } catch (const std::exception& e) {
+    exception_to_python(e);
+    return nullptr;
+  }
+}
+
+
 
 } // extern "C"
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_ARROW_ARROW_h
+#define dt_ARROW_ARROW_h
+#include <cstdint>
+#include "_dt.h"
+extern "C" {
+
+// The structures of the Arrow C data interface, as defined in
+// https://arrow.apache.org/docs/format/CDataInterface.html
+// These definitions are ABI-stable, and must not be modified. The
+// include guard allows them to be shared with other libraries that
+// also define these structures.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+  int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+  int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+  const char* (*get_last_error)(struct ArrowArrayStream*);
+  void (*release)(struct ArrowArrayStream*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+}  // extern "C"
+
+
+namespace dt {
+namespace arrow {
+
+
+/**
+  * Export the frame `dt` as an Arrow struct array whose children are
+  * the columns of the frame. The output structures are filled in,
+  * and become owned by the caller, who must eventually call their
+  * `release` callbacks.
+  *
+  * Wherever possible the data buffers are shared with the frame
+  * without copying: this is the case for all numeric columns, for
+  * the character data of string columns, and for the offsets of
+  * string columns without NAs. Validity bitmaps are only created for
+  * the columns that contain NAs. Dictionary-encoded string columns
+  * are exported as Arrow dictionary arrays.
+  */
+void export_schema(const DataTable* dt, ArrowSchema* out);
+void export_array(const DataTable* dt, ArrowArray* out);
+void export_stream(const DataTable* dt, ArrowArrayStream* out);
+
+
+/**
+  * Create a new DataTable from an Arrow array (either a struct array,
+  * whose children become the columns, or any other array, which
+  * becomes a single column). The content of `array` is moved into the
+  * returned DataTable, leaving `array->release` set to NULL; the
+  * `schema` is not modified.
+  *
+  * The data buffers are used without copying where datatable's and
+  * Arrow's layouts coincide: for numeric columns without nulls, and
+  * for string columns without nulls whose offsets start at 0. The
+  * character data of strings is never copied, unless the nulls in the
+  * array occupy some space in it.
+  */
+DataTable* import_array(const ArrowSchema* schema, ArrowArray* array);
+
+/**
+  * Read all record batches from the `stream` and combine them into a
+  * single DataTable. The stream is not released.
+  */
+DataTable* import_stream(ArrowArrayStream* stream);
+
+
+}}  // namespace dt::arrow
+#endif
@@ -0,0 +1,432 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <cerrno>                  // ENOMEM
+#include <cstring>                 // std::memcpy
+#include <string>                  // std::string
+#include <vector>                  // std::vector
+#include "arrow/arrow.h"
+#include "parallel/api.h"
+#include "utils/exceptions.h"
+#include "buffer.h"
+#include "column.h"
+#include "datatable.h"
+#include "stype.h"
+namespace dt {
+namespace arrow {
+
+
+// The `release` callbacks may be invoked by the consumer from any
+// thread, whereas deleting the buffers that hold python objects (such
+// as those created from numpy arrays) requires the GIL.
+class GilGuard {
+  private:
+    PyGILState_STATE state_;
+    bool active_;
+    size_t : 24;
+
+  public:
+    GilGuard() : active_(Py_IsInitialized()) {
+      if (active_) state_ = PyGILState_Ensure();
+    }
+    ~GilGuard() {
+      if (active_) PyGILState_Release(state_);
+    }
+};
+
+
+
+
+//------------------------------------------------------------------------------
+// ArrowSchema
+//------------------------------------------------------------------------------
+
+struct SchemaData {
+  std::string format;
+  std::string name;
+  std::vector<ArrowSchema*> children;
+  ArrowSchema* dictionary;
+};
+
+
+static void release_schema(ArrowSchema* schema) {
+  if (!schema->release) return;
+  auto data = static_cast<SchemaData*>(schema->private_data);
+  for (ArrowSchema* child : data->children) {
+    if (child->release) child->release(child);
+    delete child;
+  }
+  if (data->dictionary) {
+    if (data->dictionary->release) data->dictionary->release(data->dictionary);
+    delete data->dictionary;
+  }
+  delete data;
+  schema->release = nullptr;
+}
+
+
+// Fill in the `out` structure. The children (and the dictionary, if
+// requested) are allocated, but remain empty until they are filled by
+// the caller.
+static void init_schema(ArrowSchema* out, const std::string& format,
+                        const std::string& name, int64_t flags,
+                        size_t nchildren, bool with_dictionary)
+{
+  auto data = new SchemaData();
+  data->format = format;
+  data->name = name;
+  data->children.resize(nchildren);
+  for (size_t i = 0; i < nchildren; ++i) {
+    data->children[i] = new ArrowSchema();
+  }
+  data->dictionary = with_dictionary? new ArrowSchema() : nullptr;
+
+  out->format = data->format.c_str();
+  out->name = data->name.c_str();
+  out->metadata = nullptr;
+  out->flags = flags;
+  out->n_children = static_cast<int64_t>(nchildren);
+  out->children = data->children.data();
+  out->dictionary = data->dictionary;
+  out->release = release_schema;
+  out->private_data = data;
+}
+
+
+static const char* column_format(SType stype, const std::string& name) {
+  switch (stype) {
+    case SType::VOID:    return "n";
+    case SType::BOOL:    return "b";
+    case SType::INT8:    return "c";
+    case SType::INT16:   return "s";
+    case SType::INT32:   return "i";
+    case SType::INT64:   return "l";
+    case SType::FLOAT32: return "f";
+    case SType::FLOAT64: return "g";
+    case SType::STR32:   return "u";
+    case SType::STR64:   return "U";
+    default:
+      throw TypeError() << "Column `" << name << "` of type "
+          << stype_name(stype) << " cannot be exported into Arrow format";
+  }
+}
+
+
+static void export_column_schema(const Column& col, const std::string& name,
+                                 ArrowSchema* out)
+{
+  Column codes, dict;
+  if (col.get_categorical(&codes, &dict)) {
+    init_schema(out, column_format(codes.stype(), name), name,
+                ARROW_FLAG_NULLABLE, 0, /* with_dictionary= */ true);
+    init_schema(out->dictionary, column_format(dict.stype(), name), "",
+                0, 0, false);
+    // The dictionary of a categorical column is always sorted
+    out->flags |= ARROW_FLAG_DICTIONARY_ORDERED;
+  } else {
+    init_schema(out, column_format(col.stype(), name), name,
+                ARROW_FLAG_NULLABLE, 0, false);
+  }
+}
+
+
+void export_schema(const DataTable* dt, ArrowSchema* out) {
+  size_t ncols = dt->ncols();
+  const strvec& names = dt->get_names();
+  init_schema(out, "+s", "", 0, ncols, false);
+  try {
+    for (size_t i = 0; i < ncols; ++i) {
+      export_column_schema(dt->get_column(i), names[i], out->children[i]);
+    }
+  } catch (...) {
+    out->release(out);
+    throw;
+  }
+}
+
+
+static void copy_schema(const ArrowSchema* src, ArrowSchema* out) {
+  size_t nchildren = static_cast<size_t>(src->n_children);
+  init_schema(out, src->format, src->name, src->flags, nchildren,
+              src->dictionary != nullptr);
+  for (size_t i = 0; i < nchildren; ++i) {
+    copy_schema(src->children[i], out->children[i]);
+  }
+  if (src->dictionary) {
+    copy_schema(src->dictionary, out->dictionary);
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// ArrowArray
+//------------------------------------------------------------------------------
+
+struct ArrayData {
+  std::vector<Buffer> buffers;      // keep the exported memory alive
+  std::vector<const void*> pointers;
+  std::vector<ArrowArray*> children;
+  ArrowArray* dictionary;
+};
+
+
+static void release_array(ArrowArray* array) {
+  if (!array->release) return;
+  GilGuard gil;
+  auto data = static_cast<ArrayData*>(array->private_data);
+  for (ArrowArray* child : data->children) {
+    if (child->release) child->release(child);
+    delete child;
+  }
+  if (data->dictionary) {
+    if (data->dictionary->release) data->dictionary->release(data->dictionary);
+    delete data->dictionary;
+  }
+  delete data;
+  array->release = nullptr;
+}
+
+
+static ArrayData* init_array(ArrowArray* out, size_t length,
+                             size_t null_count, size_t nbuffers,
+                             size_t nchildren)
+{
+  auto data = new ArrayData();
+  data->buffers.resize(nbuffers);
+  data->pointers.resize(nbuffers, nullptr);
+  data->children.resize(nchildren);
+  for (size_t i = 0; i < nchildren; ++i) {
+    data->children[i] = new ArrowArray();
+  }
+  data->dictionary = nullptr;
+
+  out->length = static_cast<int64_t>(length);
+  out->null_count = static_cast<int64_t>(null_count);
+  out->offset = 0;
+  out->n_buffers = static_cast<int64_t>(nbuffers);
+  out->n_children = static_cast<int64_t>(nchildren);
+  out->buffers = data->pointers.data();
+  out->children = data->children.data();
+  out->dictionary = nullptr;
+  out->release = release_array;
+  out->private_data = data;
+  return data;
+}
+
+
+static void set_buffer(ArrayData* data, size_t i, Buffer&& buf) {
+  data->pointers[i] = buf.rptr();
+  data->buffers[i] = std::move(buf);
+}
+
+
+// Create a bitmap with bits set for the rows where `is_valid(i)` is
+// true. Each iteration fills one byte, i.e. 8 rows.
+template <typename F>
+static Buffer make_bitmap(size_t n, F is_valid) {
+  size_t nbytes = (n + 7) / 8;
+  Buffer buf = Buffer::mem(nbytes);
+  auto out = static_cast<uint8_t*>(buf.xptr());
+  dt::parallel_for_static(nbytes,
+    [&](size_t j) {
+      size_t i0 = j * 8;
+      size_t i1 = std::min(i0 + 8, n);
+      uint8_t byte = 0;
+      for (size_t i = i0; i < i1; ++i) {
+        byte |= static_cast<uint8_t>(is_valid(i) << (i - i0));
+      }
+      out[j] = byte;
+    });
+  return buf;
+}
+
+
+template <typename T>
+static void export_fixed(const Column& col, size_t nas, ArrayData* data) {
+  auto values = static_cast<const T*>(col.get_data_readonly());
+  if (nas) {
+    set_buffer(data, 0, make_bitmap(col.nrows(),
+        [=](size_t i) { return !ISNA<T>(values[i]); }));
+  }
+  set_buffer(data, 1, col.get_data_buffer(0));
+}
+
+
+static void export_bool(const Column& col, size_t nas, ArrayData* data) {
+  auto values = static_cast<const int8_t*>(col.get_data_readonly());
+  if (nas) {
+    set_buffer(data, 0, make_bitmap(col.nrows(),
+        [=](size_t i) { return !ISNA<int8_t>(values[i]); }));
+  }
+  set_buffer(data, 1, make_bitmap(col.nrows(),
+      [=](size_t i) { return values[i] == 1; }));
+}
+
+
+// In datatable the offsets of NA strings have the highest bit set,
+// which Arrow does not allow. Thus the offsets are shared with Arrow
+// only if there are no NAs in the column.
+template <typename U>
+static void export_string(const Column& col, size_t nas, ArrayData* data) {
+  constexpr U NA_BIT = U(1) << (sizeof(U) * 8 - 1);
+  size_t n = col.nrows();
+  auto offsets = static_cast<const U*>(col.get_data_readonly(0));
+  if (nas) {
+    set_buffer(data, 0, make_bitmap(n,
+        [=](size_t i) { return !(offsets[i + 1] & NA_BIT); }));
+    Buffer buf = Buffer::mem((n + 1) * sizeof(U));
+    auto out = static_cast<U*>(buf.xptr());
+    dt::parallel_for_static(n + 1,
+      [=](size_t i) {
+        out[i] = offsets[i] & ~NA_BIT;
+      });
+    set_buffer(data, 1, std::move(buf));
+  } else {
+    set_buffer(data, 1, col.get_data_buffer(0));
+  }
+  set_buffer(data, 2, col.get_data_buffer(1));
+}
+
+
+static void export_column(const Column& column, ArrowArray* out) {
+  Column col(column);
+  Column codes, dict;
+  if (col.get_categorical(&codes, &dict)) {
+    export_column(codes, out);
+    auto data = static_cast<ArrayData*>(out->private_data);
+    data->dictionary = new ArrowArray();
+    out->dictionary = data->dictionary;
+    export_column(dict, out->dictionary);
+    return;
+  }
+  col.materialize();
+  size_t n = col.nrows();
+  SType stype = col.stype();
+  if (stype == SType::VOID) {
+    init_array(out, n, n, 0, 0);
+    return;
+  }
+  size_t nas = col.na_count();
+  bool is_string = (stype == SType::STR32 || stype == SType::STR64);
+  ArrayData* data = init_array(out, n, nas, is_string? 3 : 2, 0);
+  switch (stype) {
+    case SType::BOOL:    export_bool(col, nas, data); break;
+    case SType::INT8:    export_fixed<int8_t>(col, nas, data); break;
+    case SType::INT16:   export_fixed<int16_t>(col, nas, data); break;
+    case SType::INT32:   export_fixed<int32_t>(col, nas, data); break;
+    case SType::INT64:   export_fixed<int64_t>(col, nas, data); break;
+    case SType::FLOAT32: export_fixed<float>(col, nas, data); break;
+    case SType::FLOAT64: export_fixed<double>(col, nas, data); break;
+    case SType::STR32:   export_string<uint32_t>(col, nas, data); break;
+    case SType::STR64:   export_string<uint64_t>(col, nas, data); break;
+    default:
+      throw RuntimeError() << "Unexpected stype " << stype;  // LCOV_EXCL_LINE
+  }
+}
+
+
+void export_array(const DataTable* dt, ArrowArray* out) {
+  size_t ncols = dt->ncols();
+  ArrayData* data = init_array(out, dt->nrows(), 0, 1, ncols);
+  try {
+    for (size_t i = 0; i < ncols; ++i) {
+      export_column(dt->get_column(i), data->children[i]);
+    }
+  } catch (...) {
+    out->release(out);
+    throw;
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// ArrowArrayStream
+//------------------------------------------------------------------------------
+
+// The stream produces a single record batch, which is created upfront
+// while the caller holds the GIL. The stream's callbacks only hand over
+// the already exported structures.
+struct StreamData {
+  ArrowSchema schema;
+  ArrowArray array;
+};
+
+
+static int stream_get_schema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto data = static_cast<StreamData*>(stream->private_data);
+  try {
+    copy_schema(&data->schema, out);
+    return 0;
+  } catch (...) {
+    return ENOMEM;
+  }
+}
+
+
+static int stream_get_next(ArrowArrayStream* stream, ArrowArray* out) {
+  auto data = static_cast<StreamData*>(stream->private_data);
+  // Moving the array leaves the stream exhausted: the next call will
+  // return a released array, which indicates the end of the stream.
+  std::memcpy(out, &data->array, sizeof(ArrowArray));
+  data->array.release = nullptr;
+  return 0;
+}
+
+
+static const char* stream_get_last_error(ArrowArrayStream*) {
+  return nullptr;
+}
+
+
+static void release_stream(ArrowArrayStream* stream) {
+  if (!stream->release) return;
+  auto data = static_cast<StreamData*>(stream->private_data);
+  if (data->schema.release) data->schema.release(&data->schema);
+  if (data->array.release) data->array.release(&data->array);
+  delete data;
+  stream->release = nullptr;
+}
+
+
+void export_stream(const DataTable* dt, ArrowArrayStream* out) {
+  auto data = new StreamData();
+  try {
+    export_schema(dt, &data->schema);
+    export_array(dt, &data->array);
+  } catch (...) {
+    if (data->schema.release) data->schema.release(&data->schema);
+    delete data;
+    throw;
+  }
+  out->get_schema = stream_get_schema;
+  out->get_next = stream_get_next;
+  out->get_last_error = stream_get_last_error;
+  out->release = release_stream;
+  out->private_data = data;
+}
+
+
+
+}}  // namespace dt::arrow
@@ -0,0 +1,549 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>               // std::sort, std::unique, std::lower_bound
+#include <cstdint>                 // INT64_MAX
+#include <cstring>                 // std::memcpy, std::strcmp, std::strncmp
+#include <memory>                  // std::shared_ptr, std::unique_ptr
+#include <string>                  // std::string
+#include <type_traits>             // std::is_same
+#include <vector>                  // std::vector
+#include "arrow/arrow.h"
+#include "column/categorical.h"
+#include "column/strvec.h"
+#include "parallel/api.h"
+#include "utils/exceptions.h"
+#include "buffer.h"
+#include "column.h"
+#include "datatable.h"
+#include "ltype.h"
+#include "stype.h"
+namespace dt {
+namespace arrow {
+
+// Owner of the imported ArrowArray: the array is released when the
+// last Buffer referencing its memory is deleted.
+using ArrayOwner = std::shared_ptr<ArrowArray>;
+
+
+static ArrayOwner take_ownership(ArrowArray* array) {
+  auto moved = new ArrowArray(*array);
+  array->release = nullptr;
+  return ArrayOwner(moved,
+    [](ArrowArray* arr) {
+      if (arr->release) arr->release(arr);
+      delete arr;
+    });
+}
+
+
+static Error invalid_array() {
+  return ValueError() << "Invalid Arrow array: ";
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Array slices
+//------------------------------------------------------------------------------
+
+/**
+  * Range of rows `[offset, offset + length)` within an ArrowArray.
+  * The offset is usually the array's own offset, however for the
+  * children of a struct array it also includes the offset of the
+  * parent.
+  */
+struct Slice {
+  const ArrowSchema* schema;
+  const ArrowArray* array;
+  size_t offset;
+  size_t length;
+
+  Slice(const ArrowSchema* s, const ArrowArray* a, size_t parent_offset,
+        size_t n)
+    : schema(s), array(a), offset(parent_offset), length(n)
+  {
+    if (a->offset < 0 || a->length < 0 ||
+        parent_offset + n > static_cast<size_t>(a->length)) {
+      throw invalid_array() << "array of length " << a->length
+          << " is too short";
+    }
+    offset += static_cast<size_t>(a->offset);
+  }
+
+  void check_nbuffers(int64_t expected) const {
+    if (array->n_buffers != expected) {
+      throw invalid_array() << "an array of type `" << schema->format
+          << "` should have " << expected << " buffers, instead got "
+          << array->n_buffers;
+    }
+  }
+
+  template <typename T>
+  const T* data(size_t i) const {
+    return static_cast<const T*>(array->buffers[i]);
+  }
+
+  // Validity bitmap, or nullptr if all values are valid
+  const uint8_t* validity() const {
+    if (array->null_count == 0 || array->n_buffers == 0) return nullptr;
+    return data<uint8_t>(0);
+  }
+
+  size_t count_nulls() const {
+    const uint8_t* bitmap = validity();
+    if (!bitmap) return 0;
+    if (array->null_count > 0 && offset == static_cast<size_t>(array->offset)
+        && length == static_cast<size_t>(array->length)) {
+      return static_cast<size_t>(array->null_count);
+    }
+    size_t nulls = 0;
+    for (size_t i = 0; i < length; ++i) {
+      nulls += !is_valid(bitmap, i);
+    }
+    return nulls;
+  }
+
+  bool is_valid(const uint8_t* bitmap, size_t i) const {
+    size_t j = offset + i;
+    return (bitmap[j >> 3] >> (j & 7)) & 1;
+  }
+};
+
+
+
+
+//------------------------------------------------------------------------------
+// Import columns
+//------------------------------------------------------------------------------
+
+/**
+  * Arrow type `A` is imported into a column of type `T`. When the
+  * types are the same and there are no nulls, the data buffer is
+  * used as-is; otherwise the data is converted, replacing nulls with
+  * the NA values.
+  */
+template <typename A, typename T>
+static Column import_fixed(const Slice& s, const ArrayOwner& owner) {
+  s.check_nbuffers(2);
+  size_t n = s.length;
+  const A* values = s.data<A>(1);
+  if (!values && n) throw invalid_array() << "the data buffer is missing";
+  values += s.offset;
+  size_t nulls = s.count_nulls();
+  if (std::is_same<A, T>::value && nulls == 0) {
+    return Column::new_mbuf_column(n, stype_from<T>,
+                                   Buffer::external(values, n * sizeof(T), owner));
+  }
+  Buffer buf = Buffer::mem(n * sizeof(T));
+  auto out = static_cast<T*>(buf.xptr());
+  const uint8_t* bitmap = nulls? s.validity() : nullptr;
+  dt::parallel_for_static(n,
+    [&](size_t i) {
+      out[i] = (bitmap && !s.is_valid(bitmap, i))
+                  ? GETNA<T>() : static_cast<T>(values[i]);
+    });
+  return Column::new_mbuf_column(n, stype_from<T>, std::move(buf));
+}
+
+
+/**
+  * Arrow uint64 values are imported as int64 if they all fit into
+  * that type, and as float64 otherwise (the same way as fread treats
+  * the integers that are too large for int64).
+  */
+static Column import_uint64(const Slice& s, const ArrayOwner& owner) {
+  s.check_nbuffers(2);
+  size_t n = s.length;
+  const uint64_t* values = s.data<uint64_t>(1);
+  if (!values && n) throw invalid_array() << "the data buffer is missing";
+  values += s.offset;
+  const uint8_t* bitmap = s.count_nulls()? s.validity() : nullptr;
+  constexpr uint64_t MAX = static_cast<uint64_t>(INT64_MAX);
+  for (size_t i = 0; i < n; ++i) {
+    if (values[i] > MAX && (!bitmap || s.is_valid(bitmap, i))) {
+      return import_fixed<uint64_t, double>(s, owner);
+    }
+  }
+  return import_fixed<uint64_t, int64_t>(s, owner);
+}
+
+
+static Column import_bool(const Slice& s) {
+  s.check_nbuffers(2);
+  size_t n = s.length;
+  const uint8_t* values = s.data<uint8_t>(1);
+  if (!values && n) throw invalid_array() << "the data buffer is missing";
+  const uint8_t* bitmap = s.validity();
+  Buffer buf = Buffer::mem(n);
+  auto out = static_cast<int8_t*>(buf.xptr());
+  dt::parallel_for_static(n,
+    [&](size_t i) {
+      out[i] = (bitmap && !s.is_valid(bitmap, i))
+                  ? NA_I1 : static_cast<int8_t>(s.is_valid(values, i));
+    });
+  return Column::new_mbuf_column(n, SType::BOOL, std::move(buf));
+}
+
+
+/**
+  * Arrow strings with offsets of type `O` are imported into a column
+  * with offsets of type `U`. The character data is shared with the
+  * Arrow array, unless some of the null strings have a non-zero length
+  * in it (which Arrow allows, but datatable does not).
+  */
+template <typename O, typename U>
+static Column import_string(const Slice& s, const ArrayOwner& owner) {
+  constexpr U NA_BIT = U(1) << (sizeof(U) * 8 - 1);
+  s.check_nbuffers(3);
+  size_t n = s.length;
+  const O* offsets = s.data<O>(1);
+  const char* chars = s.data<char>(2);
+  if (!offsets) throw invalid_array() << "the offsets buffer is missing";
+  offsets += s.offset;
+  O start = offsets[0];
+  O end = offsets[n];
+  if (start < 0 || end < start) {
+    throw invalid_array() << "string offsets are invalid";
+  }
+  size_t nulls = s.count_nulls();
+  if (nulls == 0 && start == 0) {
+    return Column::new_string_column(n,
+        Buffer::external(offsets, (n + 1) * sizeof(O), owner),
+        Buffer::external(chars, static_cast<size_t>(end), owner));
+  }
+
+  const uint8_t* bitmap = nulls? s.validity() : nullptr;
+  bool compact = false;
+  if (bitmap) {
+    for (size_t i = 0; i < n; ++i) {
+      if (!s.is_valid(bitmap, i) && offsets[i + 1] != offsets[i]) {
+        compact = true;
+        break;
+      }
+    }
+  }
+  Buffer offsets_buf = Buffer::mem((n + 1) * sizeof(U));
+  auto out = static_cast<U*>(offsets_buf.xptr());
+  out[0] = 0;
+  if (!compact) {
+    dt::parallel_for_static(n,
+      [&](size_t i) {
+        U off = static_cast<U>(offsets[i + 1] - start);
+        out[i + 1] = (bitmap && !s.is_valid(bitmap, i))? (off | NA_BIT) : off;
+      });
+    Buffer strbuf = Buffer::external(chars + start,
+                                     static_cast<size_t>(end - start), owner);
+    return Column::new_string_column(n, std::move(offsets_buf),
+                                     std::move(strbuf));
+  }
+
+  std::vector<char> data;
+  for (size_t i = 0; i < n; ++i) {
+    if (s.is_valid(bitmap, i)) {
+      data.insert(data.end(), chars + offsets[i], chars + offsets[i + 1]);
+      out[i + 1] = static_cast<U>(data.size());
+    } else {
+      out[i + 1] = static_cast<U>(data.size()) | NA_BIT;
+    }
+  }
+  return Column::new_string_column(n, std::move(offsets_buf),
+                                   Buffer::copy(data.data(), data.size()));
+}
+
+
+static Column import_column(const Slice& s, const ArrayOwner& owner);
+
+
+template <typename A, typename T>
+static Column make_codes(const Slice& s, const std::vector<int32_t>& map) {
+  s.check_nbuffers(2);
+  size_t n = s.length;
+  const A* indices = s.data<A>(1);
+  if (!indices && n) throw invalid_array() << "the data buffer is missing";
+  indices += s.offset;
+  const uint8_t* bitmap = s.validity();
+  size_t ndict = map.size();
+  Buffer buf = Buffer::mem(n * sizeof(T));
+  auto out = static_cast<T*>(buf.xptr());
+  bool out_of_bounds = false;
+  for (size_t i = 0; i < n; ++i) {
+    if (bitmap && !s.is_valid(bitmap, i)) {
+      out[i] = GETNA<T>();
+      continue;
+    }
+    auto index = static_cast<size_t>(indices[i]);
+    if (indices[i] < 0 || index >= ndict) {
+      out_of_bounds = true;
+      break;
+    }
+    int32_t code = map[index];
+    out[i] = code < 0? GETNA<T>() : static_cast<T>(code);
+  }
+  if (out_of_bounds) {
+    throw invalid_array() << "dictionary index is out of bounds";
+  }
+  return Column::new_mbuf_column(n, stype_from<T>, std::move(buf));
+}
+
+
+template <typename A>
+static Column make_codes(const Slice& s, const std::vector<int32_t>& map,
+                         size_t ncategories)
+{
+  return (ncategories <= 127)?   make_codes<A, int8_t>(s, map) :
+         (ncategories <= 32767)? make_codes<A, int16_t>(s, map) :
+                                 make_codes<A, int32_t>(s, map);
+}
+
+
+/**
+  * Dictionary-encoded Arrow arrays with string values become
+  * categorical columns. Since datatable requires the dictionary to be
+  * sorted and free of duplicates and NAs, the dictionary is re-sorted,
+  * and the indices are remapped.
+  */
+static Column import_dictionary(const Slice& s, const ArrayOwner& owner) {
+  const ArrowArray* dict_array = s.array->dictionary;
+  if (!dict_array) {
+    throw invalid_array() << "the dictionary is missing";
+  }
+  Slice ds(s.schema->dictionary, dict_array, 0,
+           static_cast<size_t>(dict_array->length));
+  Column values = import_column(ds, owner);
+  if (values.ltype() != LType::STRING) {
+    throw NotImplError() << "Cannot import a dictionary-encoded Arrow array "
+        "with values of type `" << ds.schema->format << "`";
+  }
+  size_t ndict = values.nrows();
+  strvec dict_values;
+  CString str;
+  for (size_t i = 0; i < ndict; ++i) {
+    if (values.get_element(i, &str)) {
+      dict_values.emplace_back(str.data(), str.size());
+    }
+  }
+  std::sort(dict_values.begin(), dict_values.end());
+  dict_values.erase(std::unique(dict_values.begin(), dict_values.end()),
+                    dict_values.end());
+  size_t ncategories = dict_values.size();
+  if (ncategories == 0) {
+    return Column::new_na_column(s.length, values.stype());
+  }
+  std::vector<int32_t> map(ndict, -1);
+  for (size_t i = 0; i < ndict; ++i) {
+    if (values.get_element(i, &str)) {
+      std::string value(str.data(), str.size());
+      auto it = std::lower_bound(dict_values.begin(), dict_values.end(), value);
+      map[i] = static_cast<int32_t>(it - dict_values.begin());
+    }
+  }
+
+  Column codes;
+  const char* format = s.schema->format;
+  switch (format[1] == '\0'? format[0] : '\0') {
+    case 'c': codes = make_codes<int8_t>(s, map, ncategories); break;
+    case 'C': codes = make_codes<uint8_t>(s, map, ncategories); break;
+    case 's': codes = make_codes<int16_t>(s, map, ncategories); break;
+    case 'S': codes = make_codes<uint16_t>(s, map, ncategories); break;
+    case 'i': codes = make_codes<int32_t>(s, map, ncategories); break;
+    case 'I': codes = make_codes<uint32_t>(s, map, ncategories); break;
+    case 'l': codes = make_codes<int64_t>(s, map, ncategories); break;
+    case 'L': codes = make_codes<uint64_t>(s, map, ncategories); break;
+    default:
+      throw invalid_array() << "dictionary indices of type `" << format
+          << "` are not allowed";
+  }
+  Column dict(new Strvec_ColumnImpl(dict_values));
+  dict.materialize();
+  return Column(new Categorical_ColumnImpl(std::move(codes), std::move(dict),
+                                           values.stype()));
+}
+
+
+static bool starts_with(const char* format, const char* prefix) {
+  return std::strncmp(format, prefix, std::strlen(prefix)) == 0;
+}
+
+
+static Column import_column(const Slice& s, const ArrayOwner& owner) {
+  const char* format = s.schema->format;
+  if (s.schema->dictionary) {
+    return import_dictionary(s, owner);
+  }
+  if (format[0] != '\0' && format[1] == '\0') {
+    switch (format[0]) {
+      case 'n': return Column::new_na_column(s.length, SType::BOOL);
+      case 'b': return import_bool(s);
+      case 'c': return import_fixed<int8_t, int8_t>(s, owner);
+      case 'C': return import_fixed<uint8_t, int16_t>(s, owner);
+      case 's': return import_fixed<int16_t, int16_t>(s, owner);
+      case 'S': return import_fixed<uint16_t, int32_t>(s, owner);
+      case 'i': return import_fixed<int32_t, int32_t>(s, owner);
+      case 'I': return import_fixed<uint32_t, int64_t>(s, owner);
+      case 'l': return import_fixed<int64_t, int64_t>(s, owner);
+      case 'L': return import_uint64(s, owner);
+      case 'f': return import_fixed<float, float>(s, owner);
+      case 'g': return import_fixed<double, double>(s, owner);
+      case 'u': return import_string<int32_t, uint32_t>(s, owner);
+      case 'U': return import_string<int64_t, uint64_t>(s, owner);
+      default: break;
+    }
+  }
+  // Temporal types are imported as their underlying integers: the
+  // number of days/seconds/milli-, micro- or nanoseconds.
+  if (std::strcmp(format, "tdD") == 0 || std::strcmp(format, "tts") == 0 ||
+      std::strcmp(format, "ttm") == 0) {
+    return import_fixed<int32_t, int32_t>(s, owner);
+  }
+  if (std::strcmp(format, "tdm") == 0 || std::strcmp(format, "ttu") == 0 ||
+      std::strcmp(format, "ttn") == 0 || starts_with(format, "ts") ||
+      starts_with(format, "tD")) {
+    return import_fixed<int64_t, int64_t>(s, owner);
+  }
+  throw NotImplError() << "Cannot import Arrow array of type `" << format
+      << "`";
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Public API
+//------------------------------------------------------------------------------
+
+DataTable* import_array(const ArrowSchema* schema, ArrowArray* array) {
+  if (!array->release) {
+    throw invalid_array() << "the array was already released";
+  }
+  if (array->length < 0 || array->offset < 0) {
+    throw invalid_array() << "negative length or offset";
+  }
+  ArrayOwner owner = take_ownership(array);
+  const ArrowArray* arr = owner.get();
+  size_t nrows = static_cast<size_t>(arr->length);
+  colvec columns;
+  strvec names;
+  if (std::strcmp(schema->format, "+s") == 0) {
+    if (arr->null_count > 0) {
+      throw NotImplError() << "Cannot import an Arrow struct array with nulls";
+    }
+    if (schema->n_children != arr->n_children) {
+      throw invalid_array() << "the number of children in the schema and in "
+          "the array do not match";
+    }
+    auto parent_offset = static_cast<size_t>(arr->offset);
+    for (int64_t i = 0; i < arr->n_children; ++i) {
+      const ArrowSchema* child_schema = schema->children[i];
+      Slice s(child_schema, arr->children[i], parent_offset, nrows);
+      columns.push_back(import_column(s, owner));
+      names.push_back(child_schema->name? child_schema->name : "");
+    }
+  } else {
+    Slice s(schema, arr, 0, nrows);
+    columns.push_back(import_column(s, owner));
+    names.push_back(schema->name? schema->name : "");
+  }
+  return new DataTable(std::move(columns), names);
+}
+
+
+static Error stream_error(ArrowArrayStream* stream, int code) {
+  const char* message = stream->get_last_error(stream);
+  auto err = IOError() << "Error " << code << " while reading Arrow stream";
+  if (message) err << ": " << message;
+  return err;
+}
+
+
+static SType import_stype(const ArrowSchema* schema) {
+  // Import a zero-length array of the given type, and check the type
+  // of the resulting column.
+  const void* buffers[3] = {nullptr, nullptr, nullptr};
+  int64_t zero = 0;
+  ArrowArray dictionary {0, 0, 0, 3, 0, buffers, nullptr, nullptr,
+                         nullptr, nullptr};
+  buffers[1] = &zero;
+  ArrowArray array {0, 0, 0, 3, 0, buffers, nullptr,
+                    schema->dictionary? &dictionary : nullptr,
+                    nullptr, nullptr};
+  const char* format = schema->format;
+  bool is_string = schema->dictionary ||
+                   std::strcmp(format, "u") == 0 ||
+                   std::strcmp(format, "U") == 0;
+  if (std::strcmp(format, "n") == 0) array.n_buffers = 0;
+  else if (!is_string) array.n_buffers = 2;
+  if (schema->dictionary) array.n_buffers = 2;
+  Slice s(schema, &array, 0, 0);
+  Column col = import_column(s, ArrayOwner());
+  return col.stype();
+}
+
+
+DataTable* import_stream(ArrowArrayStream* stream) {
+  ArrowSchema schema;
+  int ret = stream->get_schema(stream, &schema);
+  if (ret) throw stream_error(stream, ret);
+  std::unique_ptr<ArrowSchema, void(*)(ArrowSchema*)> schema_guard(&schema,
+    [](ArrowSchema* sch) { if (sch->release) sch->release(sch); });
+
+  std::vector<std::unique_ptr<DataTable>> batches;
+  while (true) {
+    ArrowArray array;
+    ret = stream->get_next(stream, &array);
+    if (ret) throw stream_error(stream, ret);
+    if (!array.release) break;
+    batches.emplace_back(import_array(&schema, &array));
+  }
+
+  if (batches.empty()) {
+    // Create an empty frame with the columns described by the schema
+    colvec columns;
+    strvec names;
+    bool is_struct = (std::strcmp(schema.format, "+s") == 0);
+    int64_t ncols = is_struct? schema.n_children : 1;
+    for (int64_t i = 0; i < ncols; ++i) {
+      const ArrowSchema* child = is_struct? schema.children[i] : &schema;
+      columns.push_back(Column::new_data_column(0, import_stype(child)));
+      names.push_back(child->name? child->name : "");
+    }
+    return new DataTable(std::move(columns), names);
+  }
+  DataTable* res = batches[0].release();
+  if (batches.size() > 1) {
+    size_t ncols = res->ncols();
+    std::vector<DataTable*> rest;
+    for (size_t j = 1; j < batches.size(); ++j) {
+      rest.push_back(batches[j].get());
+    }
+    std::vector<sztvec> col_indices(ncols, sztvec(rest.size()));
+    for (size_t i = 0; i < ncols; ++i) {
+      for (size_t j = 0; j < rest.size(); ++j) col_indices[i][j] = i;
+    }
+    res->rbind(rest, col_indices);
+  }
+  return res;
+}
+
+
+
+}}  // namespace dt::arrow
@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
 #include <algorithm>           // std::min
+#include <atomic>              // std::atomic
 #include <cerrno>              // errno
 #include <cstring>             // std::strerror, std::memcpy
 #include <mutex>               // std::mutex, std::lock_guard
@@ -305,8 +306,9 @@ class Memory_BufferImpl : public BufferImpl
 /**
   * This class represents a piece of memory owned by some external
   * entity. The lifetime of the memory region may be guarded by a
-  * Py_buffer object. However, it is also possible to wrap a
-  * completely unguarded memory range, in which case it is the
+  * Py_buffer object, or by an arbitrary `owner` object. However, it
+  * is also possible to wrap a completely unguarded memory range, in
+  * which case it is the
   * responsibility of the user to ensure that the memory remains
   * valid during the lifetime of External_BufferImpl object.
   */
@@ -314,6 +316,7 @@ class External_BufferImpl : public BufferImpl
 {
   private:
     std::unique_ptr<py::buffer> pybufinfo_;
+    std::shared_ptr<void> owner_;
 
   public:
     External_BufferImpl(const void* ptr, size_t n) {
@@ -331,6 +334,13 @@ class External_BufferImpl : public BufferImpl
       pybufinfo_ = std::move(pybuf);
     }
 
+    External_BufferImpl(const void* ptr, size_t n,
+                        std::shared_ptr<void>&& owner)
+      : External_BufferImpl(ptr, n)
+    {
+      owner_ = std::move(owner);
+    }
+
     External_BufferImpl(void* ptr, size_t n)
       : External_BufferImpl(static_cast<const void*>(ptr), n)
     {
@@ -349,7 +359,7 @@ class External_BufferImpl : public BufferImpl
     }
 
     void to_memory(Buffer& out) override {
-      if (pybufinfo_) out = Buffer::copy(data_, size_);
+      if (pybufinfo_ || owner_) out = Buffer::copy(data_, size_);
     }
 };
 
@@ -501,6 +511,83 @@ class TemporaryFile_BufferImpl : public BufferImpl
 
 
 
+//------------------------------------------------------------------------------
+// Lazy_BufferImpl
+//------------------------------------------------------------------------------
+
+/**
+  * Buffer whose contents are produced on demand: the memory is
+  * allocated and then filled by the user-provided function `fill_`
+  * only when the data pointer is requested for the first time. For
+  * example, compressed columns in a Jay file are opened this way, so
+  * that only the columns that are actually used get decompressed.
+  *
+  * The data pointer may be requested from several threads at once
+  * (for example, within a parallel region). In this case only one
+  * thread will run the `fill_` function, while the others wait for
+  * it to finish.
+  */
+class Lazy_BufferImpl : public BufferImpl
+{
+  private:
+    std::function<void(void*)> fill_;
+    std::mutex mutex_;
+    std::atomic<bool> filled_;
+
+  public:
+    Lazy_BufferImpl(size_t n, std::function<void(void*)>&& fill)
+      : fill_(std::move(fill)),
+        filled_(false)
+    {
+      xassert(n > 0);
+      size_ = n;
+      writable_ = false;
+      resizable_ = false;
+    }
+
+    ~Lazy_BufferImpl() override {
+      dt::free(data_);
+    }
+
+    void* data() const override {
+      if (!filled_.load(std::memory_order_acquire)) {
+        const_cast<Lazy_BufferImpl*>(this)->fill();
+      }
+      return data_;
+    }
+
+    size_t memory_footprint() const noexcept override {
+      return sizeof(Lazy_BufferImpl) + (filled_? size_ : 0);
+    }
+
+    void verify_integrity() const override {
+      if (filled_) {
+        BufferImpl::verify_integrity();
+      } else {
+        XAssert(!data_ && size_ > 0);
+      }
+    }
+
+  private:
+    void fill() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (filled_) return;
+      void* ptr = dt::malloc<void>(size_);
+      try {
+        fill_(ptr);
+      } catch (...) {
+        dt::free(ptr);
+        throw;
+      }
+      data_ = ptr;
+      fill_ = nullptr;  // release the resources held by the function
+      filled_.store(true, std::memory_order_release);
+    }
+};
+
+
+
+
 //------------------------------------------------------------------------------
 // Mmap_BufferImpl
 //------------------------------------------------------------------------------
@@ -800,6 +887,11 @@ class Mmap_BufferImpl : public BufferImpl, MemoryMapWorker {
               ptr, n, std::make_unique<py::buffer>(std::move(pb))));
   }
 
+  Buffer Buffer::external(const void* ptr, size_t n,
+                          std::shared_ptr<void> owner) {
+    return Buffer(new External_BufferImpl(ptr, n, std::move(owner)));
+  }
+
   Buffer Buffer::pybytes(const py::oobj& src) {
     return Buffer(new PyBytes_BufferImpl(src));
   }
@@ -816,6 +908,10 @@ class Mmap_BufferImpl : public BufferImpl, MemoryMapWorker {
     return Buffer(new Mmap_BufferImpl(path, n, fd, create));
   }
 
+  Buffer Buffer::lazy(size_t n, std::function<void(void*)> fill) {
+    return n? Buffer(new Lazy_BufferImpl(n, std::move(fill))) : Buffer();
+  }
+
   Buffer Buffer::tmp(std::shared_ptr<TemporaryFile> tempfile,
                      size_t offset, size_t length) {
     return Buffer(new TemporaryFile_BufferImpl(std::move(tempfile),
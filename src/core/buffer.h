@@ -22,7 +22,8 @@
 #ifndef dt_BUFFER_h
 #define dt_BUFFER_h
 #include <cstdint>
-#include <memory>             // std::unique_ptr
+#include <functional>         // std::function
+#include <memory>             // std::unique_ptr, std::shared_ptr
 #include <string>             // std::string
 #include <type_traits>        // std::is_same
 #include "_dt.h"
@@ -121,11 +122,22 @@ class Buffer
     //   interface. The Buffer object created in this way is neither
     //   writeable nor resizeable.
     //
+    // Buffer::external(ptr, n, owner)
+    //   Same as above, except that the memory's lifetime is guarded by an
+    //   arbitrary `owner` object, which is released when the Buffer is
+    //   deleted. This is used, for example, for the buffers imported via
+    //   the Arrow C data interface.
+    //
     // Buffer::view(src, n, offset)
     //   Create Buffer as a "view" onto another Buffer `src`. The
     //   view is positioned at `offset` from the beginning of `src`s buffer,
     //   and has the length `n`.
     //
+    // Buffer::lazy(n, fill)
+    //   Create Buffer of size `n` whose memory will be allocated and
+    //   then filled by calling `fill(ptr)` only when the data is
+    //   accessed for the first time. The resulting Buffer is read-only.
+    //
     // Buffer:mmap(path)
     //   Create Buffer by mem-mapping a file given by the `path`.
     //
@@ -140,8 +152,11 @@ class Buffer
     static Buffer external(void* ptr, size_t n);
     static Buffer external(const void* ptr, size_t n);
     static Buffer external(const void* ptr, size_t n, py::buffer&& pybuf);
+    static Buffer external(const void* ptr, size_t n,
+                           std::shared_ptr<void> owner);
     static Buffer pybytes(const py::oobj& src);
     static Buffer view(const Buffer& src, size_t n, size_t offset);
+    static Buffer lazy(size_t n, std::function<void(void*)> fill);
     static Buffer mmap(const std::string& path);
     static Buffer mmap(const std::string& path, size_t n, int fd = -1,
                        bool create = true);
@@ -135,7 +135,10 @@ dt::ColumnImpl* Column::_get_mutable_impl(bool keep_stats) {
     impl_->refcount_ -= 1;
     impl_ = newimpl;
   } else {
-    if (!keep_stats) reset_stats();
+    if (!keep_stats) {
+      reset_stats();
+      impl_->zone_map_ = nullptr;
+    }
   }
   xassert(impl_->refcount_ == 1);
   return const_cast<dt::ColumnImpl*>(impl_);
@@ -179,6 +182,10 @@ bool Column::allow_parallel_access() const {
   return impl_->allow_parallel_access();
 }
 
+bool Column::get_categorical(Column* codes, Column* dict) const {
+  return impl_->get_categorical(codes, dict);
+}
+
 bool Column::is_constant() const noexcept {
   return bool(dynamic_cast<const dt::Const_ColumnImpl*>(impl_));
 }
@@ -241,6 +248,46 @@ bool Column::get_element(size_t i, py::oobj* out) const {
   return impl_->get_element(i, out);
 }
 
+void Column::get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, float* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, double* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, dt::CString* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
+void Column::get_elements(size_t i0, size_t i1, py::oobj* out, bool* valid) const {
+  xassert(i0 <= i1 && i1 <= nrows());
+  impl_->get_elements(i0, i1, out, valid);
+}
+
 
 
 template <typename T>
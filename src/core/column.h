@@ -21,11 +21,18 @@
 //------------------------------------------------------------------------------
 #ifndef dt_COLUMN_h
 #define dt_COLUMN_h
+#include <memory>        // std::shared_ptr
 #include "_dt.h"
 #include "stats.h"       // Stat (enum), Stats
 
 namespace dt {
   class ColumnImpl;
+  class ZoneMap;
+
+  // Recommended number of rows to be requested in a single call to
+  // `Column::get_elements()`. Virtual columns use buffers of this
+  // size for reading the values of their children.
+  static constexpr size_t GET_ELEMENTS_BATCH = 1024;
 }
 
 enum class NaStorage : uint8_t {
@@ -156,6 +163,27 @@ class Column
     bool get_element(size_t i, dt::CString* out) const;
     bool get_element(size_t i, py::oobj* out) const;
 
+    // `get_elements(i0, i1, out, valid)` retrieves the column's
+    // elements in the range of rows `[i0; i1)` into the array `out`,
+    // and their validity flags into the array `valid`. Both arrays
+    // must have room for at least `i1 - i0` elements. Same as with
+    // `get_element()`, the values in `out` that correspond to NAs
+    // may contain garbage.
+    //
+    // For virtual columns this is much faster than calling
+    // `get_element()` in a loop, since the virtual calls are made
+    // once per batch of rows instead of once per element. The best
+    // batch size is `dt::GET_ELEMENTS_BATCH` rows.
+    //
+    void get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, float* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, double* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, dt::CString* out, bool* valid) const;
+    void get_elements(size_t i0, size_t i1, py::oobj* out, bool* valid) const;
+
     // `get_element_as_pyobject(i)` returns the i-th element of the
     // column wrapped into a pyobject of the appropriate type.
     py::oobj get_element_as_pyobject(size_t i) const;
@@ -225,6 +253,26 @@ class Column
     void replace_stats(std::unique_ptr<Stats>&&);
     bool is_stat_computed(Stat) const;
 
+    // A column opened from a Jay file may carry a `ZoneMap`: per
+    // row-group min/max/nacount of its values. The zone map is
+    // dropped whenever the column's data is modified.
+    const dt::ZoneMap* get_zone_map() const noexcept;
+    void set_zone_map(std::shared_ptr<const dt::ZoneMap>);
+
+    // A string column may be dictionary-encoded, in which case this
+    // method returns true and stores the column's integer codes and
+    // its sorted dictionary into `codes` and `dict` (unless they are
+    // null). The codes are ordered in the same way as the strings,
+    // and thus may be used instead of the column for sorting and
+    // grouping. See "column/categorical.h".
+    bool get_categorical(Column* codes, Column* dict = nullptr) const;
+
+    // Returns the integer codes of a dictionary-encoded column, or
+    // the column itself otherwise. Sorting, grouping and top-k
+    // selection use this in order to compare categorical columns by
+    // their codes.
+    Column unwrap_categorical_codes() const;
+
 
   //------------------------------------
   // ColumnImpl manipulation
@@ -272,7 +320,9 @@ class Column
     flatbuffers::Offset<jay::Column> write_to_jay(
         const std::string& name,
         flatbuffers::FlatBufferBuilder&,
-        WritableBuffer*);
+        WritableBuffer*,
+        jay::Codec,
+        size_t chunk_nrows);
     void write_data_to_jay(jay::ColumnBuilder&, WritableBuffer*);
 
   private:
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <memory>        // std::unique_ptr
+#include <vector>        // std::vector
+#include "column/batch_buffer.h"
+namespace dt {
+
+
+// Blocks released beyond this number are returned to the system,
+// so that a single very deep expression does not leave megabytes
+// of memory attached to each thread.
+static constexpr size_t MAX_FREE_BLOCKS = 32;
+
+// Blocks are allocated as `double`s, which guarantees the alignment
+// suitable for any of the element types.
+using block_t = std::unique_ptr<double[]>;
+static constexpr size_t BLOCK_NDOUBLES = BATCH_BLOCK_SIZE / sizeof(double);
+
+static thread_local std::vector<block_t> free_blocks;
+
+
+void* acquire_batch_block() {
+  if (free_blocks.empty()) {
+    return new double[BLOCK_NDOUBLES];
+  }
+  void* block = free_blocks.back().release();
+  free_blocks.pop_back();
+  return block;
+}
+
+
+void release_batch_block(void* block) noexcept {
+  auto dblock = static_cast<double*>(block);
+  if (free_blocks.size() < MAX_FREE_BLOCKS) {
+    try {
+      free_blocks.emplace_back(dblock);
+      return;
+    } catch (...) {}
+  }
+  delete[] dblock;
+}
+
+
+
+
+}  // namespace dt
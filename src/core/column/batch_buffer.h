@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_COLUMN_BATCH_BUFFER_h
+#define dt_COLUMN_BATCH_BUFFER_h
+#include <new>           // placement new
+#include <type_traits>   // std::is_trivially_destructible
+#include "column.h"
+namespace dt {
+
+
+// Size of a single scratch block, enough for GET_ELEMENTS_BATCH
+// values of any element type.
+static constexpr size_t BATCH_BLOCK_SIZE = GET_ELEMENTS_BATCH * 32;
+
+void* acquire_batch_block();
+void release_batch_block(void* block) noexcept;
+
+
+
+/**
+  * Temporary array of `GET_ELEMENTS_BATCH` elements of type `T`,
+  * used by the virtual columns for reading the values of their
+  * children in `get_elements()`.
+  *
+  * The memory comes from a small per-thread pool of heap blocks
+  * rather than from the stack: the `get_elements()` calls recurse
+  * through the whole tree of a virtual column, and a deeply nested
+  * expression would otherwise overflow the stack of the thread.
+  */
+template <typename T>
+class BatchBuffer {
+  static_assert(sizeof(T) * GET_ELEMENTS_BATCH <= BATCH_BLOCK_SIZE,
+                "Type is too large for a BatchBuffer");
+  private:
+    T* data_;
+
+  public:
+    BatchBuffer() : data_(static_cast<T*>(acquire_batch_block())) {
+      if (!std::is_trivially_default_constructible<T>::value) {
+        for (size_t i = 0; i < GET_ELEMENTS_BATCH; ++i) {
+          new (data_ + i) T();
+        }
+      }
+    }
+
+    BatchBuffer(const BatchBuffer&) = delete;
+    BatchBuffer(BatchBuffer&& other) noexcept : data_(other.data_) {
+      other.data_ = nullptr;
+    }
+
+    ~BatchBuffer() {
+      if (!data_) return;
+      if (!std::is_trivially_destructible<T>::value) {
+        for (size_t i = 0; i < GET_ELEMENTS_BATCH; ++i) {
+          data_[i].~T();
+        }
+      }
+      release_batch_block(data_);
+    }
+
+    T* data() const noexcept { return data_; }
+    operator T*() const noexcept { return data_; }
+};
+
+
+
+
+}  // namespace dt
+#endif
@@ -21,6 +21,8 @@
 //------------------------------------------------------------------------------
 #ifndef dt_COLUMN_CAST_h
 #define dt_COLUMN_CAST_h
+#include <algorithm>  // std::min
+#include "column/batch_buffer.h"
 #include "column/virtual.h"
 namespace dt {
 
@@ -38,9 +40,32 @@ class Cast_ColumnImpl : public Virtual_ColumnImpl {
 
     size_t n_children() const noexcept override;
     const Column& child(size_t) const override;
+
+  protected:
+    template <typename TI, typename TO>
+    void _cast_elements(size_t i0, size_t i1, TO* out, bool* valid) const;
 };
 
 
+// Retrieve elements `[i0; i1)` of type TI from the `arg_` column in
+// batches, then cast them into type TO and write into `out`.
+//
+template <typename TI, typename TO>
+void Cast_ColumnImpl::_cast_elements(
+    size_t i0, size_t i1, TO* out, bool* valid) const
+{
+  BatchBuffer<TI> x;
+  for (size_t j0 = i0; j0 < i1; j0 += GET_ELEMENTS_BATCH) {
+    size_t n = std::min(GET_ELEMENTS_BATCH, i1 - j0);
+    TO* tout = out + (j0 - i0);
+    arg_.get_elements(j0, j0 + n, x, valid + (j0 - i0));
+    for (size_t k = 0; k < n; ++k) {
+      tout[k] = static_cast<TO>(x[k]);
+    }
+  }
+}
+
+
 
 
 //------------------------------------------------------------------------------
@@ -125,6 +150,13 @@ class CastBool_ColumnImpl : public Cast_ColumnImpl {
     bool get_element(size_t, CString*)  const override;
     bool get_element(size_t, py::oobj*) const override;
 
+    void get_elements(size_t, size_t, int8_t*, bool*)  const override;
+    void get_elements(size_t, size_t, int16_t*, bool*) const override;
+    void get_elements(size_t, size_t, int32_t*, bool*) const override;
+    void get_elements(size_t, size_t, int64_t*, bool*) const override;
+    void get_elements(size_t, size_t, float*, bool*)   const override;
+    void get_elements(size_t, size_t, double*, bool*)  const override;
+
   private:
     template <typename T> inline bool _get(size_t i, T* out) const;
 };
@@ -156,6 +188,13 @@ class CastNumeric_ColumnImpl : public Cast_ColumnImpl {
     bool get_element(size_t, CString*)  const override;
     bool get_element(size_t, py::oobj*) const override;
 
+    void get_elements(size_t, size_t, int8_t*, bool*)  const override;
+    void get_elements(size_t, size_t, int16_t*, bool*) const override;
+    void get_elements(size_t, size_t, int32_t*, bool*) const override;
+    void get_elements(size_t, size_t, int64_t*, bool*) const override;
+    void get_elements(size_t, size_t, float*, bool*)   const override;
+    void get_elements(size_t, size_t, double*, bool*)  const override;
+
   private:
     template <typename V> inline bool _get(size_t i, V* out) const;
 };
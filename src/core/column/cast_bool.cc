@@ -92,5 +92,31 @@ inline bool CastBool_ColumnImpl::_get(size_t i, T* out) const {
 
 
 
+void CastBool_ColumnImpl::get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const {
+  arg_.get_elements(i0, i1, out, valid);
+}
+
+void CastBool_ColumnImpl::get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const {
+  _cast_elements<int8_t>(i0, i1, out, valid);
+}
+
+void CastBool_ColumnImpl::get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const {
+  _cast_elements<int8_t>(i0, i1, out, valid);
+}
+
+void CastBool_ColumnImpl::get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const {
+  _cast_elements<int8_t>(i0, i1, out, valid);
+}
+
+void CastBool_ColumnImpl::get_elements(size_t i0, size_t i1, float* out, bool* valid) const {
+  _cast_elements<int8_t>(i0, i1, out, valid);
+}
+
+void CastBool_ColumnImpl::get_elements(size_t i0, size_t i1, double* out, bool* valid) const {
+  _cast_elements<int8_t>(i0, i1, out, valid);
+}
+
+
+
 
 }  // namespace dt
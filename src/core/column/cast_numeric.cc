@@ -108,6 +108,38 @@ bool CastNumeric_ColumnImpl<T>::get_element(size_t i, py::oobj* out) const {
 }
 
 
+template <typename T>
+void CastNumeric_ColumnImpl<T>::get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const {
+  _cast_elements<T>(i0, i1, out, valid);
+}
+
+template <typename T>
+void CastNumeric_ColumnImpl<T>::get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const {
+  _cast_elements<T>(i0, i1, out, valid);
+}
+
+template <typename T>
+void CastNumeric_ColumnImpl<T>::get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const {
+  _cast_elements<T>(i0, i1, out, valid);
+}
+
+template <typename T>
+void CastNumeric_ColumnImpl<T>::get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const {
+  _cast_elements<T>(i0, i1, out, valid);
+}
+
+template <typename T>
+void CastNumeric_ColumnImpl<T>::get_elements(size_t i0, size_t i1, float* out, bool* valid) const {
+  _cast_elements<T>(i0, i1, out, valid);
+}
+
+template <typename T>
+void CastNumeric_ColumnImpl<T>::get_elements(size_t i0, size_t i1, double* out, bool* valid) const {
+  _cast_elements<T>(i0, i1, out, valid);
+}
+
+
+
 template class CastNumeric_ColumnImpl<int8_t>;
 template class CastNumeric_ColumnImpl<int16_t>;
 template class CastNumeric_ColumnImpl<int32_t>;
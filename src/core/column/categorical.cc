@@ -0,0 +1,393 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>             // std::sort, std::unique, std::lower_bound
+#include <atomic>                // std::atomic
+#include <cstring>               // std::memcmp
+#include <memory>                // std::unique_ptr
+#include <string>                // std::string
+#include <vector>                // std::vector
+#include "column/categorical.h"
+#include "column/strvec.h"
+#include "models/murmurhash.h"
+#include "parallel/api.h"
+#include "utils/assert.h"
+#include "ltype.h"
+#include "stype.h"
+namespace dt {
+
+
+
+//------------------------------------------------------------------------------
+// Construction
+//------------------------------------------------------------------------------
+
+Categorical_ColumnImpl::Categorical_ColumnImpl(
+    Column&& codes, Column&& dict, SType stype)
+  : Virtual_ColumnImpl(codes.nrows(), stype),
+    codes_(std::move(codes)),
+    dict_(std::move(dict))
+{
+  xassert(codes_.ltype() == LType::INT);
+  xassert(dict_.ltype() == LType::STRING);
+  xassert(stype_to_ltype(stype) == LType::STRING);
+}
+
+
+ColumnImpl* Categorical_ColumnImpl::clone() const {
+  return new Categorical_ColumnImpl(Column(codes_), Column(dict_), stype_);
+}
+
+
+void Categorical_ColumnImpl::verify_integrity() const {
+  codes_.verify_integrity();
+  dict_.verify_integrity();
+  XAssert(codes_.nrows() == nrows_);
+  XAssert(codes_.ltype() == LType::INT);
+  XAssert(dict_.ltype() == LType::STRING);
+  XAssert(dict_.na_count() == 0);
+}
+
+
+size_t Categorical_ColumnImpl::memory_footprint() const noexcept {
+  return sizeof(*this) + codes_.memory_footprint() + dict_.memory_footprint();
+}
+
+
+size_t Categorical_ColumnImpl::n_children() const noexcept {
+  return 2;
+}
+
+const Column& Categorical_ColumnImpl::child(size_t i) const {
+  xassert(i <= 1);
+  return i == 0? codes_ : dict_;
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Data access
+//------------------------------------------------------------------------------
+
+template <typename T>
+static bool get_code(const Column& codes, size_t i, size_t* out) {
+  T code;
+  bool valid = codes.get_element(i, &code);
+  *out = static_cast<size_t>(code);
+  return valid;
+}
+
+
+bool Categorical_ColumnImpl::get_element(size_t i, CString* out) const {
+  size_t code = 0;
+  bool valid = false;
+  switch (codes_.stype()) {
+    case SType::INT8:  valid = get_code<int8_t>(codes_, i, &code); break;
+    case SType::INT16: valid = get_code<int16_t>(codes_, i, &code); break;
+    case SType::INT32: valid = get_code<int32_t>(codes_, i, &code); break;
+    default: throw RuntimeError() << "Invalid stype of categorical codes";
+  }
+  return valid && dict_.get_element(code, out);
+}
+
+
+bool Categorical_ColumnImpl::get_categorical(Column* codes, Column* dict) const {
+  if (codes) *codes = codes_;
+  if (dict) *dict = dict_;
+  return true;
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Column manipulation
+//------------------------------------------------------------------------------
+
+// These methods modify only the codes, so that the result is still a
+// dictionary-encoded column sharing the same dictionary.
+
+void Categorical_ColumnImpl::apply_rowindex(const RowIndex& ri, Column& out) {
+  if (!ri) return;
+  Column codes(codes_);
+  codes.apply_rowindex(ri);
+  out = Column(new Categorical_ColumnImpl(std::move(codes), Column(dict_),
+                                          stype_));
+}
+
+
+void Categorical_ColumnImpl::na_pad(size_t new_nrows, Column& out) {
+  xassert(new_nrows > nrows_);
+  Column codes(codes_);
+  codes.resize(new_nrows);
+  out = Column(new Categorical_ColumnImpl(std::move(codes), Column(dict_),
+                                          stype_));
+}
+
+
+void Categorical_ColumnImpl::truncate(size_t new_nrows, Column& out) {
+  xassert(new_nrows < nrows_);
+  Column codes(codes_);
+  codes.resize(new_nrows);
+  out = Column(new Categorical_ColumnImpl(std::move(codes), Column(dict_),
+                                          stype_));
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Encoding
+//------------------------------------------------------------------------------
+
+// Minimum number of rows processed by a single thread in `encode()`.
+static constexpr size_t MIN_ROWS_PER_THREAD = 1 << 16;
+
+
+/**
+  * Open-addressing hash set of strings, that assigns consecutive ids
+  * to the strings in the order of their insertion.
+  */
+class StringIndex {
+  private:
+    std::vector<int32_t> slots_;  // string id, or -1 for an empty slot
+    std::vector<uint64_t> hashes_;
+    size_t mask_;
+
+  public:
+    strvec strings;
+
+    StringIndex() : slots_(256, -1), mask_(255) {}
+
+    size_t size() const noexcept {
+      return strings.size();
+    }
+
+    int32_t find_or_insert(const CString& str) {
+      uint64_t h = hash_murmur2(str.data(), str.size());
+      size_t k = static_cast<size_t>(h) & mask_;
+      while (true) {
+        int32_t id = slots_[k];
+        if (id < 0) break;
+        auto uid = static_cast<size_t>(id);
+        if (hashes_[uid] == h && strings[uid].size() == str.size() &&
+            std::memcmp(strings[uid].data(), str.data(), str.size()) == 0) {
+          return id;
+        }
+        k = (k + 1) & mask_;
+      }
+      auto id = static_cast<int32_t>(strings.size());
+      slots_[k] = id;
+      hashes_.push_back(h);
+      strings.emplace_back(str.data(), str.size());
+      if (2 * strings.size() > slots_.size()) _rehash();
+      return id;
+    }
+
+    uint64_t last_hash() const noexcept {
+      return hashes_.back();
+    }
+
+  private:
+    void _rehash() {
+      size_t nslots = slots_.size() * 2;
+      mask_ = nslots - 1;
+      slots_.assign(nslots, -1);
+      for (size_t i = 0; i < hashes_.size(); ++i) {
+        size_t k = static_cast<size_t>(hashes_[i]) & mask_;
+        while (slots_[k] >= 0) k = (k + 1) & mask_;
+        slots_[k] = static_cast<int32_t>(i);
+      }
+    }
+};
+
+
+/**
+  * Lock-free set of the hashes of the strings found by all threads.
+  * The number of distinct hashes is a lower bound on the number of
+  * distinct strings in the column, so that the encoding can be aborted
+  * as soon as it exceeds `limit`, even when none of the chunks alone
+  * has that many distinct values (which is typical when the number of
+  * threads is large).
+  */
+class DistinctHashCounter {
+  private:
+    std::unique_ptr<std::atomic<uint64_t>[]> slots_;  // 0 = empty slot
+    size_t mask_;
+    size_t limit_;
+    std::atomic<size_t> count_;
+
+  public:
+    DistinctHashCounter(size_t limit, size_t nthreads)
+      : limit_(limit), count_(0)
+    {
+      // Each thread may insert one more hash after the limit was
+      // exceeded, so the table never becomes more than half-full
+      size_t nslots = 16;
+      while (nslots < 2 * (limit + nthreads + 1)) nslots *= 2;
+      slots_.reset(new std::atomic<uint64_t>[nslots]);
+      for (size_t i = 0; i < nslots; ++i) {
+        slots_[i].store(0, std::memory_order_relaxed);
+      }
+      mask_ = nslots - 1;
+    }
+
+    // Returns false if the number of distinct hashes exceeds the limit
+    bool add(uint64_t h) {
+      if (h == 0) h = 1;
+      size_t k = static_cast<size_t>(h) & mask_;
+      while (true) {
+        uint64_t current = slots_[k].load(std::memory_order_relaxed);
+        if (current == h) return true;
+        if (current == 0) {
+          if (slots_[k].compare_exchange_strong(current, h,
+                                                std::memory_order_relaxed)) {
+            return count_.fetch_add(1, std::memory_order_relaxed) < limit_;
+          }
+          if (current == h) return true;
+        }
+        k = (k + 1) & mask_;
+      }
+    }
+};
+
+
+template <typename T>
+static Column make_codes(const int32_t* ids, size_t nrows, size_t nchunks,
+                         const std::vector<std::vector<int32_t>>& id2code)
+{
+  Column codes = Column::new_data_column(nrows, stype_from<T>);
+  T* out = static_cast<T*>(codes.get_data_editable());
+  parallel_for_dynamic(nchunks,
+    [&](size_t t) {
+      size_t i0 = nrows * t / nchunks;
+      size_t i1 = nrows * (t + 1) / nchunks;
+      const int32_t* map = id2code[t].data();
+      for (size_t i = i0; i < i1; ++i) {
+        out[i] = ids[i] < 0? GETNA<T>()
+                           : static_cast<T>(map[ids[i]]);
+      }
+    });
+  return codes;
+}
+
+
+/**
+  * The rows of the column are split into contiguous chunks, and each
+  * chunk is indexed by a separate thread, which assigns "local" ids
+  * to all distinct strings in that chunk. Then the distinct strings
+  * from all chunks are merged and sorted, producing the dictionary,
+  * and finally the local ids are converted into the indices within
+  * the dictionary. The process is aborted as soon as the chunks
+  * together are known to have more than `max_categories` distinct
+  * values (see `DistinctHashCounter`).
+  */
+Column Categorical_ColumnImpl::encode(const Column& col, size_t max_categories)
+{
+  xassert(col.ltype() == LType::STRING);
+  size_t nrows = col.nrows();
+  if (nrows == 0 || nrows > size_t(INT32_MAX)) return Column();
+  max_categories = std::min(max_categories, size_t(INT32_MAX));
+
+  size_t nchunks = std::min(num_threads_in_pool(),
+                            nrows / MIN_ROWS_PER_THREAD + 1);
+  if (!col.allow_parallel_access()) nchunks = 1;
+  std::vector<StringIndex> indices(nchunks);
+  Buffer ids_buf = Buffer::mem(nrows * sizeof(int32_t));
+  int32_t* ids = static_cast<int32_t*>(ids_buf.xptr());
+  std::atomic<bool> aborted { false };
+  std::unique_ptr<DistinctHashCounter> counter;
+  if (nchunks > 1) {
+    counter.reset(new DistinctHashCounter(max_categories, nchunks));
+  }
+
+  parallel_for_dynamic(nchunks,
+    [&](size_t t) {
+      size_t i0 = nrows * t / nchunks;
+      size_t i1 = nrows * (t + 1) / nchunks;
+      StringIndex& index = indices[t];
+      CString value;
+      for (size_t i = i0; i < i1; ++i) {
+        if ((i & 1023) == 0 && aborted.load(std::memory_order_relaxed)) {
+          return;
+        }
+        if (col.get_element(i, &value)) {
+          size_t size0 = index.size();
+          ids[i] = index.find_or_insert(value);
+          if (index.size() > size0 &&
+              (index.size() > max_categories ||
+               (counter && !counter->add(index.last_hash())))) {
+            aborted.store(true, std::memory_order_relaxed);
+            return;
+          }
+        } else {
+          ids[i] = -1;
+        }
+      }
+    });
+  if (aborted.load()) return Column();
+
+  // Build the sorted dictionary. The comparison of std::string's is
+  // lexicographical by unsigned chars, same as for CString's.
+  strvec dict_values;
+  for (const auto& index : indices) {
+    dict_values.insert(dict_values.end(), index.strings.begin(),
+                       index.strings.end());
+  }
+  std::sort(dict_values.begin(), dict_values.end());
+  dict_values.erase(std::unique(dict_values.begin(), dict_values.end()),
+                    dict_values.end());
+  size_t ncategories = dict_values.size();
+  if (ncategories > max_categories) return Column();
+
+  std::vector<std::vector<int32_t>> id2code(nchunks);
+  parallel_for_dynamic(nchunks,
+    [&](size_t t) {
+      const strvec& strings = indices[t].strings;
+      auto& map = id2code[t];
+      map.reserve(strings.size());
+      for (const auto& str : strings) {
+        auto it = std::lower_bound(dict_values.begin(), dict_values.end(), str);
+        map.push_back(static_cast<int32_t>(it - dict_values.begin()));
+      }
+    });
+
+  Column codes =
+      (ncategories <= 127)?   make_codes<int8_t>(ids, nrows, nchunks, id2code) :
+      (ncategories <= 32767)? make_codes<int16_t>(ids, nrows, nchunks, id2code) :
+                              make_codes<int32_t>(ids, nrows, nchunks, id2code);
+  Column dict(new Strvec_ColumnImpl(dict_values));
+  dict.materialize();
+  return Column(new Categorical_ColumnImpl(std::move(codes), std::move(dict),
+                                           col.stype()));
+}
+
+
+
+}  // namespace dt
+
+
+
+Column Column::unwrap_categorical_codes() const {
+  Column codes;
+  return get_categorical(&codes)? codes : *this;
+}
@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_COLUMN_CATEGORICAL_h
+#define dt_COLUMN_CATEGORICAL_h
+#include "column/virtual.h"
+namespace dt {
+
+
+/**
+  * Dictionary-encoded string column.
+  *
+  * The column consists of the integer `codes_` (of type int8, int16
+  * or int32, whichever is the smallest to hold all the codes), and
+  * the string column `dict_` of distinct values. The i-th element of
+  * the column is `dict_[codes_[i]]`, or NA if `codes_[i]` is NA.
+  *
+  * The dictionary is always sorted in ascending order and contains
+  * no NAs. Consequently, the codes compare the same way as the
+  * strings they represent, which allows sorting, grouping and
+  * joining by such columns using only their integer codes. The
+  * dictionary is shared between the column and all its views
+  * created via `apply_rowindex()`, `truncate()`, etc.
+  */
+class Categorical_ColumnImpl : public Virtual_ColumnImpl {
+  private:
+    Column codes_;
+    Column dict_;
+
+  public:
+    Categorical_ColumnImpl(Column&& codes, Column&& dict, SType stype);
+
+    // Encode string column `col`, or return an empty Column if the
+    // column contains more than `max_categories` distinct values.
+    static Column encode(const Column& col, size_t max_categories);
+
+    ColumnImpl* clone() const override;
+    void verify_integrity() const override;
+    size_t memory_footprint() const noexcept override;
+    size_t n_children() const noexcept override;
+    const Column& child(size_t i) const override;
+
+    bool get_element(size_t i, CString* out) const override;
+    bool get_categorical(Column* codes, Column* dict) const override;
+
+    void apply_rowindex(const RowIndex&, Column& out) override;
+    void na_pad(size_t new_nrows, Column& out) override;
+    void truncate(size_t new_nrows, Column& out) override;
+};
+
+
+
+}  // namespace dt
+#endif
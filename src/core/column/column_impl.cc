@@ -19,6 +19,8 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>  // std::min
+#include "column/batch_buffer.h"
 #include "column/cast.h"
 #include "column/column_impl.h"
 #include "column/nafilled.h"
@@ -62,6 +64,46 @@ bool ColumnImpl::get_element(size_t, CString*) const { err(stype_, "string"); }
 bool ColumnImpl::get_element(size_t, py::oobj*)const { err(stype_, "object"); }
 
 
+template <typename T>
+void ColumnImpl::_get_elements(size_t i0, size_t i1, T* out, bool* valid) const {
+  for (size_t i = i0; i < i1; ++i) {
+    valid[i - i0] = this->get_element(i, out + (i - i0));
+  }
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, float* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, double* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, CString* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+void ColumnImpl::get_elements(size_t i0, size_t i1, py::oobj* out, bool* valid) const {
+  _get_elements(i0, i1, out, valid);
+}
+
+
 
 
 //------------------------------------------------------------------------------
@@ -74,22 +116,23 @@ void ColumnImpl::_materialize_fw(Column& out) {
   auto out_column = Sentinel_ColumnImpl::make_column(nrows_, stype_);
   auto out_data = static_cast<T*>(out_column.get_data_editable(0));
   auto nthreads = NThreads(this->allow_parallel_access());
-
+  size_t nbatches = (nrows_ + GET_ELEMENTS_BATCH - 1) / GET_ELEMENTS_BATCH;
+
+  auto fill_batch = [=](size_t j) {
+    size_t i0 = j * GET_ELEMENTS_BATCH;
+    size_t i1 = std::min(i0 + GET_ELEMENTS_BATCH, nrows_);
+    T* out = out_data + i0;
+    BatchBuffer<bool> valid;
+    this->get_elements(i0, i1, out, valid);
+    for (size_t k = 0; k < i1 - i0; ++k) {
+      out[k] = valid[k]? out[k] : GETNA<T>();
+    }
+  };
   if (computationally_expensive()) {
-    parallel_for_dynamic(nrows_, nthreads,
-      [=](size_t i) {
-        T value;
-        bool isvalid = this->get_element(i, &value);
-        out_data[i] = isvalid? value : GETNA<T>();
-      });
+    parallel_for_dynamic(nbatches, nthreads, fill_batch);
   }
   else {
-    parallel_for_static(nrows_, nthreads,
-      [=](size_t i) {
-        T value;
-        bool isvalid = this->get_element(i, &value);
-        out_data[i] = isvalid? value : GETNA<T>();
-      });
+    parallel_for_static(nbatches, ChunkSize(1), nthreads, fill_batch);
   }
   out = std::move(out_column);
 }
@@ -247,6 +290,10 @@ const Column& ColumnImpl::child(size_t) const {
   throw RuntimeError() << "This Column object has no children";
 }
 
+bool ColumnImpl::get_categorical(Column*, Column*) const {
+  return false;
+}
+
 void ColumnImpl::na_pad(size_t new_nrows, Column& out) {
   xassert(new_nrows > nrows());
   out = Column(new NaFilled_ColumnImpl(std::move(out), new_nrows));
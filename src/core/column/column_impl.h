@@ -27,6 +27,7 @@
 #include "groupby.h"     // Groupby
 #include "buffer.h"      // Buffer
 #include "stats.h"       // Stats
+#include "zone_map.h"    // ZoneMap
 namespace dt {
 
 
@@ -56,6 +57,7 @@ class ColumnImpl
     size_t : 24;
     mutable uint32_t refcount_;
     mutable std::unique_ptr<Stats> stats_;
+    mutable std::shared_ptr<const ZoneMap> zone_map_;
 
   //------------------------------------
   // Constructors
@@ -85,6 +87,18 @@ class ColumnImpl
     virtual bool get_element(size_t i, CString* out) const;
     virtual bool get_element(size_t i, py::oobj* out) const;
 
+    // By default these call `get_element()` for each row in the
+    // range. Virtual columns should override them so that the
+    // values are computed in tight loops over blocks of rows.
+    virtual void get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, float* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, double* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, CString* out, bool* valid) const;
+    virtual void get_elements(size_t i0, size_t i1, py::oobj* out, bool* valid) const;
+
 
   //------------------------------------
   // Properties
@@ -100,6 +114,11 @@ class ColumnImpl
     virtual const Column& child(size_t i) const;
     Stats* stats() const;
 
+    // Dictionary-encoded columns return true and store their codes
+    // and dictionary into the output variables (if not null), see
+    // "column/categorical.h". Other columns return false.
+    virtual bool get_categorical(Column* codes, Column* dict) const;
+
 
   //------------------------------------
   // Data buffers
@@ -164,6 +183,7 @@ class ColumnImpl
     virtual void rbind_impl(colvec& columns, size_t nrows, bool isempty,
                             SType& cast_stype);
 
+    template <typename T> void _get_elements(size_t, size_t, T*, bool*) const;
     template <typename T> void _materialize_fw(Column&);
     void _materialize_str(Column&);
     void _materialize_obj(Column&);
@@ -59,8 +59,25 @@ class ConstFloat_ColumnImpl : public Const_ColumnImpl {
       return true;
     }
 
+    void get_elements(size_t i0, size_t i1, float* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
+    void get_elements(size_t i0, size_t i1, double* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
 
   private:
+    template <typename V>
+    void _fill(size_t n, V* out, bool* valid) const {
+      V x = static_cast<V>(value);
+      for (size_t k = 0; k < n; ++k) {
+        out[k] = x;
+        valid[k] = true;
+      }
+    }
+
     static SType normalize_stype(SType stype0, double x) {
       constexpr double MAXF32 = double(std::numeric_limits<float>::max());
       switch (stype0) {
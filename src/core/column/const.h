@@ -60,6 +60,13 @@ class ConstNa_ColumnImpl : public Const_ColumnImpl {
     bool get_element(size_t, CString*)  const override;
     bool get_element(size_t, py::oobj*) const override;
 
+    void get_elements(size_t, size_t, int8_t*, bool*)  const override;
+    void get_elements(size_t, size_t, int16_t*, bool*) const override;
+    void get_elements(size_t, size_t, int32_t*, bool*) const override;
+    void get_elements(size_t, size_t, int64_t*, bool*) const override;
+    void get_elements(size_t, size_t, float*, bool*)   const override;
+    void get_elements(size_t, size_t, double*, bool*)  const override;
+
     ColumnImpl* clone() const override;
     void materialize(Column&, bool) override;
     void na_pad(size_t nrows, Column&) override;
@@ -125,8 +132,41 @@ class ConstInt_ColumnImpl : public Const_ColumnImpl {
       return true;
     }
 
+    void get_elements(size_t i0, size_t i1, int8_t* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
+    void get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
+    void get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
+    void get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
+    void get_elements(size_t i0, size_t i1, float* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
+    void get_elements(size_t i0, size_t i1, double* out, bool* valid) const override {
+      _fill(i1 - i0, out, valid);
+    }
+
 
   private:
+    template <typename V>
+    void _fill(size_t n, V* out, bool* valid) const {
+      V x = static_cast<V>(value);
+      for (size_t k = 0; k < n; ++k) {
+        out[k] = x;
+        valid[k] = true;
+      }
+    }
+
     static SType normalize_stype(SType stype0, int64_t x) {
       switch (stype0) {
         case SType::INT8:
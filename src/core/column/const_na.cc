@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <cstring>          // std::memset
 #include "column/const.h"
 #include "column/sentinel_fw.h"
 #include "column/sentinel_str.h"
@@ -43,6 +44,31 @@ bool ConstNa_ColumnImpl::get_element(size_t, CString*)  const { return false; }
 bool ConstNa_ColumnImpl::get_element(size_t, py::oobj*) const { return false; }
 
 
+void ConstNa_ColumnImpl::get_elements(size_t i0, size_t i1, int8_t*, bool* valid) const {
+  std::memset(valid, 0, i1 - i0);
+}
+
+void ConstNa_ColumnImpl::get_elements(size_t i0, size_t i1, int16_t*, bool* valid) const {
+  std::memset(valid, 0, i1 - i0);
+}
+
+void ConstNa_ColumnImpl::get_elements(size_t i0, size_t i1, int32_t*, bool* valid) const {
+  std::memset(valid, 0, i1 - i0);
+}
+
+void ConstNa_ColumnImpl::get_elements(size_t i0, size_t i1, int64_t*, bool* valid) const {
+  std::memset(valid, 0, i1 - i0);
+}
+
+void ConstNa_ColumnImpl::get_elements(size_t i0, size_t i1, float*, bool* valid) const {
+  std::memset(valid, 0, i1 - i0);
+}
+
+void ConstNa_ColumnImpl::get_elements(size_t i0, size_t i1, double*, bool* valid) const {
+  std::memset(valid, 0, i1 - i0);
+}
+
+
 ColumnImpl* ConstNa_ColumnImpl::clone() const {
   return new ConstNa_ColumnImpl(nrows_, stype_);
 }
@@ -21,7 +21,9 @@
 //------------------------------------------------------------------------------
 #ifndef dt_COLUMN_FUNC_BINARY_h
 #define dt_COLUMN_FUNC_BINARY_h
+#include <algorithm>  // std::min
 #include "column.h"
+#include "column/batch_buffer.h"
 #include "column/virtual.h"
 #include "models/utils.h"
 #include "stype.h"
@@ -60,6 +62,7 @@ class FuncBinary1_ColumnImpl : public Virtual_ColumnImpl {
     const Column& child(size_t i) const override;
 
     bool get_element(size_t i, TO* out) const override;
+    void get_elements(size_t i0, size_t i1, TO* out, bool* valid) const override;
 };
 
 
@@ -91,6 +94,7 @@ class FuncBinary2_ColumnImpl : public Virtual_ColumnImpl {
     const Column& child(size_t i) const override;
 
     bool get_element(size_t i, TO* out) const override;
+    void get_elements(size_t i0, size_t i1, TO* out, bool* valid) const override;
 };
 
 
@@ -133,6 +137,32 @@ bool FuncBinary1_ColumnImpl<T1, T2, TO>::get_element(size_t i, TO* out) const {
 }
 
 
+template <typename T1, typename T2, typename TO>
+void FuncBinary1_ColumnImpl<T1, T2, TO>::get_elements(
+    size_t i0, size_t i1, TO* out, bool* valid) const
+{
+  BatchBuffer<T1> x1;
+  BatchBuffer<T2> x2;
+  BatchBuffer<bool> x2valid;
+  for (size_t j0 = i0; j0 < i1; j0 += GET_ELEMENTS_BATCH) {
+    size_t n = std::min(GET_ELEMENTS_BATCH, i1 - j0);
+    TO* tout = out + (j0 - i0);
+    bool* tvalid = valid + (j0 - i0);
+    arg1_.get_elements(j0, j0 + n, x1, tvalid);
+    arg2_.get_elements(j0, j0 + n, x2, x2valid);
+    for (size_t k = 0; k < n; ++k) {
+      if (!(tvalid[k] && x2valid[k])) {
+        tvalid[k] = false;
+        continue;
+      }
+      TO value = func_(x1[k], x2[k]);
+      tout[k] = value;
+      tvalid[k] = _notnan(value);
+    }
+  }
+}
+
+
 template <typename T1, typename T2, typename TO>
 void FuncBinary1_ColumnImpl<T1, T2, TO>::verify_integrity() const {
   arg1_.verify_integrity();
@@ -193,6 +223,26 @@ bool FuncBinary2_ColumnImpl<T1, T2, TO>::get_element(size_t i, TO* out) const {
 }
 
 
+template <typename T1, typename T2, typename TO>
+void FuncBinary2_ColumnImpl<T1, T2, TO>::get_elements(
+    size_t i0, size_t i1, TO* out, bool* valid) const
+{
+  BatchBuffer<T1> x1;
+  BatchBuffer<T2> x2;
+  BatchBuffer<bool> x2valid;
+  for (size_t j0 = i0; j0 < i1; j0 += GET_ELEMENTS_BATCH) {
+    size_t n = std::min(GET_ELEMENTS_BATCH, i1 - j0);
+    TO* tout = out + (j0 - i0);
+    bool* tvalid = valid + (j0 - i0);
+    arg1_.get_elements(j0, j0 + n, x1, tvalid);
+    arg2_.get_elements(j0, j0 + n, x2, x2valid);
+    for (size_t k = 0; k < n; ++k) {
+      tvalid[k] = func_(x1[k], tvalid[k], x2[k], x2valid[k], tout + k);
+    }
+  }
+}
+
+
 template <typename T1, typename T2, typename TO>
 void FuncBinary2_ColumnImpl<T1, T2, TO>::verify_integrity() const {
   arg1_.verify_integrity();
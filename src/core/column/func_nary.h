@@ -48,6 +48,7 @@ class FuncNary_ColumnImpl : public Virtual_ColumnImpl
     const Column& child(size_t i) const override;
 
     bool get_element(size_t i, T* out) const override;
+    void get_elements(size_t i0, size_t i1, T* out, bool* valid) const override;
 };
 
 
@@ -105,6 +106,16 @@ bool FuncNary_ColumnImpl<T>::get_element(size_t i, T* out) const {
 }
 
 
+template <typename T>
+void FuncNary_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, T* out, bool* valid) const
+{
+  for (size_t i = i0; i < i1; ++i) {
+    valid[i - i0] = evaluator_(i, out + (i - i0), columns_);
+  }
+}
+
+
 
 
 }  // namespace dt
@@ -21,6 +21,8 @@
 //------------------------------------------------------------------------------
 #ifndef dt_COLUMN_FUNC_UNARY_h
 #define dt_COLUMN_FUNC_UNARY_h
+#include <algorithm>  // std::min
+#include "column/batch_buffer.h"
 #include "column/virtual.h"
 #include "models/utils.h"
 #include "column.h"
@@ -57,6 +59,7 @@ class FuncUnary1_ColumnImpl : public Virtual_ColumnImpl {
     const Column& child(size_t i) const override;
 
     bool get_element(size_t i, TO* out) const override;
+    void get_elements(size_t i0, size_t i1, TO* out, bool* valid) const override;
 };
 
 
@@ -85,6 +88,7 @@ class FuncUnary2_ColumnImpl : public Virtual_ColumnImpl {
     const Column& child(size_t i) const override;
 
     bool get_element(size_t i, TO* out) const override;
+    void get_elements(size_t i0, size_t i1, TO* out, bool* valid) const override;
 };
 
 
@@ -124,6 +128,26 @@ bool FuncUnary1_ColumnImpl<TI, TO>::get_element(size_t i, TO* out) const {
 }
 
 
+template <typename TI, typename TO>
+void FuncUnary1_ColumnImpl<TI, TO>::get_elements(
+    size_t i0, size_t i1, TO* out, bool* valid) const
+{
+  BatchBuffer<TI> x;
+  for (size_t j0 = i0; j0 < i1; j0 += GET_ELEMENTS_BATCH) {
+    size_t n = std::min(GET_ELEMENTS_BATCH, i1 - j0);
+    TO* tout = out + (j0 - i0);
+    bool* tvalid = valid + (j0 - i0);
+    arg_.get_elements(j0, j0 + n, x, tvalid);
+    for (size_t k = 0; k < n; ++k) {
+      if (!tvalid[k]) continue;
+      TO value = func_(x[k]);
+      tout[k] = value;
+      tvalid[k] = _notnan(value);
+    }
+  }
+}
+
+
 template <typename TI, typename TO>
 void FuncUnary1_ColumnImpl<TI, TO>::verify_integrity() const {
   arg_.verify_integrity();
@@ -179,6 +203,23 @@ bool FuncUnary2_ColumnImpl<TI, TO>::get_element(size_t i, TO* out) const {
 }
 
 
+template <typename TI, typename TO>
+void FuncUnary2_ColumnImpl<TI, TO>::get_elements(
+    size_t i0, size_t i1, TO* out, bool* valid) const
+{
+  BatchBuffer<TI> x;
+  for (size_t j0 = i0; j0 < i1; j0 += GET_ELEMENTS_BATCH) {
+    size_t n = std::min(GET_ELEMENTS_BATCH, i1 - j0);
+    TO* tout = out + (j0 - i0);
+    bool* tvalid = valid + (j0 - i0);
+    arg_.get_elements(j0, j0 + n, x, tvalid);
+    for (size_t k = 0; k < n; ++k) {
+      tvalid[k] = func_(x[k], tvalid[k], tout + k);
+    }
+  }
+}
+
+
 template <typename TI, typename TO>
 void FuncUnary2_ColumnImpl<TI, TO>::verify_integrity() const {
   arg_.verify_integrity();
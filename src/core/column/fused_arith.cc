@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>     // std::min
+#include <type_traits>   // std::is_floating_point
+#include "column/fused_arith.h"
+#include "models/utils.h"
+#include "utils/assert.h"
+namespace dt {
+
+
+// Type in which the arithmetic is carried out: unsigned for integers,
+// so that the overflows wrap around instead of being UB.
+template <typename T> struct wrap_type { using t = T; };
+template <> struct wrap_type<int32_t> { using t = uint32_t; };
+template <> struct wrap_type<int64_t> { using t = uint64_t; };
+
+
+template <typename T>
+static void _add(T* x, const T* y, size_t n) {
+  using U = typename wrap_type<T>::t;
+  for (size_t k = 0; k < n; ++k) {
+    x[k] = static_cast<T>(static_cast<U>(x[k]) + static_cast<U>(y[k]));
+  }
+}
+
+template <typename T>
+static void _sub(T* x, const T* y, size_t n) {
+  using U = typename wrap_type<T>::t;
+  for (size_t k = 0; k < n; ++k) {
+    x[k] = static_cast<T>(static_cast<U>(x[k]) - static_cast<U>(y[k]));
+  }
+}
+
+template <typename T>
+static void _mul(T* x, const T* y, size_t n) {
+  using U = typename wrap_type<T>::t;
+  for (size_t k = 0; k < n; ++k) {
+    x[k] = static_cast<T>(static_cast<U>(x[k]) * static_cast<U>(y[k]));
+  }
+}
+
+template <typename T>
+static void _div(T* x, const T* y, size_t n, std::true_type) {
+  for (size_t k = 0; k < n; ++k) {
+    x[k] = x[k] / y[k];
+  }
+}
+
+// Integer division is never fused (the program is checked in the
+// constructor), this overload only exists to keep the switch generic.
+template <typename T>
+static void _div(T*, const T*, size_t, std::false_type) {
+  xassert(false);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// FusedArith_ColumnImpl
+//------------------------------------------------------------------------------
+
+template <typename T>
+FusedArith_ColumnImpl<T>::FusedArith_ColumnImpl(
+    std::vector<Column>&& inputs, std::vector<FusedInstr>&& program,
+    size_t nrows, SType stype)
+  : Virtual_ColumnImpl(nrows, stype),
+    inputs_(std::move(inputs)),
+    program_(std::move(program)),
+    stack_depth_(0)
+{
+  xassert(compatible_type<T>(stype));
+  size_t sp = 0;
+  for (const auto& instr : program_) {
+    if (instr.op == FusedOp::LOAD) {
+      xassert(instr.arg < inputs_.size());
+      xassert(inputs_[instr.arg].stype() == stype);
+      sp++;
+      stack_depth_ = std::max(stack_depth_, sp);
+    } else {
+      xassert(sp >= 2);
+      xassert(instr.op != FusedOp::DIV || std::is_floating_point<T>::value);
+      sp--;
+    }
+  }
+  xassert(sp == 1);
+}
+
+
+template <typename T>
+ColumnImpl* FusedArith_ColumnImpl<T>::clone() const {
+  return new FusedArith_ColumnImpl<T>(
+      std::vector<Column>(inputs_), std::vector<FusedInstr>(program_),
+      nrows_, stype_);
+}
+
+
+template <typename T>
+void FusedArith_ColumnImpl<T>::verify_integrity() const {
+  xassert(compatible_type<T>(stype_));
+  XAssert(stack_depth_ >= 1);
+  for (const auto& col : inputs_) {
+    col.verify_integrity();
+    XAssert(col.stype() == stype_);
+    XAssert(nrows_ <= col.nrows());
+  }
+}
+
+
+template <typename T>
+size_t FusedArith_ColumnImpl<T>::n_children() const noexcept {
+  return inputs_.size();
+}
+
+template <typename T>
+const Column& FusedArith_ColumnImpl<T>::child(size_t i) const {
+  xassert(i < inputs_.size());
+  return inputs_[i];
+}
+
+
+
+template <typename T>
+bool FusedArith_ColumnImpl<T>::get_element(size_t i, T* out) const {
+  bool valid;
+  get_elements(i, i + 1, out, &valid);
+  return valid;
+}
+
+
+template <typename T>
+void FusedArith_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, T* out, bool* valid) const
+{
+  // The bottom slot of the stack is the output array itself
+  std::vector<BatchBuffer<T>> stack(stack_depth_ - 1);
+  for (size_t j0 = i0; j0 < i1; j0 += GET_ELEMENTS_BATCH) {
+    size_t n = std::min(GET_ELEMENTS_BATCH, i1 - j0);
+    _evaluate(j0, n, out + (j0 - i0), valid + (j0 - i0), stack);
+  }
+}
+
+
+template <typename T>
+void FusedArith_ColumnImpl<T>::_evaluate(
+    size_t i0, size_t n, T* out, bool* valid,
+    const std::vector<BatchBuffer<T>>& stack) const
+{
+  auto slot = [&](size_t k) -> T* {
+    return k == 0? out : stack[k - 1].data();
+  };
+  BatchBuffer<bool> tvalid;
+  std::fill(valid, valid + n, true);
+
+  size_t sp = 0;
+  for (const auto& instr : program_) {
+    if (instr.op == FusedOp::LOAD) {
+      inputs_[instr.arg].get_elements(i0, i0 + n, slot(sp), tvalid);
+      for (size_t k = 0; k < n; ++k) {
+        valid[k] &= tvalid[k];
+      }
+      sp++;
+      continue;
+    }
+    sp--;
+    T* x = slot(sp - 1);
+    const T* y = slot(sp);
+    switch (instr.op) {
+      case FusedOp::ADD: _add(x, y, n); break;
+      case FusedOp::SUB: _sub(x, y, n); break;
+      case FusedOp::MUL: _mul(x, y, n); break;
+      case FusedOp::DIV: _div(x, y, n, std::is_floating_point<T>{}); break;
+      default: xassert(false);
+    }
+  }
+  xassert(sp == 1);
+  if (std::is_floating_point<T>::value) {
+    for (size_t k = 0; k < n; ++k) {
+      valid[k] = valid[k] && _notnan(out[k]);
+    }
+  }
+}
+
+
+
+
+template class FusedArith_ColumnImpl<int32_t>;
+template class FusedArith_ColumnImpl<int64_t>;
+template class FusedArith_ColumnImpl<float>;
+template class FusedArith_ColumnImpl<double>;
+
+
+}  // namespace dt
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_COLUMN_FUSED_ARITH_h
+#define dt_COLUMN_FUSED_ARITH_h
+#include <vector>
+#include "_dt.h"
+#include "column/batch_buffer.h"
+#include "column/virtual.h"
+namespace dt {
+
+
+/**
+  * Arithmetic operations that can be fused into a single
+  * FusedArith_ColumnImpl. `LOAD` pushes one of the input columns
+  * onto the evaluation stack, all other ops pop two values and
+  * push the result.
+  */
+enum class FusedOp : uint8_t {
+  NONE,
+  LOAD,
+  ADD,
+  SUB,
+  MUL,
+  DIV,
+};
+
+struct FusedInstr {
+  FusedOp  op;
+  uint32_t arg;  // index of the input column, for LOAD only
+};
+
+
+
+/**
+  * Virtual column that evaluates a tree of arithmetic operations
+  * over columns of the same stype `T`, compiled into a stack program
+  * in postfix order. For example, `(A * B + C) / D` becomes
+  *
+  *   LOAD A; LOAD B; MUL; LOAD C; ADD; LOAD D; DIV
+  *
+  * Compared to a tree of nested FuncBinary columns, the program is
+  * evaluated over blocks of rows at a time: each instruction is a
+  * tight loop over the block, there are no per-element virtual
+  * calls, and the NA checks are done once at the end. This relies on
+  * the fact that NaNs propagate through all the arithmetic ops, and
+  * that the result is NA whenever any of the inputs is NA.
+  *
+  * Integer ops are performed with wraparound, same as the nested
+  * columns would. The DIV op is only allowed for floating-point T.
+  */
+template <typename T>
+class FusedArith_ColumnImpl : public Virtual_ColumnImpl {
+  private:
+    std::vector<Column> inputs_;
+    std::vector<FusedInstr> program_;
+    size_t stack_depth_;
+
+  public:
+    FusedArith_ColumnImpl(std::vector<Column>&& inputs,
+                          std::vector<FusedInstr>&& program,
+                          size_t nrows, SType stype);
+
+    ColumnImpl* clone() const override;
+    void verify_integrity() const override;
+    size_t n_children() const noexcept override;
+    const Column& child(size_t i) const override;
+
+    bool get_element(size_t i, T* out) const override;
+    void get_elements(size_t i0, size_t i1, T* out, bool* valid) const override;
+
+  private:
+    void _evaluate(size_t i0, size_t n, T* out, bool* valid,
+                   const std::vector<BatchBuffer<T>>& stack) const;
+};
+
+
+extern template class FusedArith_ColumnImpl<int32_t>;
+extern template class FusedArith_ColumnImpl<int64_t>;
+extern template class FusedArith_ColumnImpl<float>;
+extern template class FusedArith_ColumnImpl<double>;
+
+
+
+}  // namespace dt
+#endif
@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>       // std::upper_bound
 #include "column/rbound.h"
 #include "ltype.h"
 #include "stype.h"
@@ -52,8 +53,11 @@ Rbound_ColumnImpl::Rbound_ColumnImpl(const colvec& columns)
     chunks_(columns)
 {
   xassert(!chunks_.empty());
+  size_t offset = 0;
   for (auto& col : chunks_) {
     col.cast_inplace(stype_);  // noop if stypes are the same
+    offsets_.push_back(offset);
+    offset += col.nrows();
   }
   calculate_nacount();
   switch (stype_to_ltype(stype_)) {
@@ -177,25 +181,30 @@ const Column& Rbound_ColumnImpl::child(size_t i) const {
 // Data access
 //------------------------------------------------------------------------------
 
+// The chunk containing row `i` is found via binary search, since an
+// rbound column may consist of a large number of chunks (for example,
+// when it was opened from a multi-file Jay dataset).
 template <typename T>
-static inline bool _get(const colvec& columns, size_t i, T* out) {
-  for (const auto& col : columns) {
-    if (i < col.nrows()) {
-      return col.get_element(i, out);
-    }
-    i -= col.nrows();
+static inline bool _get(const colvec& columns, const sztvec& offsets,
+                        size_t i, T* out)
+{
+  auto it = std::upper_bound(offsets.begin(), offsets.end(), i);
+  size_t k = static_cast<size_t>(it - offsets.begin()) - 1;
+  size_t j = i - offsets[k];
+  if (j < columns[k].nrows()) {
+    return columns[k].get_element(j, out);
   }
   throw ValueError() << "Index " << i << " is out of range";
 }
 
-bool Rbound_ColumnImpl::get_element(size_t i, int8_t* out)   const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, int16_t* out)  const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, int32_t* out)  const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, int64_t* out)  const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, float* out)    const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, double* out)   const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, CString* out)  const { return _get(chunks_, i, out); }
-bool Rbound_ColumnImpl::get_element(size_t i, py::oobj* out) const { return _get(chunks_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, int8_t* out)   const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, int16_t* out)  const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, int32_t* out)  const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, int64_t* out)  const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, float* out)    const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, double* out)   const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, CString* out)  const { return _get(chunks_, offsets_, i, out); }
+bool Rbound_ColumnImpl::get_element(size_t i, py::oobj* out) const { return _get(chunks_, offsets_, i, out); }
 
 
 
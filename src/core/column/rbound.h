@@ -31,6 +31,7 @@ namespace dt {
 class Rbound_ColumnImpl : public Virtual_ColumnImpl {
   private:
     std::vector<Column> chunks_;
+    sztvec offsets_;  // row index where each chunk starts
 
   public:
     Rbound_ColumnImpl(const colvec& columns);
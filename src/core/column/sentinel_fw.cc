@@ -193,6 +193,60 @@ bool SentinelFw_ColumnImpl<T>::get_element(size_t i, py::oobj* out) const {
 }
 
 
+// Reading a range of elements is a simple loop over the data buffer,
+// which the compiler can vectorize.
+//
+template <typename T>
+template <typename V>
+void SentinelFw_ColumnImpl<T>::_read_elements(
+    size_t i0, size_t i1, V* out, bool* valid) const
+{
+  const T* data = static_cast<const T*>(mbuf_.rptr()) + i0;
+  size_t n = i1 - i0;
+  for (size_t k = 0; k < n; ++k) {
+    T x = data[k];
+    out[k] = static_cast<V>(x);
+    valid[k] = !ISNA<T>(x);
+  }
+}
+
+template <typename T>
+void SentinelFw_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, int8_t* out, bool* valid) const {
+  _read_elements(i0, i1, out, valid);
+}
+
+template <typename T>
+void SentinelFw_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, int16_t* out, bool* valid) const {
+  _read_elements(i0, i1, out, valid);
+}
+
+template <typename T>
+void SentinelFw_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, int32_t* out, bool* valid) const {
+  _read_elements(i0, i1, out, valid);
+}
+
+template <typename T>
+void SentinelFw_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, int64_t* out, bool* valid) const {
+  _read_elements(i0, i1, out, valid);
+}
+
+template <typename T>
+void SentinelFw_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, float* out, bool* valid) const {
+  _read_elements(i0, i1, out, valid);
+}
+
+template <typename T>
+void SentinelFw_ColumnImpl<T>::get_elements(
+    size_t i0, size_t i1, double* out, bool* valid) const {
+  _read_elements(i0, i1, out, valid);
+}
+
+
 bool SentinelObj_ColumnImpl::get_element(size_t i, py::oobj* out) const {
   static_assert(sizeof(py::robj) == sizeof(PyObject*), "Invalid size of py::robj");
   py::robj x = static_cast<const py::robj*>(mbuf_.rptr())[i];
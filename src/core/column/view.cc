@@ -68,6 +68,26 @@ bool SliceView_ColumnImpl::get_element(size_t i, double* out)   const { return a
 bool SliceView_ColumnImpl::get_element(size_t i, CString* out)  const { return arg.get_element(start + i*step, out); }
 bool SliceView_ColumnImpl::get_element(size_t i, py::oobj* out) const { return arg.get_element(start + i*step, out); }
 
+void SliceView_ColumnImpl::get_elements(size_t i0, size_t i1, int8_t* out, bool* valid)  const { _get_slice(i0, i1, out, valid); }
+void SliceView_ColumnImpl::get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const { _get_slice(i0, i1, out, valid); }
+void SliceView_ColumnImpl::get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const { _get_slice(i0, i1, out, valid); }
+void SliceView_ColumnImpl::get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const { _get_slice(i0, i1, out, valid); }
+void SliceView_ColumnImpl::get_elements(size_t i0, size_t i1, float* out, bool* valid)   const { _get_slice(i0, i1, out, valid); }
+void SliceView_ColumnImpl::get_elements(size_t i0, size_t i1, double* out, bool* valid)  const { _get_slice(i0, i1, out, valid); }
+
+// A contiguous slice maps onto a contiguous range of the parent column,
+// so the batch request can be forwarded as a whole.
+template <typename T>
+void SliceView_ColumnImpl::_get_slice(size_t i0, size_t i1, T* out, bool* valid) const {
+  if (step == 1) {
+    arg.get_elements(start + i0, start + i1, out, valid);
+  } else {
+    for (size_t i = i0; i < i1; ++i) {
+      valid[i - i0] = arg.get_element(start + i*step, out + (i - i0));
+    }
+  }
+}
+
 
 
 
@@ -51,6 +51,17 @@ class SliceView_ColumnImpl : public Virtual_ColumnImpl {
     bool get_element(size_t i, double* out)   const override;
     bool get_element(size_t i, CString* out)  const override;
     bool get_element(size_t i, py::oobj* out) const override;
+
+    void get_elements(size_t i0, size_t i1, int8_t* out, bool* valid)  const override;
+    void get_elements(size_t i0, size_t i1, int16_t* out, bool* valid) const override;
+    void get_elements(size_t i0, size_t i1, int32_t* out, bool* valid) const override;
+    void get_elements(size_t i0, size_t i1, int64_t* out, bool* valid) const override;
+    void get_elements(size_t i0, size_t i1, float* out, bool* valid)   const override;
+    void get_elements(size_t i0, size_t i1, double* out, bool* valid)  const override;
+
+  private:
+    template <typename T>
+    void _get_slice(size_t i0, size_t i1, T* out, bool* valid) const;
 };
 
 
@@ -5,6 +5,7 @@
 #include "csv/reader_fread.h"                  // FreadReader
 #include "read/fread/fread_parallel_reader.h"  // FreadParallelReader
 #include "read/parse_context.h"                // ParseContext
+#include "read/row_filter.h"                   // RowFilter
 #include "utils/misc.h"                        // wallclock
 #include "datatable.h"                         // DataTable
 
@@ -76,6 +77,16 @@ std::unique_ptr<DataTable> FreadReader::read_all()
       nUserBumped += (col.get_ptype() != oldtypes[i]);
     }
 
+    // The filter refers to columns by their final names, so it can only
+    // be compiled after the user overrides were applied. Since the
+    // number of rows that pass the filter is unknown, the output is
+    // allocated conservatively and then grown as needed.
+    if (filter_arg) {
+      row_filter = std::make_unique<dt::read::RowFilter>(filter_arg, preframe);
+      allocnrow = std::min<size_t>(allocnrow, 1024);
+      D() << "Rows will be filtered with " << row_filter->repr();
+    }
+
     if (verbose) {
       if (nUserBumped || ndropped) {
         D() << "After " << nUserBumped << " type and " << ndropped
@@ -84,7 +95,7 @@ std::unique_ptr<DataTable> FreadReader::read_all()
       D() << "Allocating " << dt::log::plural(ncols - ndropped, "column slot")
           << " with " << dt::log::plural(allocnrow, "row");
     }
-    preframe.preallocate(allocnrow);
+    preframe.preallocate(std::min(allocnrow, batch_nrows));
 
     if (verbose) {
       fo.t_frame_allocated = wallclock();
@@ -96,6 +107,40 @@ std::unique_ptr<DataTable> FreadReader::read_all()
   job->add_done_amount(WORK_PREPARE);
 
 
+  auto res = read_data();
+  if (verbose) fo.report();
+  return res;
+}
+
+
+
+/**
+  * Read the next batch of data when the input is processed in chunks
+  * (see GenericReader::chunk_nrows). All parse settings, column names
+  * and types are reused from the previous batch, and the reading
+  * resumes at the current `sof`.
+  */
+std::unique_ptr<DataTable> FreadReader::read_next_batch()
+{
+  xassert(chunk_nrows && has_more_data());
+  job = std::make_shared<dt::progress::work>(WORK_READ);
+  preframe.reset_output();
+  preframe.preallocate(std::min(allocnrow, batch_nrows));
+  auto res = read_data();
+  job->done();
+  return res;
+}
+
+
+bool FreadReader::has_more_data() const {
+  return sof < eof;
+}
+
+
+// Steps [6] and [7]: read the data into the (already allocated)
+// preframe, and then convert it into a DataTable.
+std::unique_ptr<DataTable> FreadReader::read_data()
+{
   //****************************************************************************
   // [6] Read the data
   //****************************************************************************
@@ -113,11 +158,21 @@ std::unique_ptr<DataTable> FreadReader::read_all()
     fo.t_data_read = wallclock();
     fo.n_rows_read = preframe.nrows_written();
     fo.n_cols_read = preframe.n_columns_in_output();
+
+    // When reading in chunks, move the start of input past the data
+    // that was just consumed, so that the next batch may resume there.
+    if (chunk_nrows) {
+      size_t nrows_read = preframe.nrows_written();
+      xassert(nrows_read <= max_nrows);
+      max_nrows -= nrows_read;
+      // The number of physical lines consumed may be more than the
+      // number of rows if some of the fields contain newlines.
+      line += scr.get_nlines_of_data();
+      sof = (max_nrows == 0)? eof : scr.get_end_of_data();
+    }
   }
 
 
   auto _ = logger_.section("[7] Finalizing the frame");
-  std::unique_ptr<DataTable> res = std::move(preframe).to_datatable();
-  if (verbose) fo.report();
-  return res;
+  return std::move(preframe).to_datatable();
 }
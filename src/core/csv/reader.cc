@@ -22,6 +22,7 @@
 #include <stdlib.h>             // strtod
 #include <cerrno>               // errno
 #include <cstring>              // std::memcmp
+#include <memory>               // std::make_shared
 #include "csv/reader.h"
 #include "csv/reader_arff.h"
 #include "csv/reader_fread.h"
@@ -32,10 +33,14 @@
 #include "parallel/api.h"
 #include "python/_all.h"
 #include "python/string.h"
+#include "read/gunzip.h"
+#include "read/row_filter.h"
 #include "stype.h"
 #include "utils/exceptions.h"
 #include "utils/misc.h"         // wallclock
 #include "utils/macros.h"
+#include "utils/temporary_file.h"
+#include "writebuf.h"
 namespace dt {
 namespace read {
 
@@ -66,8 +71,23 @@ print unicode, or if the output gets somehow corrupted because of
 the unicode characters.
 )";
 
+static const char * doc_options_fread_categorical_threshold =
+R"(
+A string column read by :func:`fread()` is stored in dictionary-encoded
+form (as integer codes plus a shared dictionary of distinct values) if
+the number of distinct values in the column does not exceed this
+fraction of the number of rows. Such columns behave exactly the same as
+regular string columns, but use less memory, and are sorted, grouped
+and joined using their integer codes.
+
+The default is 0, meaning that dictionary encoding is disabled. Note
+that a frame with dictionary-encoded columns is saved into a Jay file of
+version 2, which cannot be read by older versions of datatable.
+)";
+
 static bool log_anonymize = false;
 static bool log_escape_unicode = false;
+static double categorical_threshold = 0.0;
 
 void GenericReader::init_options() {
   dt::register_option(
@@ -89,6 +109,20 @@ void GenericReader::init_options() {
     [](const py::Arg& value){ log_escape_unicode = value.to_bool_strict(); },
     doc_options_fread_log_escape_unicode
   );
+
+  dt::register_option(
+    "fread.categorical_threshold",
+    []{ return py::ofloat(categorical_threshold); },
+    [](const py::Arg& value) {
+      double x = value.to_double();
+      if (!(x >= 0 && x <= 1)) {
+        throw ValueError() << "Option fread.categorical_threshold should be "
+            "a number between 0 and 1, instead got " << x;
+      }
+      categorical_threshold = x;
+    },
+    doc_options_fread_categorical_threshold
+  );
 }
 
 
@@ -110,6 +144,9 @@ GenericReader::GenericReader()
   multisource_strategy = FreadMultiSourceStrategy::Warn;
   errors_strategy = IreadErrorHandlingStrategy::Error;
   memory_limit = size_t(-1);
+  chunk_nrows = 0;
+  categorical_threshold_ = categorical_threshold;
+  batch_nrows = size_t(-1);
 }
 
 
@@ -139,6 +176,9 @@ GenericReader::GenericReader(const GenericReader& g)
   columns_arg      = g.columns_arg;
   t_open_input     = g.t_open_input;
   memory_limit     = g.memory_limit;
+  chunk_nrows      = g.chunk_nrows;
+  filter_arg       = g.filter_arg;
+  categorical_threshold_ = g.categorical_threshold_;
   encoding_        = g.encoding_;
   // Runtime parameters
   job     = g.job;
@@ -146,6 +186,8 @@ GenericReader::GenericReader(const GenericReader& g)
   sof     = g.sof;
   eof     = g.eof;
   line    = g.line;
+  batch_nrows = g.batch_nrows;
+  tempstr = g.tempstr;
   logger_ = g.logger_;
   source_name = g.source_name;
 }
@@ -411,6 +453,29 @@ void GenericReader::init_logger(
 }
 
 
+void GenericReader::init_chunknrows(const py::Arg& arg) {
+  if (arg.is_none_or_undefined()) {
+    chunk_nrows = 0;
+    return;
+  }
+  chunk_nrows = arg.to_size_t();
+  if (chunk_nrows == 0) {
+    throw ValueError() << "Parameter `chunk_nrows` in iread() should be positive";
+  }
+  D() << "chunk_nrows = " << chunk_nrows;
+}
+
+void GenericReader::init_filter(const py::Arg& arg) {
+  if (arg.is_none_or_undefined()) return;
+  py::robj src = arg.to_robj();
+  if (!(src.is_fexpr() || src.is_dtexpr())) {
+    throw TypeError() << "Parameter `filter` in fread() should be an "
+        "f-expression, instead got " << src.typeobj();
+  }
+  filter_arg = arg.to_oobj();
+  D() << "filter = " << arg.to_robj().repr().to_string();
+}
+
 void GenericReader::init_memorylimit(const py::Arg& arg) {
   constexpr size_t UNLIMITED = size_t(-1);
   memory_limit = arg.to<size_t>(UNLIMITED);
@@ -432,10 +497,11 @@ py::oobj GenericReader::read_buffer(const Buffer& buf, size_t extra_byte)
     auto _ = logger_.section("[1] Prepare for reading");
     job = std::make_shared<dt::progress::work>(WORK_PREPARE + WORK_READ);
     open_buffer(buf, extra_byte);
+    decompress_input();
     process_encoding();
     log_file_sample();
   }
-  bool done = read_jay();
+  bool done = read_jay() || read_parquet();
 
   if (!done) {
     detect_and_skip_bom();
@@ -633,6 +699,39 @@ void GenericReader::open_buffer(const Buffer& buf, size_t extra_byte) {
 }
 
 
+/**
+ * If the input is compressed with GZIP, then decompress it and replace
+ * the input buffer with the decompressed data. The data is streamed into
+ * a temporary file as it is decompressed, and the file is then used as
+ * the input. Multi-member gzip inputs are decompressed in parallel (see
+ * `dt::read::gunzip()`).
+ */
+void GenericReader::decompress_input() {
+  if (!dt::read::is_gzip(sof, datasize())) return;
+  double t0 = wallclock();
+  job->add_work_amount(WORK_DECOMPRESS);
+  job->set_message("Decompressing");
+  dt::progress::subtask subjob(*job, WORK_DECOMPRESS);
+
+  size_t input_size = datasize();
+  auto tempfile = std::make_shared<TemporaryFile>();
+  WritableBuffer* wb = tempfile->data_w();
+  size_t nmembers = dt::read::gunzip(sof, input_size,
+      static_cast<size_t>(std::max(nthreads, 1)),
+      [&](const char* data, size_t n) { wb->write(n, data); });
+  size_t output_size = wb->size();
+  Buffer out = output_size? Buffer::tmp(tempfile, 0, output_size)
+                          : Buffer();
+  if (verbose) {
+    D() << "Input is gzip-compressed: " << dt::log::plural(nmembers, "member")
+        << " of total size " << input_size << " bytes decompressed into "
+        << output_size << " bytes in " << (wallclock() - t0) << "s";
+  }
+  open_buffer(out, 0);
+  subjob.done();
+}
+
+
 void GenericReader::process_encoding() {
   if (encoding_.empty()) return;
   if (verbose) {
@@ -854,7 +953,37 @@ bool GenericReader::read_jay() {
 }
 
 
+bool GenericReader::read_parquet() {
+  size_t size = datasize();
+  if (size >= 12 &&
+      std::memcmp(sof, "PAR1", 4) == 0 &&
+      std::memcmp(sof + size - 4, "PAR1", 4) == 0)
+  {
+    job->add_done_amount(WORK_PREPARE);
+    input_mbuf.resize(size);
+    DataTable* dt = open_parquet_from_mbuf(input_mbuf);
+    job->add_done_amount(WORK_READ);
+    output_ = py::Frame::oframe(dt);
+    return true;
+  }
+  return false;
+}
+
+
 bool GenericReader::read_csv() {
+  if (chunk_nrows) {
+    // In chunked mode the FreadReader must outlive this function: it
+    // keeps the detected parse settings and the position within the
+    // input, and is handed over to the Source_Chunked continuation.
+    batch_nrows = chunk_nrows;
+    auto freader = std::make_unique<FreadReader>(*this);
+    auto dt = freader->read_all();
+    if (!dt) return false;
+    Source_Chunked chunks(*source_name, std::move(freader), std::move(dt));
+    output_ = chunks.read(*this);
+    continuation_ = chunks.continuation();
+    return true;
+  }
   auto dt = FreadReader(*this).read_all();
   if (dt) {
     output_ = py::Frame::oframe(dt.release());
@@ -27,10 +27,13 @@
 #include "python/obj.h"     // py::robj, py::oobj
 #include "python/list.h"    // py::olist
 #include "read/preframe.h"  // dt::read::PreFrame
+#include "read/source.h"    // dt::read::Source
 #include "utils/logger.h"
 namespace dt {
 namespace read {
 
+class RowFilter;
+
 
 // What fread() should do if the input contains multiple sources
 enum class FreadMultiSourceStrategy : int8_t {
@@ -91,6 +94,17 @@ class GenericReader
   // header:
   //   Is the header present? Possible values are 0 (no), 1 (yes), and -128
   //   (auto-detect, default).
+  // chunk_nrows:
+  //   If non-zero, the input will be read in batches, producing a separate
+  //   Frame for every `chunk_nrows` rows of data (iread only). The default
+  //   is 0, meaning the entire input is read into a single Frame.
+  // filter_arg:
+  //   An f-expression selecting which rows of the input should be kept.
+  //   The rows for which the expression is not true are discarded while
+  //   parsing, before they are stored in the output columns.
+  // categorical_threshold_:
+  //   String columns with at most this fraction of distinct values are
+  //   dictionary-encoded (option `fread.categorical_threshold`).
   //
   public:
     int32_t nthreads;
@@ -113,16 +127,30 @@ class GenericReader
     strvec  na_strings_container;
     std::unique_ptr<const char*[]> na_strings_ptr;
     size_t  memory_limit;
+    size_t  chunk_nrows;
+    py::oobj filter_arg;
+    double  categorical_threshold_;
     std::string encoding_;
 
   //---- Runtime parameters ----
   // line:
   //   Line number (within the original input) of the `offset` pointer.
+  // batch_nrows:
+  //   When reading in chunks, the number of rows after which the parallel
+  //   reader should stop, leaving the rest of the input for the next batch.
+  //   Otherwise this is SIZE_MAX.
+  // continuation_:
+  //   When reading in chunks, the Source that will produce the remaining
+  //   Frames of the current input.
+  // row_filter:
+  //   The compiled form of `filter_arg`, created once the columns of the
+  //   input are known.
   //
   public:
     static constexpr size_t WORK_PREPARE = 2;
     static constexpr size_t WORK_READ = 100;
     static constexpr size_t WORK_DECODE_UTF16 = 50;
+    static constexpr size_t WORK_DECOMPRESS = 50;
     std::shared_ptr<dt::progress::work> job;
     Buffer input_mbuf;
     const char* sof;
@@ -132,11 +160,14 @@ class GenericReader
     bool cr_is_newline;
     int : 24;
     PreFrame preframe;
+    size_t batch_nrows;
     double t_open_input{ 0 };
 
     log::Logger logger_;
     py::oobj output_;
     const std::string* source_name;
+    std::unique_ptr<Source> continuation_;
+    std::unique_ptr<RowFilter> row_filter;
 
   private:
     py::oobj src_arg;
@@ -204,6 +235,8 @@ class GenericReader
     void init_dec        (const py::Arg&);
     void init_errors     (const py::Arg&);
     void init_fill       (const py::Arg&);
+    void init_filter     (const py::Arg&);
+    void init_chunknrows (const py::Arg&);
     void init_header     (const py::Arg&);
     void init_logger     (const py::Arg& arg_logger, const py::Arg& arg_verbose);
     void init_maxnrows   (const py::Arg&);
@@ -223,6 +256,7 @@ class GenericReader
   protected:
     void log_file_sample();
     void open_buffer(const Buffer& buf, size_t extra_byte);
+    void decompress_input();
     void process_encoding();
     void detect_and_skip_bom();
     void skip_initial_whitespace();
@@ -235,6 +269,7 @@ class GenericReader
     bool read_csv();
     bool read_empty_input();
     bool read_jay();
+    bool read_parquet();
     bool detect_improper_files();
 };
 
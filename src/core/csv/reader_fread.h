@@ -130,6 +130,8 @@ public:
   virtual ~FreadReader() override;
 
   std::unique_ptr<DataTable> read_all();
+  std::unique_ptr<DataTable> read_next_batch();
+  bool has_more_data() const;
 
   // Simple getters
   double get_mean_line_len() const { return meanLineLen; }
@@ -138,6 +140,7 @@ public:
   dt::read::ParseContext makeTokenizer() const;
 
 private:
+  std::unique_ptr<DataTable> read_data();
   void parse_column_names(dt::read::ParseContext& ctx);
   void detect_sep(dt::read::ParseContext& ctx);
 
@@ -23,6 +23,7 @@
 #define dt_DATATABLE_h
 #include <memory>         // std::unique_ptr
 #include <string>         // std::string
+#include <utility>        // std::pair
 #include <vector>         // std::vector
 #include "column.h"
 #include "groupby.h"
@@ -120,8 +121,16 @@ class DataTable {
 
     void verify_integrity() const;
 
-    Buffer save_jay();
-    void save_jay(const std::string& path, WritableBuffer::Strategy);
+    Buffer save_jay(jay::Codec codec, size_t chunk_nrows);
+    void save_jay(const std::string& path, WritableBuffer::Strategy,
+                  jay::Codec codec, size_t chunk_nrows);
+    void append_jay(const std::string& path, WritableBuffer::Strategy,
+                    jay::Codec codec, size_t chunk_nrows);
+
+    // `codec` is one of the `dt::parquet::Codec` values
+    Buffer save_parquet(int codec, size_t row_group_size);
+    void save_parquet(const std::string& path, WritableBuffer::Strategy,
+                      int codec, size_t row_group_size);
 
   private:
     DataTable(colvec&& cols);
@@ -131,7 +140,7 @@ class DataTable {
     void _integrity_check_names() const;
     void _integrity_check_pynames() const;
 
-    void save_jay_impl(WritableBuffer*);
+    void save_jay_impl(WritableBuffer*, jay::Codec, size_t chunk_nrows);
 };
 
 
@@ -139,8 +148,40 @@ class DataTable {
 DataTable* open_jay_from_file(const std::string& path);
 DataTable* open_jay_from_bytes(const char* ptr, size_t len);
 DataTable* open_jay_from_mbuf(const Buffer&);
+DataTable* open_jay_dataset(const strvec& paths);
+Buffer jay_meta_from_mbuf(const Buffer&);
+DataTable* open_parquet_from_mbuf(const Buffer&);
+
+/**
+  * Kinds of joins supported by `natural_join()`:
+  *
+  *   LEFT  - all rows of X, with matching rows of J (or NAs);
+  *   INNER - only those rows of X that have a match in J;
+  *   SEMI  - same rows as INNER, but the columns of J are not selected;
+  *   ANTI  - only those rows of X that have no match in J;
+  *   RIGHT - rows of the INNER join, followed by rows of J that have no
+  *           match in X;
+  *   OUTER - rows of the LEFT join, followed by rows of J that have no
+  *           match in X.
+  */
+enum class JoinKind : uint8_t {
+  LEFT,
+  INNER,
+  SEMI,
+  ANTI,
+  RIGHT,
+  OUTER,
+};
+
+// Pair of rowindices to apply to X and J respectively
+using JoinResult = std::pair<RowIndex, RowIndex>;
 
 RowIndex natural_join(const DataTable& xdt, const DataTable& jdt);
+JoinResult natural_join(const DataTable& xdt, const DataTable& jdt,
+                        JoinKind kind);
+JoinResult natural_join(const DataTable& xdt, const DataTable& jdt,
+                        const sztvec& jcols, JoinKind kind);
+void join_init_options();
 
 
 #endif
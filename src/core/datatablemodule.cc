@@ -29,8 +29,11 @@
 #include "../datatable/include/datatable.h"
 #include "call_logger.h"
 #include "csv/reader.h"
+#include "datatable.h"
 #include "datatablemodule.h"
 #include "expr/fexpr.h"
+#include "expr/fbinary/fexpr_binaryop.h"
+#include "expr/query_plan.h"
 #include "expr/head_func.h"
 #include "expr/head_reduce.h"
 #include "expr/namespace.h"
@@ -408,6 +411,11 @@ static void initialize_options(const py::PKArgs& args) {
   py::Frame::init_display_options();
   dt::read::GenericReader::init_options();
   sort_init_options();
+  sort_hash_init_options();
+  sort_external_init_options();
+  join_init_options();
+  dt::expr::init_fuse_options();
+  dt::expr::init_query_plan_options();
   dt::CallLogger::init_options();
 }
 
@@ -7,6 +7,9 @@
 //------------------------------------------------------------------------------
 #include <cstring>
 #include <string.h>
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
 #include "read/constants.h"
 #include "encodings.h"
 
@@ -70,6 +73,15 @@ int is_valid_utf8(const uint8_t* src, size_t len)
   const uint8_t* ch = src;
   const uint8_t* end = src + len;
   while (ch < end) {
+    #if defined(__SSE2__)
+      // Skip over blocks of pure ASCII characters 16 bytes at a time
+      while (ch + 16 <= end) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ch));
+        if (_mm_movemask_epi8(x)) break;
+        ch += 16;
+      }
+      if (ch == end) break;
+    #endif
     uint8_t c = *ch;
     if (c < 0x80) {
       ch++;
@@ -26,6 +26,7 @@
 #include "expr/py_sort.h"
 #include "expr/py_update.h"
 #include "expr/workframe.h"
+#include "expr/zone_filter.h"
 #include "frame/py_frame.h"
 #include "ltype.h"
 #include "sort.h"
@@ -51,7 +52,8 @@ EvalContext::EvalContext(DataTable* dt, EvalMode evalmode)
 
 void EvalContext::add_join(py::ojoin oj) {
   DataTable* dt = oj.get_datatable();
-  frames_.emplace_back(dt, RowIndex(), /* natural_join= */ true);
+  frames_.emplace_back(dt, RowIndex(), /* natural_join= */ true,
+                       oj.get_kind(), oj.get_join_columns());
 }
 
 
@@ -83,6 +85,11 @@ void EvalContext::add_i(py::oobj oi) {
 }
 
 
+void EvalContext::add_filter(py::oobj oc) {
+  filters_.push_back(as_fexpr(oc));
+}
+
+
 void EvalContext::add_j(py::oobj oj) {
   py::oupdate arg_update = oj.to_oupdate_lax();
   if (arg_update) {
@@ -146,27 +153,35 @@ const RowIndex& EvalContext::get_group_rowindex() {
 //------------------------------------------------------------------------------
 
 py::oobj EvalContext::evaluate() {
-  // Compute joins
-  DataTable* xdt = get_datatable(0);
-  for (size_t i = 1; i < nframes(); ++i) {
-    DataTable* jdt = get_datatable(i);
-    frames_[i].ri_ = natural_join(*xdt, *jdt);
-  }
-
+  compute_joins();
   compute_groupby_and_sort();
   xassert(groupby_);
 
   // Compute i filter
   if (byexpr_ || sortexpr_) {
+    xassert(filters_.empty());
     auto rigb = iexpr_->evaluate_iby(*this);
     apply_rowindex(std::move(rigb.first));
     replace_groupby(std::move(rigb.second));
   } else {
-    RowIndex rowindex = iexpr_->evaluate_i(*this);
-    apply_rowindex(std::move(rowindex));
+    // The conditions of a conjunction are applied one by one, from
+    // the cheapest to the most expensive.
+    std::vector<const FExpr*> filters;
+    filters.push_back(iexpr_.get());
+    for (const auto& expr : filters_) filters.push_back(expr.get());
+    for (const FExpr* expr : filters) {
+      auto conditions = QueryPlan::order_filters(expr);
+      if (conditions.empty()) conditions.push_back(expr);
+      for (const FExpr* condition : conditions) {
+        RowIndex rowindex = evaluate_i_with_zone_maps(*condition, *this);
+        apply_rowindex(std::move(rowindex));
+      }
+    }
     replace_groupby(Groupby::single_group(nrows()));
   }
 
+  plan_.find_common_subexprs({jexpr_, rexpr_});
+
   switch (eval_mode_) {
     case EvalMode::SELECT: return evaluate_select();
     case EvalMode::DELETE: return evaluate_delete();
@@ -228,6 +243,69 @@ void EvalContext::create_placeholder_columns() {
 
 
 
+//------------------------------------------------------------------------------
+// Joins
+//------------------------------------------------------------------------------
+
+// Returns true if the join columns are exactly the key of the frame,
+// in which case each row of the root frame has at most one match.
+static bool _joined_on_key(const DataTable* jdt, const sztvec& jcols) {
+  if (jdt->nkeys() != jcols.size()) return false;
+  for (size_t i = 0; i < jcols.size(); ++i) {
+    if (jcols[i] != i) return false;
+  }
+  return true;
+}
+
+
+// Joins are computed in the order in which they were given. A LEFT
+// join on the key only sets the rowindex of the joined frame, whereas
+// other kinds of joins also select (or add, or repeat) rows in the
+// root frame. In the latter case all subsequent joins must be
+// performed against the subset of rows that were selected by the
+// previous joins.
+//
+// RIGHT and OUTER joins add rows that do not exist in the root frame
+// (its rowindex contains NAs), so they cannot be used in `del DT[...]`.
+//
+void EvalContext::compute_joins() {
+  DataTable* xdt = get_datatable(0);
+  for (size_t i = 1; i < nframes(); ++i) {
+    DataTable* jdt = get_datatable(i);
+    JoinKind kind = frames_[i].kind_;
+    if (eval_mode_ == EvalMode::DELETE &&
+        (kind == JoinKind::RIGHT || kind == JoinKind::OUTER)) {
+      throw ValueError() << "Cannot delete from a Frame joined with how=\""
+          << (kind == JoinKind::RIGHT? "right" : "outer") << "\"";
+    }
+    const sztvec& jcols = frames_[i].join_cols_;
+    bool on_key = _joined_on_key(jdt, jcols);
+    const RowIndex& ri0 = get_rowindex(0);
+    if (kind == JoinKind::LEFT && on_key && !ri0) {
+      frames_[i].ri_ = natural_join(*xdt, *jdt);
+      continue;
+    }
+    std::unique_ptr<DataTable> xsubset;
+    if (ri0) {
+      colvec columns;
+      columns.reserve(xdt->ncols());
+      for (size_t j = 0; j < xdt->ncols(); ++j) {
+        columns.push_back(xdt->get_column(j));
+        columns.back().apply_rowindex(ri0);
+      }
+      xsubset.reset(new DataTable(std::move(columns), *xdt));
+    }
+    const DataTable& x = xsubset? *xsubset : *xdt;
+    JoinResult res = on_key? natural_join(x, *jdt, kind)
+                           : natural_join(x, *jdt, jcols, kind);
+    apply_rowindex(res.first);
+    frames_[i].ri_ = std::move(res.second);
+  }
+}
+
+
+
+
 //------------------------------------------------------------------------------
 // Groupby
 //------------------------------------------------------------------------------
@@ -242,7 +320,6 @@ bool EvalContext::reverse_sort() {
 }
 
 void EvalContext::compute_groupby_and_sort() {
-  size_t nr = nrows();
   if (byexpr_ || sortexpr_) {
     Workframe wf(*this);
     std::vector<Column> cols;
@@ -268,15 +345,29 @@ void EvalContext::compute_groupby_and_sort() {
       wf.truncate_columns(n_group_cols);
       set_groupby_columns(std::move(wf));
 
-      auto rigb = group(cols, flags);
+      // When only grouping is needed, attempt the hash-based grouping
+      // first, since it avoids sorting all the rows of the frame. When
+      // the `i` selector only needs the first few rows of each group,
+      // sort only those rows.
+      RiGb rigb;
+      bool done = false;
+      if (sortexpr_) {
+        size_t k = iexpr_->selected_rows_limit();
+        done = k && group_topk(cols, flags, n_group_cols, k, &rigb);
+      } else {
+        done = group_hashed(cols, flags, &rigb);
+      }
+      if (!done) {
+        rigb = group(cols, flags);
+      }
       apply_rowindex(std::move(rigb.first));
       groupby_ = std::move(rigb.second);
     }
   }
   if (!groupby_) {
-    groupby_ = Groupby::single_group(nr);
+    groupby_ = Groupby::single_group(nrows());
   }
-  xassert(groupby_.last_offset() == nr);
+  xassert(groupby_.last_offset() == nrows());
 }
 
 
@@ -556,10 +647,30 @@ bool EvalContext::is_naturally_joined(size_t i) const {
   return frames_[i].natural_;
 }
 
+JoinKind EvalContext::get_join_kind(size_t i) const {
+  xassert(i < frames_.size());
+  return frames_[i].kind_;
+}
+
+const sztvec& EvalContext::get_join_columns(size_t i) const {
+  xassert(i < frames_.size());
+  return frames_[i].join_cols_;
+}
+
 bool EvalContext::has_groupby() const {
   return bool(byexpr_);
 }
 
+std::shared_ptr<GroupStats>& EvalContext::get_group_stats(
+    size_t iframe, size_t icol)
+{
+  return group_stats_[std::make_pair(iframe, icol)];
+}
+
+QueryPlan& EvalContext::get_plan() {
+  return plan_;
+}
+
 
 bool EvalContext::has_group_column(size_t frame_index, size_t col_index) const
 {
@@ -21,16 +21,21 @@
 //------------------------------------------------------------------------------
 #ifndef dt_EXPR_EVAL_CONTEXT_h
 #define dt_EXPR_EVAL_CONTEXT_h
+#include <map>               // std::map
+#include <memory>            // std::shared_ptr
+#include <utility>           // std::pair
 #include <vector>            // std::vector
 #include "expr/declarations.h"
 #include "expr/expr.h"
 #include "expr/py_by.h"      // py::oby
+#include "expr/query_plan.h"
 #include "expr/workframe.h"
 #include "datatable.h"       // DataTable
 #include "rowindex.h"        // RowIndex
 namespace dt {
 namespace expr {
 
+class GroupStats;  // see head_reduce_unary.cc
 
 
 /**
@@ -42,15 +47,18 @@ namespace expr {
   * part of the `DT[i,j]`: there is `iexpr_`, `jexpr_`, `byexpr_`,
   * `sortexpr_` and `rexpr_` (replacement). There are no join nodes
   * however: the join frames are stored into the `frames_` vector
-  * directly. This may be expanded in the future when we allow joins
-  * on arbitrary conditions.
+  * directly, together with the kind of each join. This may be
+  * expanded in the future when we allow joins on arbitrary
+  * conditions.
   *
   * The `frames_` vector contains the list of frames that participate
   * in the evaluation. The first element of this vector is the root
   * frame (`DT`), and all subsequent elements are joined frames. Each
   * element in the `frames_` vector also contains a rowindex
   * describing which rows of that frame must be selected. The length
-  * (nrows) of all these rowindices must be equal.
+  * (nrows) of all these rowindices must be equal. Note that joins
+  * other than LEFT may cause the rowindex of the root frame to
+  * contain NAs (for the rows that came from the joined frame only).
   *
   * The `groupby_` object specifies how the rows are split into
   * groups. This object may not be "empty", and as a fallback will
@@ -86,17 +94,37 @@ namespace expr {
   *   If this flag is false (it's true by default), then the groupby
   *   columns would not be added to the resulting frame.
   *
+  * group_stats_
+  *   Per-group statistics of the columns that are arguments to the
+  *   basic reducers (sum, mean, sd, etc), indexed by the frame id and
+  *   the column id. This allows multiple reducers applied to the same
+  *   column to be computed in a single pass over the data.
+  *
+  * plan_
+  *   The common subexpressions of the `j` and replacement expressions
+  *   that are evaluated only once (see "expr/query_plan.h").
+  *
+  * filters_
+  *   Additional row-wise conditions that are applied one after
+  *   another after the `i` filter, as if `DT[i, :][c1, :][c2, :]...`
+  *   were evaluated. These are used by the LazyFrame (see
+  *   "frame/lazy.cc"), and cannot be combined with by() or sort().
+  *
   */
 class EvalContext
 {
   struct subframe {
     DataTable* dt_;
     RowIndex   ri_;
+    sztvec     join_cols_;  // columns on which this frame is joined
     bool       natural_;  // was this frame joined naturally?
-    size_t : 56;
+    JoinKind   kind_;     // kind of the join, for naturally joined frames
+    size_t : 48;
 
-    subframe(DataTable* dt, const RowIndex& ri, bool n)
-      : dt_(dt), ri_(ri), natural_(n) {}
+    subframe(DataTable* dt, const RowIndex& ri, bool n,
+             JoinKind kind = JoinKind::LEFT, sztvec&& cols = sztvec())
+      : dt_(dt), ri_(ri), join_cols_(std::move(cols)), natural_(n),
+        kind_(kind) {}
   };
   using frameVec = std::vector<subframe>;
 
@@ -107,6 +135,7 @@ class EvalContext
     std::shared_ptr<FExpr>  byexpr_;
     std::shared_ptr<FExpr>  sortexpr_;
     std::shared_ptr<FExpr>  rexpr_;
+    vecExpr                 filters_;
 
     // Runtime
     frameVec   frames_;
@@ -115,6 +144,9 @@ class EvalContext
     RowIndex   group_rowindex_;
     Workframe  groupby_columns_;
     strvec     newnames_;
+    std::map<std::pair<size_t, size_t>, std::shared_ptr<GroupStats>>
+               group_stats_;
+    QueryPlan  plan_;
     EvalMode   eval_mode_;
     bool       add_groupby_columns_;
     bool       reverse_;
@@ -131,6 +163,7 @@ class EvalContext
     void add_groupby(py::oby);
     void add_sortby(py::osort);
     void add_i(py::oobj);
+    void add_filter(py::oobj);
     void add_j(py::oobj);
     void add_replace(py::oobj);
 
@@ -142,7 +175,11 @@ class EvalContext
     const RowIndex& get_ungroup_rowindex();
     const RowIndex& get_group_rowindex();
     bool is_naturally_joined(size_t i) const;
+    JoinKind get_join_kind(size_t i) const;
+    const sztvec& get_join_columns(size_t i) const;
     bool has_groupby() const;
+    std::shared_ptr<GroupStats>& get_group_stats(size_t iframe, size_t icol);
+    QueryPlan& get_plan();
     bool has_group_column(size_t frame_index, size_t column_index) const;
     size_t nframes() const;
     size_t nrows() const;
@@ -153,6 +190,7 @@ class EvalContext
 
     bool reverse_sort();
   private:
+    void compute_joins();
     void compute_groupby_and_sort();
 
     py::oobj evaluate_delete();
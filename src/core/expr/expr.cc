@@ -66,12 +66,18 @@ OldExpr::operator bool() const noexcept {
 
 
 Workframe OldExpr::evaluate_n(EvalContext& ctx) const {
-  return head->evaluate_n(inputs, ctx);
+  Workframe shared(ctx);
+  if (ctx.get_plan().get_shared_result(this, shared)) return shared;
+  return ctx.get_plan().save_shared_result(this,
+                                           head->evaluate_n(inputs, ctx));
 }
 
 
 Workframe OldExpr::evaluate_j(EvalContext& ctx) const
 {
+  // Only the function heads are ever shared, and for them
+  // `evaluate_j()` is the same as `evaluate_n()`.
+  if (ctx.get_plan().is_shared(this)) return evaluate_n(ctx);
   return head->evaluate_j(inputs, ctx);
 }
 
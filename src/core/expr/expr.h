@@ -99,6 +99,8 @@ class OldExpr : public FExpr {
 
     Kind get_expr_kind() const override;
     operator bool() const noexcept;  // Check whether the Expr is empty or not
+    const Head* get_head() const noexcept { return head.get(); }
+    const vecExpr& get_inputs() const noexcept { return inputs; }
 
     // FExpr API
     Workframe evaluate_n(EvalContext& ctx) const override;
@@ -35,6 +35,7 @@ class FExpr__add__ : public FExpr_BinaryOp {
 
     std::string name() const override        { return "+"; }
     int precedence() const noexcept override { return 11; }
+    FusedOp fused_op() const override        { return FusedOp::ADD; }
 
 
     Column evaluate1(Column&& lcol, Column&& rcol) const override {
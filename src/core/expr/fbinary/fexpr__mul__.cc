@@ -34,6 +34,7 @@ class FExpr__mul__ : public FExpr_BinaryOp {
 
     std::string name() const override        { return "*"; }
     int precedence() const noexcept override { return 12; }
+    FusedOp fused_op() const override        { return FusedOp::MUL; }
 
 
     Column evaluate1(Column&& lcol, Column&& rcol) const override {
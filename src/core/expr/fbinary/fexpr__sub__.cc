@@ -34,6 +34,7 @@ class FExpr__sub__ : public FExpr_BinaryOp {
 
     std::string name() const override        { return "-"; }
     int precedence() const noexcept override { return 11; }
+    FusedOp fused_op() const override        { return FusedOp::SUB; }
 
 
     Column evaluate1(Column&& lcol, Column&& rcol) const override {
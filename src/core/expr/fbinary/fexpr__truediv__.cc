@@ -34,6 +34,7 @@ class FExpr__truediv__ : public FExpr_BinaryOp {
 
     std::string name() const override        { return "/"; }
     int precedence() const noexcept override { return 12; }
+    FusedOp fused_op() const override        { return FusedOp::DIV; }
 
 
     Column evaluate1(Column&& lcol, Column&& rcol) const override {
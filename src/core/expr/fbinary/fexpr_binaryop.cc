@@ -34,8 +34,20 @@ FExpr_BinaryOp::FExpr_BinaryOp(ptrExpr&& x, ptrExpr&& y)
 
 
 Workframe FExpr_BinaryOp::evaluate_n(EvalContext& ctx) const {
-  Workframe lhswf = lhs_->evaluate_n(ctx);
-  Workframe rhswf = rhs_->evaluate_n(ctx);
+  Workframe shared(ctx);
+  if (ctx.get_plan().get_shared_result(this, shared)) return shared;
+
+  Workframe res = can_fuse()? evaluate_fused(ctx)
+                            : evaluate_pair(lhs_->evaluate_n(ctx),
+                                            rhs_->evaluate_n(ctx));
+  return ctx.get_plan().save_shared_result(this, std::move(res));
+}
+
+
+Workframe FExpr_BinaryOp::evaluate_pair(
+    Workframe&& lhswf, Workframe&& rhswf) const
+{
+  EvalContext& ctx = lhswf.get_context();
   if (lhswf.ncols() == 1) lhswf.repeat_column(rhswf.ncols());
   if (rhswf.ncols() == 1) rhswf.repeat_column(lhswf.ncols());
   if (lhswf.ncols() != rhswf.ncols()) {
@@ -55,6 +67,20 @@ Workframe FExpr_BinaryOp::evaluate_n(EvalContext& ctx) const {
 }
 
 
+FusedOp FExpr_BinaryOp::fused_op() const {
+  return FusedOp::NONE;
+}
+
+
+const ptrExpr& FExpr_BinaryOp::get_lhs() const {
+  return lhs_;
+}
+
+const ptrExpr& FExpr_BinaryOp::get_rhs() const {
+  return rhs_;
+}
+
+
 std::string FExpr_BinaryOp::repr() const {
   auto lstr = lhs_->repr();
   auto rstr = rhs_->repr();
@@ -21,6 +21,7 @@
 //------------------------------------------------------------------------------
 #ifndef dt_EXPR_FEXPR_BINARYOP_h
 #define dt_EXPR_FEXPR_BINARYOP_h
+#include "column/fused_arith.h"
 #include "expr/fexpr_func.h"
 namespace dt {
 namespace expr {
@@ -51,9 +52,27 @@ class FExpr_BinaryOp : public FExpr_Func {
 
     virtual Column evaluate1(Column&& lcol, Column&& rcol) const = 0;
     virtual std::string name() const = 0;
+
+    // Arithmetic operators that can be fused with their arguments
+    // into a single FusedArith column return the corresponding op
+    // here. See "expr/fbinary/fuse.cc".
+    virtual FusedOp fused_op() const;
+
+    const ptrExpr& get_lhs() const;
+    const ptrExpr& get_rhs() const;
+
+  private:
+    Workframe evaluate_pair(Workframe&& lhswf, Workframe&& rhswf) const;
+    Workframe evaluate_fused(EvalContext&) const;
+    bool can_fuse() const;
+
+    friend class FusedTree;
 };
 
 
+void init_fuse_options();
+
+
 
 
 }}  // namespace dt::expr
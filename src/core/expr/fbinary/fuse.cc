@@ -0,0 +1,265 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+//
+// Fusion of arithmetic expressions.
+//
+// An expression such as `(f.A * 2 + f.B) / f.C` is normally evaluated
+// into a tree of nested FuncBinary columns, where each node retrieves
+// its arguments from the child columns one element at a time. Here,
+// instead, the tree of fusable operators (+, -, *, /) is first
+// collected into a `FusedTree`, whose leaves (any other expressions)
+// are evaluated in the usual way. Then the stypes of all nodes are
+// inferred using the same rules as the individual operators use, and
+// each maximal subtree of nodes that have the same stype is compiled
+// into a single FusedArith column.
+//
+// If any of the leaves turns out to be non-numeric, or produces more
+// than one column, then the tree is "replayed" using the regular
+// binary operators over the already evaluated leaves.
+//
+//------------------------------------------------------------------------------
+#include <vector>
+#include "column/fused_arith.h"
+#include "expr/eval_context.h"
+#include "expr/fbinary/fexpr_binaryop.h"
+#include "expr/workframe.h"
+#include "python/bool.h"
+#include "options.h"
+#include "stype.h"
+namespace dt {
+namespace expr {
+
+
+static const char* doc_fexpr_fuse =
+R"(
+Internal
+)";
+
+static bool fuse_enabled = true;
+
+void init_fuse_options() {
+  dt::register_option(
+    "fexpr.fuse",
+    []{ return py::obool(fuse_enabled); },
+    [](const py::Arg& value){ fuse_enabled = value.to_bool_strict(); },
+    doc_fexpr_fuse
+  );
+}
+
+
+static bool is_fusable(const FExpr* expr) {
+  auto binop = dynamic_cast<const FExpr_BinaryOp*>(expr);
+  return binop && binop->fused_op() != FusedOp::NONE;
+}
+
+
+// Fusing pays off only when at least one of the arguments is itself
+// a fusable operator; single operators produce regular FuncBinary
+// columns.
+bool FExpr_BinaryOp::can_fuse() const {
+  return fuse_enabled &&
+         fused_op() != FusedOp::NONE &&
+         (is_fusable(lhs_.get()) || is_fusable(rhs_.get()));
+}
+
+
+static bool is_numeric(SType stype) {
+  switch (stype) {
+    case SType::BOOL:
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:
+    case SType::FLOAT32:
+    case SType::FLOAT64: return true;
+    default:             return false;
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// FusedTree
+//------------------------------------------------------------------------------
+
+class FusedTree {
+  private:
+    struct Node {
+      const FExpr_BinaryOp* expr;  // nullptr for leaf nodes
+      FusedOp op;
+      SType stype;
+      size_t lhs;    // for leaf nodes: the index of the leaf
+      size_t rhs;
+    };
+
+    EvalContext& ctx_;
+    std::vector<Node> nodes_;
+    std::vector<Workframe> leaves_;
+    std::vector<Column> columns_;
+    size_t nrows_;
+
+  public:
+    explicit FusedTree(EvalContext& ctx)
+      : ctx_(ctx), nrows_(0) {}
+
+    Workframe evaluate(const FExpr_BinaryOp* root) {
+      size_t iroot = add_op(root);
+      for (const Workframe& wf : leaves_) {
+        if (wf.ncols() != 1 || !is_numeric(wf.get_column(0).stype())) {
+          return replay(iroot);
+        }
+      }
+      Workframe args(ctx_);
+      for (Workframe& wf : leaves_) {
+        args.cbind(std::move(wf));
+      }
+      Grouping gmode = args.get_grouping_mode();
+      for (size_t i = 0; i < args.ncols(); ++i) {
+        columns_.push_back(args.retrieve_column(i));
+      }
+      nrows_ = columns_[0].nrows();
+      infer_stypes();
+
+      Workframe outputs(ctx_);
+      outputs.add_column(build(iroot, nodes_[iroot].stype), std::string(),
+                         gmode);
+      return outputs;
+    }
+
+  private:
+    // Children are always added before their parents, so the root
+    // node ends up the last.
+    size_t add_op(const FExpr_BinaryOp* binop) {
+      size_t lhs = add_expr(binop->lhs_);
+      size_t rhs = add_expr(binop->rhs_);
+      nodes_.push_back(Node{binop, binop->fused_op(), SType::VOID, lhs, rhs});
+      return nodes_.size() - 1;
+    }
+
+    // Common subexpressions are evaluated (or reused) as leaves.
+    size_t add_expr(const ptrExpr& expr) {
+      if (is_fusable(expr.get()) && !ctx_.get_plan().is_shared(expr.get())) {
+        return add_op(static_cast<const FExpr_BinaryOp*>(expr.get()));
+      }
+      nodes_.push_back(Node{nullptr, FusedOp::LOAD, SType::VOID,
+                            leaves_.size(), 0});
+      leaves_.push_back(expr->evaluate_n(ctx_));
+      return nodes_.size() - 1;
+    }
+
+    Workframe replay(size_t i) {
+      const Node& node = nodes_[i];
+      if (!node.expr) {
+        return std::move(leaves_[node.lhs]);
+      }
+      Workframe lhswf = replay(node.lhs);
+      Workframe rhswf = replay(node.rhs);
+      return node.expr->evaluate_pair(std::move(lhswf), std::move(rhswf));
+    }
+
+    // These rules must be the same as in `evaluate1()` of the
+    // corresponding operators.
+    void infer_stypes() {
+      for (Node& node : nodes_) {
+        if (!node.expr) {
+          node.stype = columns_[node.lhs].stype();
+          continue;
+        }
+        SType stype = common_stype(nodes_[node.lhs].stype,
+                                   nodes_[node.rhs].stype);
+        if (node.op == FusedOp::DIV) {
+          if (stype != SType::FLOAT32) stype = SType::FLOAT64;
+        }
+        else if (stype == SType::BOOL || stype == SType::INT8 ||
+                 stype == SType::INT16) {
+          stype = SType::INT32;
+        }
+        node.stype = stype;
+      }
+    }
+
+    // Create a column that evaluates node `i` and has the given stype.
+    Column build(size_t i, SType stype) {
+      const Node& node = nodes_[i];
+      Column col;
+      if (!node.expr) {
+        col = columns_[node.lhs];
+      }
+      else if (node.stype != stype) {
+        col = build(i, node.stype);
+      }
+      else {
+        std::vector<Column> inputs;
+        std::vector<FusedInstr> program;
+        emit(i, stype, inputs, program);
+        switch (stype) {
+          case SType::INT32:   return make<int32_t>(std::move(inputs), std::move(program), stype);
+          case SType::INT64:   return make<int64_t>(std::move(inputs), std::move(program), stype);
+          case SType::FLOAT32: return make<float>(std::move(inputs), std::move(program), stype);
+          case SType::FLOAT64: return make<double>(std::move(inputs), std::move(program), stype);
+          default: throw RuntimeError() << "Unexpected stype " << stype
+                                        << " in a fused expression";
+        }
+      }
+      col.cast_inplace(stype);
+      return col;
+    }
+
+    // Append the program for node `i` in postfix order. Nodes of a
+    // different stype become the inputs of the fused column.
+    void emit(size_t i, SType stype, std::vector<Column>& inputs,
+              std::vector<FusedInstr>& program)
+    {
+      const Node& node = nodes_[i];
+      if (node.expr && node.stype == stype) {
+        emit(node.lhs, stype, inputs, program);
+        emit(node.rhs, stype, inputs, program);
+        program.push_back(FusedInstr{node.op, 0});
+      }
+      else {
+        auto iinput = static_cast<uint32_t>(inputs.size());
+        inputs.push_back(build(i, stype));
+        program.push_back(FusedInstr{FusedOp::LOAD, iinput});
+      }
+    }
+
+    template <typename T>
+    Column make(std::vector<Column>&& inputs,
+                std::vector<FusedInstr>&& program, SType stype)
+    {
+      return Column(new FusedArith_ColumnImpl<T>(
+          std::move(inputs), std::move(program), nrows_, stype));
+    }
+};
+
+
+
+Workframe FExpr_BinaryOp::evaluate_fused(EvalContext& ctx) const {
+  FusedTree tree(ctx);
+  return tree.evaluate(this);
+}
+
+
+
+
+}}  // namespace dt::expr
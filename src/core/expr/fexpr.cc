@@ -50,11 +50,21 @@ int64_t FExpr::evaluate_int() const {
 }                        // LCOV_EXCL_LINE
 
 
+double FExpr::evaluate_float() const {
+  throw RuntimeError();  // LCOV_EXCL_LINE
+}                        // LCOV_EXCL_LINE
+
+
 py::oobj FExpr::evaluate_pystr() const {
   throw RuntimeError();  // LCOV_EXCL_LINE
 }                        // LCOV_EXCL_LINE
 
 
+size_t FExpr::selected_rows_limit() const {
+  return 0;
+}
+
+
 void FExpr::prepare_by(EvalContext&, Workframe&, std::vector<SortFlag>&) const {
   throw RuntimeError();  // LCOV_EXCL_LINE
 }                        // LCOV_EXCL_LINE
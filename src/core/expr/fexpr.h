@@ -123,8 +123,26 @@ class FExpr {
       */
     virtual int64_t evaluate_int() const;
 
+    /**
+      * If an expression's get_expr_kind() is Kind::Float, then this
+      * method should return this expression converted to a regular
+      * double value.
+      */
+    virtual double evaluate_float() const;
+
 
     virtual py::oobj evaluate_pystr() const;
+
+    /**
+      * When this expression is used as an `i` selector in a query with
+      * a `sort()` clause, and it only selects rows among the first `n`
+      * rows of each group, then this method should return `n`. This
+      * allows the query to sort only the first `n` rows of each group
+      * (see `group_topk()`). The default implementation returns 0,
+      * meaning that the rows may be selected from anywhere within the
+      * group.
+      */
+    virtual size_t selected_rows_limit() const;
 };
 
 
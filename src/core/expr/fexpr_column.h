@@ -43,6 +43,7 @@ class FExpr_ColumnAsAttr : public FExpr_Func {
     std::string repr() const override;
 
     py::oobj get_pyname() const;
+    size_t get_namespace() const;
 };
 
 
@@ -63,6 +64,7 @@ class FExpr_ColumnAsArg : public FExpr_Func {
     std::string repr() const override;
 
     ptrExpr get_arg() const;
+    size_t get_namespace() const;
 };
 
 
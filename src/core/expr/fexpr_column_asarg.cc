@@ -58,6 +58,10 @@ ptrExpr FExpr_ColumnAsArg::get_arg() const {
   return arg_;
 }
 
+size_t FExpr_ColumnAsArg::get_namespace() const {
+  return namespace_;
+}
+
 
 
 
@@ -63,6 +63,10 @@ py::oobj FExpr_ColumnAsAttr::get_pyname() const {
   return pyname_;
 }
 
+size_t FExpr_ColumnAsAttr::get_namespace() const {
+  return namespace_;
+}
+
 
 
 
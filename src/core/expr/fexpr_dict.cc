@@ -40,6 +40,11 @@ FExpr_Dict::FExpr_Dict(strvec&& names, vecExpr&& args)
 }
 
 
+const vecExpr& FExpr_Dict::get_args() const {
+  return args_;
+}
+
+
 ptrExpr FExpr_Dict::make(py::robj src) {
   strvec names;
   vecExpr args;
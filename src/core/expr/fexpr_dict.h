@@ -37,6 +37,7 @@ class FExpr_Dict : public FExpr {
   public:
     FExpr_Dict(strvec&&, vecExpr&&);
     static ptrExpr make(py::robj);
+    const vecExpr& get_args() const;
 
     Workframe evaluate_n(EvalContext&) const override;
     Workframe evaluate_j(EvalContext&) const override;
@@ -40,12 +40,20 @@ std::string FExpr_FuncUnary::repr() const {
 
 
 Workframe FExpr_FuncUnary::evaluate_n(EvalContext& ctx) const {
+  Workframe shared(ctx);
+  if (ctx.get_plan().get_shared_result(this, shared)) return shared;
+
   Workframe wf = arg_->evaluate_n(ctx);
   for (size_t i = 0; i < wf.ncols(); ++i) {
     Column col = wf.retrieve_column(i);
     wf.replace_column(i, evaluate1(std::move(col)));
   }
-  return wf;
+  return ctx.get_plan().save_shared_result(this, std::move(wf));
+}
+
+
+const ptrExpr& FExpr_FuncUnary::get_arg() const {
+  return arg_;
 }
 
 
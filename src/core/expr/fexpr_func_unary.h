@@ -42,6 +42,8 @@ class FExpr_FuncUnary : public FExpr_Func {
     // API for the derived classes
     virtual Column evaluate1(Column&& col) const = 0;
     virtual std::string name() const = 0;
+
+    const ptrExpr& get_arg() const;
 };
 
 
@@ -37,6 +37,11 @@ FExpr_List::FExpr_List(vecExpr&& args)
 {}
 
 
+const vecExpr& FExpr_List::get_args() const {
+  return args_;
+}
+
+
 ptrExpr FExpr_List::make(py::robj src) {
   vecExpr args;
   if (src.is_list_or_tuple()) {
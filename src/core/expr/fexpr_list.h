@@ -35,6 +35,7 @@ class FExpr_List : public FExpr {
   public:
     FExpr_List(vecExpr&& args);
     static ptrExpr make(py::robj);
+    const vecExpr& get_args() const;
 
     Workframe evaluate_n(EvalContext&) const override;
     Workframe evaluate_j(EvalContext&) const override;
@@ -89,6 +89,7 @@ class FExpr_Literal_Int : public FExpr {
     std::string repr() const override;
     Kind get_expr_kind() const override;
     int64_t evaluate_int() const override;
+    size_t selected_rows_limit() const override;
 };
 
 
@@ -111,6 +112,7 @@ class FExpr_Literal_Float : public FExpr {
     int precedence() const noexcept override;
     std::string repr() const override;
     Kind get_expr_kind() const override;
+    double evaluate_float() const override;
 };
 
 
@@ -175,6 +177,7 @@ class FExpr_Literal_SliceInt : public FExpr_Literal_Slice {
 
     Kind get_expr_kind() const override;
     std::string repr() const override;
+    size_t selected_rows_limit() const override;
 };
 
 
@@ -115,6 +115,11 @@ Kind FExpr_Literal_Float::get_expr_kind() const {
 }
 
 
+double FExpr_Literal_Float::evaluate_float() const {
+  return value_;
+}
+
+
 int FExpr_Literal_Float::precedence() const noexcept {
   return 18;
 }
@@ -205,6 +205,11 @@ int64_t FExpr_Literal_Int::evaluate_int() const {
   return value_;
 }
 
+// `DT[n, :, by(), sort()]` selects the row `n` within each group
+size_t FExpr_Literal_Int::selected_rows_limit() const {
+  return value_ >= 0? static_cast<size_t>(value_) + 1 : 0;
+}
+
 
 int FExpr_Literal_Int::precedence() const noexcept {
   return 18;
@@ -19,10 +19,14 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>  // std::find
 #include "column/const.h"
+#include "column/ifelse.h"
+#include "column/isna.h"
 #include "expr/fexpr_literal.h"
 #include "expr/eval_context.h"
 #include "expr/workframe.h"
+#include "stype.h"
 namespace dt {
 namespace expr {
 
@@ -46,19 +50,95 @@ Workframe FExpr_Literal_SliceAll::evaluate_f(
 }
 
 
+static Column _make_isna(Column&& col) {
+  switch (col.stype()) {
+    case SType::BOOL:
+    case SType::INT8:    return Column(new Isna_ColumnImpl<int8_t>(std::move(col)));
+    case SType::INT16:   return Column(new Isna_ColumnImpl<int16_t>(std::move(col)));
+    case SType::INT32:   return Column(new Isna_ColumnImpl<int32_t>(std::move(col)));
+    case SType::INT64:   return Column(new Isna_ColumnImpl<int64_t>(std::move(col)));
+    case SType::FLOAT32: return Column(new Isna_ColumnImpl<float>(std::move(col)));
+    case SType::FLOAT64: return Column(new Isna_ColumnImpl<double>(std::move(col)));
+    case SType::STR32:
+    case SType::STR64:   return Column(new Isna_ColumnImpl<CString>(std::move(col)));
+    default:
+      throw RuntimeError() << "Unexpected stype " << col.stype();  // LCOV_EXCL_LINE
+  }
+}
+
+
+// In a RIGHT or OUTER join, the rows that come from the joined frame
+// only have no corresponding row in the root frame, and thus the key
+// columns of the root frame are NA for such rows. When selecting all
+// columns, we replace these key columns with the "coalesced" values:
+// the key from the root frame if it is valid, or the key from the
+// joined frame otherwise.
+//
+static Column _coalesced_key_column(
+    EvalContext& ctx, size_t icol, size_t jframe, size_t jcol)
+{
+  Workframe refs(ctx);
+  refs.add_ref_column(0, icol);
+  refs.add_ref_column(jframe, jcol);
+  Column xcol = refs.retrieve_column(0);
+  Column jkey = refs.retrieve_column(1);
+  SType stype = common_stype(xcol.stype(), jkey.stype());
+  xcol.cast_inplace(stype);
+  jkey.cast_inplace(stype);
+  Column cond = _make_isna(Column(xcol));
+  return Column(new IfElse_ColumnImpl(
+                    std::move(cond), std::move(jkey), std::move(xcol)));
+}
+
+
 // When `:` is used in j expression, it means "all columns in all frames,
-// including the joined frames". There are 2 exceptions though:
+// including the joined frames". There are several exceptions though:
 //   - any groupby columns are not added (since they should be added at the
 //     front by the groupby operation itself);
-//   - key columns in naturally joined frames are skipped, to avoid duplication.
+//   - join columns in naturally joined frames are skipped, to avoid
+//     duplication;
+//   - frames joined via SEMI or ANTI joins are skipped entirely;
+//   - key columns of the root frame are coalesced with the keys of the
+//     frames joined via RIGHT or OUTER joins (when selecting).
 //
 Workframe FExpr_Literal_SliceAll::evaluate_j(EvalContext& ctx) const {
   Workframe outputs(ctx);
+  const DataTable* dt0 = ctx.get_datatable(0);
+  // For each column in the root frame, the pair (frame, column) of the
+  // key in a RIGHT/OUTER-joined frame that this column is coalesced with.
+  std::vector<std::pair<size_t, size_t>> coalesce(dt0->ncols(), {0, 0});
+  if (ctx.get_mode() == EvalMode::SELECT) {
+    for (size_t i = 1; i < ctx.nframes(); ++i) {
+      JoinKind kind = ctx.get_join_kind(i);
+      if (kind != JoinKind::RIGHT && kind != JoinKind::OUTER) continue;
+      const DataTable* dti = ctx.get_datatable(i);
+      py::otuple names = dti->get_pynames();
+      for (size_t k : ctx.get_join_columns(i)) {
+        size_t j = dt0->xcolindex(names[k]);
+        coalesce[j] = {i, k};
+      }
+    }
+  }
+
   for (size_t i = 0; i < ctx.nframes(); ++i) {
     const DataTable* dti = ctx.get_datatable(i);
-    size_t j0 = ctx.is_naturally_joined(i)? dti->nkeys() : 0;
-    for (size_t j = j0; j < dti->ncols(); ++j) {
+    if (i > 0 && ctx.is_naturally_joined(i)) {
+      JoinKind kind = ctx.get_join_kind(i);
+      if (kind == JoinKind::SEMI || kind == JoinKind::ANTI) continue;
+    }
+    const sztvec& join_cols = ctx.get_join_columns(i);
+    for (size_t j = 0; j < dti->ncols(); ++j) {
       if (ctx.has_group_column(i, j)) continue;
+      if (std::find(join_cols.begin(), join_cols.end(), j) != join_cols.end()) {
+        continue;
+      }
+      if (i == 0 && coalesce[j].first) {
+        outputs.add_column(
+            _coalesced_key_column(ctx, j, coalesce[j].first, coalesce[j].second),
+            std::string(dti->get_names()[j]),
+            Grouping::GtoALL);
+        continue;
+      }
       outputs.add_ref_column(i, j);
     }
   }
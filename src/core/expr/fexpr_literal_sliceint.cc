@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>     // std::min, std::max
 #include "column/const.h"
 #include "expr/eval_context.h"
 #include "expr/fexpr_literal.h"
@@ -84,6 +85,18 @@ RiGb FExpr_Literal_SliceInt::evaluate_iby(EvalContext& ctx) const {
   int64_t istop = value_.stop();
   int64_t istep = value_.step();
   if (istep == py::oslice::NA) istep = 1;
+  if (istep != 0) {
+    // The values that are outside of the range of rows are clamped,
+    // without changing the meaning of the slice, so that they can be
+    // safely converted into int32 below.
+    int64_t n = static_cast<int64_t>(ctx.nrows());
+    auto clamp = [](int64_t x, int64_t lo, int64_t hi) {
+      return x == py::oslice::NA? x : std::min(std::max(x, lo), hi);
+    };
+    istart = clamp(istart, -n - 1, n);
+    istop = clamp(istop, -n - 1, n);
+    istep = clamp(istep, -std::max<int64_t>(n, 1), std::max<int64_t>(n, 1));
+  }
 
   const Groupby& gb = ctx.get_groupby();
   size_t ngroups = gb.size();
@@ -189,6 +202,18 @@ Kind FExpr_Literal_SliceInt::get_expr_kind() const {
   return Kind::SliceInt;
 }
 
+// A slice `[start:stop:step]` with non-negative start/stop and positive
+// step selects rows among the first `stop` rows of each group.
+size_t FExpr_Literal_SliceInt::selected_rows_limit() const {
+  int64_t istart = value_.start();
+  int64_t istop = value_.stop();
+  int64_t istep = value_.step();
+  if (istart != py::oslice::NA && istart < 0) return 0;
+  if (istop == py::oslice::NA || istop < 0) return 0;
+  if (istep != py::oslice::NA && istep <= 0) return 0;
+  return static_cast<size_t>(istop);
+}
+
 
 std::string FExpr_Literal_SliceInt::repr() const {
   int64_t istart = value_.start();
@@ -99,6 +99,8 @@ class Head_Func_Binary : public Head_Func {
   public:
     explicit Head_Func_Binary(Op);
     Workframe evaluate_n(const vecExpr&, EvalContext&) const override;
+
+    Op get_op() const { return op; }
 };
 
 
@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <memory>
 #include <unordered_map>
 #include "column/latent.h"
 #include "column/virtual.h"
@@ -26,6 +27,7 @@
 #include "expr/expr.h"
 #include "expr/head_reduce.h"
 #include "expr/workframe.h"
+#include "parallel/api.h"
 #include "utils/assert.h"
 #include "utils/exceptions.h"
 #include "stype.h"
@@ -958,6 +960,311 @@ static Column compute_gmedian(Column&& arg, const Groupby&) {
 
 
 
+//------------------------------------------------------------------------------
+// Fused reducers
+//------------------------------------------------------------------------------
+
+// Statistics that can be computed by `GroupStats`, as a bitmask
+static constexpr int STAT_COUNT = 1;
+static constexpr int STAT_SUM = 2;
+static constexpr int STAT_MEAN = 4;
+static constexpr int STAT_SD = 8;
+static constexpr int STAT_MIN = 16;
+static constexpr int STAT_MAX = 32;
+
+static int _stat_for_op(Op op) {
+  switch (op) {
+    case Op::COUNT: return STAT_COUNT;
+    case Op::SUM:   return STAT_SUM;
+    case Op::MEAN:  return STAT_MEAN;
+    case Op::STDEV: return STAT_SD;
+    case Op::MIN:   return STAT_MIN;
+    case Op::MAX:   return STAT_MAX;
+    default:        return 0;
+  }
+}
+
+
+/**
+  * Per-group statistics of a single column, shared by all reducers
+  * that are applied to this column within the same `EvalContext`.
+  *
+  * Each reducer registers the statistic that it needs via `reduce()`,
+  * and receives a (latent) column that reads the values from this
+  * object. The statistics themselves are computed only once, when the
+  * first of these columns is materialized: at that point all reducers
+  * in the `j` expression have already been registered, and thus every
+  * group is scanned only once, regardless of the number of reducers.
+  *
+  * The results are exactly the same as those produced by the
+  * individual reducer functions above, since the accumulators are
+  * computed in the same order and with the same types.
+  */
+class GroupStats {
+  protected:
+    Column arg_;
+    Groupby groupby_;
+    int requested_;
+    int computed_;
+
+  public:
+    GroupStats(Column&& col, const Groupby& gby)
+      : arg_(std::move(col)),
+        groupby_(gby),
+        requested_(0),
+        computed_(0) {}
+    virtual ~GroupStats() = default;
+
+    // Can these stats be reused for a column grouped by `gby`?
+    bool compatible_with(const Groupby& gby) const {
+      return gby.size() == groupby_.size() &&
+             gby.offsets_r() == groupby_.offsets_r();
+    }
+
+    const Column& arg() const {
+      return arg_;
+    }
+
+    void compute() {
+      if ((requested_ & ~computed_) == 0) return;
+      compute_impl(requested_);
+      computed_ = requested_;
+    }
+
+    virtual Column reduce(Op op, const std::shared_ptr<GroupStats>& self) = 0;
+
+  protected:
+    virtual void compute_impl(int stats) = 0;
+};
+
+
+// T - type of elements in the source column
+// S - type of the `sum()` result
+//
+template <typename T, typename S>
+class GroupStats_ : public GroupStats {
+  private:
+    std::vector<int64_t> counts_;
+    std::vector<S> sums_;
+    std::vector<double> dsums_;  // sums for the mean
+    std::vector<double> m2s_;    // sum of squared deviations for sd
+    std::vector<T> mins_;
+    std::vector<T> maxs_;
+
+  public:
+    using GroupStats::GroupStats;
+
+    Column reduce(Op op, const std::shared_ptr<GroupStats>& self) override;
+
+    template <typename U>
+    bool get(Op op, size_t i, U* out) const {
+      int64_t count = counts_[i];
+      switch (op) {
+        case Op::COUNT: {
+          *out = static_cast<U>(count);
+          return true;
+        }
+        case Op::SUM: {
+          *out = static_cast<U>(sums_[i]);
+          return true;
+        }
+        case Op::MEAN: {
+          if (!count) return false;
+          *out = static_cast<U>(dsums_[i] / static_cast<double>(count));
+          return true;
+        }
+        case Op::STDEV: {
+          if (count <= 1) return false;
+          double m2 = m2s_[i];
+          *out = static_cast<U>(m2 >= 0? std::sqrt(m2/static_cast<double>(count - 1))
+                                       : 0.0);
+          return true;
+        }
+        case Op::MIN: {
+          *out = static_cast<U>(mins_[i]);
+          return count > 0;
+        }
+        case Op::MAX: {
+          *out = static_cast<U>(maxs_[i]);
+          return count > 0;
+        }
+        default: return false;
+      }
+    }
+
+  protected:
+    void compute_impl(int stats) override {
+      size_t ngroups = groupby_.size();
+      bool do_sum = (stats & STAT_SUM);
+      bool do_mean = (stats & STAT_MEAN);
+      bool do_sd = (stats & STAT_SD);
+      bool do_min = (stats & STAT_MIN);
+      bool do_max = (stats & STAT_MAX);
+      counts_.resize(ngroups);
+      if (do_sum) sums_.resize(ngroups);
+      if (do_mean) dsums_.resize(ngroups);
+      if (do_sd) m2s_.resize(ngroups);
+      if (do_min) mins_.resize(ngroups);
+      if (do_max) maxs_.resize(ngroups);
+
+      dt::parallel_for_dynamic(ngroups,
+        [&](size_t g) {
+          size_t i0, i1;
+          groupby_.get_group(g, &i0, &i1);
+          int64_t count = 0;
+          S sum = 0;
+          double dsum = 0;
+          double mean = 0, m2 = 0;
+          T min = 0, max = 0;
+          for (size_t i = i0; i < i1; ++i) {
+            T value;
+            bool isvalid = arg_.get_element(i, &value);
+            if (!isvalid) continue;
+            count++;
+            if (do_sum) sum += static_cast<S>(value);
+            if (do_mean) dsum += static_cast<double>(value);
+            if (do_sd) {
+              double tmp1 = static_cast<double>(value) - mean;
+              mean += tmp1 / static_cast<double>(count);
+              double tmp2 = static_cast<double>(value) - mean;
+              m2 += tmp1 * tmp2;
+            }
+            if (do_min && (value < min || count == 1)) min = value;
+            if (do_max && (value > max || count == 1)) max = value;
+          }
+          counts_[g] = count;
+          if (do_sum) sums_[g] = sum;
+          if (do_mean) dsums_[g] = dsum;
+          if (do_sd) m2s_[g] = m2;
+          if (do_min) mins_[g] = min;
+          if (do_max) maxs_[g] = max;
+        });
+    }
+};
+
+
+// T - type of elements in the source column
+// S - type of the `sum()` result in GroupStats
+// U - type of output elements from this column
+//
+template <typename T, typename S, typename U>
+class FusedReduced_ColumnImpl : public Virtual_ColumnImpl {
+  private:
+    std::shared_ptr<GroupStats> stats_;
+    Op op_;
+
+  public:
+    FusedReduced_ColumnImpl(SType stype, size_t nrows,
+                            const std::shared_ptr<GroupStats>& stats, Op op)
+      : Virtual_ColumnImpl(nrows, stype),
+        stats_(stats),
+        op_(op)
+    {
+      xassert(compatible_type<U>(stype));
+    }
+
+    ColumnImpl* clone() const override {
+      return new FusedReduced_ColumnImpl<T, S, U>(stype_, nrows_, stats_, op_);
+    }
+
+    void pre_materialize_hook() override {
+      stats_->compute();
+    }
+
+    bool get_element(size_t i, U* out) const override {
+      auto stats = static_cast<const GroupStats_<T, S>*>(stats_.get());
+      return stats->get(op_, i, out);
+    }
+
+    size_t n_children() const noexcept override {
+      return 1;
+    }
+
+    const Column& child(size_t i) const override {
+      xassert(i == 0);  (void)i;
+      return stats_->arg();
+    }
+};
+
+
+template <typename T, typename S>
+Column GroupStats_<T, S>::reduce(Op op, const std::shared_ptr<GroupStats>& self)
+{
+  xassert(self.get() == this);
+  using V = typename std::conditional<std::is_same<T, float>::value,
+                                      float, double>::type;
+  requested_ |= _stat_for_op(op);
+  size_t n = groupby_.size();
+  ColumnImpl* res = nullptr;
+  switch (op) {
+    case Op::COUNT:
+      res = new FusedReduced_ColumnImpl<T, S, int64_t>(SType::INT64, n, self, op);
+      break;
+    case Op::SUM:
+      res = new FusedReduced_ColumnImpl<T, S, S>(stype_from<S>, n, self, op);
+      break;
+    case Op::MEAN:
+    case Op::STDEV:
+      res = new FusedReduced_ColumnImpl<T, S, V>(stype_from<V>, n, self, op);
+      break;
+    case Op::MIN:
+    case Op::MAX:
+      res = new FusedReduced_ColumnImpl<T, S, T>(stype_from<T>, n, self, op);
+      break;
+    default:
+      throw RuntimeError() << "Unexpected reducer in GroupStats";
+  }
+  return Column(new Latent_ColumnImpl(res));
+}
+
+
+static std::shared_ptr<GroupStats> _make_group_stats(
+    Column&& arg, const Groupby& gby)
+{
+  switch (arg.stype()) {
+    case SType::BOOL:
+    case SType::INT8:    return std::make_shared<GroupStats_<int8_t, int64_t>>(std::move(arg), gby);
+    case SType::INT16:   return std::make_shared<GroupStats_<int16_t, int64_t>>(std::move(arg), gby);
+    case SType::INT32:   return std::make_shared<GroupStats_<int32_t, int64_t>>(std::move(arg), gby);
+    case SType::INT64:   return std::make_shared<GroupStats_<int64_t, int64_t>>(std::move(arg), gby);
+    case SType::FLOAT32: return std::make_shared<GroupStats_<float, float>>(std::move(arg), gby);
+    case SType::FLOAT64: return std::make_shared<GroupStats_<double, double>>(std::move(arg), gby);
+    default:             return nullptr;
+  }
+}
+
+
+static bool _is_fusable(Op op, SType stype) {
+  if (!_stat_for_op(op)) return false;
+  switch (stype) {
+    case SType::BOOL:
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:
+    case SType::FLOAT32:
+    case SType::FLOAT64: return true;
+    default:             return false;
+  }
+}
+
+
+// Apply reducer `op` to the column `arg`, which is column `icol` of
+// frame `iframe` in the evaluation context. The per-group statistics
+// are shared with all other reducers applied to the same column.
+static Column _fused_reduce(Op op, Column&& arg, const Groupby& gby,
+                            EvalContext& ctx, size_t iframe, size_t icol)
+{
+  std::shared_ptr<GroupStats>& stats = ctx.get_group_stats(iframe, icol);
+  if (!stats || !stats->compatible_with(gby)) {
+    stats = _make_group_stats(std::move(arg), gby);
+  }
+  return stats->reduce(op, stats);
+}
+
+
+
+
 //------------------------------------------------------------------------------
 // Head_Reduce_Unary
 //------------------------------------------------------------------------------
@@ -1001,10 +1308,19 @@ Workframe Head_Reduce_Unary::evaluate_n(
     }
   }
 
+  bool grouped = (inputs.get_grouping_mode() != Grouping::GtoALL);
   Workframe outputs(ctx);
   for (size_t i = 0; i < inputs.ncols(); ++i) {
+    // Reducers applied to columns of the frame directly can share their
+    // pass over the data with other reducers on the same column
+    size_t iframe, icol;
+    bool fused = !grouped &&
+                 _is_fusable(op, inputs.get_column(i).stype()) &&
+                 inputs.is_reference_column(i, &iframe, &icol);
+    Column arg = inputs.retrieve_column(i);
     outputs.add_column(
-        fn(inputs.retrieve_column(i), gby),
+        fused? _fused_reduce(op, std::move(arg), gby, ctx, iframe, icol)
+             : fn(std::move(arg), gby),
         inputs.retrieve_name(i),
         Grouping::GtoONE);
   }
@@ -22,6 +22,8 @@
 #include "expr/py_join.h"
 #include "datatable.h"
 #include "python/arg.h"
+#include "python/list.h"
+#include "python/string.h"
 namespace py {
 
 
@@ -31,13 +33,12 @@ namespace py {
 //------------------------------------------------------------------------------
 
 static const char* doc_join =
-R"(join(frame)
+R"(join(frame, how="left", on=None)
 --
 
 Join clause for use in Frame’s square-bracket selector.
 
-This clause is equivalent to the SQL `JOIN`, though for the moment
-datatable only supports left outer joins. In order to join,
+This clause is equivalent to the SQL `JOIN`. In order to join,
 the `frame` must be :meth:`keyed <Frame.key>` first, and then joined
 to another frame `DT` as
 
@@ -48,20 +49,64 @@ to another frame `DT` as
 provided that `DT` has the column(s) with the same name(s) as
 the key in `frame`.
 
+Alternatively, the join columns can be given explicitly via the `on`
+parameter, in which case the `frame` does not have to be keyed, and
+its values in the join columns need not be unique:
+
+.. code-block:: python
+
+    DT[:, :, join(X, on="id")]
+
+Each row of `DT` will then be repeated as many times as there are
+matching rows in `frame` (a "many-to-many" join).
+
 Parameters
 ----------
 frame: Frame
     An input keyed frame to be joined to the current one.
 
+how: "left" | "inner" | "semi" | "anti" | "right" | "outer"
+    The kind of join to perform:
+
+    - ``"left"`` (default): all rows of `DT` are kept, and the columns
+      of `frame` are NA for the rows that have no match;
+    - ``"inner"``: only those rows of `DT` that have a match in `frame`
+      are kept;
+    - ``"semi"``: same rows as the ``"inner"`` join, however the columns
+      of `frame` are not added when selecting all columns with ``:``;
+    - ``"anti"``: only those rows of `DT` that have no match in `frame`
+      are kept, and the columns of `frame` are not added when selecting
+      all columns with ``:``;
+    - ``"right"``: the rows of the ``"inner"`` join, followed by those
+      rows of `frame` that have no match in `DT`;
+    - ``"outer"``: the rows of the ``"left"`` join, followed by those
+      rows of `frame` that have no match in `DT`.
+
+    For the ``"right"`` and ``"outer"`` joins, the key columns selected
+    with ``:`` contain the key values from `frame` for the rows that
+    came from `frame` only. All other columns of `DT` are NA in those
+    rows; in particular, ``f.<key>`` refers to the key column of `DT`,
+    whereas ``g.<key>`` refers to the key column of `frame`.
+
 return: Join Object
     In most of the cases the returned object is directly used in the
     Frame’s square-bracket selector.
 
+on: str | List[str] | None
+    The names of the columns in `frame` to join on. The columns with
+    the same names must also be present in `DT`. If not given, the
+    key columns of `frame` are used.
+
 except: TypeError
     The exception is raised if the input frame is missing.
 
 except: ValueError
-    The exception is raised if `frame` is not keyed.
+    The exception is raised if `frame` is not keyed and parameter `on`
+    is not given, or if `how` is not one of the valid join kinds.
+
+except: KeyError
+    The exception is raised if any of the `on` columns is not present
+    in `frame`.
 
 See Also
 --------
@@ -72,7 +117,21 @@ See Also
 )";
 
 static PKArgs args___init__(
-    1, 0, 0, false, false, {"frame"}, "__init__", doc_join);
+    1, 0, 2, false, false, {"frame", "how", "on"}, "__init__", doc_join);
+
+static JoinKind _parse_join_kind(const Arg& arg) {
+  if (arg.is_none_or_undefined()) return JoinKind::LEFT;
+  std::string how = arg.to_string();
+  if (how == "left")  return JoinKind::LEFT;
+  if (how == "inner") return JoinKind::INNER;
+  if (how == "semi")  return JoinKind::SEMI;
+  if (how == "anti")  return JoinKind::ANTI;
+  if (how == "right") return JoinKind::RIGHT;
+  if (how == "outer") return JoinKind::OUTER;
+  throw ValueError() << "Invalid value `" << how << "` for parameter "
+      "`how` in join(): must be one of \"left\", \"inner\", \"semi\", "
+      "\"anti\", \"right\" or \"outer\"";
+}
 
 void ojoin::pyobj::m__init__(const PKArgs& args) {
   if (!args[0]) {
@@ -83,14 +142,38 @@ void ojoin::pyobj::m__init__(const PKArgs& args) {
     throw TypeError() << "The argument to join() must be a Frame";
   }
   DataTable* jdt = join_frame.to_datatable();
-  if (jdt->nkeys() == 0) {
-    throw ValueError() << "The join frame is not keyed";
+  kind = _parse_join_kind(args[1]);
+
+  const Arg& arg_on = args[2];
+  if (arg_on.is_none_or_undefined()) {
+    if (jdt->nkeys() == 0) {
+      throw ValueError() << "The join frame is not keyed";
+    }
+    on_columns = None();
+  }
+  else {
+    olist names(0);
+    if (arg_on.is_string()) {
+      names.append(arg_on.to_oobj());
+    } else {
+      for (const auto& name : arg_on.to_stringlist()) {
+        names.append(ostring(name));
+      }
+    }
+    if (names.size() == 0) {
+      throw ValueError() << "Parameter `on` in join() cannot be empty";
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+      jdt->xcolindex(names[i]);  // throws if the column doesn't exist
+    }
+    on_columns = std::move(names);
   }
 }
 
 
 void ojoin::pyobj::m__dealloc__() {
   join_frame = nullptr;  // Releases the stored oobj
+  on_columns = nullptr;
 }
 
 
@@ -98,15 +181,35 @@ oobj ojoin::pyobj::get_joinframe() const {
   return join_frame;
 }
 
+oobj ojoin::pyobj::get_how() const {
+  switch (kind) {
+    case JoinKind::LEFT:  return ostring("left");
+    case JoinKind::INNER: return ostring("inner");
+    case JoinKind::SEMI:  return ostring("semi");
+    case JoinKind::ANTI:  return ostring("anti");
+    case JoinKind::RIGHT: return ostring("right");
+    case JoinKind::OUTER: return ostring("outer");
+  }
+  return None();  // LCOV_EXCL_LINE
+}
+
+oobj ojoin::pyobj::get_on() const {
+  return on_columns;
+}
+
 void ojoin::pyobj::impl_init_type(XTypeMaker& xt) {
   xt.set_class_name("datatable.join");
   xt.set_class_doc("join() clause for use in DT[i, j, ...]");
   xt.set_subclassable(true);
 
   static GSArgs args_joinframe("joinframe");
+  static GSArgs args_how("how");
+  static GSArgs args_on("on");
   xt.add(CONSTRUCTOR(&pyobj::m__init__, args___init__));
   xt.add(DESTRUCTOR(&pyobj::m__dealloc__));
   xt.add(GETTER(&pyobj::get_joinframe, args_joinframe));
+  xt.add(GETTER(&pyobj::get_how, args_how));
+  xt.add(GETTER(&pyobj::get_on, args_on));
 }
 
 
@@ -124,6 +227,32 @@ DataTable* ojoin::get_datatable() const {
 }
 
 
+JoinKind ojoin::get_kind() const {
+  auto w = static_cast<pyobj*>(v);
+  return w->kind;
+}
+
+
+// Indices of the columns in the join frame on which to join: either the
+// key columns, or the columns given in the `on` parameter.
+sztvec ojoin::get_join_columns() const {
+  auto w = static_cast<pyobj*>(v);
+  DataTable* jdt = w->join_frame.to_datatable();
+  sztvec res;
+  if (w->on_columns.is_none()) {
+    for (size_t i = 0; i < jdt->nkeys(); ++i) {
+      res.push_back(i);
+    }
+  } else {
+    py::olist names = w->on_columns.to_pylist();
+    for (size_t i = 0; i < names.size(); ++i) {
+      res.push_back(jdt->xcolindex(names[i]));
+    }
+  }
+  return res;
+}
+
+
 bool ojoin::check(PyObject* val) {
   return pyobj::check(val);
 }
@@ -23,6 +23,7 @@
 #define dt_EXPR_PY_JOIN_h
 #include "python/obj.h"
 #include "python/xobject.h"
+#include "datatable.h"      // JoinKind
 namespace py {
 
 
@@ -32,10 +33,15 @@ class ojoin : public oobj
   class pyobj : public XObject<pyobj> {
     public:
       oobj join_frame;
+      oobj on_columns;  // list of column names, or None
+      JoinKind kind;
+      size_t : 56;
 
       void m__init__(const PKArgs&);
       void m__dealloc__();
       oobj get_joinframe() const;
+      oobj get_how() const;
+      oobj get_on() const;
 
       static void impl_init_type(XTypeMaker& xt);
 
@@ -54,6 +60,8 @@ class ojoin : public oobj
     ojoin& operator=(ojoin&&) = default;
 
     DataTable* get_datatable() const;
+    JoinKind get_kind() const;
+    sztvec get_join_columns() const;
 
     static bool check(PyObject* v);
     static void init(PyObject* m);
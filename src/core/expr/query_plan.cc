@@ -0,0 +1,457 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>                       // std::stable_sort
+#include <cstring>                         // std::memcpy
+#include <limits>                          // std::numeric_limits
+#include "expr/expr.h"                     // OldExpr
+#include "expr/fbinary/fexpr_binaryop.h"   // FExpr_BinaryOp
+#include "expr/fexpr.h"                    // FExpr
+#include "expr/fexpr_column.h"             // FExpr_ColumnAsAttr, FExpr_ColumnAsArg
+#include "expr/fexpr_dict.h"               // FExpr_Dict
+#include "expr/fexpr_func_unary.h"         // FExpr_FuncUnary
+#include "expr/fexpr_list.h"               // FExpr_List
+#include "expr/head_func.h"                // Head_Func_Unary, Head_Func_Binary
+#include "expr/head_func_other.h"          // Head_Func_Re_Match
+#include "expr/op.h"                       // Op
+#include "expr/query_plan.h"
+#include "expr/workframe.h"
+#include "python/bool.h"
+#include "utils/assert.h"
+#include "options.h"
+namespace dt {
+namespace expr {
+
+
+static const char* doc_fexpr_cse =
+R"(
+Internal
+)";
+
+static const char* doc_fexpr_order_filters =
+R"(
+Internal
+)";
+
+static bool cse_enabled = true;
+static bool order_filters_enabled = true;
+
+void init_query_plan_options() {
+  dt::register_option(
+    "fexpr.cse",
+    []{ return py::obool(cse_enabled); },
+    [](const py::Arg& value){ cse_enabled = value.to_bool_strict(); },
+    doc_fexpr_cse
+  );
+
+  dt::register_option(
+    "fexpr.order_filters",
+    []{ return py::obool(order_filters_enabled); },
+    [](const py::Arg& value){ order_filters_enabled = value.to_bool_strict(); },
+    doc_fexpr_order_filters
+  );
+}
+
+
+static constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
+
+
+
+
+//------------------------------------------------------------------------------
+// Finding common subexpressions
+//------------------------------------------------------------------------------
+
+// Walks the expression trees, and records every arithmetic or function
+// node together with its structural key. Two nodes with the same key
+// produce the same result within a single EvalContext.
+//
+// Only the node types whose semantics is fully determined by their
+// key are keyed; any other node (and all of its ancestors) is
+// considered unique. The inputs of reducers are still visited, so
+// that `sum(f.x/f.y)` and `mean(f.x/f.y)` could share `f.x/f.y`.
+//
+class SubexprCollector {
+  public:
+    struct Occurrence {
+      const FExpr* expr;
+      size_t parent;
+      std::string key;  // empty if the node cannot be keyed
+    };
+    std::vector<Occurrence> occurrences;
+
+    void visit_top(const FExpr* e) {
+      if (!e) return;
+      if (auto list = dynamic_cast<const FExpr_List*>(e)) {
+        for (const auto& arg : list->get_args()) visit_top(arg.get());
+      }
+      else if (auto dict = dynamic_cast<const FExpr_Dict*>(e)) {
+        for (const auto& arg : dict->get_args()) visit_top(arg.get());
+      }
+      else {
+        std::string key;
+        visit(e, NO_PARENT, &key);
+      }
+    }
+
+  private:
+    size_t add_occurrence(const FExpr* e, size_t parent) {
+      occurrences.push_back(Occurrence{e, parent, std::string()});
+      return occurrences.size() - 1;
+    }
+
+    // Returns true if the node `e` was keyed, in which case its key is
+    // stored in `out`.
+    bool visit(const FExpr* e, size_t parent, std::string* out) {
+      if (auto binop = dynamic_cast<const FExpr_BinaryOp*>(e)) {
+        size_t i = add_occurrence(e, parent);
+        std::string lkey, rkey;
+        bool lok = visit(binop->get_lhs().get(), i, &lkey);
+        bool rok = visit(binop->get_rhs().get(), i, &rkey);
+        if (!lok || !rok) return false;
+        *out = "(" + lkey + " " + binop->name() + " " + rkey + ")";
+        occurrences[i].key = *out;
+        return true;
+      }
+      if (auto unop = dynamic_cast<const FExpr_FuncUnary*>(e)) {
+        size_t i = add_occurrence(e, parent);
+        std::string akey;
+        if (!visit(unop->get_arg().get(), i, &akey)) return false;
+        *out = unop->name() + "(" + akey + ")";
+        occurrences[i].key = *out;
+        return true;
+      }
+      if (auto oldexpr = dynamic_cast<const OldExpr*>(e)) {
+        size_t i = add_occurrence(e, parent);
+        bool ok = true;
+        std::string key = "@";
+        auto unop = dynamic_cast<const Head_Func_Unary*>(oldexpr->get_head());
+        auto binop = dynamic_cast<const Head_Func_Binary*>(oldexpr->get_head());
+        if (unop)       key += std::to_string(static_cast<int>(unop->get_op()));
+        else if (binop) key += std::to_string(static_cast<int>(binop->get_op()));
+        else            ok = false;
+        key += "(";
+        for (const auto& input : oldexpr->get_inputs()) {
+          std::string ikey;
+          ok &= visit(input.get(), i, &ikey);
+          key += ikey;
+          key += ",";
+        }
+        if (!ok) return false;
+        *out = key + ")";
+        occurrences[i].key = *out;
+        return true;
+      }
+      return leaf_key(e, out);
+    }
+
+    static bool leaf_key(const FExpr* e, std::string* out) {
+      if (auto col = dynamic_cast<const FExpr_ColumnAsAttr*>(e)) {
+        *out = "f" + std::to_string(col->get_namespace()) + "." +
+               col->get_pyname().to_string();
+        return true;
+      }
+      if (auto col = dynamic_cast<const FExpr_ColumnAsArg*>(e)) {
+        std::string akey;
+        if (!leaf_key(col->get_arg().get(), &akey)) return false;
+        *out = "f" + std::to_string(col->get_namespace()) + "[" + akey + "]";
+        return true;
+      }
+      switch (e->get_expr_kind()) {
+        case Kind::None:  *out = "None"; return true;
+        case Kind::Bool:  *out = e->evaluate_bool()? "True" : "False"; return true;
+        case Kind::Int:   *out = std::to_string(e->evaluate_int()); return true;
+        case Kind::Float: {
+          // use the exact bits, so that different values never collide
+          double value = e->evaluate_float();
+          uint64_t bits;
+          std::memcpy(&bits, &value, sizeof(double));
+          *out = "F" + std::to_string(bits);
+          return true;
+        }
+        case Kind::Str: {
+          std::string value = e->evaluate_pystr().to_string();
+          *out = "S" + std::to_string(value.size()) + ":" + value;
+          return true;
+        }
+        default: return false;
+      }
+    }
+};
+
+
+
+QueryPlan::QueryPlan() {}
+
+
+// A key is shared if it occurs at least twice, and not all of its
+// occurrences are within the parents that are shared themselves: for
+// example, in `[log(f.x/f.y), log(f.x/f.y)]` only the `log()` node
+// needs to be stored, while in `[log(f.x/f.y), f.x/f.y]` the ratio
+// is shared.
+//
+void QueryPlan::find_common_subexprs(const vecExpr& exprs) {
+  shared_.clear();
+  results_.clear();
+  if (!cse_enabled) return;
+
+  SubexprCollector collector;
+  for (const auto& expr : exprs) {
+    collector.visit_top(expr.get());
+  }
+  const auto& occurrences = collector.occurrences;
+
+  std::unordered_map<std::string, size_t> counts;
+  for (const auto& occ : occurrences) {
+    if (!occ.key.empty()) counts[occ.key]++;
+  }
+  std::unordered_map<std::string, size_t> slots;
+  for (const auto& occ : occurrences) {
+    if (occ.key.empty()) continue;
+    size_t count = counts[occ.key];
+    if (count < 2) continue;
+    size_t parent_count = 0;
+    if (occ.parent != NO_PARENT && !occurrences[occ.parent].key.empty()) {
+      parent_count = counts[occurrences[occ.parent].key];
+    }
+    if (parent_count < count && slots.count(occ.key) == 0) {
+      slots[occ.key] = results_.size();
+      results_.push_back(SharedResult{{}, {}, Grouping::SCALAR, false});
+    }
+  }
+  for (const auto& occ : occurrences) {
+    auto it = slots.find(occ.key);
+    if (it != slots.end()) shared_[occ.expr] = it->second;
+  }
+}
+
+
+bool QueryPlan::is_shared(const FExpr* expr) const {
+  return !shared_.empty() && shared_.count(expr);
+}
+
+
+bool QueryPlan::get_shared_result(const FExpr* expr, Workframe& out) const {
+  if (shared_.empty()) return false;
+  auto it = shared_.find(expr);
+  if (it == shared_.end()) return false;
+  const SharedResult& res = results_[it->second];
+  if (!res.computed) return false;
+  for (size_t i = 0; i < res.columns.size(); ++i) {
+    out.add_column(Column(res.columns[i]), std::string(res.names[i]),
+                   res.gmode);
+  }
+  return true;
+}
+
+
+// The shared columns are materialized, so that each of their
+// consumers reads the computed values instead of re-evaluating
+// them.
+Workframe QueryPlan::save_shared_result(const FExpr* expr, Workframe&& wf) {
+  if (shared_.empty()) return std::move(wf);
+  auto it = shared_.find(expr);
+  if (it == shared_.end()) return std::move(wf);
+  SharedResult& res = results_[it->second];
+  if (res.computed) return std::move(wf);
+  for (size_t i = 0; i < wf.ncols(); ++i) {
+    if (!wf.is_computed_column(i)) return std::move(wf);
+  }
+  for (size_t i = 0; i < wf.ncols(); ++i) {
+    Column col = wf.retrieve_column(i);
+    col.materialize();
+    res.columns.push_back(col);
+    res.names.push_back(wf.get_name(i));
+    wf.replace_column(i, std::move(col));
+  }
+  res.gmode = wf.get_grouping_mode();
+  res.computed = true;
+  return std::move(wf);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Ordering of filters
+//------------------------------------------------------------------------------
+
+static bool is_logical(const OldExpr* e, Op op) {
+  auto binop = dynamic_cast<const Head_Func_Binary*>(e->get_head());
+  if (binop) return binop->get_op() == op && e->get_inputs().size() == 2;
+  auto unop = dynamic_cast<const Head_Func_Unary*>(e->get_head());
+  if (unop) return unop->get_op() == op && e->get_inputs().size() == 1;
+  return false;
+}
+
+
+static void split_conjunction(const FExpr* e, std::vector<const FExpr*>& out) {
+  auto oldexpr = dynamic_cast<const OldExpr*>(e);
+  if (oldexpr && is_logical(oldexpr, Op::AND)) {
+    split_conjunction(oldexpr->get_inputs()[0].get(), out);
+    split_conjunction(oldexpr->get_inputs()[1].get(), out);
+  } else {
+    out.push_back(e);
+  }
+}
+
+
+// Returns true if `e` is known to produce a boolean column without
+// evaluating it. Operators `&`, `|` and `~` are also bitwise operators
+// on integers, so they qualify only when their inputs are boolean.
+static bool is_condition(const FExpr* e) {
+  if (auto binop = dynamic_cast<const FExpr_BinaryOp*>(e)) {
+    std::string name = binop->name();
+    return name == "==" || name == "!=" || name == "<" ||
+           name == "<=" || name == ">"  || name == ">=";
+  }
+  if (auto oldexpr = dynamic_cast<const OldExpr*>(e)) {
+    const auto& inputs = oldexpr->get_inputs();
+    if (is_logical(oldexpr, Op::AND) || is_logical(oldexpr, Op::OR)) {
+      return is_condition(inputs[0].get()) && is_condition(inputs[1].get());
+    }
+    if (is_logical(oldexpr, Op::UINVERT)) {
+      return is_condition(inputs[0].get());
+    }
+    const Head* head = oldexpr->get_head();
+    auto unop = dynamic_cast<const Head_Func_Unary*>(head);
+    return (unop && unop->get_op() == Op::ISNA) ||
+           dynamic_cast<const Head_Func_Re_Match*>(head) ||
+           dynamic_cast<const Head_Func_IsClose*>(head);
+  }
+  return false;
+}
+
+
+// Returns true if the value of `e` in each row depends only on the
+// values of the columns in that row, i.e. there are no reducers,
+// shifts, or other functions that look at the whole column or group.
+static bool is_rowwise(const FExpr* e) {
+  if (dynamic_cast<const FExpr_ColumnAsAttr*>(e)) return true;
+  if (auto col = dynamic_cast<const FExpr_ColumnAsArg*>(e)) {
+    Kind kind = col->get_arg()->get_expr_kind();
+    return kind == Kind::Int || kind == Kind::Str;
+  }
+  if (auto binop = dynamic_cast<const FExpr_BinaryOp*>(e)) {
+    return is_rowwise(binop->get_lhs().get()) &&
+           is_rowwise(binop->get_rhs().get());
+  }
+  if (auto unop = dynamic_cast<const FExpr_FuncUnary*>(e)) {
+    return is_rowwise(unop->get_arg().get());
+  }
+  if (auto oldexpr = dynamic_cast<const OldExpr*>(e)) {
+    const Head* head = oldexpr->get_head();
+    if (!dynamic_cast<const Head_Func_Unary*>(head) &&
+        !dynamic_cast<const Head_Func_Binary*>(head) &&
+        !dynamic_cast<const Head_Func_Re_Match*>(head) &&
+        !dynamic_cast<const Head_Func_IsClose*>(head)) return false;
+    for (const auto& input : oldexpr->get_inputs()) {
+      if (!is_rowwise(input.get())) return false;
+    }
+    return true;
+  }
+  switch (e->get_expr_kind()) {
+    case Kind::None:
+    case Kind::Bool:
+    case Kind::Int:
+    case Kind::Float:
+    case Kind::Str: return true;
+    default:        return false;
+  }
+}
+
+
+// A row-wise condition selects the same rows regardless of whether
+// it is applied to the whole frame, or to each group separately, or
+// before or after some other row-wise condition. Such filters can be
+// combined freely (see frame/lazy.cc).
+bool QueryPlan::is_rowwise_condition(const FExpr* expr) {
+  return is_condition(expr) && is_rowwise(expr);
+}
+
+
+// Rough estimate of the cost of evaluating an expression, per row.
+static size_t estimate_cost(const FExpr* e) {
+  if (dynamic_cast<const FExpr_ColumnAsAttr*>(e) ||
+      dynamic_cast<const FExpr_ColumnAsArg*>(e)) {
+    return 1;
+  }
+  if (auto binop = dynamic_cast<const FExpr_BinaryOp*>(e)) {
+    return 1 + estimate_cost(binop->get_lhs().get()) +
+               estimate_cost(binop->get_rhs().get());
+  }
+  if (auto unop = dynamic_cast<const FExpr_FuncUnary*>(e)) {
+    return 2 + estimate_cost(unop->get_arg().get());
+  }
+  if (auto oldexpr = dynamic_cast<const OldExpr*>(e)) {
+    const Head* head = oldexpr->get_head();
+    size_t cost = dynamic_cast<const Head_Func_Re_Match*>(head)? 100 :
+                  dynamic_cast<const Head_Func_Unary*>(head) ||
+                  dynamic_cast<const Head_Func_Binary*>(head)? 1 : 20;
+    for (const auto& input : oldexpr->get_inputs()) {
+      cost += estimate_cost(input.get());
+    }
+    return cost;
+  }
+  switch (e->get_expr_kind()) {
+    case Kind::None:
+    case Kind::Bool:
+    case Kind::Int:
+    case Kind::Float:
+    case Kind::Str: return 0;
+    default:        return 20;
+  }
+}
+
+
+// If the filter is a conjunction of row-wise conditions with different
+// costs, return these conditions ordered from the cheapest to the most
+// expensive. Otherwise return an empty vector, meaning that the
+// filter should be evaluated as a whole. Conditions that involve
+// reducers, such as `f.A > mean(f.A)`, depend on the set of rows they
+// are applied to, and therefore cannot be evaluated after some other
+// condition has already narrowed the rows.
+//
+std::vector<const FExpr*> QueryPlan::order_filters(const FExpr* iexpr) {
+  std::vector<const FExpr*> filters;
+  if (!order_filters_enabled || !iexpr) return filters;
+  split_conjunction(iexpr, filters);
+  if (filters.size() < 2) return {};
+
+  std::unordered_map<const FExpr*, size_t> costs;
+  for (const FExpr* filter : filters) {
+    if (!is_rowwise_condition(filter)) return {};
+    costs[filter] = estimate_cost(filter);
+  }
+  size_t cost0 = costs[filters[0]];
+  bool all_same = std::all_of(filters.begin(), filters.end(),
+      [&](const FExpr* filter){ return costs[filter] == cost0; });
+  if (all_same) return {};
+
+  std::stable_sort(filters.begin(), filters.end(),
+      [&](const FExpr* a, const FExpr* b){ return costs[a] < costs[b]; });
+  return filters;
+}
+
+
+
+
+}}  // namespace dt::expr
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_EXPR_QUERY_PLAN_h
+#define dt_EXPR_QUERY_PLAN_h
+#include <string>            // std::string
+#include <unordered_map>     // std::unordered_map
+#include <vector>            // std::vector
+#include "expr/declarations.h"
+#include "column.h"
+namespace dt {
+namespace expr {
+
+
+/**
+  * Lightweight logical plan of a single `DT[i, j, ...]` call, which
+  * is used by the EvalContext in order to avoid redundant work.
+  *
+  * Common subexpressions
+  *   Before the `j` (and the replacement) expressions are evaluated,
+  *   their trees are scanned and each arithmetic / function node gets
+  *   a structural key, such as "(f0.x / f0.y)". The nodes whose key
+  *   occurs more than once are marked as "shared": the first time
+  *   such node is evaluated, its result is materialized and stored,
+  *   and all subsequent evaluations of the same key reuse the stored
+  *   columns. Thus in `DT[:, [f.x/f.y, log(f.x/f.y)]]` the ratio is
+  *   computed only once.
+  *
+  * Filter ordering
+  *   If the `i` filter is a conjunction `c1 & c2 & ...` of boolean
+  *   conditions with different estimated costs, the conditions are
+  *   applied one after another, from the cheapest to the most
+  *   expensive, so that the expensive conditions are evaluated only
+  *   on the rows that passed the cheaper ones.
+  */
+class QueryPlan {
+  private:
+    struct SharedResult {
+      std::vector<Column> columns;
+      strvec names;
+      Grouping gmode;
+      bool computed;
+      size_t : 56;
+    };
+
+    std::unordered_map<const FExpr*, size_t> shared_;
+    std::vector<SharedResult> results_;
+
+  public:
+    QueryPlan();
+
+    void find_common_subexprs(const vecExpr& exprs);
+    bool is_shared(const FExpr* expr) const;
+    bool get_shared_result(const FExpr* expr, Workframe& out) const;
+    Workframe save_shared_result(const FExpr* expr, Workframe&& wf);
+
+    static std::vector<const FExpr*> order_filters(const FExpr* iexpr);
+    static bool is_rowwise_condition(const FExpr* expr);
+};
+
+
+void init_query_plan_options();
+
+
+
+}}  // namespace dt::expr
+#endif
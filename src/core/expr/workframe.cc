@@ -252,6 +252,11 @@ const Column& Workframe::get_column(size_t i) const {
 }
 
 
+const std::string& Workframe::get_name(size_t i) const {
+  xassert(i < entries_.size());
+  return entries_[i].name;
+}
+
 std::string Workframe::retrieve_name(size_t i) {
   xassert(i < entries_.size());
   return std::move(entries_[i].name);
@@ -0,0 +1,490 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <cmath>                           // std::isnan
+#include <memory>                          // std::unique_ptr
+#include <vector>                          // std::vector
+#include "expr/eval_context.h"
+#include "expr/expr.h"                     // OldExpr
+#include "expr/fbinary/fexpr_binaryop.h"   // FExpr_BinaryOp
+#include "expr/fexpr.h"                    // FExpr
+#include "expr/fexpr_column.h"             // FExpr_ColumnAsAttr, FExpr_ColumnAsArg
+#include "expr/head_func.h"                // Head_Func_Unary, Head_Func_Binary
+#include "expr/op.h"                       // Op
+#include "expr/workframe.h"
+#include "expr/zone_filter.h"
+#include "parallel/api.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+#include "datatable.h"
+#include "stype.h"
+#include "zone_map.h"
+namespace dt {
+namespace expr {
+
+
+/**
+  * Possible outcomes of the filter within a single row group: whether
+  * the filter may evaluate to True, False, or NA for at least one row
+  * in the group. Note that "may" is important here: a row group can
+  * be skipped only when `can_true` is false, and thus it is always
+  * safe to answer "yes" when in doubt.
+  */
+struct Outcome {
+  bool can_true;
+  bool can_false;
+  bool can_na;
+};
+
+static constexpr Outcome ANY_OUTCOME = {true, true, true};
+
+
+/**
+  * Node in the tree of the analyzed filter. Each node can tell the
+  * possible outcomes of its sub-expression within any row group.
+  */
+class ZoneNode {
+  public:
+    virtual ~ZoneNode();
+    virtual Outcome evaluate(size_t i) const = 0;
+};
+
+ZoneNode::~ZoneNode() {}
+
+using NodePtr = std::unique_ptr<ZoneNode>;
+
+
+
+//------------------------------------------------------------------------------
+// Nodes
+//------------------------------------------------------------------------------
+
+// Any expression which we cannot reason about.
+class Unknown_ZoneNode : public ZoneNode {
+  public:
+    Outcome evaluate(size_t) const override {
+      return ANY_OUTCOME;
+    }
+};
+
+
+// Operators `&` and `|` follow the Kleene logic, same as in
+// "read/row_filter.cc".
+class And_ZoneNode : public ZoneNode {
+  private:
+    NodePtr lhs_, rhs_;
+
+  public:
+    And_ZoneNode(NodePtr&& lhs, NodePtr&& rhs)
+      : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    Outcome evaluate(size_t i) const override {
+      Outcome x = lhs_->evaluate(i);
+      Outcome y = rhs_->evaluate(i);
+      return Outcome {
+        x.can_true && y.can_true,
+        x.can_false || y.can_false,
+        (x.can_na && (y.can_true || y.can_na)) ||
+        (y.can_na && (x.can_true || x.can_na))
+      };
+    }
+};
+
+
+class Or_ZoneNode : public ZoneNode {
+  private:
+    NodePtr lhs_, rhs_;
+
+  public:
+    Or_ZoneNode(NodePtr&& lhs, NodePtr&& rhs)
+      : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    Outcome evaluate(size_t i) const override {
+      Outcome x = lhs_->evaluate(i);
+      Outcome y = rhs_->evaluate(i);
+      return Outcome {
+        x.can_true || y.can_true,
+        x.can_false && y.can_false,
+        (x.can_na && (y.can_false || y.can_na)) ||
+        (y.can_na && (x.can_false || x.can_na))
+      };
+    }
+};
+
+
+class Not_ZoneNode : public ZoneNode {
+  private:
+    NodePtr arg_;
+
+  public:
+    explicit Not_ZoneNode(NodePtr&& arg)
+      : arg_(std::move(arg)) {}
+
+    Outcome evaluate(size_t i) const override {
+      Outcome x = arg_->evaluate(i);
+      return Outcome { x.can_false, x.can_true, x.can_na };
+    }
+};
+
+
+static size_t _nvalid(const ZoneMap* zm, size_t i) {
+  return zm->chunk_end(i) - zm->chunk_start(i) - zm->zone(i).nacount;
+}
+
+
+class BoolColumn_ZoneNode : public ZoneNode {
+  private:
+    const ZoneMap* zm_;
+
+  public:
+    explicit BoolColumn_ZoneNode(const ZoneMap* zm) : zm_(zm) {}
+
+    Outcome evaluate(size_t i) const override {
+      const auto& z = zm_->zone(i);
+      bool valid = _nvalid(zm_, i) > 0;
+      return Outcome { valid && z.imax == 1,
+                       valid && z.imin == 0,
+                       z.nacount > 0 };
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Comparison of a column with a literal
+//------------------------------------------------------------------------------
+
+enum class CmpOp : uint8_t { EQ, NE, LT, LE, GT, GE };
+
+static CmpOp _flip(CmpOp op) {
+  switch (op) {
+    case CmpOp::LT: return CmpOp::GT;
+    case CmpOp::LE: return CmpOp::GE;
+    case CmpOp::GT: return CmpOp::LT;
+    case CmpOp::GE: return CmpOp::LE;
+    default:        return op;
+  }
+}
+
+
+// Same semantics as in FExpr__eq__ & co: the result of a comparison
+// is never NA; a missing value is not equal to any valid value, and
+// is not less or greater than anything.
+template <typename V>
+static Outcome _compare(CmpOp op, V vmin, V vmax, V y,
+                        bool valid, bool hasna)
+{
+  bool all_eq = valid && vmin == y && vmax == y;
+  bool some_eq = valid && vmin <= y && y <= vmax;
+  switch (op) {
+    case CmpOp::EQ: return { some_eq, hasna || (valid && !all_eq), false };
+    case CmpOp::NE: return { hasna || (valid && !all_eq), some_eq, false };
+    case CmpOp::LT: return { valid && vmin < y,  hasna || (valid && vmax >= y), false };
+    case CmpOp::LE: return { valid && vmin <= y, hasna || (valid && vmax > y),  false };
+    case CmpOp::GT: return { valid && vmax > y,  hasna || (valid && vmin <= y), false };
+    case CmpOp::GE: return { valid && vmax >= y, hasna || (valid && vmin < y),  false };
+  }
+  return ANY_OUTCOME;  // LCOV_EXCL_LINE
+}
+
+static Outcome _merge(const Outcome& x, const Outcome& y) {
+  return Outcome { x.can_true || y.can_true,
+                   x.can_false || y.can_false,
+                   x.can_na || y.can_na };
+}
+
+
+class Compare_ZoneNode : public ZoneNode {
+  private:
+    const ZoneMap* zm_;
+    CmpOp op_;
+    Kind kind_;    // kind of the literal: None, Bool, Int or Float
+    bool is_float32_;
+    int64_t ivalue_;
+    double fvalue_;
+
+  public:
+    Compare_ZoneNode(const ZoneMap* zm, SType stype, CmpOp op, Kind kind,
+                     int64_t ivalue, double fvalue)
+      : zm_(zm), op_(op), kind_(kind),
+        is_float32_(stype == SType::FLOAT32),
+        ivalue_(ivalue), fvalue_(fvalue) {}
+
+    Outcome evaluate(size_t i) const override {
+      const auto& z = zm_->zone(i);
+      bool valid = _nvalid(zm_, i) > 0;
+      bool hasna = z.nacount > 0;
+      if (kind_ == Kind::None) {
+        // `x == None` is the same as `isna(x)`, and `x != None` is its
+        // negation; other comparisons with None are always false.
+        switch (op_) {
+          case CmpOp::EQ: return { hasna, valid, false };
+          case CmpOp::NE: return { valid, hasna, false };
+          default:        return { false, true, false };
+        }
+      }
+      if (zm_->is_float()) {
+        Outcome res = _compare<double>(op_, z.fmin, z.fmax, fvalue_,
+                                       valid, hasna);
+        // A float32 column may be compared with the literal rounded
+        // to float32, so we must allow for both possibilities.
+        if (is_float32_) {
+          double fvalue32 = static_cast<double>(static_cast<float>(fvalue_));
+          res = _merge(res, _compare<double>(op_, z.fmin, z.fmax, fvalue32,
+                                             valid, hasna));
+        }
+        return res;
+      }
+      if (kind_ == Kind::Float) {
+        return _compare<double>(op_, static_cast<double>(z.imin),
+                                static_cast<double>(z.imax), fvalue_,
+                                valid, hasna);
+      }
+      return _compare<int64_t>(op_, z.imin, z.imax, ivalue_, valid, hasna);
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Analyzing the filter
+//------------------------------------------------------------------------------
+
+class ZoneAnalyzer {
+  private:
+    const DataTable* dt_;
+    const ZoneMap* layout_;
+
+  public:
+    explicit ZoneAnalyzer(const DataTable* dt)
+      : dt_(dt), layout_(nullptr) {}
+
+    // The zone map which defines the row groups used by the analyzed
+    // filter, or nullptr if the filter uses no zone maps at all.
+    const ZoneMap* layout() const { return layout_; }
+
+    NodePtr analyze(const FExpr* e) {
+      const Column* col = find_column(e);
+      if (col) {
+        const ZoneMap* zm = zone_map(*col);
+        if (zm && col->stype() == SType::BOOL) {
+          return NodePtr(new BoolColumn_ZoneNode(zm));
+        }
+        return unknown();
+      }
+      if (auto binop = dynamic_cast<const FExpr_BinaryOp*>(e)) {
+        return analyze_comparison(binop);
+      }
+      if (auto oldexpr = dynamic_cast<const OldExpr*>(e)) {
+        return analyze_logical(oldexpr);
+      }
+      return unknown();
+    }
+
+  private:
+    static NodePtr unknown() {
+      return NodePtr(new Unknown_ZoneNode());
+    }
+
+    // All zone maps used by the filter must have the same layout of
+    // row groups; the columns with any other layout are ignored.
+    const ZoneMap* zone_map(const Column& col) {
+      const ZoneMap* zm = col.get_zone_map();
+      if (!zm) return nullptr;
+      if (!layout_) layout_ = zm;
+      if (!zm->same_layout(*layout_)) return nullptr;
+      return zm;
+    }
+
+    // If `e` is a reference to a column of the main frame, such as
+    // `f.A` or `f[0]`, then return that column.
+    const Column* find_column(const FExpr* e) const {
+      auto colattr = dynamic_cast<const FExpr_ColumnAsAttr*>(e);
+      auto colarg = dynamic_cast<const FExpr_ColumnAsArg*>(e);
+      if (!colattr && !colarg) return nullptr;
+      size_t ns = colattr? colattr->get_namespace() : colarg->get_namespace();
+      if (ns != 0) return nullptr;
+      int64_t ncols = static_cast<int64_t>(dt_->ncols());
+      int64_t index = -1;
+      if (colattr) {
+        index = dt_->colindex(colattr->get_pyname());
+      } else {
+        auto arg = colarg->get_arg();
+        switch (arg->get_expr_kind()) {
+          case Kind::Int: {
+            index = arg->evaluate_int();
+            if (index < 0) index += ncols;
+            break;
+          }
+          case Kind::Str: index = dt_->colindex(arg->evaluate_pystr()); break;
+          default: break;
+        }
+      }
+      if (index < 0 || index >= ncols) return nullptr;
+      return &dt_->get_column(static_cast<size_t>(index));
+    }
+
+    // Logical operators `&`, `|` and `~` are not yet ported to the
+    // FExpr framework, and thus they appear in the tree as `OldExpr`
+    // nodes with a unary/binary function head.
+    NodePtr analyze_logical(const OldExpr* e) {
+      const auto& inputs = e->get_inputs();
+      auto unop = dynamic_cast<const Head_Func_Unary*>(e->get_head());
+      auto binop = dynamic_cast<const Head_Func_Binary*>(e->get_head());
+      if (unop && unop->get_op() == Op::UINVERT && inputs.size() == 1) {
+        return NodePtr(new Not_ZoneNode(analyze(inputs[0].get())));
+      }
+      if (binop && binop->get_op() == Op::AND && inputs.size() == 2) {
+        auto lhs = analyze(inputs[0].get());
+        auto rhs = analyze(inputs[1].get());
+        return NodePtr(new And_ZoneNode(std::move(lhs), std::move(rhs)));
+      }
+      if (binop && binop->get_op() == Op::OR && inputs.size() == 2) {
+        auto lhs = analyze(inputs[0].get());
+        auto rhs = analyze(inputs[1].get());
+        return NodePtr(new Or_ZoneNode(std::move(lhs), std::move(rhs)));
+      }
+      return unknown();
+    }
+
+    NodePtr analyze_comparison(const FExpr_BinaryOp* e) {
+      std::string name = e->name();
+      CmpOp op;
+      if      (name == "==") op = CmpOp::EQ;
+      else if (name == "!=") op = CmpOp::NE;
+      else if (name == "<")  op = CmpOp::LT;
+      else if (name == "<=") op = CmpOp::LE;
+      else if (name == ">")  op = CmpOp::GT;
+      else if (name == ">=") op = CmpOp::GE;
+      else return unknown();
+
+      const FExpr* lhs = e->get_lhs().get();
+      const FExpr* rhs = e->get_rhs().get();
+      const Column* col = find_column(lhs);
+      const FExpr* literal = rhs;
+      if (!col) {
+        col = find_column(rhs);
+        literal = lhs;
+        op = _flip(op);
+      }
+      if (!col) return unknown();
+
+      int64_t ivalue = 0;
+      double fvalue = 0;
+      Kind kind = literal->get_expr_kind();
+      switch (kind) {
+        case Kind::None:  break;
+        case Kind::Bool:  ivalue = literal->evaluate_bool(); break;
+        case Kind::Int:   ivalue = literal->evaluate_int(); break;
+        case Kind::Float: fvalue = literal->evaluate_float(); break;
+        default:          return unknown();
+      }
+      if (kind != Kind::Float) fvalue = static_cast<double>(ivalue);
+      if (std::isnan(fvalue)) return unknown();
+
+      const ZoneMap* zm = zone_map(*col);
+      if (!zm) return unknown();
+      return NodePtr(new Compare_ZoneNode(zm, col->stype(), op, kind,
+                                          ivalue, fvalue));
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Evaluating the filter
+//------------------------------------------------------------------------------
+
+template <typename T>
+static RowIndex _make_rowindex(const std::vector<std::vector<size_t>>& parts,
+                               size_t total, int flags)
+{
+  Buffer buf = Buffer::mem(total * sizeof(T));
+  T* out = static_cast<T*>(buf.xptr());
+  for (const auto& part : parts) {
+    for (size_t i : part) *out++ = static_cast<T>(i);
+  }
+  return RowIndex(std::move(buf), flags | RowIndex::SORTED);
+}
+
+
+RowIndex evaluate_i_with_zone_maps(const FExpr& iexpr, EvalContext& ctx) {
+  const DataTable* dt0 = ctx.get_datatable(0);
+  if (ctx.get_rowindex(0) || ctx.nframes() != 1) {
+    return iexpr.evaluate_i(ctx);
+  }
+  ZoneAnalyzer analyzer(dt0);
+  NodePtr root = analyzer.analyze(&iexpr);
+  const ZoneMap* layout = analyzer.layout();
+  if (!layout) {
+    return iexpr.evaluate_i(ctx);
+  }
+
+  size_t nrows = dt0->nrows();
+  size_t nchunks = layout->nchunks();
+  xassert(layout->nrows() == nrows);
+  sztvec selected_chunks;
+  for (size_t i = 0; i < nchunks; ++i) {
+    if (root->evaluate(i).can_true) selected_chunks.push_back(i);
+  }
+  if (selected_chunks.size() == nchunks) {
+    return iexpr.evaluate_i(ctx);
+  }
+
+  Workframe wf = iexpr.evaluate_n(ctx);
+  if (wf.ncols() != 1) {
+    throw TypeError() << "i-expression evaluated into " << wf.ncols()
+        << " columns";
+  }
+  Column col = wf.retrieve_column(0);
+  if (col.stype() != SType::BOOL) {
+    throw TypeError() << "Filter expression must be boolean, instead it "
+        "was of type " << col.stype();
+  }
+
+  // Evaluate the filter within the selected row groups only
+  size_t nselected = selected_chunks.size();
+  std::vector<std::vector<size_t>> parts(nselected);
+  dt::parallel_for_dynamic(nselected,
+    NThreads(col.allow_parallel_access()),
+    [&](size_t k) {
+      size_t i0 = layout->chunk_start(selected_chunks[k]);
+      size_t i1 = layout->chunk_end(selected_chunks[k]);
+      auto& part = parts[k];
+      int8_t value;
+      for (size_t i = i0; i < i1; ++i) {
+        bool isvalid = col.get_element(i, &value);
+        if (isvalid && value) part.push_back(i);
+      }
+    });
+
+  size_t total = 0;
+  for (const auto& part : parts) total += part.size();
+  if (nrows <= Column::MAX_ARR32_SIZE) {
+    return _make_rowindex<int32_t>(parts, total, RowIndex::ARR32);
+  } else {
+    return _make_rowindex<int64_t>(parts, total, RowIndex::ARR64);
+  }
+}
+
+
+
+}}  // namespace dt::expr
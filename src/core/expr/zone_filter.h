@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_EXPR_ZONE_FILTER_h
+#define dt_EXPR_ZONE_FILTER_h
+#include "expr/declarations.h"
+#include "rowindex.h"
+namespace dt {
+namespace expr {
+
+
+/**
+  * Evaluate the i-filter `iexpr` of `DT[i, j]`, using the zone maps
+  * of the columns of `DT` (see "zone_map.h") to skip the row groups
+  * where the filter cannot be true. Only the rows of the remaining
+  * groups are evaluated, so that the data in the skipped groups is
+  * never touched.
+  *
+  * The zone maps are consulted for comparisons of a column with a
+  * literal, for boolean columns, and for their combinations via
+  * operators `&`, `|` and `~`; any other part of the filter is
+  * assumed to potentially select any row. When no row groups can be
+  * skipped, this is equivalent to `iexpr.evaluate_i(ctx)`.
+  */
+RowIndex evaluate_i_with_zone_maps(const FExpr& iexpr, EvalContext& ctx);
+
+
+
+}}  // namespace dt::expr
+#endif
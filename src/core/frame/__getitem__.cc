@@ -137,6 +137,18 @@ oobj Frame::_main_getset(robj item, robj value) {
     // otherwise fall-through
   }
 
+  return _eval_query(targs, value);
+}
+
+
+// Evaluate the generic form `DT[i, j, ...]` of the selector, where
+// `targs` has at least 2 elements. The `filters` are the additional
+// row-wise conditions applied after `i` (see frame/lazy.cc).
+oobj Frame::_eval_query(rtuple targs, robj value,
+                        const std::vector<oobj>& filters)
+{
+  size_t nargs = targs.size();
+
   // 1. Create the EvalContext
   auto mode = value == GETITEM? dt::expr::EvalMode::SELECT :
               value == DELITEM? dt::expr::EvalMode::DELETE :
@@ -175,6 +187,9 @@ oobj Frame::_main_getset(robj item, robj value) {
   // 3. Instantiate `i` and `j` nodes.
   xassert(nargs >= 2);
   ctx.add_i(targs[0]);
+  for (const oobj& filter : filters) {
+    ctx.add_filter(filter);
+  }
   ctx.add_j(targs[1]);
 
   if (mode == dt::expr::EvalMode::UPDATE) {
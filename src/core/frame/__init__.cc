@@ -21,9 +21,12 @@
 //------------------------------------------------------------------------------
 #include "frame/py_frame.h"
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
+#include "arrow/arrow.h"
 #include "column/npmasked.h"
+#include "jay/jay_generated.h"
 #include "python/_all.h"
 #include "utils/alloc.h"
 #include "stype.h"
@@ -133,6 +136,9 @@ class FrameInitializationManager {
       if (src.is_numpy_array()) {
         return init_from_numpy();
       }
+      if (src.is_arrow_object()) {
+        return init_from_arrow();
+      }
       if (src.is_ellipsis() &&
                !defined_names && !defined_stypes && !defined_stype) {
         return init_mystery_frame();
@@ -431,6 +437,46 @@ class FrameInitializationManager {
     }
 
 
+    void init_from_arrow() {
+      if (stypes_arg || stype_arg) {
+        throw TypeError() << "Argument `stypes` is not supported in Frame() "
+            "constructor when creating a Frame from an Arrow object";
+      }
+      py::robj arrowsrc = src.to_robj();
+      std::unique_ptr<DataTable> res;
+      if (arrowsrc.has_attr("__arrow_c_stream__")) {
+        py::oobj capsule = arrowsrc.invoke("__arrow_c_stream__");
+        auto stream = static_cast<ArrowArrayStream*>(PyCapsule_GetPointer(
+                          capsule.to_borrowed_ref(), "arrow_array_stream"));
+        if (!stream) throw PyError();
+        res.reset(dt::arrow::import_stream(stream));
+      } else {
+        py::otuple capsules = arrowsrc.invoke("__arrow_c_array__").to_otuple();
+        if (capsules.size() != 2) {
+          throw TypeError() << "Method __arrow_c_array__() should return a "
+              "tuple of 2 elements";
+        }
+        auto schema = static_cast<ArrowSchema*>(PyCapsule_GetPointer(
+                          capsules[0].to_borrowed_ref(), "arrow_schema"));
+        if (!schema) throw PyError();
+        auto array = static_cast<ArrowArray*>(PyCapsule_GetPointer(
+                         capsules[1].to_borrowed_ref(), "arrow_array"));
+        if (!array) throw PyError();
+        res.reset(dt::arrow::import_array(schema, array));
+      }
+      size_t ncols = res->ncols();
+      check_names_count(ncols);
+      for (size_t i = 0; i < ncols; ++i) {
+        cols.push_back(res->get_column(i));
+      }
+      if (names_arg) {
+        make_datatable(names_arg);
+      } else {
+        make_datatable(res.get());
+      }
+    }
+
+
     void init_from_numpy() {
       if (stypes_arg || stype_arg) {
         throw TypeError() << "Argument `stypes` is not supported in Frame() "
@@ -714,7 +760,7 @@ static PKArgs fn___setstate__(
 
 // TODO: add py::obytes object
 oobj Frame::m__getstate__(const PKArgs&) {
-  Buffer mr = dt->save_jay();
+  Buffer mr = dt->save_jay(jay::Codec_None, 0);
   auto data = static_cast<const char*>(mr.xptr());
   auto size = static_cast<Py_ssize_t>(mr.size());
   return oobj::from_new_reference(PyBytes_FromStringAndSize(data, size));
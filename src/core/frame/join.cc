@@ -19,18 +19,26 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <atomic>       // std::atomic
+#include <cstring>      // std::memcpy
 #include <limits>       // std::numeric_limits
 #include <memory>       // std::unique_ptr
 #include <type_traits>  // std::is_integral
 #include <vector>       // std::vector
+#include "models/murmurhash.h"
 #include "parallel/api.h"
+#include "python/arg.h"
 #include "python/args.h"
+#include "python/int.h"
 #include "python/obj.h"
 #include "python/tuple.h"
 #include "utils/assert.h"
 #include "column.h"
 #include "datatable.h"
 #include "datatablemodule.h"
+#include "ltype.h"
+#include "options.h"
+#include "sort.h"
 #include "stype.h"
 
 
@@ -41,12 +49,16 @@ static comparator_maker cmps[dt::STYPES_COUNT][dt::STYPES_COUNT];
 
 static cmpptr _make_comparatorM(const DataTable& Xdt, const DataTable& Jdt,
                                 const sztvec& x_ind, const sztvec& j_ind);
+static cmpptr _make_comparatorC(const Column& colx, const Column& colj);
 
 static cmpptr _make_comparator1(const DataTable& Xdt, const DataTable& Jdt,
                                 size_t xi, size_t ji)
 {
   const Column& colx = Xdt.get_column(xi);
   const Column& colj = Jdt.get_column(ji);
+  if (colx.ltype() == dt::LType::STRING && colj.get_categorical(nullptr)) {
+    return _make_comparatorC(colx, colj);
+  }
   dt::SType stype1 = colx.stype();
   dt::SType stype2 = colj.stype();
   auto cmp = cmps[static_cast<size_t>(stype1)][static_cast<size_t>(stype2)];
@@ -97,14 +109,25 @@ static cmpptr _make_comparator(const DataTable& Xdt, const DataTable& Jdt,
  *     or 0 depending if the row-value is greater than, less than, or equal
  *     to the value stored.
  *
- * This comparison function is then used as the basis for the binary search
- * algorithm to perform a join between two tables.
+ *   hash_jrow(size_t row) -> uint64_t
+ *     compute the hash of the `row`th value in the J frame.
+ *
+ *   hash_xrow() -> uint64_t
+ *     compute the hash of the value from the X frame stored during the
+ *     previous `set_xrow()` call. The hash is computed after the value was
+ *     converted into the type of the J column, so that any two values for
+ *     which `cmp_jrow()` returns 0 have the same hash.
+ *
+ * These functions are then used as the basis for either the binary search
+ * or the hash lookup algorithm to perform a join between two tables.
  */
 class Cmp {
   public:
     virtual ~Cmp();
     virtual int cmp_jrow(size_t row) const = 0;
     virtual int set_xrow(size_t row) = 0;
+    virtual uint64_t hash_jrow(size_t row) const = 0;
+    virtual uint64_t hash_xrow() const = 0;
 };
 
 Cmp::~Cmp() {}
@@ -124,6 +147,8 @@ class MultiCmp : public Cmp {
              const sztvec& Xindices, const sztvec& Jindices);
     int set_xrow(size_t row) override;
     int cmp_jrow(size_t row) const override;
+    uint64_t hash_jrow(size_t row) const override;
+    uint64_t hash_xrow() const override;
 };
 
 static cmpptr _make_comparatorM(const DataTable& Xdt, const DataTable& Jdt,
@@ -159,6 +184,59 @@ int MultiCmp::cmp_jrow(size_t row) const {
   return 0;
 }
 
+uint64_t MultiCmp::hash_jrow(size_t row) const {
+  uint64_t h = 0;
+  for (const cmpptr& ch : col_cmps) {
+    h = (h ^ ch->hash_jrow(row)) * 0x9E3779B97F4A7C15ULL;
+  }
+  return h;
+}
+
+uint64_t MultiCmp::hash_xrow() const {
+  uint64_t h = 0;
+  for (const cmpptr& ch : col_cmps) {
+    h = (h ^ ch->hash_xrow()) * 0x9E3779B97F4A7C15ULL;
+  }
+  return h;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Hashing of individual values
+//------------------------------------------------------------------------------
+
+// Hash of an NA value, shared by all column types (NAs in the X frame
+// match NAs in the J frame).
+static constexpr uint64_t NA_HASH = 0x5DEECE66DULL;
+
+template <typename T>
+static uint64_t _hash_value(T value) {
+  static_assert(std::is_integral<T>::value, "Wrong type in _hash_value");
+  return fmix64(static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+template <>
+uint64_t _hash_value(float value) {
+  uint32_t bits;
+  value += 0.0f;  // convert -0.0 into +0.0
+  std::memcpy(&bits, &value, sizeof(float));
+  return fmix64(bits);
+}
+
+template <>
+uint64_t _hash_value(double value) {
+  uint64_t bits;
+  value += 0.0;  // convert -0.0 into +0.0
+  std::memcpy(&bits, &value, sizeof(double));
+  return fmix64(bits);
+}
+
+static uint64_t _hash_string(const dt::CString& value) {
+  if (value.isna()) return NA_HASH;
+  return hash_murmur2(value.data(), value.size());
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -180,6 +258,8 @@ class FwCmp : public Cmp {
 
     int cmp_jrow(size_t row) const override;
     int set_xrow(size_t row) override;
+    uint64_t hash_jrow(size_t row) const override;
+    uint64_t hash_xrow() const override;
 };
 
 
@@ -234,6 +314,20 @@ int FwCmp<TX, TJ>::set_xrow(size_t row) {
 }
 
 
+template <typename TX, typename TJ>
+uint64_t FwCmp<TX, TJ>::hash_jrow(size_t row) const {
+  TJ j_value;
+  bool j_valid = colJ.get_element(row, &j_value);
+  return j_valid? _hash_value<TJ>(j_value) : NA_HASH;
+}
+
+
+template <typename TX, typename TJ>
+uint64_t FwCmp<TX, TJ>::hash_xrow() const {
+  return x_valid? _hash_value<TJ>(x_value) : NA_HASH;
+}
+
+
 
 //------------------------------------------------------------------------------
 // String Cmp
@@ -251,6 +345,8 @@ class StringCmp : public Cmp {
 
     int cmp_jrow(size_t row) const override;
     int set_xrow(size_t row) override;
+    uint64_t hash_jrow(size_t row) const override;
+    uint64_t hash_xrow() const override;
 };
 
 
@@ -291,6 +387,132 @@ int StringCmp::set_xrow(size_t row) {
 }
 
 
+uint64_t StringCmp::hash_jrow(size_t row) const {
+  dt::CString j_value;
+  bool j_valid = colJ.get_element(row, &j_value);
+  return j_valid? _hash_string(j_value) : NA_HASH;
+}
+
+
+uint64_t StringCmp::hash_xrow() const {
+  return _hash_string(x_value);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Categorical Cmp
+//------------------------------------------------------------------------------
+
+/**
+ * Comparator used when the J column is dictionary-encoded, and X is a
+ * string column. Each value from X is converted into the code that it
+ * has in J's dictionary, so that the rows of J are compared using their
+ * integer codes only. If X is dictionary-encoded too, then its entire
+ * dictionary is converted once, and the values from X are mapped into
+ * J's codes without any string comparisons at all.
+ */
+class CategoricalCmp : public Cmp {
+  private:
+    static constexpr int32_t NA_CODE = -1;
+    static constexpr int32_t MISSING = -2;  // not present in J's dictionary
+
+    const Column& colX;
+    Column xcodes;
+    Column jcodes;
+    Column jdict;
+    std::vector<int32_t> x2j;  // maps X's dictionary into J's codes
+    int32_t x_value;
+    int : 32;
+
+  public:
+    CategoricalCmp(const Column&, const Column&);
+
+    int cmp_jrow(size_t row) const override;
+    int set_xrow(size_t row) override;
+    uint64_t hash_jrow(size_t row) const override;
+    uint64_t hash_xrow() const override;
+
+  private:
+    int32_t find_in_jdict(const dt::CString& value) const;
+};
+
+static cmpptr _make_comparatorC(const Column& colx, const Column& colj) {
+  return cmpptr(new CategoricalCmp(colx, colj));
+}
+
+
+CategoricalCmp::CategoricalCmp(const Column& xcol, const Column& jcol)
+  : colX(xcol), x_value(NA_CODE)
+{
+  bool ok = jcol.get_categorical(&jcodes, &jdict);
+  xassert(ok); (void) ok;
+  jcodes.cast_inplace(dt::SType::INT32);
+  Column xdict;
+  if (xcol.get_categorical(&xcodes, &xdict)) {
+    xcodes.cast_inplace(dt::SType::INT32);
+    size_t n = xdict.nrows();
+    x2j.resize(n);
+    dt::CString value;
+    for (size_t i = 0; i < n; ++i) {
+      xdict.get_element(i, &value);
+      x2j[i] = find_in_jdict(value);
+    }
+  }
+}
+
+
+int32_t CategoricalCmp::find_in_jdict(const dt::CString& value) const {
+  size_t lo = 0, hi = jdict.nrows();
+  dt::CString dvalue;
+  while (lo < hi) {
+    size_t mid = (lo + hi) >> 1;
+    jdict.get_element(mid, &dvalue);
+    if (dvalue < value) lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo < jdict.nrows()) {
+    jdict.get_element(lo, &dvalue);
+    if (dvalue == value) return static_cast<int32_t>(lo);
+  }
+  return MISSING;
+}
+
+
+int CategoricalCmp::set_xrow(size_t row) {
+  if (xcodes) {
+    int32_t code;
+    bool valid = xcodes.get_element(row, &code);
+    x_value = valid? x2j[static_cast<size_t>(code)] : NA_CODE;
+  } else {
+    dt::CString value;
+    bool valid = colX.get_element(row, &value);
+    x_value = valid? find_in_jdict(value) : NA_CODE;
+  }
+  return (x_value == MISSING)? -1 : 0;
+}
+
+
+int CategoricalCmp::cmp_jrow(size_t row) const {
+  int32_t j_value;
+  bool j_valid = jcodes.get_element(row, &j_value);
+  if (!j_valid) j_value = NA_CODE;
+  return (j_value > x_value) - (j_value < x_value);
+}
+
+
+uint64_t CategoricalCmp::hash_jrow(size_t row) const {
+  int32_t j_value;
+  bool j_valid = jcodes.get_element(row, &j_value);
+  return j_valid? _hash_value(j_value) : NA_HASH;
+}
+
+
+uint64_t CategoricalCmp::hash_xrow() const {
+  return (x_value == NA_CODE)? NA_HASH : _hash_value(x_value);
+}
+
+
 
 //------------------------------------------------------------------------------
 // Comparators for different stypes
@@ -368,6 +590,32 @@ static void _init_comparators() {
 
 
 
+//------------------------------------------------------------------------------
+// Join options
+//------------------------------------------------------------------------------
+
+static const char* doc_join_hash_threshold =
+R"(
+Internal
+)";
+
+static size_t join_hash_threshold = 1 << 16;
+
+void join_init_options() {
+  dt::register_option(
+    "join.hash_threshold",
+    []{ return py::oint(join_hash_threshold); },
+    [](const py::Arg& value) {
+      int64_t n = value.to_int64_strict();
+      if (n < 0) n = 0;
+      join_hash_threshold = static_cast<size_t>(n);
+    },
+    doc_join_hash_threshold
+  );
+}
+
+
+
 //------------------------------------------------------------------------------
 // Join functionality
 //------------------------------------------------------------------------------
@@ -391,9 +639,246 @@ static size_t binsearch(Cmp* cmp, size_t nrows) {
 }
 
 
+static void _binsearch_join(const DataTable& xdt, const DataTable& jdt,
+                            const sztvec& xcols, const sztvec& jcols,
+                            size_t nchunks, int32_t* result_indices)
+{
+  dt::parallel_region(dt::NThreads(nchunks),
+    [&] {
+      // Creating the comparator may fail if xcols and jcols are incompatible
+      cmpptr comparator = _make_comparator(xdt, jdt, xcols, jcols);
+
+      dt::nested_for_static(xdt.nrows(),
+        [&](size_t i) {
+          int r = comparator->set_xrow(i);
+          if (r == 0) {
+            size_t j = binsearch(comparator.get(), jdt.nrows());
+            result_indices[i] = static_cast<int32_t>(j);
+          } else {
+            result_indices[i] = RowIndex::NA<int32_t>;
+          }
+        });
+    });
+}
 
-// declared in datatable.h
-RowIndex natural_join(const DataTable& xdt, const DataTable& jdt) {
+
+/**
+ * Join via a hash table built over the rows of the J frame.
+ *
+ * The table uses open addressing with linear probing, and its size is a
+ * power of 2 that is at least twice the number of rows in J. Each slot
+ * stores a 64-bit value whose lower half is the J row index, and the upper
+ * half is the upper 32 bits of that row's hash. The "tag" allows us to skip
+ * most of the `cmp_jrow()` calls on collisions. An empty slot is marked
+ * with `EMPTY` (i.e. row index -1).
+ *
+ * The table is filled in parallel using compare-and-swap on the slots, after
+ * which the rows of X are looked up in parallel too. Since the J frame is
+ * keyed, all its rows are distinct and there can be at most one match for
+ * every row in X.
+ */
+static void _hash_join(const DataTable& xdt, const DataTable& jdt,
+                       const sztvec& xcols, const sztvec& jcols,
+                       size_t nchunks, int32_t* result_indices)
+{
+  constexpr uint64_t EMPTY = uint64_t(-1);
+  size_t jrows = jdt.nrows();
+  size_t nslots = 16;
+  while (nslots < 2 * jrows) nslots <<= 1;
+  size_t mask = nslots - 1;
+
+  std::unique_ptr<std::atomic<uint64_t>[]> slots(
+      new std::atomic<uint64_t>[nslots]);
+  dt::parallel_for_static(nslots,
+    [&](size_t i) {
+      slots[i].store(EMPTY, std::memory_order_relaxed);
+    });
+
+  size_t nthreads = std::min(std::max(jrows / 200, size_t(1)),
+                             dt::num_threads_in_pool());
+  dt::parallel_region(dt::NThreads(nthreads),
+    [&] {
+      cmpptr comparator = _make_comparator(xdt, jdt, xcols, jcols);
+      dt::nested_for_static(jrows,
+        [&](size_t j) {
+          uint64_t h = comparator->hash_jrow(j);
+          uint64_t value = (h & 0xFFFFFFFF00000000ULL) | j;
+          size_t k = static_cast<size_t>(h) & mask;
+          while (true) {
+            uint64_t expected = EMPTY;
+            if (slots[k].compare_exchange_strong(expected, value,
+                                                 std::memory_order_relaxed)) {
+              break;
+            }
+            k = (k + 1) & mask;
+          }
+        });
+    });
+
+  dt::parallel_region(dt::NThreads(nchunks),
+    [&] {
+      cmpptr comparator = _make_comparator(xdt, jdt, xcols, jcols);
+      dt::nested_for_static(xdt.nrows(),
+        [&](size_t i) {
+          int32_t res = RowIndex::NA<int32_t>;
+          if (comparator->set_xrow(i) == 0) {
+            uint64_t h = comparator->hash_xrow();
+            uint64_t tag = h & 0xFFFFFFFF00000000ULL;
+            size_t k = static_cast<size_t>(h) & mask;
+            while (true) {
+              uint64_t value = slots[k].load(std::memory_order_relaxed);
+              if (value == EMPTY) break;
+              if ((value & 0xFFFFFFFF00000000ULL) == tag) {
+                size_t j = static_cast<size_t>(value & 0xFFFFFFFFULL);
+                if (comparator->cmp_jrow(j) == 0) {
+                  res = static_cast<int32_t>(j);
+                  break;
+                }
+              }
+              k = (k + 1) & mask;
+            }
+          }
+          result_indices[i] = res;
+        });
+    });
+}
+
+
+/**
+ * Find the first row `j` in `[start; n)` such that J[j] >= x, where x is
+ * the value stored in the comparator, assuming that J[j] < x for all
+ * `j < start`. The search "gallops" from `start` with exponentially
+ * increasing steps, and then finishes with a binary search. Thus, its
+ * cost is logarithmic in the distance between `start` and the result.
+ */
+static size_t _gallop_lower_bound(Cmp* cmp, size_t start, size_t n) {
+  size_t lo = start;
+  size_t hi = start;
+  size_t step = 1;
+  while (hi < n && cmp->cmp_jrow(hi) < 0) {
+    lo = hi + 1;
+    hi = lo + step;
+    step <<= 1;
+  }
+  if (hi > n) hi = n;
+  while (lo < hi) {
+    size_t mid = (lo + hi) >> 1;
+    if (cmp->cmp_jrow(mid) < 0) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+
+/**
+ * Merge join, used when X is sorted by the join columns (J is always
+ * sorted, since it is keyed).
+ *
+ * The rows of X are split into contiguous chunks, one per thread. Since
+ * X is sorted, each chunk covers a distinct range of key values. Each
+ * thread locates the start of its range in J, and then walks both
+ * frames in lockstep, advancing in J via galloping search. The result is
+ * that both X and J are scanned sequentially, and each thread only
+ * touches the part of J that corresponds to its key range.
+ *
+ * If a row of X turns out to be out of order, this function falls back
+ * to a search over the entire J for that row, so the result is correct
+ * regardless of the order of X.
+ */
+static void _merge_join(const DataTable& xdt, const DataTable& jdt,
+                        const sztvec& xcols, const sztvec& jcols,
+                        size_t nchunks, int32_t* result_indices)
+{
+  size_t xrows = xdt.nrows();
+  size_t jrows = jdt.nrows();
+  dt::parallel_region(dt::NThreads(nchunks),
+    [&] {
+      cmpptr comparator = _make_comparator(xdt, jdt, xcols, jcols);
+      Cmp* cmp = comparator.get();
+      size_t ith = dt::this_thread_index();
+      size_t nth = dt::num_threads_in_team();
+      size_t i0 = xrows * ith / nth;
+      size_t i1 = xrows * (ith + 1) / nth;
+      size_t jpos = 0;  // lower bound for the previous value from X
+      for (size_t i = i0; i < i1; ++i) {
+        int32_t res = RowIndex::NA<int32_t>;
+        if (cmp->set_xrow(i) == 0) {
+          if (jpos > 0 && cmp->cmp_jrow(jpos - 1) >= 0) jpos = 0;
+          jpos = _gallop_lower_bound(cmp, jpos, jrows);
+          if (jpos < jrows && cmp->cmp_jrow(jpos) == 0) {
+            res = static_cast<int32_t>(jpos);
+          }
+        }
+        result_indices[i] = res;
+      }
+    });
+}
+
+
+/**
+ * Check whether X is sorted by the columns `xcols`, in the same order
+ * that is used for keys. This is trivially true if X is keyed by these
+ * columns, otherwise the rows of X are compared pairwise in parallel,
+ * stopping as soon as any unsorted pair is found.
+ */
+static bool _is_sorted(const DataTable& xdt, const sztvec& xcols) {
+  size_t xrows = xdt.nrows();
+  if (xrows <= 1) return true;
+  if (xdt.nkeys() >= xcols.size()) {
+    bool keyed = true;
+    for (size_t i = 0; i < xcols.size(); ++i) {
+      keyed = keyed && (xcols[i] == i);
+    }
+    if (keyed) return true;
+  }
+  size_t nchunks = std::min(std::max(xrows / 1000, size_t(1)),
+                            dt::num_threads_in_pool());
+  std::atomic<bool> sorted { true };
+  dt::parallel_region(dt::NThreads(nchunks),
+    [&] {
+      // Compare X with itself: set_xrow(i) / cmp_jrow(i-1)
+      cmpptr cmp = _make_comparator(xdt, xdt, xcols, xcols);
+      size_t ith = dt::this_thread_index();
+      size_t nth = dt::num_threads_in_team();
+      size_t i0 = std::max(xrows * ith / nth, size_t(1));
+      size_t i1 = xrows * (ith + 1) / nth;
+      for (size_t i = i0; i < i1; ++i) {
+        if ((i & 1023) == 0 && !sorted.load(std::memory_order_relaxed)) break;
+        cmp->set_xrow(i);
+        if (cmp->cmp_jrow(i - 1) > 0) {
+          sorted.store(false, std::memory_order_relaxed);
+          break;
+        }
+      }
+    });
+  return sorted.load();
+}
+
+
+/**
+ * The hash join is used when J is too large to comfortably fit in cache
+ * (as controlled by option `join.hash_threshold`), and when there are
+ * enough rows in X to amortize the cost of building the hash table: each
+ * binary search costs ~log2(nrows(J)) random accesses into J, whereas the
+ * hash table requires a single pass over J plus ~1 access per row of X.
+ */
+static bool _use_hash_join(size_t xrows, size_t jrows) {
+  if (jrows < join_hash_threshold) return false;
+  size_t log2j = 0;
+  while ((size_t(1) << log2j) < jrows) log2j++;
+  return xrows * log2j >= 2 * jrows;
+}
+
+
+
+/**
+ * Find the matching row in J for every row in X, writing the results into
+ * array `result_indices` of length `nrows(X)`. Rows that have no match are
+ * marked with NA.
+ */
+static void _find_matches(const DataTable& xdt, const DataTable& jdt,
+                          int32_t* result_indices)
+{
   size_t k = jdt.nkeys();  // Number of join columns
   xassert(k > 0);
 
@@ -410,40 +895,330 @@ RowIndex natural_join(const DataTable& xdt, const DataTable& jdt) {
     jcols.push_back(i);
   }
 
-  Buffer result_buf = Buffer::mem(xdt.nrows() * sizeof(int32_t));
-  if (xdt.nrows()) {
-    auto result_indices = static_cast<int32_t*>(result_buf.xptr());
-    size_t nchunks = std::min(std::max(xdt.nrows() / 200, size_t(1)),
-                              dt::num_threads_in_pool());
-    xassert(nchunks);
-
-    if (jdt.nrows() == 0) {
-      dt::parallel_for_static(xdt.nrows(),
-        [&](size_t i) {
-          result_indices[i] = RowIndex::NA<int32_t>;
-        });
+  if (xdt.nrows() == 0) return;
+  size_t nchunks = std::min(std::max(xdt.nrows() / 200, size_t(1)),
+                            dt::num_threads_in_pool());
+  xassert(nchunks);
+
+  if (jdt.nrows() == 0) {
+    dt::parallel_for_static(xdt.nrows(),
+      [&](size_t i) {
+        result_indices[i] = RowIndex::NA<int32_t>;
+      });
+  }
+  else {
+    // Verify that the join columns have compatible types before checking
+    // the sortedness of X, which uses an X-vs-X comparator.
+    _make_comparator(xdt, jdt, xcols, jcols);
+    if (_is_sorted(xdt, xcols)) {
+      _merge_join(xdt, jdt, xcols, jcols, nchunks, result_indices);
+    }
+    else if (_use_hash_join(xdt.nrows(), jdt.nrows())) {
+      _hash_join(xdt, jdt, xcols, jcols, nchunks, result_indices);
     }
     else {
-      dt::parallel_region(dt::NThreads(nchunks),
-        [&] {
-          // Creating the comparator may fail if xcols and jcols are incompatible
-          cmpptr comparator = _make_comparator(xdt, jdt, xcols, jcols);
+      _binsearch_join(xdt, jdt, xcols, jcols, nchunks, result_indices);
+    }
+  }
+}
+
+
+// declared in datatable.h
+RowIndex natural_join(const DataTable& xdt, const DataTable& jdt) {
+  Buffer result_buf = Buffer::mem(xdt.nrows() * sizeof(int32_t));
+  _find_matches(xdt, jdt, static_cast<int32_t*>(result_buf.wptr()));
+  return RowIndex(std::move(result_buf), RowIndex::ARR32);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Join kinds
+//------------------------------------------------------------------------------
+
+/**
+ * Helper for expanding a set of rows in parallel: every `i` in `[0; n)`
+ * produces `count(i)` output elements (possibly 0), and these elements are
+ * written by calling `emit(k, i)`, where `k` is the offset of the first
+ * element produced by `i` within the output.
+ *
+ * The expansion is done in two passes: first each chunk of rows counts
+ * how many elements it will emit, and then, after the offsets of all
+ * chunks are known, the chunks emit their elements in parallel. This
+ * allows the caller to allocate the output exactly once, via the
+ * `alloc(total)` callback which is invoked between the two passes.
+ */
+template <typename FCount, typename FAlloc, typename FEmit>
+static void _expand_rows(size_t n, FCount count, FAlloc alloc, FEmit emit) {
+  size_t nchunks = std::min(std::max(n / 1000, size_t(1)),
+                            4 * dt::num_threads_in_pool());
+  sztvec offsets(nchunks + 1, 0);
+  dt::parallel_for_dynamic(nchunks,
+    [&](size_t ichunk) {
+      size_t i0 = n * ichunk / nchunks;
+      size_t i1 = n * (ichunk + 1) / nchunks;
+      size_t total = 0;
+      for (size_t i = i0; i < i1; ++i) {
+        total += static_cast<size_t>(count(i));
+      }
+      offsets[ichunk + 1] = total;
+    });
+  for (size_t i = 1; i <= nchunks; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  alloc(offsets[nchunks]);
+  dt::parallel_for_dynamic(nchunks,
+    [&](size_t ichunk) {
+      size_t i0 = n * ichunk / nchunks;
+      size_t i1 = n * (ichunk + 1) / nchunks;
+      size_t k = offsets[ichunk];
+      for (size_t i = i0; i < i1; ++i) {
+        size_t c = static_cast<size_t>(count(i));
+        if (c) emit(k, i);
+        k += c;
+      }
+    });
+}
 
-          dt::nested_for_static(xdt.nrows(),
+
+// declared in datatable.h
+JoinResult natural_join(const DataTable& xdt, const DataTable& jdt,
+                        JoinKind kind)
+{
+  size_t xrows = xdt.nrows();
+  Buffer matches_buf = Buffer::mem(xrows * sizeof(int32_t));
+  _find_matches(xdt, jdt, static_cast<int32_t*>(matches_buf.wptr()));
+  const int32_t* matches = static_cast<const int32_t*>(matches_buf.rptr());
+  constexpr int32_t NA = RowIndex::NA<int32_t>;
+
+  if (kind == JoinKind::LEFT) {
+    return JoinResult(RowIndex(),
+                      RowIndex(std::move(matches_buf), RowIndex::ARR32));
+  }
+
+  // For the RIGHT and OUTER joins, the rows from J that were not matched
+  // by any row in X are appended at the end of the result.
+  bool add_unmatched = (kind == JoinKind::RIGHT || kind == JoinKind::OUTER);
+  std::unique_ptr<std::atomic<bool>[]> jmatched;
+  size_t jrows = jdt.nrows();
+  if (add_unmatched) {
+    jmatched.reset(new std::atomic<bool>[jrows]);
+    dt::parallel_for_static(jrows,
+      [&](size_t j) {
+        jmatched[j].store(false, std::memory_order_relaxed);
+      });
+    dt::parallel_for_static(xrows,
+      [&](size_t i) {
+        if (matches[i] != NA) {
+          size_t j = static_cast<size_t>(matches[i]);
+          jmatched[j].store(true, std::memory_order_relaxed);
+        }
+      });
+  }
+
+  // Rows from X that are present in the output
+  bool keep_all_x = (kind == JoinKind::OUTER);
+  bool keep_matched = (kind != JoinKind::ANTI);
+  Buffer xbuf, jbuf;
+  int32_t* xindices = nullptr;
+  int32_t* jindices = nullptr;
+  size_t nx = xrows;
+  if (keep_all_x) {
+    xbuf = Buffer::mem(xrows * sizeof(int32_t));
+    jbuf = std::move(matches_buf);
+  } else {
+    _expand_rows(xrows,
+      [&](size_t i) { return (matches[i] != NA) == keep_matched; },
+      [&](size_t count) {
+        nx = count;
+        xbuf = Buffer::mem(count * sizeof(int32_t));
+        jbuf = Buffer::mem(count * sizeof(int32_t));
+        xindices = static_cast<int32_t*>(xbuf.xptr());
+        jindices = static_cast<int32_t*>(jbuf.xptr());
+      },
+      [&](size_t k, size_t i) {
+        xindices[k] = static_cast<int32_t>(i);
+        jindices[k] = matches[i];
+      });
+  }
+
+  if (add_unmatched) {
+    size_t nj = 0;
+    _expand_rows(jrows,
+      [&](size_t j) { return !jmatched[j].load(std::memory_order_relaxed); },
+      [&](size_t count) {
+        nj = count;
+        xbuf.resize((nx + nj) * sizeof(int32_t));
+        jbuf.resize((nx + nj) * sizeof(int32_t));
+        xindices = static_cast<int32_t*>(xbuf.xptr());
+        jindices = static_cast<int32_t*>(jbuf.xptr());
+        if (keep_all_x) {
+          dt::parallel_for_static(nx,
             [&](size_t i) {
-              int r = comparator->set_xrow(i);
-              if (r == 0) {
-                size_t j = binsearch(comparator.get(), jdt.nrows());
-                result_indices[i] = static_cast<int32_t>(j);
-              } else {
-                result_indices[i] = RowIndex::NA<int32_t>;
-              }
+              xindices[i] = static_cast<int32_t>(i);
             });
-        });
-    }
+        }
+      },
+      [&](size_t k, size_t j) {
+        xindices[nx + k] = NA;
+        jindices[nx + k] = static_cast<int32_t>(j);
+      });
   }
 
-  return RowIndex(std::move(result_buf), RowIndex::ARR32);
+  RowIndex xri(std::move(xbuf), RowIndex::ARR32 |
+                                (add_unmatched? 0 : RowIndex::SORTED));
+  // Note: for ANTI join all entries in `jbuf` are NAs
+  RowIndex jri(std::move(jbuf), RowIndex::ARR32);
+  return JoinResult(std::move(xri), std::move(jri));
+}
+
+
+
+/**
+ * Join on columns `jcols` of J, whose values need not be unique. Every
+ * row of X produces as many rows in the output as there are matching rows
+ * in J (i.e. this is a many-to-many join).
+ *
+ * First, J is grouped by the join columns, and a keyed frame of unique
+ * join values (one row per group) is created. The rows of X are matched
+ * against this frame, producing the group index for every row of X. Then
+ * the output is computed in two passes: the number of output rows for
+ * each row of X is counted first, and then the output rowindices are
+ * allocated and filled in parallel.
+ *
+ * For RIGHT and OUTER joins, the rows of J that were not matched are
+ * appended at the end, in the order of their join values.
+ */
+JoinResult natural_join(const DataTable& xdt, const DataTable& jdt,
+                        const sztvec& jcols, JoinKind kind)
+{
+  size_t k = jcols.size();
+  xassert(k > 0);
+  size_t xrows = xdt.nrows();
+  size_t jrows = jdt.nrows();
+  constexpr int32_t NA = RowIndex::NA<int32_t>;
+
+  // Group J by the join columns
+  std::vector<Column> gcols;
+  strvec gnames;
+  for (size_t j : jcols) {
+    gcols.push_back(jdt.get_column(j));
+    gnames.push_back(jdt.get_names()[j]);
+  }
+  RiGb rigb = group(gcols, std::vector<SortFlag>(k, SortFlag::NONE));
+  size_t ngroups = jrows? rigb.second.size() : 0;
+  const int32_t* goffsets = rigb.second.offsets_r();
+  // Ordering of J's rows, such that each group forms a contiguous range
+  Buffer jorder_buf;
+  const int32_t* jorder = rigb.first.indices32();
+  if (!rigb.first.isarr32()) {
+    jorder_buf = Buffer::mem(jrows * sizeof(int32_t));
+    rigb.first.extract_into(jorder_buf, RowIndex::ARR32);
+    jorder = static_cast<const int32_t*>(jorder_buf.rptr());
+  }
+
+  // Frame of unique join values, sorted, i.e. suitable as a key
+  Buffer firsts_buf = Buffer::mem(ngroups * sizeof(int32_t));
+  int32_t* firsts = static_cast<int32_t*>(firsts_buf.xptr());
+  for (size_t g = 0; g < ngroups; ++g) {
+    firsts[g] = jorder[goffsets[g]];
+  }
+  RowIndex firsts_ri(std::move(firsts_buf), RowIndex::ARR32);
+  for (Column& col : gcols) {
+    col.apply_rowindex(firsts_ri);
+  }
+  DataTable keysdt(std::move(gcols), gnames);
+  keysdt.set_nkeys_unsafe(k);
+
+  Buffer matches_buf = Buffer::mem(xrows * sizeof(int32_t));
+  _find_matches(xdt, keysdt, static_cast<int32_t*>(matches_buf.wptr()));
+  const int32_t* matches = static_cast<const int32_t*>(matches_buf.rptr());
+
+  auto group_size = [&](int32_t g) -> size_t {
+    return static_cast<size_t>(goffsets[g + 1] - goffsets[g]);
+  };
+  bool keep_unmatched_x = (kind == JoinKind::LEFT || kind == JoinKind::OUTER ||
+                           kind == JoinKind::ANTI);
+  bool expand_matched = (kind == JoinKind::LEFT || kind == JoinKind::INNER ||
+                         kind == JoinKind::RIGHT || kind == JoinKind::OUTER);
+  bool keep_matched = (kind != JoinKind::ANTI);
+  bool add_unmatched = (kind == JoinKind::RIGHT || kind == JoinKind::OUTER);
+
+  Buffer xbuf, jbuf;
+  int32_t* xindices = nullptr;
+  int32_t* jindices = nullptr;
+  size_t nx = 0;
+  _expand_rows(xrows,
+    [&](size_t i) -> size_t {
+      int32_t g = matches[i];
+      if (g == NA) return keep_unmatched_x;
+      if (!keep_matched) return 0;
+      return expand_matched? group_size(g) : 1;
+    },
+    [&](size_t total) {
+      nx = total;
+      xbuf = Buffer::mem(total * sizeof(int32_t));
+      jbuf = Buffer::mem(total * sizeof(int32_t));
+      xindices = static_cast<int32_t*>(xbuf.xptr());
+      jindices = static_cast<int32_t*>(jbuf.xptr());
+    },
+    [&](size_t k0, size_t i) {
+      int32_t g = matches[i];
+      if (g == NA) {
+        xindices[k0] = static_cast<int32_t>(i);
+        jindices[k0] = NA;
+      }
+      else if (expand_matched) {
+        for (int32_t r = goffsets[g]; r < goffsets[g + 1]; ++r) {
+          xindices[k0] = static_cast<int32_t>(i);
+          jindices[k0] = jorder[r];
+          k0++;
+        }
+      }
+      else {
+        xindices[k0] = static_cast<int32_t>(i);
+        jindices[k0] = jorder[goffsets[g]];
+      }
+    });
+
+  if (add_unmatched) {
+    std::unique_ptr<std::atomic<bool>[]> gmatched(
+        new std::atomic<bool>[ngroups]);
+    dt::parallel_for_static(ngroups,
+      [&](size_t g) {
+        gmatched[g].store(false, std::memory_order_relaxed);
+      });
+    dt::parallel_for_static(xrows,
+      [&](size_t i) {
+        if (matches[i] != NA) {
+          size_t g = static_cast<size_t>(matches[i]);
+          gmatched[g].store(true, std::memory_order_relaxed);
+        }
+      });
+    _expand_rows(ngroups,
+      [&](size_t g) -> size_t {
+        bool matched = gmatched[g].load(std::memory_order_relaxed);
+        return matched? 0 : group_size(static_cast<int32_t>(g));
+      },
+      [&](size_t total) {
+        xbuf.resize((nx + total) * sizeof(int32_t));
+        jbuf.resize((nx + total) * sizeof(int32_t));
+        xindices = static_cast<int32_t*>(xbuf.xptr());
+        jindices = static_cast<int32_t*>(jbuf.xptr());
+      },
+      [&](size_t k0, size_t g) {
+        for (int32_t r = goffsets[g]; r < goffsets[g + 1]; ++r) {
+          xindices[nx + k0] = NA;
+          jindices[nx + k0] = jorder[r];
+          k0++;
+        }
+      });
+  }
+
+  RowIndex xri(std::move(xbuf), RowIndex::ARR32 |
+                                (add_unmatched? 0 : RowIndex::SORTED));
+  RowIndex jri(std::move(jbuf), RowIndex::ARR32);
+  return JoinResult(std::move(xri), std::move(jri));
 }
 
 
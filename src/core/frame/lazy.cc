@@ -0,0 +1,367 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+//
+// This file implements `Frame.lazy()`, which returns a LazyFrame: an
+// object that records a chain of `[i, j, by(), sort(), join()]`
+// selectors without evaluating them,
+//
+//     LF = DT.lazy()[f.A > 0, :][f.B < 5, :][:, [f.C, f.D]]
+//
+// and then evaluates the whole chain in `LF.to_frame()`. Before the
+// evaluation, the adjacent steps are merged into a single `DT[...]`
+// call whenever the result is guaranteed to be the same. For the
+// example above, the chain is evaluated within a single EvalContext,
+// where the condition `f.B < 5` is applied to the rows selected by
+// `f.A > 0`, and then `j` is computed. Thus no intermediate frames
+// are created, and only the columns that are referenced by the
+// expressions are ever read -- which for a memory-mapped Jay file
+// means that the other columns are never loaded from disk.
+//
+// The merging rules are (here `c` denotes a row-wise condition, see
+// `QueryPlan::is_rowwise_condition()`):
+//
+//   [i, :][:, j]             ->  [i, j]
+//   [i, :][c, j]             ->  [i, j], with the condition `c`
+//                                applied after `i`
+//   [:, :, sort(s)][k, j]    ->  [k, j, sort(s)]
+//
+// where in the last rule `k` is an integer or a slice. In particular,
+// `[:, :, sort(s)][:k, :]` becomes the top-k query `[:k, :, sort(s)]`.
+// All other steps are evaluated one after another.
+//
+//------------------------------------------------------------------------------
+#include <vector>
+#include "expr/declarations.h"
+#include "expr/fexpr.h"
+#include "expr/py_by.h"         // py::oby
+#include "expr/py_join.h"       // py::ojoin
+#include "expr/py_sort.h"       // py::osort
+#include "expr/query_plan.h"
+#include "frame/py_frame.h"
+#include "python/_all.h"
+#include "python/string.h"
+#include "python/xobject.h"
+#include "utils/assert.h"
+namespace py {
+
+
+//------------------------------------------------------------------------------
+// Planning
+//------------------------------------------------------------------------------
+
+struct LazyStep {
+  oobj i;
+  oobj j;
+  std::vector<oobj> extras;
+  std::vector<oobj> filters;  // row-wise conditions applied after `i`
+  bool has_by;
+  bool has_sort;
+  bool has_join;
+  bool has_other;
+  size_t : 32;
+
+  explicit LazyStep(rtuple targs)
+    : i(targs[0]), j(targs[1]),
+      has_by(false), has_sort(false), has_join(false), has_other(false)
+  {
+    for (size_t k = 2; k < targs.size(); ++k) {
+      robj arg = targs[k];
+      extras.push_back(oobj(arg));
+      if (arg.is_none()) continue;
+      if (arg.to_oby_lax()) has_by = true;
+      else if (arg.to_osort_lax()) has_sort = true;
+      else if (arg.to_ojoin_lax()) has_join = true;
+      else has_other = true;
+    }
+  }
+
+  bool has_extras() const {
+    return has_by || has_sort || has_join || has_other;
+  }
+
+  // `[i, :]`: a step that only selects rows
+  bool is_row_filter() const {
+    return !has_extras() && is_all(j);
+  }
+
+  // `[:, :, sort(s)]`
+  bool is_sort_only() const {
+    return has_sort && !has_by && !has_join && !has_other &&
+           is_all(i) && is_all(j) && filters.empty();
+  }
+
+  otuple to_tuple() const {
+    otuple res(2 + extras.size());
+    res.set(0, i);
+    res.set(1, j);
+    for (size_t k = 0; k < extras.size(); ++k) {
+      res.set(2 + k, extras[k]);
+    }
+    return res;
+  }
+
+  static bool is_all(const oobj& x) {
+    return x.is_none() || (x.is_slice() && x.to_oslice().is_trivial());
+  }
+
+  static bool is_rowwise_condition(const oobj& x) {
+    if (!x.is_fexpr() && !x.is_dtexpr()) return false;
+    auto expr = dt::expr::as_fexpr(x);
+    return dt::expr::QueryPlan::is_rowwise_condition(expr.get());
+  }
+};
+
+
+// Try to merge step `next` into the step `acc`, which precedes it
+// in the chain. Returns false if the steps must be evaluated
+// separately.
+//
+// A row filter cannot be merged into the steps with by(), sort() or
+// join(): in the first two cases the filter would be applied within
+// each group, and in the latter it would also see the rows added
+// by an outer join.
+//
+static bool merge_steps(LazyStep& acc, const LazyStep& next) {
+  if (acc.is_row_filter()) {
+    if (next.has_extras()) return false;
+    if (LazyStep::is_all(next.i)) {
+      acc.j = next.j;
+      return true;
+    }
+    if (LazyStep::is_rowwise_condition(next.i)) {
+      acc.filters.push_back(next.i);
+      acc.j = next.j;
+      return true;
+    }
+    return false;
+  }
+  if (acc.is_sort_only()) {
+    if (next.has_extras()) return false;
+    if (LazyStep::is_all(next.i) || next.i.is_int() || next.i.is_slice()) {
+      acc.i = next.i;
+      acc.j = next.j;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static std::vector<LazyStep> make_plan(const otuple& steps) {
+  std::vector<LazyStep> plan;
+  for (size_t k = 0; k < steps.size(); ++k) {
+    LazyStep step(steps[k].to_rtuple_lax());
+    if (step.is_row_filter() && LazyStep::is_all(step.i)) continue;
+    if (plan.empty() || !merge_steps(plan.back(), step)) {
+      plan.push_back(std::move(step));
+    }
+  }
+  return plan;
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// LazyFrame
+//------------------------------------------------------------------------------
+
+class LazyFrame : public XObject<LazyFrame>
+{
+  private:
+    oobj frame_;
+    otuple steps_;
+
+    void m__init__(const PKArgs& args) {
+      frame_ = args[0].to_oobj();
+      steps_ = args[1].to_otuple();
+    }
+
+    void m__dealloc__() {
+      frame_ = nullptr;
+      steps_ = otuple();
+    }
+
+    oobj m__getitem__(robj item) {
+      rtuple targs = item.to_rtuple_lax();
+      if (!targs) {
+        return m__getitem__(otuple({py::None(), item}));
+      }
+      if (targs.size() <= 1) {
+        throw ValueError() << "Invalid tuple of size " << targs.size()
+            << " used as a frame selector";
+      }
+      size_t n = steps_.size();
+      otuple newsteps(n + 1);
+      for (size_t k = 0; k < n; ++k) {
+        newsteps.set(k, steps_[k]);
+      }
+      newsteps.set(n, item);
+      return LazyFrame::make(frame_, newsteps);
+    }
+
+    oobj m__repr__() const {
+      return ostring("<LazyFrame: " + std::to_string(steps_.size()) +
+                     " step" + (steps_.size() == 1? "" : "s") + ">");
+    }
+
+    oobj to_frame(const PKArgs&) {
+      oobj res = frame_;
+      for (const LazyStep& step : make_plan(steps_)) {
+        otuple targs = step.to_tuple();
+        auto frame = reinterpret_cast<Frame*>(res.to_borrowed_ref());
+        res = frame->_eval_query(targs.to_rtuple_lax(),
+                                 robj(reinterpret_cast<PyObject*>(-1)),
+                                 step.filters);
+      }
+      if (res.to_borrowed_ref() == frame_.to_borrowed_ref()) {
+        res = Frame::oframe(new DataTable(*frame_.to_datatable()));
+      }
+      return res;
+    }
+
+    oobj explain(const PKArgs&) {
+      std::string out;
+      for (const LazyStep& step : make_plan(steps_)) {
+        otuple targs = step.to_tuple();
+        out += "DT[";
+        for (size_t k = 0; k < targs.size(); ++k) {
+          if (k) out += ", ";
+          out += targs[k].repr().to_string();
+          if (k == 0) {
+            for (const oobj& filter : step.filters) {
+              out += " then " + filter.repr().to_string();
+            }
+          }
+        }
+        out += "]\n";
+      }
+      return ostring(out);
+    }
+
+  public:
+    static void impl_init_type(XTypeMaker& xt);
+};
+
+
+static const char* doc_LazyFrame_to_frame =
+R"(to_frame(self)
+--
+
+Evaluate the recorded chain of selectors, and return the resulting
+Frame.
+
+The adjacent selectors in the chain are combined into a single
+``DT[i, j, ...]`` call whenever this gives the same result, and
+the remaining ones are evaluated one after another.
+
+return: Frame
+    Same as the result of applying all the selectors to the frame
+    one after another.
+)";
+
+static const char* doc_LazyFrame_explain =
+R"(explain(self)
+--
+
+Return the string with the selectors that :meth:`.to_frame()`
+will evaluate, one per line, after all the possible selectors
+have been combined.
+)";
+
+static PKArgs args_LazyFrame_to_frame(
+    0, 0, 0, false, false, {}, "to_frame", doc_LazyFrame_to_frame);
+
+static PKArgs args_LazyFrame_explain(
+    0, 0, 0, false, false, {}, "explain", doc_LazyFrame_explain);
+
+
+void LazyFrame::impl_init_type(XTypeMaker& xt) {
+  xt.set_class_name("datatable.LazyFrame");
+
+  static PKArgs args_init(2, 0, 0, false, false, {"frame", "steps"},
+                          "__init__", nullptr);
+  xt.add(CONSTRUCTOR(&LazyFrame::m__init__, args_init));
+  xt.add(DESTRUCTOR(&LazyFrame::m__dealloc__));
+  xt.add(METHOD__GETITEM__(&LazyFrame::m__getitem__));
+  xt.add(METHOD__REPR__(&LazyFrame::m__repr__));
+  xt.add(METHOD(&LazyFrame::to_frame, args_LazyFrame_to_frame));
+  xt.add(METHOD(&LazyFrame::explain, args_LazyFrame_explain));
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Frame.lazy()
+//------------------------------------------------------------------------------
+
+static const char* doc_lazy =
+R"(lazy(self)
+--
+
+Return a lazy version of this frame, which records the
+``[i, j, ...]`` selectors applied to it instead of evaluating
+them immediately.
+
+A chain of selectors on the lazy frame is evaluated all at once
+when its :meth:`.to_frame()` method is called. At that point the
+adjacent selectors are combined wherever possible, so that no
+intermediate frames are created. For example::
+
+    >>> LF = DT.lazy()[f.A > 0, :][f.B < 5, :][:, [f.C, f.D]]
+    >>> res = LF.to_frame()
+
+is evaluated as a single ``DT[i, j]`` call, where the condition
+``f.B < 5`` is applied only to the rows where ``f.A > 0``,
+and::
+
+    >>> res = DT.lazy()[:, :, sort(f.A)][:10, :].to_frame()
+
+selects the 10 rows with the smallest values of ``A`` without
+sorting the entire frame, same as ``DT[:10, :, sort(f.A)]``.
+
+The lazy frame holds a shallow copy of the current frame, so the
+subsequent modifications of this frame do not affect it.
+
+return: LazyFrame
+    An object that supports the ``[i, j, ...]`` selectors, each
+    returning a new LazyFrame, and the methods ``.to_frame()``
+    and ``.explain()``.
+)";
+
+static PKArgs args_lazy(0, 0, 0, false, false, {}, "lazy", doc_lazy);
+
+
+oobj Frame::lazy(const PKArgs&) {
+  oobj frame = Frame::oframe(new DataTable(*dt));
+  return LazyFrame::make(frame, otuple(0));
+}
+
+
+void Frame::_init_lazy(XTypeMaker& xt) {
+  LazyFrame::init_type(nullptr);
+  xt.add(METHOD(&Frame::lazy, args_lazy));
+}
+
+
+}  // namespace py
@@ -984,6 +984,15 @@ following list describes possible choices:
     (however, this is subject to numpy's approval). The resulting
     frame will have a copy-on-write semantics.
 
+`pa.Table | pa.RecordBatch | ...`
+    Any object that implements the Arrow PyCapsule protocol (i.e. has
+    method `__arrow_c_stream__` or `__arrow_c_array__`) will be
+    converted into a Frame via the Arrow C data interface. Whenever
+    possible, the data buffers are shared with the source object
+    without copying. Arrow dictionary arrays are converted into
+    dictionary-encoded string columns. The `stypes` argument cannot
+    be used with this kind of source.
+
 `None`
     When the source is not given at all, then a 0x0 frame will be
     created; unless a `names` parameter is provided, in which
@@ -1052,7 +1061,9 @@ void Frame::impl_init_type(XTypeMaker& xt) {
   _init_init(xt);
   _init_iter(xt);
   _init_jay(xt);
+  _init_lazy(xt);
   _init_names(xt);
+  _init_parquet(xt);
   _init_rbind(xt);
   _init_replace(xt);
   _init_repr(xt);
@@ -1060,6 +1071,7 @@ void Frame::impl_init_type(XTypeMaker& xt) {
   _init_stats(xt);
   _init_sort(xt);
   _init_newsort(xt);
+  _init_toarrow(xt);
   _init_tocsv(xt);
   _init_tonumpy(xt);
   _init_topython(xt);
@@ -48,7 +48,9 @@ class Frame : public XObject<Frame> {
     static void _init_iter(XTypeMaker&);
     static void _init_jay(XTypeMaker&);
     static void _init_key(XTypeMaker&);
+    static void _init_lazy(XTypeMaker&);
     static void _init_names(XTypeMaker&);
+    static void _init_parquet(XTypeMaker&);
     static void _init_rbind(XTypeMaker&);
     static void _init_replace(XTypeMaker&);
     static void _init_repr(XTypeMaker&);
@@ -56,6 +58,7 @@ class Frame : public XObject<Frame> {
     static void _init_sort(XTypeMaker&);
     static void _init_newsort(XTypeMaker&);
     static void _init_stats(XTypeMaker&);
+    static void _init_toarrow(XTypeMaker&);
     static void _init_tocsv(XTypeMaker&);
     static void _init_tonumpy(XTypeMaker&);
     static void _init_topython(XTypeMaker&);
@@ -85,6 +88,8 @@ class Frame : public XObject<Frame> {
     oobj m__copy__();
     oobj m__deepcopy__(const PKArgs&);
     size_t m__len__() const;
+    oobj m__arrow_c_array__(const PKArgs&);  // See frame/to_arrow.cc
+    oobj m__arrow_c_stream__(const PKArgs&);
 
     // Frame display
     oobj m__repr__() const;
@@ -114,6 +119,7 @@ class Frame : public XObject<Frame> {
     oobj colindex(const PKArgs&);
     oobj copy(const PKArgs&);
     oobj head(const PKArgs&);
+    oobj lazy(const PKArgs&);  // See frame/lazy.cc
     void materialize(const PKArgs&);
     void rbind(const PKArgs&);
     void repeat(const PKArgs&);
@@ -124,10 +130,12 @@ class Frame : public XObject<Frame> {
     oobj export_names(const PKArgs&);
 
     // Conversion methods
+    oobj to_arrow(const PKArgs&);
     oobj to_csv(const PKArgs&);
     oobj to_dict(const PKArgs&);
     oobj to_jay(const PKArgs&);  // See jay/save_jay.cc
     oobj to_list(const PKArgs&);
+    oobj to_parquet(const PKArgs&);  // See parquet/save_parquet.cc
     oobj to_numpy(const PKArgs&);
     oobj to_pandas(const PKArgs&);
     oobj to_tuples(const PKArgs&);
@@ -155,8 +163,11 @@ class Frame : public XObject<Frame> {
     oobj _main_getset(robj item, robj value);
     oobj _get_single_column(robj selector);
     oobj _del_single_column(robj selector);
+    oobj _eval_query(rtuple targs, robj value,
+                     const std::vector<oobj>& filters = {});
 
     friend class FrameInitializationManager;
+    friend class LazyFrame;
     friend class pylistNP;
     friend class strvecNP;
 };
@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include "arrow/arrow.h"
+#include "frame/py_frame.h"
+#include "python/_all.h"
+#include "python/args.h"
+#include "datatable.h"
+namespace py {
+
+
+//------------------------------------------------------------------------------
+// PyCapsules
+//------------------------------------------------------------------------------
+
+// The capsules own the Arrow structures they contain. If the consumer
+// does not move the structure out of the capsule, it is released when
+// the capsule is destroyed.
+
+static void release_schema_capsule(PyObject* capsule) {
+  auto schema = static_cast<ArrowSchema*>(
+                    PyCapsule_GetPointer(capsule, "arrow_schema"));
+  if (schema->release) schema->release(schema);
+  delete schema;
+}
+
+static void release_array_capsule(PyObject* capsule) {
+  auto array = static_cast<ArrowArray*>(
+                   PyCapsule_GetPointer(capsule, "arrow_array"));
+  if (array->release) array->release(array);
+  delete array;
+}
+
+static void release_stream_capsule(PyObject* capsule) {
+  auto stream = static_cast<ArrowArrayStream*>(
+                    PyCapsule_GetPointer(capsule, "arrow_array_stream"));
+  if (stream->release) stream->release(stream);
+  delete stream;
+}
+
+
+static oobj schema_capsule(const DataTable* dt) {
+  auto schema = new ArrowSchema();
+  try {
+    dt::arrow::export_schema(dt, schema);
+  } catch (...) {
+    delete schema;
+    throw;
+  }
+  return oobj::from_new_reference(
+      PyCapsule_New(schema, "arrow_schema", release_schema_capsule));
+}
+
+static oobj array_capsule(const DataTable* dt) {
+  auto array = new ArrowArray();
+  try {
+    dt::arrow::export_array(dt, array);
+  } catch (...) {
+    delete array;
+    throw;
+  }
+  return oobj::from_new_reference(
+      PyCapsule_New(array, "arrow_array", release_array_capsule));
+}
+
+static oobj stream_capsule(const DataTable* dt) {
+  auto stream = new ArrowArrayStream();
+  try {
+    dt::arrow::export_stream(dt, stream);
+  } catch (...) {
+    delete stream;
+    throw;
+  }
+  return oobj::from_new_reference(
+      PyCapsule_New(stream, "arrow_array_stream", release_stream_capsule));
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Frame.__arrow_c_array__(), Frame.__arrow_c_stream__()
+//------------------------------------------------------------------------------
+
+static const char* doc___arrow_c_array__ =
+R"(__arrow_c_array__(self, requested_schema=None)
+--
+
+Export the frame as a pair of PyCapsules holding the ``ArrowSchema``
+and ``ArrowArray`` structures of the `Arrow C data interface`_. The
+frame is exported as a struct array, whose children are the columns
+of the frame.
+
+This method implements the Arrow PyCapsule protocol, which allows
+the frame to be passed directly to any library that supports this
+protocol, for example ``pyarrow.record_batch(DT)``. The data buffers
+of the frame are shared with the consumer without copying whenever
+Arrow's memory layout is the same as datatable's.
+
+.. _`Arrow C data interface`: https://arrow.apache.org/docs/format/CDataInterface.html
+
+Parameters
+----------
+requested_schema: PyCapsule | None
+    This parameter is accepted for compatibility with the protocol,
+    but is ignored: the frame is always exported with its own schema.
+
+return: Tuple[PyCapsule, PyCapsule]
+)";
+
+static PKArgs args___arrow_c_array__(
+    0, 1, 0, false, false, {"requested_schema"}, "__arrow_c_array__",
+    doc___arrow_c_array__);
+
+oobj Frame::m__arrow_c_array__(const PKArgs&) {
+  oobj schema = schema_capsule(dt);
+  oobj array = array_capsule(dt);
+  return otuple{schema, array};
+}
+
+
+static const char* doc___arrow_c_stream__ =
+R"(__arrow_c_stream__(self, requested_schema=None)
+--
+
+Export the frame as a PyCapsule holding an ``ArrowArrayStream``
+structure of the Arrow C stream interface. The stream produces a
+single record batch with all the data of the frame.
+
+This method implements the Arrow PyCapsule protocol, which allows
+the frame to be passed directly to functions such as
+``pyarrow.table(DT)``.
+
+Parameters
+----------
+requested_schema: PyCapsule | None
+    This parameter is accepted for compatibility with the protocol,
+    but is ignored: the frame is always exported with its own schema.
+
+return: PyCapsule
+)";
+
+static PKArgs args___arrow_c_stream__(
+    0, 1, 0, false, false, {"requested_schema"}, "__arrow_c_stream__",
+    doc___arrow_c_stream__);
+
+oobj Frame::m__arrow_c_stream__(const PKArgs&) {
+  return stream_capsule(dt);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Frame.to_arrow()
+//------------------------------------------------------------------------------
+
+static const char* doc_to_arrow =
+R"(to_arrow(self)
+--
+
+Convert this frame into a ``pyarrow.Table``.
+
+The conversion goes through the Arrow C data interface, which allows
+most of the data to be shared between the frame and the resulting
+table, without copying:
+
+- boolean columns are converted into bitmaps;
+- numeric columns are shared as-is;
+- the character data of string columns is shared; the offsets of
+  string columns are shared too, unless the column contains NAs;
+- dictionary-encoded string columns become dictionary arrays.
+
+For the columns that contain NAs, a validity bitmap is created.
+
+Parameters
+----------
+return: pyarrow.Table
+
+except: ImportError
+    If the ``pyarrow`` module is not installed.
+
+except: TypeError
+    If the frame has columns of type ``obj64``, which cannot be
+    converted into Arrow format.
+)";
+
+static PKArgs args_to_arrow(
+    0, 0, 0, false, false, {}, "to_arrow", doc_to_arrow);
+
+oobj Frame::to_arrow(const PKArgs&) {
+  oobj pyarrow = oobj::import("pyarrow");
+  // The capsules guarantee that the structures are released, even if
+  // pyarrow fails to import them.
+  oobj schema = schema_capsule(dt);
+  oobj array = array_capsule(dt);
+  auto schema_ptr = PyCapsule_GetPointer(schema.to_borrowed_ref(),
+                                         "arrow_schema");
+  auto array_ptr = PyCapsule_GetPointer(array.to_borrowed_ref(),
+                                        "arrow_array");
+  // `RecordBatch._import_from_c()` is available in all versions of
+  // pyarrow that support the C data interface, unlike the newer
+  // PyCapsule-based constructors.
+  oobj batch = pyarrow.get_attr("RecordBatch").invoke("_import_from_c",
+      otuple{oobj::wrap(reinterpret_cast<size_t>(array_ptr)),
+             oobj::wrap(reinterpret_cast<size_t>(schema_ptr))});
+  olist batches(1);
+  batches.set(0, batch);
+  return pyarrow.get_attr("Table").invoke("from_batches", otuple{batches});
+}
+
+
+void Frame::_init_toarrow(XTypeMaker& xt) {
+  xt.add(METHOD(&Frame::m__arrow_c_array__, args___arrow_c_array__));
+  xt.add(METHOD(&Frame::m__arrow_c_stream__, args___arrow_c_stream__));
+  xt.add(METHOD(&Frame::to_arrow, args_to_arrow));
+}
+
+
+
+}  // namespace py
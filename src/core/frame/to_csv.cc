@@ -43,7 +43,8 @@ static void change_to_lowercase(std::string& str) {
 static const char* doc_to_csv =
 R"(to_csv(self, path=None, *, quoting="minimal", append=False,
        header="auto", bom=False, hex=False, compression=None,
-       verbose=False, method="auto")
+       verbose=False, method="auto", compression_level=None,
+       compression_member_size=None)
 --
 
 Write the contents of the Frame into a CSV file.
@@ -119,6 +120,10 @@ compression: None | "gzip" | "auto"
     output file's name. The only compression format currently supported
     is "gzip". Compression may not be used when `append` is True.
 
+    The output is split into chunks, and each chunk is compressed by
+    its own thread into a separate gzip "member". The members are then
+    concatenated in order, producing a valid .gz file.
+
 verbose: bool
     If True, some extra information will be printed to the console,
     which may help to debug the inner workings of the algorithm.
@@ -128,6 +133,20 @@ method: "mmap" | "write" | "auto"
     gives a better performance; on other OSes 'mmap' may not work at
     all.
 
+compression_level: int
+    The level of gzip compression, from 0 (no compression, fastest) to
+    9 (best compression, slowest). The default is zlib's default level
+    of 6. This parameter can only be used when the output is
+    compressed.
+
+compression_member_size: int
+    The approximate size in bytes of the uncompressed CSV data stored
+    in each gzip member. Larger members compress slightly better, while
+    smaller members allow more parallelism. By default the size is
+    chosen automatically so that all threads have work to do, but is
+    never larger than 1MB. This parameter can only be used when the
+    output is compressed.
+
 (return): None | str | bytes
     None if `path` is non-empty. This is the most common case: the
     output is written to the file provided.
@@ -138,9 +157,9 @@ method: "mmap" | "write" | "auto"
 )";
 
 static PKArgs args_to_csv(
-    0, 1, 8, false, false,
+    0, 1, 10, false, false,
     {"path", "quoting", "append", "header", "bom", "hex", "compression",
-     "verbose", "method"},
+     "verbose", "method", "compression_level", "compression_member_size"},
     "to_csv", doc_to_csv);
 
 
@@ -155,6 +174,8 @@ oobj Frame::to_csv(const PKArgs& args)
   const Arg& arg_compress = args[6];
   const Arg& arg_verbose  = args[7];
   const Arg& arg_strategy = args[8];
+  const Arg& arg_zlevel   = args[9];
+  const Arg& arg_zsize    = args[10];
 
   // path
   oobj path = arg_path.to<oobj>(ostring(""));
@@ -230,6 +251,34 @@ oobj Frame::to_csv(const PKArgs& args)
         << compress_str << "' in Frame.to_csv()";
   }
 
+  // compression_level
+  int compression_level = -1;
+  if (!arg_zlevel.is_none_or_undefined()) {
+    if (!compress) {
+      throw ValueError() << "Parameter `compression_level` in Frame.to_csv() "
+          "can only be used when the output is compressed";
+    }
+    compression_level = arg_zlevel.to_int32_strict();
+    if (compression_level < 0 || compression_level > 9) {
+      throw ValueError() << "Parameter `compression_level` in Frame.to_csv() "
+          "should be an integer from 0 to 9, instead got " << compression_level;
+    }
+  }
+
+  // compression_member_size
+  size_t compression_member_size = 0;
+  if (!arg_zsize.is_none_or_undefined()) {
+    if (!compress) {
+      throw ValueError() << "Parameter `compression_member_size` in "
+          "Frame.to_csv() can only be used when the output is compressed";
+    }
+    compression_member_size = arg_zsize.to_size_t();
+    if (compression_member_size == 0) {
+      throw ValueError() << "Parameter `compression_member_size` in "
+          "Frame.to_csv() should be positive";
+    }
+  }
+
   // verbose
   bool verbose = arg_verbose.to<bool>(false);
 
@@ -248,6 +297,8 @@ oobj Frame::to_csv(const PKArgs& args)
   writer.set_verbose(verbose);
   writer.set_quoting(quoting);
   writer.set_compression(compress);
+  writer.set_compression_level(compression_level);
+  writer.set_compression_member_size(compression_member_size);
   writer.write_main();
   return writer.get_result();
 }
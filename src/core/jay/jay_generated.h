@@ -22,6 +22,10 @@ struct StatsFloat32;
 
 struct StatsFloat64;
 
+struct ZoneInt;
+
+struct ZoneFloat;
+
 struct Frame;
 
 struct Column;
@@ -78,6 +82,38 @@ inline const char *EnumNameType(Type e) {
   return EnumNamesType()[index];
 }
 
+enum Codec : uint8_t {
+  Codec_None = 0,
+  Codec_Lz4 = 1,
+  Codec_Zlib = 2,
+  Codec_MIN = Codec_None,
+  Codec_MAX = Codec_Zlib
+};
+
+inline const Codec (&EnumValuesCodec())[3] {
+  static const Codec values[] = {
+    Codec_None,
+    Codec_Lz4,
+    Codec_Zlib
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesCodec() {
+  static const char * const names[] = {
+    "None",
+    "Lz4",
+    "Zlib",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameCodec(Codec e) {
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesCodec()[index];
+}
+
 enum Stats {
   Stats_NONE = 0,
   Stats_Bool = 1,
@@ -282,6 +318,60 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(8) StatsFloat64 FLATBUFFERS_FINAL_CLASS {
 };
 FLATBUFFERS_STRUCT_END(StatsFloat64, 16);
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(8) ZoneInt FLATBUFFERS_FINAL_CLASS {
+ private:
+  int64_t min_;
+  int64_t max_;
+  uint64_t nacount_;
+
+ public:
+  ZoneInt() {
+    memset(this, 0, sizeof(ZoneInt));
+  }
+  ZoneInt(int64_t _min, int64_t _max, uint64_t _nacount)
+      : min_(flatbuffers::EndianScalar(_min)),
+        max_(flatbuffers::EndianScalar(_max)),
+        nacount_(flatbuffers::EndianScalar(_nacount)) {
+  }
+  int64_t min() const {
+    return flatbuffers::EndianScalar(min_);
+  }
+  int64_t max() const {
+    return flatbuffers::EndianScalar(max_);
+  }
+  uint64_t nacount() const {
+    return flatbuffers::EndianScalar(nacount_);
+  }
+};
+FLATBUFFERS_STRUCT_END(ZoneInt, 24);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(8) ZoneFloat FLATBUFFERS_FINAL_CLASS {
+ private:
+  double min_;
+  double max_;
+  uint64_t nacount_;
+
+ public:
+  ZoneFloat() {
+    memset(this, 0, sizeof(ZoneFloat));
+  }
+  ZoneFloat(double _min, double _max, uint64_t _nacount)
+      : min_(flatbuffers::EndianScalar(_min)),
+        max_(flatbuffers::EndianScalar(_max)),
+        nacount_(flatbuffers::EndianScalar(_nacount)) {
+  }
+  double min() const {
+    return flatbuffers::EndianScalar(min_);
+  }
+  double max() const {
+    return flatbuffers::EndianScalar(max_);
+  }
+  uint64_t nacount() const {
+    return flatbuffers::EndianScalar(nacount_);
+  }
+};
+FLATBUFFERS_STRUCT_END(ZoneFloat, 24);
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(8) Buffer FLATBUFFERS_FINAL_CLASS {
  private:
   uint64_t offset_;
@@ -309,7 +399,8 @@ struct Frame FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_NROWS = 4,
     VT_NCOLS = 6,
     VT_NKEYS = 8,
-    VT_COLUMNS = 10
+    VT_COLUMNS = 10,
+    VT_CHUNK_NROWS = 12
   };
   uint64_t nrows() const {
     return GetField<uint64_t>(VT_NROWS, 0);
@@ -323,6 +414,9 @@ struct Frame FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<Column>> *columns() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<Column>> *>(VT_COLUMNS);
   }
+  uint64_t chunk_nrows() const {
+    return GetField<uint64_t>(VT_CHUNK_NROWS, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint64_t>(verifier, VT_NROWS) &&
@@ -331,6 +425,7 @@ struct Frame FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_COLUMNS) &&
            verifier.Verify(columns()) &&
            verifier.VerifyVectorOfTables(columns()) &&
+           VerifyField<uint64_t>(verifier, VT_CHUNK_NROWS) &&
            verifier.EndTable();
   }
 };
@@ -351,6 +446,9 @@ struct FrameBuilder {
   void add_columns(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Column>>> columns) {
     fbb_.AddOffset(Frame::VT_COLUMNS, columns);
   }
+  void add_chunk_nrows(uint64_t chunk_nrows) {
+    fbb_.AddElement<uint64_t>(Frame::VT_CHUNK_NROWS, chunk_nrows, 0);
+  }
   explicit FrameBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -368,8 +466,10 @@ inline flatbuffers::Offset<Frame> CreateFrame(
     uint64_t nrows = 0,
     uint64_t ncols = 0,
     int32_t nkeys = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Column>>> columns = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Column>>> columns = 0,
+    uint64_t chunk_nrows = 0) {
   FrameBuilder builder_(_fbb);
+  builder_.add_chunk_nrows(chunk_nrows);
   builder_.add_ncols(ncols);
   builder_.add_nrows(nrows);
   builder_.add_columns(columns);
@@ -382,13 +482,15 @@ inline flatbuffers::Offset<Frame> CreateFrameDirect(
     uint64_t nrows = 0,
     uint64_t ncols = 0,
     int32_t nkeys = 0,
-    const std::vector<flatbuffers::Offset<Column>> *columns = nullptr) {
+    const std::vector<flatbuffers::Offset<Column>> *columns = nullptr,
+    uint64_t chunk_nrows = 0) {
   return jay::CreateFrame(
       _fbb,
       nrows,
       ncols,
       nkeys,
-      columns ? _fbb.CreateVector<flatbuffers::Offset<Column>>(*columns) : 0);
+      columns ? _fbb.CreateVector<flatbuffers::Offset<Column>>(*columns) : 0,
+      chunk_nrows);
 }
 
 struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -399,7 +501,19 @@ struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_NAME = 10,
     VT_NULLCOUNT = 12,
     VT_STATS_TYPE = 14,
-    VT_STATS = 16
+    VT_STATS = 16,
+    VT_CODEC = 18,
+    VT_BLOCK_SIZE = 20,
+    VT_DATA_SIZE = 22,
+    VT_STRDATA_SIZE = 24,
+    VT_DATA_BLOCKS = 26,
+    VT_STRDATA_BLOCKS = 28,
+    VT_ZONES_INT = 30,
+    VT_ZONES_FLOAT = 32,
+    VT_NROWS = 34,
+    VT_PARTS = 36,
+    VT_CODES = 38,
+    VT_CATEGORIES = 40
   };
   Type type() const {
     return static_cast<Type>(GetField<uint8_t>(VT_TYPE, 0));
@@ -444,6 +558,42 @@ struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const StatsFloat64 *stats_as_Float64() const {
     return stats_type() == Stats_Float64 ? static_cast<const StatsFloat64 *>(stats()) : nullptr;
   }
+  Codec codec() const {
+    return static_cast<Codec>(GetField<uint8_t>(VT_CODEC, 0));
+  }
+  uint64_t block_size() const {
+    return GetField<uint64_t>(VT_BLOCK_SIZE, 0);
+  }
+  uint64_t data_size() const {
+    return GetField<uint64_t>(VT_DATA_SIZE, 0);
+  }
+  uint64_t strdata_size() const {
+    return GetField<uint64_t>(VT_STRDATA_SIZE, 0);
+  }
+  const flatbuffers::Vector<uint64_t> *data_blocks() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_DATA_BLOCKS);
+  }
+  const flatbuffers::Vector<uint64_t> *strdata_blocks() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_STRDATA_BLOCKS);
+  }
+  const flatbuffers::Vector<const ZoneInt *> *zones_int() const {
+    return GetPointer<const flatbuffers::Vector<const ZoneInt *> *>(VT_ZONES_INT);
+  }
+  const flatbuffers::Vector<const ZoneFloat *> *zones_float() const {
+    return GetPointer<const flatbuffers::Vector<const ZoneFloat *> *>(VT_ZONES_FLOAT);
+  }
+  uint64_t nrows() const {
+    return GetField<uint64_t>(VT_NROWS, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<Column>> *parts() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<Column>> *>(VT_PARTS);
+  }
+  const Column *codes() const {
+    return GetPointer<const Column *>(VT_CODES);
+  }
+  const Column *categories() const {
+    return GetPointer<const Column *>(VT_CATEGORIES);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_TYPE) &&
@@ -455,6 +605,26 @@ struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint8_t>(verifier, VT_STATS_TYPE) &&
            VerifyOffset(verifier, VT_STATS) &&
            VerifyStats(verifier, stats(), stats_type()) &&
+           VerifyField<uint8_t>(verifier, VT_CODEC) &&
+           VerifyField<uint64_t>(verifier, VT_BLOCK_SIZE) &&
+           VerifyField<uint64_t>(verifier, VT_DATA_SIZE) &&
+           VerifyField<uint64_t>(verifier, VT_STRDATA_SIZE) &&
+           VerifyOffset(verifier, VT_DATA_BLOCKS) &&
+           verifier.Verify(data_blocks()) &&
+           VerifyOffset(verifier, VT_STRDATA_BLOCKS) &&
+           verifier.Verify(strdata_blocks()) &&
+           VerifyOffset(verifier, VT_ZONES_INT) &&
+           verifier.Verify(zones_int()) &&
+           VerifyOffset(verifier, VT_ZONES_FLOAT) &&
+           verifier.Verify(zones_float()) &&
+           VerifyField<uint64_t>(verifier, VT_NROWS) &&
+           VerifyOffset(verifier, VT_PARTS) &&
+           verifier.Verify(parts()) &&
+           verifier.VerifyVectorOfTables(parts()) &&
+           VerifyOffset(verifier, VT_CODES) &&
+           verifier.VerifyTable(codes()) &&
+           VerifyOffset(verifier, VT_CATEGORIES) &&
+           verifier.VerifyTable(categories()) &&
            verifier.EndTable();
   }
 };
@@ -484,6 +654,42 @@ struct ColumnBuilder {
   void add_stats(flatbuffers::Offset<void> stats) {
     fbb_.AddOffset(Column::VT_STATS, stats);
   }
+  void add_codec(Codec codec) {
+    fbb_.AddElement<uint8_t>(Column::VT_CODEC, static_cast<uint8_t>(codec), 0);
+  }
+  void add_block_size(uint64_t block_size) {
+    fbb_.AddElement<uint64_t>(Column::VT_BLOCK_SIZE, block_size, 0);
+  }
+  void add_data_size(uint64_t data_size) {
+    fbb_.AddElement<uint64_t>(Column::VT_DATA_SIZE, data_size, 0);
+  }
+  void add_strdata_size(uint64_t strdata_size) {
+    fbb_.AddElement<uint64_t>(Column::VT_STRDATA_SIZE, strdata_size, 0);
+  }
+  void add_data_blocks(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> data_blocks) {
+    fbb_.AddOffset(Column::VT_DATA_BLOCKS, data_blocks);
+  }
+  void add_strdata_blocks(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> strdata_blocks) {
+    fbb_.AddOffset(Column::VT_STRDATA_BLOCKS, strdata_blocks);
+  }
+  void add_zones_int(flatbuffers::Offset<flatbuffers::Vector<const ZoneInt *>> zones_int) {
+    fbb_.AddOffset(Column::VT_ZONES_INT, zones_int);
+  }
+  void add_zones_float(flatbuffers::Offset<flatbuffers::Vector<const ZoneFloat *>> zones_float) {
+    fbb_.AddOffset(Column::VT_ZONES_FLOAT, zones_float);
+  }
+  void add_nrows(uint64_t nrows) {
+    fbb_.AddElement<uint64_t>(Column::VT_NROWS, nrows, 0);
+  }
+  void add_parts(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Column>>> parts) {
+    fbb_.AddOffset(Column::VT_PARTS, parts);
+  }
+  void add_codes(flatbuffers::Offset<Column> codes) {
+    fbb_.AddOffset(Column::VT_CODES, codes);
+  }
+  void add_categories(flatbuffers::Offset<Column> categories) {
+    fbb_.AddOffset(Column::VT_CATEGORIES, categories);
+  }
   explicit ColumnBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -504,13 +710,37 @@ inline flatbuffers::Offset<Column> CreateColumn(
     flatbuffers::Offset<flatbuffers::String> name = 0,
     uint64_t nullcount = 0,
     Stats stats_type = Stats_NONE,
-    flatbuffers::Offset<void> stats = 0) {
+    flatbuffers::Offset<void> stats = 0,
+    Codec codec = Codec_None,
+    uint64_t block_size = 0,
+    uint64_t data_size = 0,
+    uint64_t strdata_size = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> data_blocks = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> strdata_blocks = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const ZoneInt *>> zones_int = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const ZoneFloat *>> zones_float = 0,
+    uint64_t nrows = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Column>>> parts = 0,
+    flatbuffers::Offset<Column> codes = 0,
+    flatbuffers::Offset<Column> categories = 0) {
   ColumnBuilder builder_(_fbb);
+  builder_.add_nrows(nrows);
+  builder_.add_strdata_size(strdata_size);
+  builder_.add_data_size(data_size);
+  builder_.add_block_size(block_size);
   builder_.add_nullcount(nullcount);
+  builder_.add_categories(categories);
+  builder_.add_codes(codes);
+  builder_.add_parts(parts);
+  builder_.add_zones_float(zones_float);
+  builder_.add_zones_int(zones_int);
+  builder_.add_strdata_blocks(strdata_blocks);
+  builder_.add_data_blocks(data_blocks);
   builder_.add_stats(stats);
   builder_.add_name(name);
   builder_.add_strdata(strdata);
   builder_.add_data(data);
+  builder_.add_codec(codec);
   builder_.add_stats_type(stats_type);
   builder_.add_type(type);
   return builder_.Finish();
@@ -524,7 +754,19 @@ inline flatbuffers::Offset<Column> CreateColumnDirect(
     const char *name = nullptr,
     uint64_t nullcount = 0,
     Stats stats_type = Stats_NONE,
-    flatbuffers::Offset<void> stats = 0) {
+    flatbuffers::Offset<void> stats = 0,
+    Codec codec = Codec_None,
+    uint64_t block_size = 0,
+    uint64_t data_size = 0,
+    uint64_t strdata_size = 0,
+    const std::vector<uint64_t> *data_blocks = nullptr,
+    const std::vector<uint64_t> *strdata_blocks = nullptr,
+    const std::vector<ZoneInt> *zones_int = nullptr,
+    const std::vector<ZoneFloat> *zones_float = nullptr,
+    uint64_t nrows = 0,
+    const std::vector<flatbuffers::Offset<Column>> *parts = nullptr,
+    flatbuffers::Offset<Column> codes = 0,
+    flatbuffers::Offset<Column> categories = 0) {
   return jay::CreateColumn(
       _fbb,
       type,
@@ -533,7 +775,19 @@ inline flatbuffers::Offset<Column> CreateColumnDirect(
       name ? _fbb.CreateString(name) : 0,
       nullcount,
       stats_type,
-      stats);
+      stats,
+      codec,
+      block_size,
+      data_size,
+      strdata_size,
+      data_blocks ? _fbb.CreateVector<uint64_t>(*data_blocks) : 0,
+      strdata_blocks ? _fbb.CreateVector<uint64_t>(*strdata_blocks) : 0,
+      zones_int ? _fbb.CreateVectorOfStructs<ZoneInt>(*zones_int) : 0,
+      zones_float ? _fbb.CreateVectorOfStructs<ZoneFloat>(*zones_float) : 0,
+      nrows,
+      parts ? _fbb.CreateVector<flatbuffers::Offset<Column>>(*parts) : 0,
+      codes,
+      categories);
 }
 
 inline bool VerifyStats(flatbuffers::Verifier &, const void *, Stats type) {
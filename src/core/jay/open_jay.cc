@@ -19,19 +19,37 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>            // std::sort
 #include <string>
 #include <cstring>              // std::memcmp
+#include "column/categorical.h"
+#include "column/rbound.h"
 #include "frame/py_frame.h"
 #include "jay/jay_generated.h"
+#include "parallel/api.h"
+#include "python/xargs.h"
+#include "read/gunzip.h"
+#include "utils/lz4.h"
 #include "datatable.h"
 #include "datatablemodule.h"
+#include "ltype.h"
 #include "stype.h"
+#include "zone_map.h"
 
 
 // Helper functions
+static Column load_column(size_t nrows, size_t chunk_nrows,
+                          const jay::Column* jaycol,
+                          const Buffer& jaybuf);
 static Column column_from_jay(size_t nrows,
                               const jay::Column* jaycol,
                               const Buffer& jaybuf);
+static Column categorical_column_from_jay(size_t nrows, dt::SType,
+                                          const jay::Column* jaycol,
+                                          const Buffer& jaybuf);
+static void zone_map_from_jay(Column& col, size_t chunk_nrows,
+                              const jay::Column* jaycol);
+static Column rbind_columns(const colvec& parts);
 
 static void check_jay_signature(const uint8_t* ptr, size_t size);
 
@@ -55,10 +73,12 @@ DataTable* open_jay_from_bytes(const char* ptr, size_t len) {
 }
 
 
-DataTable* open_jay_from_mbuf(const Buffer& mbuf)
-{
-  std::vector<std::string> colnames;
-
+/**
+  * Locate the meta section within the Jay file `mbuf`, and verify
+  * that it contains a valid `jay::Frame` record. The returned buffer
+  * is a view into `mbuf`.
+  */
+Buffer jay_meta_from_mbuf(const Buffer& mbuf) {
   const uint8_t* ptr = static_cast<const uint8_t*>(mbuf.rptr());
   const size_t len = mbuf.size();
   check_jay_signature(ptr, len);
@@ -69,12 +89,22 @@ DataTable* open_jay_from_mbuf(const Buffer& mbuf)
         << meta_size << " bytes, however file size is only " << len;
   }
 
-  auto meta_ptr = ptr + len - 16 - meta_size;
-  auto frame = jay::GetFrame(meta_ptr);
+  size_t meta_offset = len - 16 - meta_size;
+  auto meta_ptr = ptr + meta_offset;
   flatbuffers::Verifier verifier(meta_ptr, meta_size);
-  if (!frame->Verify(verifier)) {
+  if (!jay::GetFrame(meta_ptr)->Verify(verifier)) {
     throw IOError() << "Invalid meta record in a Jay file";
   }
+  return Buffer::view(mbuf, meta_size, meta_offset);
+}
+
+
+DataTable* open_jay_from_mbuf(const Buffer& mbuf)
+{
+  std::vector<std::string> colnames;
+
+  Buffer meta = jay_meta_from_mbuf(mbuf);
+  auto frame = jay::GetFrame(meta.rptr());
 
   size_t ncols = frame->ncols();
   size_t nrows = frame->nrows();
@@ -84,7 +114,7 @@ DataTable* open_jay_from_mbuf(const Buffer& mbuf)
   columns.reserve(ncols);
   size_t i = 0;
   for (const jay::Column* jcol : *msg_columns) {
-    Column col = column_from_jay(nrows, jcol, mbuf);
+    Column col = load_column(nrows, frame->chunk_nrows(), jcol, mbuf);
     if (col.nrows() != nrows) {
       throw IOError() << "Length of column " << i << " is " << col.nrows()
           << ", however the Frame contains " << nrows << " rows";
@@ -124,7 +154,10 @@ static void check_jay_signature(const uint8_t* sof, size_t size) {
         << static_cast<char>(eof[-1]) << "`";
   }
 
-  if (std::memcmp(sof, "JAY1\0\0\0\0", 8) != 0) {
+  // Version 2 is written when the file uses compressed buffers,
+  // appended parts or dictionary-encoded columns (see save_jay.cc)
+  if (std::memcmp(sof, "JAY1\0\0\0\0", 8) != 0 &&
+      std::memcmp(sof, "JAY2\0\0\0\0", 8) != 0) {
     std::string version(reinterpret_cast<const char*>(sof) + 3, 5);
     throw IOError() << "Unsupported Jay file version: " << version;
   }
@@ -133,10 +166,110 @@ static void check_jay_signature(const uint8_t* sof, size_t size) {
 
 
 
+/**
+  * Open a "dataset": several Jay files which are viewed as a single
+  * Frame, obtained by rbinding the frames from all files. The columns
+  * of the result are `Rbound` columns over the columns of individual
+  * files, so that no data is copied. All files must have the same
+  * column names and types.
+  */
+DataTable* open_jay_dataset(const strvec& paths) {
+  if (paths.empty()) {
+    throw ValueError() << "Jay dataset contains no files";
+  }
+  std::vector<std::unique_ptr<DataTable>> frames;
+  for (const std::string& path : paths) {
+    frames.emplace_back(open_jay_from_file(path));
+    const DataTable* dt0 = frames[0].get();
+    const DataTable* dti = frames.back().get();
+    bool compatible = (dti->ncols() == dt0->ncols()) &&
+                      (dti->get_names() == dt0->get_names());
+    for (size_t j = 0; compatible && j < dt0->ncols(); ++j) {
+      compatible = (dti->get_column(j).stype() == dt0->get_column(j).stype());
+    }
+    if (!compatible) {
+      throw ValueError() << "Jay file `" << path << "` cannot be opened as "
+          "part of the dataset: its columns are different from the columns "
+          "of file `" << paths[0] << "`";
+    }
+  }
+  if (frames.size() == 1) {
+    return frames[0].release();
+  }
+
+  size_t ncols = frames[0]->ncols();
+  colvec columns;
+  columns.reserve(ncols);
+  for (size_t j = 0; j < ncols; ++j) {
+    colvec parts;
+    for (const auto& frame : frames) {
+      parts.push_back(frame->get_column(j));
+    }
+    columns.push_back(rbind_columns(parts));
+  }
+  return new DataTable(std::move(columns), frames[0]->get_names());
+}
+
+
+
+
 //------------------------------------------------------------------------------
 // Open an individual column
 //------------------------------------------------------------------------------
 
+/**
+  * Load column `jcol` together with its zone map. A column that
+  * consists of several parts (i.e. the file was appended to) is
+  * loaded as an rbound column over these parts.
+  */
+static Column load_column(size_t nrows, size_t chunk_nrows,
+                          const jay::Column* jcol, const Buffer& jaybuf)
+{
+  auto jparts = jcol->parts();
+  if (!jparts || jparts->size() == 0) {
+    Column col = column_from_jay(nrows, jcol, jaybuf);
+    if (chunk_nrows) zone_map_from_jay(col, chunk_nrows, jcol);
+    return col;
+  }
+  colvec parts;
+  for (const jay::Column* jpart : *jparts) {
+    if (jpart->parts() || jpart->type() != jcol->type() || !jpart->name()) {
+      throw IOError() << "Invalid Jay file: column `" << jcol->name()->str()
+          << "` has an invalid part " << parts.size();
+    }
+    Column part = column_from_jay(jpart->nrows(), jpart, jaybuf);
+    if (chunk_nrows) zone_map_from_jay(part, chunk_nrows, jpart);
+    parts.push_back(std::move(part));
+  }
+  return rbind_columns(parts);
+}
+
+
+/**
+  * Rbind several columns of the same type without copying the data.
+  * If all the columns have zone maps, the result gets the
+  * concatenation of these maps.
+  */
+static Column rbind_columns(const colvec& parts) {
+  xassert(!parts.empty());
+  if (parts.size() == 1) return parts[0];
+  std::vector<const dt::ZoneMap*> zone_maps;
+  for (const Column& col : parts) {
+    auto zm = col.get_zone_map();
+    if (!zm || zm->is_float() != parts[0].get_zone_map()->is_float()) {
+      zone_maps.clear();
+      break;
+    }
+    zone_maps.push_back(zm);
+  }
+  Column res(new dt::Rbound_ColumnImpl(parts));
+  if (!zone_maps.empty()) {
+    res.set_zone_map(dt::ZoneMap::concat(zone_maps));
+  }
+  return res;
+}
+
+
 static Buffer extract_buffer(
     const Buffer& src, const jay::Buffer* jbuf)
 {
@@ -146,6 +279,84 @@ static Buffer extract_buffer(
 }
 
 
+/**
+ * Create a Buffer for the data stored in compressed blocks (see
+ * `saveCompressedRange()` in save_jay.cc). The Buffer is "lazy": the
+ * blocks will be decompressed, in parallel, only when the data is
+ * accessed for the first time.
+ */
+static Buffer extract_compressed_buffer(
+    const Buffer& src, const jay::Buffer* jbuf, const jay::Column* jcol,
+    size_t size, const flatbuffers::Vector<uint64_t>* jblocks)
+{
+  jay::Codec codec = jcol->codec();
+  size_t block_size = jcol->block_size();
+  if (codec > jay::Codec_MAX) {
+    throw IOError() << "Invalid Jay file: unknown compression codec "
+        << static_cast<int>(codec);
+  }
+  if (!jbuf || !jblocks || !block_size) {
+    throw IOError() << "Invalid Jay file: missing information about "
+        "compressed blocks";
+  }
+  size_t offset = jbuf->offset() + 8;
+  size_t length = jbuf->length();
+  size_t nblocks = jblocks->size();
+  if (offset > src.size() || length > src.size() - offset ||
+      nblocks != (size + block_size - 1) / block_size) {
+    throw IOError() << "Invalid Jay file: compressed buffer is out of bounds";
+  }
+  // Starting offset of each compressed block within the buffer
+  std::vector<size_t> starts(nblocks + 1, 0);
+  for (size_t i = 0; i < nblocks; ++i) {
+    size_t block_len = jblocks->Get(static_cast<flatbuffers::uoffset_t>(i));
+    if (block_len > length - starts[i]) {
+      throw IOError() << "Invalid Jay file: compressed block " << i
+          << " is out of bounds";
+    }
+    starts[i + 1] = starts[i] + block_len;
+  }
+  if (starts[nblocks] != length) {
+    throw IOError() << "Invalid Jay file: sizes of compressed blocks do not "
+        "match the size of the buffer";
+  }
+
+  Buffer compressed = Buffer::view(src, length, offset);
+  return Buffer::lazy(size,
+    [=](void* out) {
+      auto in = static_cast<const char*>(compressed.rptr());
+      auto decompress_block = [&](size_t i) {
+        const char* block = in + starts[i];
+        size_t block_len = starts[i + 1] - starts[i];
+        char* dest = static_cast<char*>(out) + i * block_size;
+        size_t dest_len = std::min(block_size, size - i * block_size);
+        if (block_len == dest_len) {
+          std::memcpy(dest, block, dest_len);
+        }
+        else if (codec == jay::Codec_Lz4) {
+          dt::lz4::decompress(block, block_len, dest, dest_len);
+        }
+        else {
+          size_t nmembers;
+          Buffer res = dt::read::gunzip(block, block_len, &nmembers);
+          if (res.size() != dest_len) {
+            throw IOError() << "Invalid Jay file: compressed block " << i
+                << " has size " << res.size() << " instead of " << dest_len;
+          }
+          std::memcpy(dest, res.rptr(), dest_len);
+        }
+      };
+      // The data may be first accessed from within a parallel region,
+      // in which case the blocks are decompressed sequentially.
+      if (dt::num_threads_in_team() == 0) {
+        dt::parallel_for_dynamic(nblocks, decompress_block);
+      } else {
+        for (size_t i = 0; i < nblocks; ++i) decompress_block(i);
+      }
+    });
+}
+
+
 template <typename T, typename JStats>
 static void initStats(Stats* stats, const jay::Column* jcol) {
   auto jstats = static_cast<const JStats*>(jcol->stats());
@@ -179,10 +390,29 @@ static Column column_from_jay(
     case jay::Type_Str64:   stype = dt::SType::STR64; break;
   }
 
+  if (jcol->categories()) {
+    return categorical_column_from_jay(nrows, stype, jcol, jaybuf);
+  }
+
+  bool compressed = (jcol->codec() != jay::Codec_None);
+  bool is_string = (stype == dt::SType::STR32 || stype == dt::SType::STR64);
+
   Column col;
-  Buffer databuf = extract_buffer(jaybuf, jcol->data());
-  if (stype == dt::SType::STR32 || stype == dt::SType::STR64) {
-    Buffer strbuf = extract_buffer(jaybuf, jcol->strdata());
+  Buffer databuf = compressed
+      ? extract_compressed_buffer(jaybuf, jcol->data(), jcol,
+                                  jcol->data_size(), jcol->data_blocks())
+      : extract_buffer(jaybuf, jcol->data());
+  size_t min_data_size = is_string? (nrows + 1) * stype_elemsize(stype)
+                                  : nrows * stype_elemsize(stype);
+  if (compressed && databuf.size() < min_data_size) {
+    throw IOError() << "Invalid Jay file: data buffer of column `"
+        << jcol->name()->str() << "` is too small";
+  }
+  if (is_string) {
+    Buffer strbuf = compressed
+        ? extract_compressed_buffer(jaybuf, jcol->strdata(), jcol,
+                                    jcol->strdata_size(), jcol->strdata_blocks())
+        : extract_buffer(jaybuf, jcol->strdata());
     col = Column::new_string_column(nrows, std::move(databuf), std::move(strbuf));
   } else {
     col = Column::new_mbuf_column(nrows, stype, std::move(databuf));
@@ -204,6 +434,75 @@ static Column column_from_jay(
 }
 
 
+/**
+  * Load a dictionary-encoded column, whose integer codes and the
+  * dictionary are stored as separate (nested) columns.
+  */
+static Column categorical_column_from_jay(
+    size_t nrows, dt::SType stype, const jay::Column* jcol,
+    const Buffer& jaybuf)
+{
+  auto jcodes = jcol->codes();
+  auto jdict = jcol->categories();
+  bool valid = jcodes && jcodes->nrows() == nrows &&
+               (jcodes->type() == jay::Type_Int8 ||
+                jcodes->type() == jay::Type_Int16 ||
+                jcodes->type() == jay::Type_Int32) &&
+               (jdict->type() == jay::Type_Str32 ||
+                jdict->type() == jay::Type_Str64) &&
+               (stype == dt::SType::STR32 || stype == dt::SType::STR64);
+  if (!valid) {
+    throw IOError() << "Invalid Jay file: dictionary-encoded column `"
+        << jcol->name()->str() << "` is malformed";
+  }
+  Column codes = column_from_jay(nrows, jcodes, jaybuf);
+  Column dict = column_from_jay(jdict->nrows(), jdict, jaybuf);
+  Column col(new dt::Categorical_ColumnImpl(std::move(codes), std::move(dict),
+                                            stype));
+  col.stats()->set_nacount(static_cast<size_t>(jcol->nullcount()));
+  return col;
+}
+
+
+/**
+  * Attach the zone map stored in the Jay file (if any) to column `col`.
+  */
+static void zone_map_from_jay(Column& col, size_t chunk_nrows,
+                              const jay::Column* jcol)
+{
+  bool is_float = (col.ltype() == dt::LType::REAL);
+  auto jzones_int = jcol->zones_int();
+  auto jzones_float = jcol->zones_float();
+  size_t nzones = is_float? (jzones_float? jzones_float->size() : 0)
+                          : (jzones_int? jzones_int->size() : 0);
+  if (nzones == 0) return;
+
+  auto zm = std::make_shared<dt::ZoneMap>(col.nrows(), chunk_nrows, is_float);
+  if (zm->nchunks() != nzones) {
+    throw IOError() << "Invalid Jay file: zone map of column `"
+        << jcol->name()->str() << "` has " << nzones << " entries, whereas "
+        << zm->nchunks() << " were expected";
+  }
+  for (size_t i = 0; i < nzones; ++i) {
+    auto& z = zm->zone(i);
+    if (is_float) {
+      auto jz = (*jzones_float)[static_cast<flatbuffers::uoffset_t>(i)];
+      z.fmin = jz->min();
+      z.fmax = jz->max();
+      z.nacount = jz->nacount();
+      z.imin = z.imax = 0;
+    } else {
+      auto jz = (*jzones_int)[static_cast<flatbuffers::uoffset_t>(i)];
+      z.imin = jz->min();
+      z.imax = jz->max();
+      z.nacount = jz->nacount();
+      z.fmin = z.fmax = 0;
+    }
+  }
+  col.set_zone_map(std::move(zm));
+}
+
+
 
 //------------------------------------------------------------------------------
 // Python open_jay()
@@ -213,7 +512,8 @@ namespace py {
 static PKArgs args_open_jay(
   1, 0, 0, false, false, {"file"}, "open_jay",
   "open_jay(file)\n--\n\n"
-  "Open a Frame from the provided .jay file.\n");
+  "Open a Frame from the provided .jay file. If `file` is a list of\n"
+  "file names, then these files are opened as a single Frame.\n");
 
 
 static oobj open_jay(const PKArgs& args)
@@ -233,12 +533,91 @@ static oobj open_jay(const PKArgs& args)
     res.to_pyframe()->set_source(filename);
     return res;
   }
+  else if (args[0].is_list_or_tuple()) {
+    auto dt = open_jay_dataset(args[0].to_stringlist());
+    return Frame::oframe(dt);
+  }
   else {
     throw TypeError() << "Invalid type of the argument to open_jay()";
   }
 }
 
 
+
+
+//------------------------------------------------------------------------------
+// datatable.open_jay_dataset()
+//------------------------------------------------------------------------------
+
+static const char* doc_open_jay_dataset =
+R"(open_jay_dataset(files)
+--
+.. xversionadded:: 1.0
+
+Open several Jay files as a single frame, whose rows are the rows of
+all files in the order in which the files are given. The data is not
+copied: the columns of the returned frame refer to the data in each
+of the files. All files must have the same column names and types.
+
+Parameters
+----------
+files: str | List[str]
+    Either a list of names of Jay files, or the name of a directory.
+    In the latter case all files with extension ``.jay`` in that
+    directory are opened, in the alphabetical order of their names.
+
+return: Frame
+    A frame with the rows of all the files.
+
+except: ValueError
+    The exception is raised if the list of files is empty, or if the
+    columns of the files are not the same.
+)";
+
+static oobj open_jay_dataset(const XArgs& args) {
+  auto arg = args[0].to_robj();
+  strvec paths;
+  if (arg.is_string()) {
+    oobj isdir = oobj::import("os", "path", "isdir");
+    if (!isdir.call(otuple{arg}).to_bool_strict()) {
+      throw ValueError() << "Path `" << arg.to_string() << "` is not a "
+          "directory";
+    }
+    oobj glob = oobj::import("glob", "glob");
+    oobj escape = oobj::import("glob", "escape");
+    oobj join = oobj::import("os", "path", "join");
+    oobj pattern = join.call(otuple{escape.call(otuple{arg}),
+                                    ostring("*.jay")});
+    paths = glob.call(otuple{pattern}).to_stringlist();
+    std::sort(paths.begin(), paths.end());
+    if (paths.empty()) {
+      throw ValueError() << "Directory `" << arg.to_string() << "` "
+          "contains no Jay files";
+    }
+  }
+  else if (arg.is_list_or_tuple()) {
+    paths = arg.to_stringlist();
+  }
+  else {
+    throw TypeError() << "Argument `files` in open_jay_dataset() should be "
+        "a string or a list of strings, instead got " << arg.typeobj();
+  }
+  auto res = Frame::oframe(::open_jay_dataset(paths));
+  if (arg.is_string()) {
+    res.to_pyframe()->set_source(arg.to_string());
+  }
+  return res;
+}
+
+DECLARE_PYFN(&open_jay_dataset)
+    ->name("open_jay_dataset")
+    ->docs(doc_open_jay_dataset)
+    ->arg_names({"files"})
+    ->n_positional_args(1)
+    ->n_required_args(1);
+
+
+
 void DatatableModule::init_methods_jay() {
   ADD_FN(&open_jay, args_open_jay);
 }
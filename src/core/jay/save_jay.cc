@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <cstring>               // std::memcmp, std::memcpy
 #include "column/column_impl.h"
 #include "column/rbound.h"
 #include "column/sentinel.h"
@@ -30,14 +31,30 @@
 #include "python/args.h"
 #include "python/string.h"
 #include "utils/assert.h"
+#include "utils/file.h"
+#include "utils/lz4.h"
+#include "write/zlib_writer.h"
 #include "datatable.h"
 #include "ltype.h"
 #include "stype.h"
 #include "writebuf.h"
+#include "zone_map.h"
 
 using WritableBufferPtr = std::unique_ptr<WritableBuffer>;
+using BlocksOffset = flatbuffers::Offset<flatbuffers::Vector<uint64_t>>;
+using ZonesIntOffset = flatbuffers::Offset<flatbuffers::Vector<const jay::ZoneInt*>>;
+using ZonesFloatOffset = flatbuffers::Offset<flatbuffers::Vector<const jay::ZoneFloat*>>;
 static jay::Type stype_to_jaytype[dt::STYPES_COUNT];
 static jay::Buffer saveMemoryRange(const void*, size_t, WritableBuffer*);
+static void saveMeta(flatbuffers::FlatBufferBuilder&, WritableBuffer*, int);
+static flatbuffers::Offset<jay::Column> copyColumn(
+    const jay::Column*, size_t nrows, flatbuffers::FlatBufferBuilder&);
+static jay::Buffer saveCompressedRange(
+    const void*, size_t, jay::Codec, WritableBuffer*, std::vector<uint64_t>*);
+
+// Size of the (uncompressed) blocks into which the column's data is
+// split when the compression is used.
+static constexpr size_t JAY_BLOCK_SIZE = 1 << 20;
 template <typename T, typename StatBuilder>
 static flatbuffers::Offset<void> saveStats(
     Stats* stats, flatbuffers::FlatBufferBuilder& fbb);
@@ -47,32 +64,55 @@ static flatbuffers::Offset<void> saveStats(
 // Save DataTable
 //------------------------------------------------------------------------------
 
+// The files that use compressed buffers, dictionary-encoded columns or
+// appended parts are marked as version 2, so that the readers that do
+// not know about these features reject such files instead of misreading
+// them. All other files are still written as version 1.
+//
+static const char* jay_signature(int version) {
+  return version == 2? "JAY2\0\0\0\0" : "JAY1\0\0\0\0";
+}
+
+static int jay_version(const DataTable& dt, jay::Codec codec) {
+  if (codec != jay::Codec_None) return 2;
+  for (size_t i = 0; i < dt.ncols(); ++i) {
+    if (dt.get_column(i).get_categorical(nullptr)) return 2;
+  }
+  return 1;
+}
+
+
 /**
  * Save Frame in Jay format to the provided file.
  */
 void DataTable::save_jay(const std::string& path,
-                         WritableBuffer::Strategy wstrategy)
+                         WritableBuffer::Strategy wstrategy,
+                         jay::Codec codec,
+                         size_t chunk_nrows)
 {
   size_t sizehint = (wstrategy == WritableBuffer::Strategy::Auto)
                     ? memory_footprint() : 0;
   auto wb = WritableBuffer::create_target(path, sizehint, wstrategy);
-  save_jay_impl(wb.get());
+  save_jay_impl(wb.get(), codec, chunk_nrows);
 }
 
 
 /**
  * Save Frame in Jay format to memory,
  */
-Buffer DataTable::save_jay() {
+Buffer DataTable::save_jay(jay::Codec codec, size_t chunk_nrows) {
   auto wb = std::unique_ptr<MemoryWritableBuffer>(
                 new MemoryWritableBuffer(memory_footprint()));
-  save_jay_impl(wb.get());
+  save_jay_impl(wb.get(), codec, chunk_nrows);
   return wb->get_mbuf();
 }
 
 
-void DataTable::save_jay_impl(WritableBuffer* wb) {
-  wb->write(8, "JAY1\0\0\0\0");
+void DataTable::save_jay_impl(WritableBuffer* wb, jay::Codec codec,
+                              size_t chunk_nrows)
+{
+  int version = jay_version(*this, codec);
+  wb->write(8, jay_signature(version));
 
   flatbuffers::FlatBufferBuilder fbb(1024);
 
@@ -84,7 +124,8 @@ void DataTable::save_jay_impl(WritableBuffer* wb) {
       w << "Column `" << names_[i] << "` of type obj64 was not saved";
       w.emit_warning();
     } else {
-      auto saved_col = col.write_to_jay(names_[i], fbb, wb);
+      auto saved_col = col.write_to_jay(names_[i], fbb, wb, codec,
+                                        chunk_nrows);
       msg_columns.push_back(saved_col);
     }
   }
@@ -94,20 +135,147 @@ void DataTable::save_jay_impl(WritableBuffer* wb) {
                   nrows_,
                   msg_columns.size(),
                   static_cast<int>(nkeys_),
-                  &msg_columns);
+                  &msg_columns,
+                  chunk_nrows);
   fbb.Finish(frame);
+  saveMeta(fbb, wb, version);
+}
 
-  uint8_t* metaBytes = fbb.GetBufferPointer();
-  size_t   metaSize = fbb.GetSize();
-  wb->write(metaSize, metaBytes);
-  if (metaSize & 7) {
-    wb->write(8 - (metaSize & 7), "\0\0\0\0\0\0\0");
-    metaSize += 8 - (metaSize & 7);
+
+/**
+ * Append the Frame to an existing Jay file. The data of the new rows is
+ * written after the data section of the file, followed by the new meta
+ * section, where each column consists of the parts stored in the file
+ * before, plus the newly written part. The existing data is never moved
+ * or re-encoded, so its buffers keep their offsets within the file.
+ *
+ * The file is modified in place: the new data overwrites the old meta
+ * section, so the time to append is proportional to the size of the new
+ * rows only. If the append fails, the file is truncated back to its
+ * original size and the old meta section is restored.
+ *
+ * If the file does not exist or is empty, then it is written as with
+ * `save_jay()`.
+ */
+void DataTable::append_jay(const std::string& path,
+                           WritableBuffer::Strategy wstrategy,
+                           jay::Codec codec,
+                           size_t chunk_nrows)
+{
+  if (!File::nonempty(path)) {
+    save_jay(path, wstrategy, codec, chunk_nrows);
+    return;
+  }
+  Buffer mbuf = Buffer::mmap(path);
+  if (mbuf.size() & 7) {
+    throw IOError() << "Cannot append to Jay file `" << path
+        << "`: its size is not a multiple of 8";
+  }
+  // The tail of the file (the meta section and the footer) and its
+  // header are going to be overwritten, so keep their copies in memory
+  // in order to restore them if the append fails.
+  size_t file_size = mbuf.size();
+  size_t data_size = file_size - 16 - jay_meta_from_mbuf(mbuf).size();
+  auto fileptr = static_cast<const char*>(mbuf.rptr());
+  Buffer tail = Buffer::copy(fileptr + data_size, file_size - data_size);
+  char header[8];
+  std::memcpy(header, fileptr, 8);
+  mbuf = Buffer();
+  auto jframe = jay::GetFrame(tail.rptr());
+  auto jcolumns = jframe->columns();
+
+  // Check that the columns are the same as in the file
+  sztvec indices;
+  for (size_t i = 0; i < ncols_; ++i) {
+    if (get_column(i).stype() == dt::SType::OBJ) {
+      auto w = DatatableWarning();
+      w << "Column `" << names_[i] << "` of type obj64 was not saved";
+      w.emit_warning();
+    } else {
+      indices.push_back(i);
+    }
+  }
+  bool compatible = (jcolumns->size() == indices.size());
+  for (size_t k = 0; compatible && k < indices.size(); ++k) {
+    auto jcol = (*jcolumns)[static_cast<flatbuffers::uoffset_t>(k)];
+    const Column& col = get_column(indices[k]);
+    compatible = (jcol->name()->str() == names_[indices[k]]) &&
+                 (jcol->type() == stype_to_jaytype[int(col.stype())]);
+  }
+  if (!compatible) {
+    throw ValueError() << "Cannot append to Jay file `" << path << "`: "
+        "the names or types of the columns of the Frame are different "
+        "from those in the file";
+  }
+  if (jframe->chunk_nrows()) {
+    if (chunk_nrows && chunk_nrows != jframe->chunk_nrows()) {
+      throw ValueError() << "Cannot append to Jay file `" << path << "` "
+          "with chunk_nrows=" << chunk_nrows << ": the file uses "
+          "chunk_nrows=" << jframe->chunk_nrows();
+    }
+    chunk_nrows = jframe->chunk_nrows();
   }
 
-  wb->write(8, &metaSize);
-  wb->write(8, "\0\0\0\0" "1JAY");
-  wb->finalize();
+  try {
+    File(path, File::READWRITE).resize(data_size);
+    auto wb = WritableBuffer::create_target(path, memory_footprint(),
+                                            wstrategy, /* append = */ true);
+    xassert(wb->size() == data_size);
+    flatbuffers::FlatBufferBuilder fbb(1024);
+
+    std::vector<flatbuffers::Offset<jay::Column>> msg_columns;
+    for (size_t k = 0; k < indices.size(); ++k) {
+      Column& col = get_column(indices[k]);
+      const std::string& name = names_[indices[k]];
+      auto jcol = (*jcolumns)[static_cast<flatbuffers::uoffset_t>(k)];
+
+      std::vector<flatbuffers::Offset<jay::Column>> parts;
+      if (jcol->parts() && jcol->parts()->size()) {
+        for (const jay::Column* jpart : *jcol->parts()) {
+          parts.push_back(copyColumn(jpart, jpart->nrows(), fbb));
+        }
+      } else {
+        parts.push_back(copyColumn(jcol, jframe->nrows(), fbb));
+      }
+      parts.push_back(col.write_to_jay(name, fbb, wb.get(), codec,
+                                       chunk_nrows));
+      auto vparts = fbb.CreateVector(parts);
+      auto sname = fbb.CreateString(name);
+
+      jay::ColumnBuilder cbb(fbb);
+      cbb.add_type(jcol->type());
+      cbb.add_name(sname);
+      cbb.add_nullcount(jcol->nullcount() + col.na_count());
+      cbb.add_nrows(jframe->nrows() + nrows_);
+      cbb.add_parts(vparts);
+      msg_columns.push_back(cbb.Finish());
+    }
+    xassert((wb->size() & 7) == 0);
+
+    auto frame = jay::CreateFrameDirect(fbb,
+                    jframe->nrows() + nrows_,
+                    msg_columns.size(),
+                    0,
+                    &msg_columns,
+                    chunk_nrows);
+    fbb.Finish(frame);
+    saveMeta(fbb, wb.get(), 2);
+    wb = nullptr;
+    if (std::memcmp(header, jay_signature(2), 8) != 0) {
+      File(path, File::READWRITE).write_at(0, jay_signature(2), 8);
+    }
+  }
+  catch (...) {
+    // If the file cannot be restored, the original error is still more
+    // informative for the user.
+    try {
+      File file(path, File::READWRITE);
+      file.resize(data_size);
+      file.write_at(data_size, tail.rptr(), tail.size());
+      file.write_at(0, header, 8);
+    } catch (...) {}
+    throw;
+  }
 }
 
 
@@ -119,8 +287,27 @@ void DataTable::save_jay_impl(WritableBuffer* wb) {
 flatbuffers::Offset<jay::Column> Column::write_to_jay(
         const std::string& name,
         flatbuffers::FlatBufferBuilder& fbb,
-        WritableBuffer* wb)
+        WritableBuffer* wb,
+        jay::Codec codec,
+        size_t chunk_nrows)
 {
+  // A dictionary-encoded column is saved as a pair of nested columns:
+  // the integer codes, and the dictionary.
+  Column codes, dict;
+  if (get_categorical(&codes, &dict)) {
+    auto jcodes = codes.write_to_jay(name, fbb, wb, codec, 0);
+    auto jdict = dict.write_to_jay(name, fbb, wb, codec, 0);
+    auto sname = fbb.CreateString(name.c_str());
+    jay::ColumnBuilder cbb(fbb);
+    cbb.add_type(stype_to_jaytype[static_cast<int>(stype())]);
+    cbb.add_name(sname);
+    cbb.add_nullcount(codes.na_count());
+    cbb.add_nrows(nrows());
+    cbb.add_codes(jcodes);
+    cbb.add_categories(jdict);
+    return cbb.Finish();
+  }
+
   jay::Stats jsttype = jay::Stats_NONE;
   flatbuffers::Offset<void> jsto;
   Stats* colstats = get_stats_if_exist();
@@ -158,16 +345,73 @@ flatbuffers::Offset<jay::Column> Column::write_to_jay(
 
   auto sname = fbb.CreateString(name.c_str());
 
+  // Compressed buffers are written before the column's table is
+  // started, because the vectors of block sizes must be created
+  // outside of the table being built.
+  jay::Buffer cdata, cstrdata;
+  BlocksOffset cdata_blocks, cstrdata_blocks;
+  if (codec != jay::Codec_None) {
+    materialize();
+    std::vector<uint64_t> blocks;
+    cdata = saveCompressedRange(get_data_readonly(0), get_data_size(0),
+                                codec, wb, &blocks);
+    cdata_blocks = fbb.CreateVector(blocks);
+    if (get_num_data_buffers() == 2) {
+      cstrdata = saveCompressedRange(get_data_readonly(1), get_data_size(1),
+                                     codec, wb, &blocks);
+      cstrdata_blocks = fbb.CreateVector(blocks);
+    }
+  }
+
+  // Zone maps of the row groups, see "zone_map.h"
+  ZonesIntOffset zones_int;
+  ZonesFloatOffset zones_float;
+  if (chunk_nrows) {
+    auto zm = dt::ZoneMap::compute(*this, chunk_nrows);
+    if (zm && zm->is_float()) {
+      std::vector<jay::ZoneFloat> zones;
+      for (size_t i = 0; i < zm->nchunks(); ++i) {
+        const auto& z = zm->zone(i);
+        zones.emplace_back(z.fmin, z.fmax, z.nacount);
+      }
+      zones_float = fbb.CreateVectorOfStructs(zones);
+    }
+    else if (zm) {
+      std::vector<jay::ZoneInt> zones;
+      for (size_t i = 0; i < zm->nchunks(); ++i) {
+        const auto& z = zm->zone(i);
+        zones.emplace_back(z.imin, z.imax, z.nacount);
+      }
+      zones_int = fbb.CreateVectorOfStructs(zones);
+    }
+  }
+
   jay::ColumnBuilder cbb(fbb);
   cbb.add_type(stype_to_jaytype[static_cast<int>(stype())]);
   cbb.add_name(sname);
   cbb.add_nullcount(na_count());
-  write_data_to_jay(cbb, wb);
+  cbb.add_nrows(nrows());
+  if (codec == jay::Codec_None) {
+    write_data_to_jay(cbb, wb);
+  } else {
+    cbb.add_codec(codec);
+    cbb.add_block_size(JAY_BLOCK_SIZE);
+    cbb.add_data(&cdata);
+    cbb.add_data_size(get_data_size(0));
+    cbb.add_data_blocks(cdata_blocks);
+    if (get_num_data_buffers() == 2) {
+      cbb.add_strdata(&cstrdata);
+      cbb.add_strdata_size(get_data_size(1));
+      cbb.add_strdata_blocks(cstrdata_blocks);
+    }
+  }
 
   if (jsttype != jay::Stats_NONE) {
     cbb.add_stats_type(jsttype);
     cbb.add_stats(jsto);
   }
+  cbb.add_zones_int(zones_int);
+  cbb.add_zones_float(zones_float);
 
   return cbb.Finish();
 }
@@ -376,6 +620,197 @@ static jay::Buffer saveMemoryRange(
 
 
 
+/**
+ * Write the meta section (finished in `fbb`) and the closing signature
+ * of a Jay file, and finalize the output.
+ */
+static void saveMeta(flatbuffers::FlatBufferBuilder& fbb, WritableBuffer* wb,
+                     int version)
+{
+  uint8_t* metaBytes = fbb.GetBufferPointer();
+  size_t   metaSize = fbb.GetSize();
+  wb->write(metaSize, metaBytes);
+  if (metaSize & 7) {
+    wb->write(8 - (metaSize & 7), "\0\0\0\0\0\0\0");
+    metaSize += 8 - (metaSize & 7);
+  }
+
+  wb->write(8, &metaSize);
+  wb->write(8, version == 2? "\0\0\0\0" "2JAY" : "\0\0\0\0" "1JAY");
+  wb->finalize();
+}
+
+
+/**
+ * Re-create in `fbb` the descriptor of a column that was previously
+ * saved into a Jay file; the data buffers are not copied, the new
+ * descriptor refers to the same location within the file.
+ */
+static flatbuffers::Offset<jay::Column> copyColumn(
+    const jay::Column* jcol, size_t nrows, flatbuffers::FlatBufferBuilder& fbb)
+{
+  using namespace flatbuffers;
+  auto sname = fbb.CreateString(jcol->name()->str());
+  Offset<void> jstats;
+  // Note: `stats_type` may be set even when the stats themselves are absent
+  auto sttype = jcol->stats()? jcol->stats_type() : jay::Stats_NONE;
+  switch (sttype) {
+    case jay::Stats_Bool:    jstats = fbb.CreateStruct(*jcol->stats_as_Bool()).Union(); break;
+    case jay::Stats_Int8:    jstats = fbb.CreateStruct(*jcol->stats_as_Int8()).Union(); break;
+    case jay::Stats_Int16:   jstats = fbb.CreateStruct(*jcol->stats_as_Int16()).Union(); break;
+    case jay::Stats_Int32:   jstats = fbb.CreateStruct(*jcol->stats_as_Int32()).Union(); break;
+    case jay::Stats_Int64:   jstats = fbb.CreateStruct(*jcol->stats_as_Int64()).Union(); break;
+    case jay::Stats_Float32: jstats = fbb.CreateStruct(*jcol->stats_as_Float32()).Union(); break;
+    case jay::Stats_Float64: jstats = fbb.CreateStruct(*jcol->stats_as_Float64()).Union(); break;
+    default: break;
+  }
+  BlocksOffset data_blocks, strdata_blocks;
+  if (auto v = jcol->data_blocks()) {
+    data_blocks = fbb.CreateVector(v->data(), v->size());
+  }
+  if (auto v = jcol->strdata_blocks()) {
+    strdata_blocks = fbb.CreateVector(v->data(), v->size());
+  }
+  flatbuffers::Offset<jay::Column> codes, categories;
+  if (auto c = jcol->codes()) {
+    codes = copyColumn(c, c->nrows(), fbb);
+  }
+  if (auto c = jcol->categories()) {
+    categories = copyColumn(c, c->nrows(), fbb);
+  }
+  ZonesIntOffset zones_int;
+  ZonesFloatOffset zones_float;
+  if (auto v = jcol->zones_int()) {
+    auto ptr = reinterpret_cast<const jay::ZoneInt*>(v->Data());
+    zones_int = fbb.CreateVectorOfStructs(ptr, v->size());
+  }
+  if (auto v = jcol->zones_float()) {
+    auto ptr = reinterpret_cast<const jay::ZoneFloat*>(v->Data());
+    zones_float = fbb.CreateVectorOfStructs(ptr, v->size());
+  }
+
+  jay::ColumnBuilder cbb(fbb);
+  cbb.add_type(jcol->type());
+  cbb.add_name(sname);
+  cbb.add_nullcount(jcol->nullcount());
+  cbb.add_nrows(nrows);
+  if (jcol->data()) cbb.add_data(jcol->data());
+  if (jcol->strdata()) cbb.add_strdata(jcol->strdata());
+  if (sttype != jay::Stats_NONE) {
+    cbb.add_stats_type(sttype);
+    cbb.add_stats(jstats);
+  }
+  cbb.add_codec(jcol->codec());
+  cbb.add_block_size(jcol->block_size());
+  cbb.add_data_size(jcol->data_size());
+  cbb.add_strdata_size(jcol->strdata_size());
+  cbb.add_data_blocks(data_blocks);
+  cbb.add_strdata_blocks(strdata_blocks);
+  cbb.add_zones_int(zones_int);
+  cbb.add_zones_float(zones_float);
+  cbb.add_codes(codes);
+  cbb.add_categories(categories);
+  return cbb.Finish();
+}
+
+
+
+/**
+ * Save memory range `[data, data + len)` into the output buffer `wb`,
+ * compressing it block-by-block with the given `codec`. The blocks
+ * are compressed in parallel, and then written into the output in
+ * order, back-to-back. A block that does not become smaller after
+ * compression is written uncompressed. The sizes of all saved blocks
+ * are stored in the `blocks` vector.
+ */
+static jay::Buffer saveCompressedRange(
+    const void* data, size_t len, jay::Codec codec, WritableBuffer* wb,
+    std::vector<uint64_t>* blocks)
+{
+  class CompressTask : public dt::OrderedTask {
+    private:
+      const char* data_;
+      size_t len_;
+      WritableBuffer* wb_;
+      std::vector<uint64_t>* blocks_;
+      size_t* pos0_;
+      std::unique_ptr<char[]> buffer_;
+      std::unique_ptr<dt::write::zlib_writer> zwriter_;
+      dt::CString out_;
+      size_t write_at_;
+      jay::Codec codec_;
+      size_t : 56;
+
+    public:
+      CompressTask(const void* data, size_t len, jay::Codec codec,
+                   WritableBuffer* wb, std::vector<uint64_t>* blocks,
+                   size_t* pos0)
+        : data_(static_cast<const char*>(data)),
+          len_(len),
+          wb_(wb),
+          blocks_(blocks),
+          pos0_(pos0),
+          write_at_(0),
+          codec_(codec)
+      {
+        if (codec == jay::Codec_Lz4) {
+          buffer_ = std::unique_ptr<char[]>(new char[JAY_BLOCK_SIZE]);
+        } else {
+          zwriter_ = std::make_unique<dt::write::zlib_writer>(
+                        Z_DEFAULT_COMPRESSION, 15);
+        }
+      }
+
+      void start(size_t i) override {
+        const char* block = data_ + i * JAY_BLOCK_SIZE;
+        size_t size = std::min(JAY_BLOCK_SIZE, len_ - i * JAY_BLOCK_SIZE);
+        out_ = dt::CString(block, size);
+        if (codec_ == jay::Codec_Lz4) {
+          // A compressed block must be strictly smaller than the original,
+          // since blocks of equal sizes are read as uncompressed.
+          size_t csize = dt::lz4::compress(block, size, buffer_.get(), size - 1);
+          if (csize) out_ = dt::CString(buffer_.get(), csize);
+        } else {
+          zwriter_->compress(out_);
+          if (out_.size() >= size) out_ = dt::CString(block, size);
+        }
+      }
+
+      void order(size_t i) override {
+        write_at_ = wb_->prepare_write(out_.size(), out_.data());
+        if (i == 0) *pos0_ = write_at_;
+        blocks_->push_back(out_.size());
+      }
+
+      void finish(size_t) override {
+        wb_->write_at(write_at_, out_.size(), out_.data());
+      }
+  };
+
+  blocks->clear();
+  size_t nblocks = (len + JAY_BLOCK_SIZE - 1) / JAY_BLOCK_SIZE;
+  if (nblocks == 0) {
+    return saveMemoryRange(data, 0, wb);
+  }
+  size_t pos0 = 0;
+  dt::parallel_for_ordered(nblocks, dt::NThreads(),
+    [&] {
+      return std::make_unique<CompressTask>(data, len, codec, wb, blocks,
+                                            &pos0);
+    });
+
+  size_t total = 0;
+  for (uint64_t b : *blocks) total += b;
+  if (total & 7) {  // Align the buffer to 8-byte boundary
+    uint64_t zero = 0;
+    wb->write(8 - (total & 7), &zero);
+  }
+  xassert(pos0 >= 8);
+  return jay::Buffer(pos0 - 8, total);
+}
+
+
+
 template <typename T, typename StatBuilder>
 static flatbuffers::Offset<void> saveStats(
     Stats* stats, flatbuffers::FlatBufferBuilder& fbb)
@@ -404,7 +839,8 @@ static flatbuffers::Offset<void> saveStats(
 namespace py {
 
 static const char* doc_to_jay =
-R"(to_jay(self, path=None, method='auto')
+R"(to_jay(self, path=None, method='auto', compression=None, chunk_nrows=None,
+       append=False)
 --
 
 Save this frame to a binary file on disk, in `.jay` format.
@@ -424,6 +860,35 @@ method: 'mmap' | 'write' | 'auto'
     may be slower. This parameter has no effect when `path` is
     omitted.
 
+compression: None | 'lz4' | 'zlib'
+    If specified, the data of each column will be split into blocks
+    of 1MB, and each block compressed independently with the given
+    codec. The "lz4" codec is very fast both when writing and when
+    reading the data, while "zlib" achieves better compression at
+    the cost of speed. The compressed columns are decompressed in
+    parallel when they are accessed for the first time after the
+    file was opened.
+
+chunk_nrows: None | int
+    If specified, the rows of the frame will be split into row groups
+    of this many rows each, and for every numeric column the file will
+    store a "zone map": the min/max value and the number of NAs within
+    each row group. When the frame is opened back, a filter such as
+    ``DT[f.x > 0, :]`` will skip the row groups where the condition
+    cannot be true. Thus, the selective queries on large frames
+    will only need to touch a small fraction of the data.
+
+append: bool
+    If True, and the file `path` already exists, then the rows of this
+    frame will be appended to the data stored in that file, instead of
+    overwriting it. The existing data is copied as-is, without being
+    decoded or re-compressed, into a temporary file which then
+    replaces the original one; thus the original file remains intact
+    if the append fails. The frame must have the same column names
+    and types as the frame stored in the file. When the file was
+    saved with `chunk_nrows`, the new rows will use the same row
+    groups size.
+
 return: None | bytes
     If the `path` parameter is given, this method returns nothing.
     However, if `path` was omitted, the return value is a `bytes`
@@ -431,7 +896,10 @@ return: None | bytes
 )";
 
 static PKArgs args_to_jay(
-  1, 0, 1, false, false, {"path", "method"}, "to_jay", doc_to_jay);
+  1, 0, 4, false, false,
+  {"path", "method", "compression", "chunk_nrows", "append"},
+  "to_jay",
+  doc_to_jay);
 
 
 oobj Frame::to_jay(const PKArgs& args) {
@@ -455,14 +923,48 @@ oobj Frame::to_jay(const PKArgs& args) {
         "one of 'mmap', 'write' or 'auto'; instead got '" << str_method << "'";
   }
 
+  // compression
+  auto codec = jay::Codec_None;
+  if (!args[2].is_none_or_undefined()) {
+    auto str_compression = args[2].to_string();
+    if (str_compression == "lz4") codec = jay::Codec_Lz4;
+    else if (str_compression == "zlib") codec = jay::Codec_Zlib;
+    else {
+      throw ValueError() << "Parameter `compression` in Frame.to_jay() "
+          "should be one of None, 'lz4' or 'zlib'; instead got '"
+          << str_compression << "'";
+    }
+  }
+
+  // chunk_nrows
+  size_t chunk_nrows = 0;
+  if (!args[3].is_none_or_undefined()) {
+    chunk_nrows = args[3].to_size_t();
+    if (chunk_nrows == 0) {
+      throw ValueError() << "Parameter `chunk_nrows` in Frame.to_jay() "
+          "should be positive";
+    }
+  }
+
+  // append
+  bool append = args[4].to<bool>(false);
+
   if (filename.empty()) {
-    Buffer mr = dt->save_jay();
+    if (append) {
+      throw ValueError() << "Parameter `append` in Frame.to_jay() cannot be "
+          "used when the `path` is not given";
+    }
+    Buffer mr = dt->save_jay(codec, chunk_nrows);
     auto data = static_cast<const char*>(mr.xptr());
     auto size = static_cast<Py_ssize_t>(mr.size());
     return oobj::from_new_reference(PyBytes_FromStringAndSize(data, size));
   }
+  else if (append) {
+    dt->append_jay(filename, method, codec, chunk_nrows);
+    return None();
+  }
   else {
-    dt->save_jay(filename, method);
+    dt->save_jay(filename, method, codec, chunk_nrows);
     return None();
   }
 }
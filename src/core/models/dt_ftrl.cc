@@ -588,9 +588,6 @@ FtrlFitOutput Ftrl<T>::fit(T(*linkfn)(T),
   }
 
 
-  // Mutex to update global feature importance information
-  std::mutex m;
-
   // Calculate work amounts for full fit iterations, last fit iteration and
   // validation.
   size_t work_total = (niterations - 1) * get_work_amount(iteration_nrows);
@@ -602,21 +599,37 @@ FtrlFitOutput Ftrl<T>::fit(T(*linkfn)(T),
   job.set_message("Fitting...");
   NThreads nthreads = nthreads_from_niters(iteration_nrows, MIN_ROWS_PER_THREAD);
 
+  // Feature importances accumulated by each of the threads, these
+  // are added to the global ones when the training is over.
+  std::vector<tptr<T>> thread_fi(nthreads.get());
+
+  // The threads update the shared weights `z` and `n` without any
+  // locking (Hogwild): an update may occasionally be overwritten by
+  // another thread, which has little effect on the convergence
+  // since the features are sparse. For the same reason, when no
+  // validation is done, there is no synchronization between the
+  // iterations: each thread proceeds to the next iteration as soon
+  // as it is done with its own chunks of rows in the current one.
   dt::parallel_region(nthreads,
     [&]() {
       // Each thread gets a private storage for hashes,
       // temporary weights and feature importances.
       uint64ptr x = uint64ptr(new uint64_t[nfeatures]);
       tptr<T> w = tptr<T>(new T[nfeatures]);
-      tptr<T> fi = tptr<T>(new T[nfeatures]());
+      size_t ith = dt::this_thread_index();
+      xassert(ith < thread_fi.size());
+      thread_fi[ith] = tptr<T>(new T[nfeatures]());
+      T* fi = thread_fi[ith].get();
 
       for (size_t iter = 0; iter < niterations; ++iter) {
         size_t iteration_start = iter * iteration_nrows;
-        iteration_end = (iter == niterations - 1)? total_nrows :
-                                                   (iter + 1) * iteration_nrows;
-        size_t iteration_size = iteration_end - iteration_start;
+        size_t iter_end = (iter == niterations - 1)? total_nrows :
+                                                     (iter + 1) * iteration_nrows;
+        size_t iteration_size = iter_end - iteration_start;
+        if (ith == 0) iteration_end = iter_end;
 
-        // Training.
+        // Training. Each thread processes contiguous chunks of rows,
+        // so that the data of the hashed columns stays in cache.
         dt::nested_for_static(iteration_size, ChunkSize(MIN_ROWS_PER_THREAD), [&](size_t i) {
           size_t ii = (iteration_start + i) % dt_X_train->nrows();
           U value;
@@ -647,10 +660,10 @@ FtrlFitOutput Ftrl<T>::fit(T(*linkfn)(T),
           }
 
         }); // End training.
-        barrier();
 
         // Validation and early stopping.
         if (validation) {
+          barrier();
           dt::atomic<T> loss_global {0.0};
           T loss_local = 0.0;
 
@@ -692,7 +705,7 @@ FtrlFitOutput Ftrl<T>::fit(T(*linkfn)(T),
           }
           barrier();
 
-          double epoch = static_cast<double>(iteration_end) / static_cast<double>(dt_X_train->nrows());
+          double epoch = static_cast<double>(iter_end) / static_cast<double>(dt_X_train->nrows());
           if (std::isnan(loss_old)) {
             if (dt::this_thread_index() == 0) {
               job.set_message("Stopping at epoch " + tostr(epoch) +
@@ -709,18 +722,20 @@ FtrlFitOutput Ftrl<T>::fit(T(*linkfn)(T),
           }
         } // End validation
 
-        // Update global feature importances with the local data.
-        std::lock_guard<std::mutex> lock(m);
-        for (size_t i = 0; i < nfeatures; ++i) {
-          data_fi[i] += fi[i];
-        }
-
       } // End iteration.
 
     }
   );
   job.done();
 
+  // Update global feature importances with the thread-local data.
+  for (const tptr<T>& fi : thread_fi) {
+    if (!fi) continue;
+    for (size_t i = 0; i < nfeatures; ++i) {
+      data_fi[i] += fi[i];
+    }
+  }
+
   // Reset model stats after training, so that min gets re-computed
   // in `py::Validator::has_negatives()` during unpickling.
   reset_model_stats();
@@ -742,9 +757,13 @@ T Ftrl<T>::predict_row(const uint64ptr& x, tptr<T>& w, size_t k, F fifn) {
   T wTx = T(0);
   for (size_t i = 0; i < nfeatures; ++i) {
     size_t j = x[i];
-    T absw = std::max(std::abs(z[k][j]) - lambda1, T(0)) /
-             (std::sqrt(n[k][j]) * ialpha + gamma);
-    w[i] = -std::copysign(absw, z[k][j]);
+    // The weights may be concurrently modified by other threads
+    // during training, so each of them is read only once.
+    T zj = z[k][j];
+    T nj = n[k][j];
+    T absw = std::max(std::abs(zj) - lambda1, T(0)) /
+             (std::sqrt(nj) * ialpha + gamma);
+    w[i] = -std::copysign(absw, zj);
     wTx += w[i];
     fifn(i, absw);
   }
@@ -767,9 +786,13 @@ void Ftrl<T>::update(const uint64ptr& x,
   T gsq = g * g;
   for (size_t i = 0; i < nfeatures; ++i) {
     size_t j = x[i];
-    T sigma = (std::sqrt(n[k][j] + gsq) - std::sqrt(n[k][j])) * ialpha;
+    // Lock-free update, see the comment in `fit()`. Reading `n` once
+    // ensures that `sigma` is computed from a consistent value, so
+    // that a concurrent write cannot make it negative.
+    T nj = n[k][j];
+    T sigma = (std::sqrt(nj + gsq) - std::sqrt(nj)) * ialpha;
     z[k][j] += g - sigma * w[i];
-    n[k][j] += gsq;
+    n[k][j] = nj + gsq;
   }
 }
 
@@ -150,16 +150,3 @@ inline uint64_t getblock64(const uint64_t* p, uint64_t i) {
   return p[i];
 }
 
-
-/**
- *  Finalization mix - force all bits of a hash block to avalanche
- */
-inline uint64_t fmix64(uint64_t k) {
-  k ^= k >> 33;
-  k *= 0xff51afd7ed558ccdLLU;
-  k ^= k >> 33;
-  k *= 0xc4ceb9fe1a85ec53LLU;
-  k ^= k >> 33;
-
-  return k;
-}
@@ -13,7 +13,20 @@ void hash_murmur3(const void *, uint64_t, void *);
 
 uint64_t ROTL64(uint64_t, int8_t);
 uint64_t getblock64 (const uint64_t *, uint64_t);
-uint64_t fmix64 (uint64_t);
+
+
+/**
+ *  Finalization mix - force all bits of a hash block to avalanche
+ */
+inline uint64_t fmix64(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdLLU;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53LLU;
+  k ^= k >> 33;
+
+  return k;
+}
 
 
 #endif
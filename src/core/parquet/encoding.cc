@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>            // std::min
+#include "parquet/parquet.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+namespace dt {
+namespace parquet {
+
+
+const char* codec_name(Codec codec) {
+  switch (codec) {
+    case Codec::UNCOMPRESSED: return "UNCOMPRESSED";
+    case Codec::SNAPPY:       return "SNAPPY";
+    case Codec::GZIP:         return "GZIP";
+    case Codec::LZO:          return "LZO";
+    case Codec::BROTLI:       return "BROTLI";
+    case Codec::LZ4:          return "LZ4";
+    case Codec::ZSTD:         return "ZSTD";
+    case Codec::LZ4_RAW:      return "LZ4_RAW";
+  }
+  return "UNKNOWN";
+}
+
+const char* encoding_name(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::PLAIN:                   return "PLAIN";
+    case Encoding::PLAIN_DICTIONARY:        return "PLAIN_DICTIONARY";
+    case Encoding::RLE:                     return "RLE";
+    case Encoding::BIT_PACKED:              return "BIT_PACKED";
+    case Encoding::DELTA_BINARY_PACKED:     return "DELTA_BINARY_PACKED";
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY: return "DELTA_LENGTH_BYTE_ARRAY";
+    case Encoding::DELTA_BYTE_ARRAY:        return "DELTA_BYTE_ARRAY";
+    case Encoding::RLE_DICTIONARY:          return "RLE_DICTIONARY";
+    case Encoding::BYTE_STREAM_SPLIT:       return "BYTE_STREAM_SPLIT";
+  }
+  return "UNKNOWN";
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// RLE / bit-packing hybrid encoding
+//------------------------------------------------------------------------------
+
+static Error rle_error() {
+  return IOError() << "Invalid Parquet file: malformed RLE-encoded data";
+}
+
+
+int bit_width(uint32_t maxvalue) {
+  int w = 0;
+  while (maxvalue) {
+    w++;
+    maxvalue >>= 1;
+  }
+  return w;
+}
+
+
+static void write_uleb128(uint64_t value, std::vector<uint8_t>& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+
+// Append `ngroups` groups of 8 values each, bit-packed LSB-first
+static void write_bitpacked(const uint32_t* values, size_t nvalues,
+                            size_t ngroups, int bit_width,
+                            std::vector<uint8_t>& out)
+{
+  write_uleb128((ngroups << 1) | 1, out);
+  uint64_t acc = 0;
+  int nbits = 0;
+  for (size_t i = 0; i < ngroups * 8; ++i) {
+    uint64_t v = (i < nvalues)? values[i] : 0;
+    acc |= v << nbits;
+    nbits += bit_width;
+    while (nbits >= 8) {
+      out.push_back(static_cast<uint8_t>(acc));
+      acc >>= 8;
+      nbits -= 8;
+    }
+  }
+  xassert(nbits == 0);
+}
+
+
+void rle_encode(const uint32_t* values, size_t n, int bit_width,
+                std::vector<uint8_t>& out)
+{
+  xassert(bit_width >= 0 && bit_width <= 32);
+  size_t value_nbytes = static_cast<size_t>(bit_width + 7) / 8;
+  size_t i = 0;
+  size_t literal_start = 0;  // start of the pending bit-packed groups
+  while (i < n) {
+    uint32_t v = values[i];
+    size_t j = i + 1;
+    while (j < n && values[j] == v) j++;
+    if (j - i >= 8) {
+      if (i > literal_start) {
+        write_bitpacked(values + literal_start, i - literal_start,
+                        (i - literal_start) / 8, bit_width, out);
+      }
+      write_uleb128(static_cast<uint64_t>(j - i) << 1, out);
+      for (size_t k = 0; k < value_nbytes; ++k) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * k)));
+      }
+      i = j;
+      literal_start = i;
+    } else {
+      i = std::min(i + 8, n);
+    }
+  }
+  if (n > literal_start) {
+    size_t nvalues = n - literal_start;
+    write_bitpacked(values + literal_start, nvalues, (nvalues + 7) / 8,
+                    bit_width, out);
+  }
+}
+
+
+void rle_decode(const uint8_t* ptr, size_t size, int bit_width,
+                uint32_t* out, size_t n)
+{
+  if (bit_width < 0 || bit_width > 32) throw rle_error();
+  const uint8_t* end = ptr + size;
+  size_t value_nbytes = static_cast<size_t>(bit_width + 7) / 8;
+  uint64_t mask = (uint64_t(1) << bit_width) - 1;
+  size_t i = 0;
+  while (i < n) {
+    uint64_t header = 0;
+    for (int shift = 0; ; shift += 7) {
+      if (ptr == end || shift > 63) throw rle_error();
+      uint8_t b = *ptr++;
+      header |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if (!(b & 0x80)) break;
+    }
+    if (header & 1) {
+      // bit-packed run of (header >> 1) groups of 8 values
+      uint64_t ngroups = header >> 1;
+      if (ngroups > static_cast<uint64_t>(end - ptr)) throw rle_error();
+      size_t nvalues = static_cast<size_t>(ngroups) * 8;
+      size_t nbytes = static_cast<size_t>(ngroups) *
+                      static_cast<size_t>(bit_width);
+      if (nbytes > static_cast<size_t>(end - ptr)) throw rle_error();
+      size_t ntake = std::min(nvalues, n - i);
+      uint64_t acc = 0;
+      int nbits = 0;
+      const uint8_t* p = ptr;
+      for (size_t k = 0; k < ntake; ++k) {
+        while (nbits < bit_width) {
+          acc |= static_cast<uint64_t>(*p++) << nbits;
+          nbits += 8;
+        }
+        out[i++] = static_cast<uint32_t>(acc & mask);
+        acc >>= bit_width;
+        nbits -= bit_width;
+      }
+      ptr += nbytes;
+    } else {
+      // RLE run
+      uint64_t count = header >> 1;
+      if (value_nbytes > static_cast<size_t>(end - ptr)) throw rle_error();
+      uint32_t v = 0;
+      for (size_t k = 0; k < value_nbytes; ++k) {
+        v |= static_cast<uint32_t>(ptr[k]) << (8 * k);
+      }
+      ptr += value_nbytes;
+      if (count == 0) throw rle_error();
+      size_t ntake = static_cast<size_t>(
+                        std::min(count, static_cast<uint64_t>(n - i)));
+      for (size_t k = 0; k < ntake; ++k) out[i++] = v;
+    }
+  }
+}
+
+
+
+}}  // namespace dt::parquet
@@ -0,0 +1,1325 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>            // std::min
+#include <atomic>               // std::atomic
+#include <cmath>                // std::pow
+#include <cstring>              // std::memcpy, std::memcmp
+#include <string>               // std::string
+#include <type_traits>          // std::make_unsigned
+#include <vector>               // std::vector
+#include "parallel/api.h"
+#include "parquet/parquet.h"
+#include "parquet/thrift.h"
+#include "read/gunzip.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+#include "utils/lz4.h"
+#include "utils/snappy.h"
+#include "datatable.h"
+#include "stype.h"
+namespace dt {
+namespace parquet {
+
+static Error invalid_file() {
+  return IOError() << "Invalid Parquet file: ";
+}
+
+static Error unsupported() {
+  return NotImplError() << "Cannot read Parquet file: ";
+}
+
+
+
+//------------------------------------------------------------------------------
+// File metadata
+//------------------------------------------------------------------------------
+
+struct SchemaElement {
+  std::string name;
+  PhysicalType type;
+  Repetition repetition;
+  ConvertedType converted_type;
+  LogicalType logical_type;
+  int32_t num_children;
+  int32_t type_length;
+  int32_t scale;
+  int32_t int_bits;
+  bool int_signed;
+  bool has_type;
+  size_t : 48;
+};
+
+struct ChunkInfo {
+  PhysicalType type;
+  Codec codec;
+  int64_t num_values;
+  int64_t total_compressed_size;
+  int64_t data_page_offset;
+  int64_t dictionary_page_offset;
+};
+
+struct RowGroupInfo {
+  std::vector<ChunkInfo> columns;
+  int64_t num_rows;
+};
+
+struct FileMeta {
+  std::vector<SchemaElement> schema;
+  std::vector<RowGroupInfo> row_groups;
+  int64_t num_rows;
+};
+
+
+static void read_logical_type(ThriftReader& tr, SchemaElement& el) {
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    if (type != TType::STRUCT) {
+      tr.skip(type);
+      continue;
+    }
+    el.logical_type = static_cast<LogicalType>(id);
+    if (id == static_cast<int16_t>(LogicalType::INTEGER)) {
+      tr.begin_struct();
+      int16_t fid;
+      TType ftype;
+      while (tr.read_field(&fid, &ftype)) {
+        if (fid == 1 && ftype == TType::BYTE) {
+          // i8 fields are stored as a single raw byte
+          el.int_bits = tr.read_i8();
+        }
+        else if (fid == 2) el.int_signed = tr.read_bool(ftype);
+        else tr.skip(ftype);
+      }
+    }
+    else if (id == static_cast<int16_t>(LogicalType::DECIMAL)) {
+      tr.begin_struct();
+      int16_t fid;
+      TType ftype;
+      while (tr.read_field(&fid, &ftype)) {
+        if (fid == 1 && ftype == TType::I32) el.scale = tr.read_i32();
+        else tr.skip(ftype);
+      }
+    }
+    else {
+      tr.skip(type);
+    }
+  }
+}
+
+
+static SchemaElement read_schema_element(ThriftReader& tr) {
+  SchemaElement el;
+  el.type = PhysicalType::INT32;
+  el.repetition = Repetition::REQUIRED;
+  el.converted_type = ConvertedType::NONE;
+  el.logical_type = LogicalType::NONE;
+  el.num_children = 0;
+  el.type_length = 0;
+  el.scale = 0;
+  el.int_bits = 0;
+  el.int_signed = true;
+  el.has_type = false;
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    switch (id) {
+      case 1:
+        el.type = static_cast<PhysicalType>(tr.read_i32());
+        el.has_type = true;
+        break;
+      case 2: el.type_length = tr.read_i32(); break;
+      case 3: el.repetition = static_cast<Repetition>(tr.read_i32()); break;
+      case 4: el.name = tr.read_string(); break;
+      case 5: el.num_children = tr.read_i32(); break;
+      case 6: el.converted_type = static_cast<ConvertedType>(tr.read_i32()); break;
+      case 7: el.scale = tr.read_i32(); break;
+      case 10: read_logical_type(tr, el); break;
+      default: tr.skip(type);
+    }
+  }
+  return el;
+}
+
+
+static void read_column_metadata(ThriftReader& tr, ChunkInfo& info) {
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    switch (id) {
+      case 1: info.type = static_cast<PhysicalType>(tr.read_i32()); break;
+      case 4: info.codec = static_cast<Codec>(tr.read_i32()); break;
+      case 5: info.num_values = tr.read_i64(); break;
+      case 7: info.total_compressed_size = tr.read_i64(); break;
+      case 9: info.data_page_offset = tr.read_i64(); break;
+      case 11: info.dictionary_page_offset = tr.read_i64(); break;
+      default: tr.skip(type);
+    }
+  }
+}
+
+
+static ChunkInfo read_column_chunk(ThriftReader& tr) {
+  ChunkInfo info;
+  info.type = PhysicalType::INT32;
+  info.codec = Codec::UNCOMPRESSED;
+  info.num_values = 0;
+  info.total_compressed_size = -1;
+  info.data_page_offset = -1;
+  info.dictionary_page_offset = -1;
+  bool has_path = false;
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    switch (id) {
+      case 1: tr.skip(type); has_path = true; break;
+      case 3: read_column_metadata(tr, info); break;
+      default: tr.skip(type);
+    }
+  }
+  if (has_path) {
+    throw unsupported() << "column chunks stored in external files are not "
+        "supported";
+  }
+  if (info.data_page_offset < 0 || info.total_compressed_size < 0) {
+    throw invalid_file() << "column chunk metadata is missing";
+  }
+  return info;
+}
+
+
+static RowGroupInfo read_row_group(ThriftReader& tr) {
+  RowGroupInfo rg;
+  rg.num_rows = -1;
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    switch (id) {
+      case 1: {
+        TType etype;
+        size_t n = tr.read_list(&etype);
+        if (etype != TType::STRUCT) throw invalid_file() << "bad row group";
+        for (size_t i = 0; i < n; ++i) {
+          rg.columns.push_back(read_column_chunk(tr));
+        }
+        break;
+      }
+      case 3: rg.num_rows = tr.read_i64(); break;
+      default: tr.skip(type);
+    }
+  }
+  if (rg.num_rows < 0) throw invalid_file() << "bad row group";
+  return rg;
+}
+
+
+static FileMeta read_file_meta(const uint8_t* ptr, size_t size) {
+  FileMeta meta;
+  meta.num_rows = -1;
+  ThriftReader tr(ptr, size);
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    switch (id) {
+      case 2: {
+        TType etype;
+        size_t n = tr.read_list(&etype);
+        if (etype != TType::STRUCT) throw invalid_file() << "bad schema";
+        for (size_t i = 0; i < n; ++i) {
+          meta.schema.push_back(read_schema_element(tr));
+        }
+        break;
+      }
+      case 3: meta.num_rows = tr.read_i64(); break;
+      case 4: {
+        TType etype;
+        size_t n = tr.read_list(&etype);
+        if (etype != TType::STRUCT) throw invalid_file() << "bad row groups";
+        for (size_t i = 0; i < n; ++i) {
+          meta.row_groups.push_back(read_row_group(tr));
+        }
+        break;
+      }
+      default: tr.skip(type);
+    }
+  }
+  if (meta.num_rows < 0 || meta.schema.empty()) {
+    throw invalid_file() << "the file metadata is incomplete";
+  }
+  return meta;
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Page headers
+//------------------------------------------------------------------------------
+
+struct PageHeader {
+  PageType type;
+  int32_t uncompressed_size;
+  int32_t compressed_size;
+  int32_t num_values;
+  Encoding encoding;
+  Encoding def_encoding;
+  int32_t def_levels_size;   // V2 only
+  int32_t rep_levels_size;   // V2 only
+  bool is_compressed;        // V2 only
+  size_t : 56;
+};
+
+
+// Reads DataPageHeader, DataPageHeaderV2 or DictionaryPageHeader; the
+// first two fields of the latter are the same as in DataPageHeader.
+static void read_data_page_header(ThriftReader& tr, PageHeader& ph,
+                                  bool v2, bool dict = false)
+{
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    if (id == 1) ph.num_values = tr.read_i32();
+    else if (dict && id != 2) tr.skip(type);
+    else if (!v2 && id == 2) ph.encoding = static_cast<Encoding>(tr.read_i32());
+    else if (!v2 && id == 3) {
+      ph.def_encoding = static_cast<Encoding>(tr.read_i32());
+    }
+    else if (v2 && id == 4) ph.encoding = static_cast<Encoding>(tr.read_i32());
+    else if (v2 && id == 5) ph.def_levels_size = tr.read_i32();
+    else if (v2 && id == 6) ph.rep_levels_size = tr.read_i32();
+    else if (v2 && id == 7) ph.is_compressed = tr.read_bool(type);
+    else tr.skip(type);
+  }
+}
+
+
+static size_t read_page_header(const uint8_t* ptr, size_t size,
+                               PageHeader& ph)
+{
+  ph.type = PageType::INDEX_PAGE;
+  ph.uncompressed_size = -1;
+  ph.compressed_size = -1;
+  ph.num_values = -1;
+  ph.encoding = Encoding::PLAIN;
+  ph.def_encoding = Encoding::RLE;
+  ph.def_levels_size = 0;
+  ph.rep_levels_size = 0;
+  ph.is_compressed = true;
+  ThriftReader tr(ptr, size);
+  tr.begin_struct();
+  int16_t id;
+  TType type;
+  while (tr.read_field(&id, &type)) {
+    switch (id) {
+      case 1: ph.type = static_cast<PageType>(tr.read_i32()); break;
+      case 2: ph.uncompressed_size = tr.read_i32(); break;
+      case 3: ph.compressed_size = tr.read_i32(); break;
+      case 5: read_data_page_header(tr, ph, false); break;
+      case 7: read_data_page_header(tr, ph, false, true); break;
+      case 8: read_data_page_header(tr, ph, true); break;
+      default: tr.skip(type);
+    }
+  }
+  if (ph.uncompressed_size < 0 || ph.compressed_size < 0 ||
+      ph.def_levels_size < 0 || ph.rep_levels_size < 0) {
+    throw invalid_file() << "malformed page header";
+  }
+  return tr.position();
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Value sinks
+//------------------------------------------------------------------------------
+
+/**
+  * How the physical values stored in the file are converted into the
+  * values of the output column.
+  */
+enum class Conversion : uint8_t {
+  CAST,       // static_cast into the output type
+  UNSIGNED,   // reinterpret as unsigned, then widen
+  DECIMAL,    // multiply by 10^(-scale), giving a float64
+  INT96,      // legacy timestamps: nanoseconds since the epoch
+};
+
+struct Int96 {
+  uint8_t bytes[12];
+};
+
+template <Conversion C> struct Converter;
+
+template <> struct Converter<Conversion::CAST> {
+  template <typename T, typename P>
+  static T conv(P x, double) { return static_cast<T>(x); }
+};
+
+template <> struct Converter<Conversion::UNSIGNED> {
+  template <typename T, typename P>
+  static T conv(P x, double) {
+    return static_cast<T>(static_cast<typename std::make_unsigned<P>::type>(x));
+  }
+};
+
+template <> struct Converter<Conversion::DECIMAL> {
+  template <typename T, typename P>
+  static T conv(P x, double scale) {
+    return static_cast<T>(static_cast<double>(x) * scale);
+  }
+};
+
+template <> struct Converter<Conversion::INT96> {
+  template <typename T, typename P>
+  static T conv(const P& x, double) {
+    // 8 bytes of nanoseconds within the day, followed by 4 bytes of
+    // the Julian day number
+    constexpr int64_t JULIAN_EPOCH = 2440588;
+    constexpr int64_t NANOS_PER_DAY = 86400LL * 1000000000LL;
+    int64_t nanos;
+    int32_t day;
+    std::memcpy(&nanos, x.bytes, 8);
+    std::memcpy(&day, x.bytes + 8, 4);
+    return static_cast<T>((day - JULIAN_EPOCH) * NANOS_PER_DAY + nanos);
+  }
+};
+
+
+
+/**
+  * A sink receives the decoded values of one column chunk, and writes
+  * them into the output. Each sink implements the following methods,
+  * all of which receive `n` values of a page, of which `nvalid` are
+  * not NA; `defs` are the definition levels (or nullptr when all
+  * values are defined):
+  *
+  *   set_dictionary(ptr, size, n)
+  *   dict_size()
+  *   plain(ptr, size, defs, n, nvalid)
+  *   dictionary(indices, defs, n)
+  *   rle(ptr, size, defs, n, nvalid)
+  */
+template <typename P, typename T, Conversion C>
+class FixedSink {
+  private:
+    T* out_;
+    double scale_;
+    std::vector<P> dict_;
+
+  public:
+    FixedSink(T* out, double scale) : out_(out), scale_(scale) {}
+
+    void set_dictionary(const uint8_t* ptr, size_t size, size_t n) {
+      if (n > size / sizeof(P)) throw invalid_file() << "bad dictionary page";
+      dict_.resize(n);
+      if (n) std::memcpy(dict_.data(), ptr, n * sizeof(P));
+    }
+
+    size_t dict_size() const { return dict_.size(); }
+
+    void plain(const uint8_t* ptr, size_t size, const uint32_t* defs,
+               size_t n, size_t nvalid)
+    {
+      if (nvalid > size / sizeof(P)) throw invalid_file() << "bad data page";
+      P x;
+      for (size_t k = 0; k < n; ++k) {
+        if (defs && !defs[k]) {
+          *out_++ = GETNA<T>();
+        } else {
+          std::memcpy(&x, ptr, sizeof(P));
+          ptr += sizeof(P);
+          *out_++ = Converter<C>::template conv<T, P>(x, scale_);
+        }
+      }
+    }
+
+    void dictionary(const uint32_t* indices, const uint32_t* defs, size_t n) {
+      for (size_t k = 0; k < n; ++k) {
+        if (defs && !defs[k]) {
+          *out_++ = GETNA<T>();
+        } else {
+          *out_++ = Converter<C>::template conv<T, P>(dict_[*indices++],
+                                                      scale_);
+        }
+      }
+    }
+
+    void rle(const uint8_t*, size_t, const uint32_t*, size_t, size_t) {
+      throw unsupported() << "RLE encoding of non-boolean values is not "
+          "supported";
+    }
+};
+
+
+/**
+  * Decimals stored as FIXED_LEN_BYTE_ARRAY hold big-endian two's
+  * complement integers of `width` bytes, which are converted into
+  * float64 values.
+  */
+class DecimalBytesSink {
+  private:
+    double* out_;
+    double scale_;
+    size_t width_;
+    std::vector<double> dict_;
+
+  public:
+    DecimalBytesSink(double* out, double scale, size_t width)
+      : out_(out), scale_(scale), width_(width) {}
+
+    void set_dictionary(const uint8_t* ptr, size_t size, size_t n) {
+      if (n > size / width_) throw invalid_file() << "bad dictionary page";
+      dict_.resize(n);
+      for (size_t k = 0; k < n; ++k) {
+        dict_[k] = convert(ptr + k * width_);
+      }
+    }
+
+    size_t dict_size() const { return dict_.size(); }
+
+    void plain(const uint8_t* ptr, size_t size, const uint32_t* defs,
+               size_t n, size_t nvalid)
+    {
+      if (nvalid > size / width_) throw invalid_file() << "bad data page";
+      for (size_t k = 0; k < n; ++k) {
+        if (defs && !defs[k]) {
+          *out_++ = GETNA<double>();
+        } else {
+          *out_++ = convert(ptr);
+          ptr += width_;
+        }
+      }
+    }
+
+    void dictionary(const uint32_t* indices, const uint32_t* defs, size_t n) {
+      for (size_t k = 0; k < n; ++k) {
+        *out_++ = (defs && !defs[k])? GETNA<double>() : dict_[*indices++];
+      }
+    }
+
+    void rle(const uint8_t*, size_t, const uint32_t*, size_t, size_t) {
+      throw unsupported() << "RLE encoding of decimals is not supported";
+    }
+
+  private:
+    double convert(const uint8_t* ptr) const {
+      // The leading byte carries the sign; the remaining bytes are added
+      // as unsigned digits in base 256.
+      double value = static_cast<double>(static_cast<int8_t>(ptr[0]));
+      for (size_t i = 1; i < width_; ++i) {
+        value = value * 256.0 + static_cast<double>(ptr[i]);
+      }
+      return value * scale_;
+    }
+};
+
+
+/**
+  * Values of UINT_64 columns are written into an int64 output as they
+  * are, while keeping track of whether any of them exceeds INT64_MAX
+  * (and thus was written as a negative number). Such columns are then
+  * decoded again into float64.
+  */
+class Uint64Sink {
+  private:
+    FixedSink<int64_t, int64_t, Conversion::CAST> sink_;
+    const int64_t* out_;
+    bool overflow_;
+    size_t : 56;
+
+  public:
+    explicit Uint64Sink(int64_t* out)
+      : sink_(out, 1.0), out_(out), overflow_(false) {}
+
+    bool overflow() const { return overflow_; }
+
+    void set_dictionary(const uint8_t* ptr, size_t size, size_t n) {
+      sink_.set_dictionary(ptr, size, n);
+    }
+
+    size_t dict_size() const { return sink_.dict_size(); }
+
+    void plain(const uint8_t* ptr, size_t size, const uint32_t* defs,
+               size_t n, size_t nvalid)
+    {
+      sink_.plain(ptr, size, defs, n, nvalid);
+      check(defs, n);
+    }
+
+    void dictionary(const uint32_t* indices, const uint32_t* defs, size_t n) {
+      sink_.dictionary(indices, defs, n);
+      check(defs, n);
+    }
+
+    void rle(const uint8_t* ptr, size_t size, const uint32_t* defs,
+             size_t n, size_t nvalid)
+    {
+      sink_.rle(ptr, size, defs, n, nvalid);
+    }
+
+  private:
+    void check(const uint32_t* defs, size_t n) {
+      for (size_t k = 0; k < n; ++k) {
+        overflow_ |= (out_[k] < 0 && (!defs || defs[k]));
+      }
+      out_ += n;
+    }
+};
+
+
+class BoolSink {
+  private:
+    int8_t* out_;
+    std::vector<int8_t> dict_;
+    std::vector<uint32_t> values_;
+
+  public:
+    explicit BoolSink(int8_t* out) : out_(out) {}
+
+    void set_dictionary(const uint8_t* ptr, size_t size, size_t n) {
+      if (n > size * 8) throw invalid_file() << "bad dictionary page";
+      dict_.resize(n);
+      for (size_t k = 0; k < n; ++k) {
+        dict_[k] = (ptr[k >> 3] >> (k & 7)) & 1;
+      }
+    }
+
+    size_t dict_size() const { return dict_.size(); }
+
+    void plain(const uint8_t* ptr, size_t size, const uint32_t* defs,
+               size_t n, size_t nvalid)
+    {
+      if (nvalid > size * 8) throw invalid_file() << "bad data page";
+      size_t j = 0;
+      for (size_t k = 0; k < n; ++k) {
+        if (defs && !defs[k]) {
+          *out_++ = NA_I1;
+        } else {
+          *out_++ = (ptr[j >> 3] >> (j & 7)) & 1;
+          j++;
+        }
+      }
+    }
+
+    void dictionary(const uint32_t* indices, const uint32_t* defs, size_t n) {
+      for (size_t k = 0; k < n; ++k) {
+        *out_++ = (defs && !defs[k])? NA_I1 : dict_[*indices++];
+      }
+    }
+
+    void rle(const uint8_t* ptr, size_t size, const uint32_t* defs,
+             size_t n, size_t nvalid)
+    {
+      if (size < 4) throw invalid_file() << "bad data page";
+      uint32_t len;
+      std::memcpy(&len, ptr, 4);
+      if (len > size - 4) throw invalid_file() << "bad data page";
+      values_.resize(nvalid);
+      rle_decode(ptr + 4, len, 1, values_.data(), nvalid);
+      const uint32_t* v = values_.data();
+      for (size_t k = 0; k < n; ++k) {
+        *out_++ = (defs && !defs[k])? NA_I1 : static_cast<int8_t>(*v++);
+      }
+    }
+};
+
+
+/**
+  * String values are collected into `chars`, and for each row its end
+  * offset within `chars` is stored in `ends`, with the highest bit set
+  * for NA values. The chunks are concatenated into the output column
+  * once all of them are decoded.
+  */
+static constexpr uint64_t STR_NA = uint64_t(1) << 63;
+
+class StringSink {
+  private:
+    std::vector<uint64_t>& ends_;
+    std::vector<char>& chars_;
+    std::vector<const uint8_t*> dict_ptrs_;
+    std::vector<uint32_t> dict_lens_;
+
+  public:
+    StringSink(std::vector<uint64_t>& ends, std::vector<char>& chars)
+      : ends_(ends), chars_(chars) {}
+
+    // The dictionary data must remain alive while the sink is in use
+    void set_dictionary(const uint8_t* ptr, size_t size, size_t n) {
+      dict_ptrs_.resize(n);
+      dict_lens_.resize(n);
+      const uint8_t* end = ptr + size;
+      for (size_t k = 0; k < n; ++k) {
+        uint32_t len = read_length(ptr, end);
+        dict_ptrs_[k] = ptr;
+        dict_lens_[k] = len;
+        ptr += len;
+      }
+    }
+
+    size_t dict_size() const { return dict_ptrs_.size(); }
+
+    void plain(const uint8_t* ptr, size_t size, const uint32_t* defs,
+               size_t n, size_t)
+    {
+      const uint8_t* end = ptr + size;
+      for (size_t k = 0; k < n; ++k) {
+        if (defs && !defs[k]) {
+          ends_.push_back(chars_.size() | STR_NA);
+        } else {
+          uint32_t len = read_length(ptr, end);
+          chars_.insert(chars_.end(), ptr, ptr + len);
+          ptr += len;
+          ends_.push_back(chars_.size());
+        }
+      }
+    }
+
+    void dictionary(const uint32_t* indices, const uint32_t* defs, size_t n) {
+      for (size_t k = 0; k < n; ++k) {
+        if (defs && !defs[k]) {
+          ends_.push_back(chars_.size() | STR_NA);
+        } else {
+          uint32_t i = *indices++;
+          const uint8_t* p = dict_ptrs_[i];
+          chars_.insert(chars_.end(), p, p + dict_lens_[i]);
+          ends_.push_back(chars_.size());
+        }
+      }
+    }
+
+    void rle(const uint8_t*, size_t, const uint32_t*, size_t, size_t) {
+      throw unsupported() << "RLE encoding of strings is not supported";
+    }
+
+  private:
+    // Read the 4-byte length prefix of a string, and check that the
+    // string fits within the data
+    static uint32_t read_length(const uint8_t*& ptr, const uint8_t* end) {
+      uint32_t len;
+      if (end - ptr < 4) throw invalid_file() << "bad string data";
+      std::memcpy(&len, ptr, 4);
+      ptr += 4;
+      if (len > static_cast<size_t>(end - ptr)) {
+        throw invalid_file() << "bad string data";
+      }
+      return len;
+    }
+};
+
+
+
+
+//------------------------------------------------------------------------------
+// Column chunk decoder
+//------------------------------------------------------------------------------
+
+/**
+  * Description of a column in the file, and of the corresponding
+  * column in the output frame.
+  */
+struct ColumnDesc {
+  std::string name;
+  PhysicalType ptype;
+  SType stype;
+  Conversion conversion;
+  bool optional;
+  size_t : 16;
+  int32_t type_length;
+  double scale;
+};
+
+
+class ChunkDecoder {
+  private:
+    const uint8_t* file_;
+    size_t filesize_;
+    const ChunkInfo& info_;
+    const ColumnDesc& desc_;
+    size_t nrows_;
+    Buffer page_buf_;
+    Buffer dict_buf_;
+    std::vector<uint32_t> defs_;
+    std::vector<uint32_t> indices_;
+
+  public:
+    ChunkDecoder(const uint8_t* file, size_t filesize, const ChunkInfo& info,
+                 const ColumnDesc& desc, size_t nrows)
+      : file_(file), filesize_(filesize), info_(info), desc_(desc),
+        nrows_(nrows) {}
+
+    template <typename Sink>
+    void run(Sink& sink);
+
+  private:
+    const uint8_t* decompress(const uint8_t* src, size_t n, size_t usize,
+                              Buffer& buf) const;
+    template <typename Sink>
+    void decode_values(Sink& sink, Encoding encoding,
+                       const uint8_t* ptr, size_t size,
+                       const uint32_t* defs, size_t n, size_t nvalid);
+};
+
+
+template <typename Sink>
+void ChunkDecoder::run(Sink& sink) {
+  if (info_.type != desc_.ptype) {
+    throw invalid_file() << "the type of column `" << desc_.name
+        << "` in a row group differs from its type in the schema";
+  }
+  int64_t start = info_.data_page_offset;
+  if (info_.dictionary_page_offset > 0 &&
+      info_.dictionary_page_offset < start) {
+    start = info_.dictionary_page_offset;
+  }
+  // The last 8 bytes of the file are the footer's length and the magic
+  int64_t limit = static_cast<int64_t>(filesize_) - 8;
+  if (start < 4 || start > limit ||
+      info_.total_compressed_size > limit - start) {
+    throw invalid_file() << "column chunk of `" << desc_.name
+        << "` is out of bounds";
+  }
+  size_t pos = static_cast<size_t>(start);
+  size_t end = pos + static_cast<size_t>(info_.total_compressed_size);
+
+  size_t nread = 0;
+  while (nread < nrows_) {
+    if (pos >= end) {
+      throw invalid_file() << "column chunk of `" << desc_.name
+          << "` contains fewer values than expected";
+    }
+    PageHeader ph;
+    pos += read_page_header(file_ + pos, end - pos, ph);
+    size_t csize = static_cast<size_t>(ph.compressed_size);
+    size_t usize = static_cast<size_t>(ph.uncompressed_size);
+    if (csize > end - pos) {
+      throw invalid_file() << "page of column `" << desc_.name
+          << "` is out of bounds";
+    }
+    const uint8_t* data = file_ + pos;
+    pos += csize;
+
+    if (ph.type == PageType::DICTIONARY_PAGE) {
+      if (ph.num_values < 0) throw invalid_file() << "bad dictionary page";
+      if (ph.encoding != Encoding::PLAIN &&
+          ph.encoding != Encoding::PLAIN_DICTIONARY) {
+        throw unsupported() << "dictionary page encoding "
+            << encoding_name(ph.encoding) << " is not supported";
+      }
+      const uint8_t* ptr = decompress(data, csize, usize, dict_buf_);
+      sink.set_dictionary(ptr, usize, static_cast<size_t>(ph.num_values));
+      continue;
+    }
+    if (ph.type != PageType::DATA_PAGE && ph.type != PageType::DATA_PAGE_V2) {
+      continue;  // index pages, or unknown pages are skipped
+    }
+    if (ph.num_values < 0 ||
+        static_cast<size_t>(ph.num_values) > nrows_ - nread) {
+      throw invalid_file() << "data page of column `" << desc_.name
+          << "` contains more values than expected";
+    }
+    size_t n = static_cast<size_t>(ph.num_values);
+
+    const uint8_t* defs_ptr = nullptr;
+    size_t defs_size = 0;
+    const uint8_t* values = nullptr;
+    size_t values_size = 0;
+    if (ph.type == PageType::DATA_PAGE) {
+      const uint8_t* ptr = decompress(data, csize, usize, page_buf_);
+      values = ptr;
+      values_size = usize;
+      if (desc_.optional) {
+        if (ph.def_encoding != Encoding::RLE) {
+          throw unsupported() << "definition levels encoding "
+              << encoding_name(ph.def_encoding) << " is not supported";
+        }
+        uint32_t len;
+        if (usize < 4) throw invalid_file() << "bad data page";
+        std::memcpy(&len, ptr, 4);
+        if (len > usize - 4) throw invalid_file() << "bad data page";
+        defs_ptr = ptr + 4;
+        defs_size = len;
+        values = ptr + 4 + len;
+        values_size = usize - 4 - len;
+      }
+    } else {
+      // In V2 pages the levels are never compressed, and precede the
+      // (possibly compressed) values. The sizes of the levels are
+      // checked one at a time, so that their sum cannot overflow.
+      if (ph.rep_levels_size < 0 || ph.def_levels_size < 0) {
+        throw invalid_file() << "negative size of levels in a data page "
+            "of column `" << desc_.name << "`";
+      }
+      size_t page_size = std::min(csize, usize);
+      size_t reps_size = static_cast<size_t>(ph.rep_levels_size);
+      defs_size = static_cast<size_t>(ph.def_levels_size);
+      if (reps_size > page_size || defs_size > page_size - reps_size) {
+        throw invalid_file() << "size of levels exceeds the size of a data "
+            "page of column `" << desc_.name << "`";
+      }
+      size_t levels_size = reps_size + defs_size;
+      defs_ptr = data + reps_size;
+      if (ph.is_compressed) {
+        values = decompress(data + levels_size, csize - levels_size,
+                            usize - levels_size, page_buf_);
+      } else {
+        values = data + levels_size;
+      }
+      values_size = usize - levels_size;
+      if (!desc_.optional) defs_ptr = nullptr;
+    }
+
+    size_t nvalid = n;
+    const uint32_t* defs = nullptr;
+    if (defs_ptr) {
+      defs_.resize(n);
+      rle_decode(defs_ptr, defs_size, 1, defs_.data(), n);
+      nvalid = 0;
+      for (size_t k = 0; k < n; ++k) nvalid += (defs_[k] != 0);
+      defs = defs_.data();
+    }
+    decode_values(sink, ph.encoding, values, values_size, defs, n, nvalid);
+    nread += n;
+  }
+}
+
+
+template <typename Sink>
+void ChunkDecoder::decode_values(
+    Sink& sink, Encoding encoding, const uint8_t* ptr, size_t size,
+    const uint32_t* defs, size_t n, size_t nvalid)
+{
+  switch (encoding) {
+    case Encoding::PLAIN:
+      sink.plain(ptr, size, defs, n, nvalid);
+      return;
+    case Encoding::PLAIN_DICTIONARY:
+    case Encoding::RLE_DICTIONARY: {
+      if (size == 0 && nvalid == 0) {
+        sink.dictionary(nullptr, defs, n);
+        return;
+      }
+      if (size == 0) throw invalid_file() << "bad data page";
+      indices_.resize(nvalid);
+      rle_decode(ptr + 1, size - 1, ptr[0], indices_.data(), nvalid);
+      size_t ndict = sink.dict_size();
+      for (size_t k = 0; k < nvalid; ++k) {
+        if (indices_[k] >= ndict) {
+          throw invalid_file() << "dictionary index out of bounds in column `"
+              << desc_.name << "`";
+        }
+      }
+      sink.dictionary(indices_.data(), defs, n);
+      return;
+    }
+    case Encoding::RLE:
+      sink.rle(ptr, size, defs, n, nvalid);
+      return;
+    default:
+      throw unsupported() << "encoding " << encoding_name(encoding)
+          << " (used in column `" << desc_.name << "`) is not supported";
+  }
+}
+
+
+const uint8_t* ChunkDecoder::decompress(
+    const uint8_t* src, size_t n, size_t usize, Buffer& buf) const
+{
+  switch (info_.codec) {
+    case Codec::UNCOMPRESSED:
+      if (n != usize) throw invalid_file() << "bad page size";
+      return src;
+    case Codec::SNAPPY:
+      buf = Buffer::mem(usize);
+      snappy::decompress(src, n, buf.xptr(), usize);
+      break;
+    case Codec::LZ4_RAW:
+      buf = Buffer::mem(usize);
+      lz4::decompress(src, n, buf.xptr(), usize);
+      break;
+    case Codec::GZIP: {
+      size_t nmembers;
+      buf = dt::read::gunzip(reinterpret_cast<const char*>(src), n,
+                             &nmembers);
+      if (buf.size() != usize) {
+        throw invalid_file() << "expected " << usize << " bytes of "
+            "uncompressed data, got " << buf.size();
+      }
+      break;
+    }
+    default:
+      throw unsupported() << "compression codec " << codec_name(info_.codec)
+          << " is not supported";
+  }
+  return static_cast<const uint8_t*>(buf.rptr());
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Reading the file
+//------------------------------------------------------------------------------
+
+static ColumnDesc make_column_desc(const SchemaElement& el) {
+  ColumnDesc desc;
+  desc.name = el.name;
+  desc.ptype = el.type;
+  desc.conversion = Conversion::CAST;
+  desc.optional = (el.repetition == Repetition::OPTIONAL);
+  desc.scale = 1.0;
+  desc.type_length = el.type_length;
+  if (el.num_children > 0 || el.repetition == Repetition::REPEATED ||
+      !el.has_type) {
+    throw unsupported() << "nested column `" << el.name << "` is not "
+        "supported";
+  }
+  bool decimal = (el.converted_type == ConvertedType::DECIMAL ||
+                  el.logical_type == LogicalType::DECIMAL);
+  if (decimal) {
+    desc.conversion = Conversion::DECIMAL;
+    desc.scale = std::pow(10.0, -el.scale);
+  }
+  int bits = 0;
+  bool is_unsigned = false;
+  switch (el.converted_type) {
+    case ConvertedType::INT_8:   bits = 8; break;
+    case ConvertedType::INT_16:  bits = 16; break;
+    case ConvertedType::UINT_8:  bits = 8;  is_unsigned = true; break;
+    case ConvertedType::UINT_16: bits = 16; is_unsigned = true; break;
+    case ConvertedType::UINT_32: bits = 32; is_unsigned = true; break;
+    case ConvertedType::UINT_64: bits = 64; is_unsigned = true; break;
+    default: break;
+  }
+  if (el.logical_type == LogicalType::INTEGER) {
+    bits = el.int_bits;
+    is_unsigned = !el.int_signed;
+  }
+
+  // Columns of the Null logical type contain no data, and become
+  // all-NA boolean columns
+  if (el.logical_type == LogicalType::UNKNOWN) {
+    desc.stype = SType::VOID;
+    return desc;
+  }
+  switch (el.type) {
+    case PhysicalType::BOOLEAN: desc.stype = SType::BOOL; break;
+    case PhysicalType::INT32:
+      if (decimal) desc.stype = SType::FLOAT64;
+      else if (is_unsigned) {
+        desc.conversion = Conversion::UNSIGNED;
+        desc.stype = (bits == 8)? SType::INT16 :
+                     (bits == 16)? SType::INT32 : SType::INT64;
+      }
+      else desc.stype = (bits == 8)? SType::INT8 :
+                        (bits == 16)? SType::INT16 : SType::INT32;
+      break;
+    case PhysicalType::INT64:
+      if (decimal) desc.stype = SType::FLOAT64;
+      else if (is_unsigned) {
+        // The column becomes float64 if it turns out to contain values
+        // that do not fit into int64 (see `Uint64Sink`)
+        desc.conversion = Conversion::UNSIGNED;
+        desc.stype = SType::INT64;
+      }
+      else desc.stype = SType::INT64;
+      break;
+    case PhysicalType::INT96:
+      desc.stype = SType::INT64;
+      desc.conversion = Conversion::INT96;
+      break;
+    case PhysicalType::FLOAT:  desc.stype = SType::FLOAT32; break;
+    case PhysicalType::DOUBLE: desc.stype = SType::FLOAT64; break;
+    case PhysicalType::BYTE_ARRAY: desc.stype = SType::STR32; break;
+    case PhysicalType::FIXED_LEN_BYTE_ARRAY:
+      if (decimal && el.type_length > 0 && el.type_length <= 16) {
+        desc.stype = SType::FLOAT64;
+        break;
+      }
+      throw unsupported() << "column `" << el.name << "` of type "
+          "FIXED_LEN_BYTE_ARRAY is not supported";
+    default:
+      throw unsupported() << "column `" << el.name << "` has physical type "
+          << static_cast<int>(el.type) << ", which is not supported";
+  }
+  return desc;
+}
+
+
+template <typename P, typename T, Conversion C>
+static void decode_fixed(ChunkDecoder& decoder, Buffer& out, size_t row0,
+                         double scale)
+{
+  FixedSink<P, T, C> sink(static_cast<T*>(out.xptr()) + row0, scale);
+  decoder.run(sink);
+}
+
+
+static void decode_chunk(ChunkDecoder& decoder, const ColumnDesc& desc,
+                         Buffer& out, size_t row0)
+{
+  constexpr auto CAST = Conversion::CAST;
+  double scale = desc.scale;
+  switch (desc.conversion) {
+    case Conversion::CAST:
+      switch (desc.stype) {
+        case SType::INT8:
+          return decode_fixed<int32_t, int8_t, CAST>(decoder, out, row0, scale);
+        case SType::INT16:
+          return decode_fixed<int32_t, int16_t, CAST>(decoder, out, row0, scale);
+        case SType::INT32:
+          return decode_fixed<int32_t, int32_t, CAST>(decoder, out, row0, scale);
+        case SType::INT64:
+          return decode_fixed<int64_t, int64_t, CAST>(decoder, out, row0, scale);
+        case SType::FLOAT32:
+          return decode_fixed<float, float, CAST>(decoder, out, row0, scale);
+        case SType::FLOAT64:
+          return decode_fixed<double, double, CAST>(decoder, out, row0, scale);
+        default: break;
+      }
+      break;
+    case Conversion::UNSIGNED: {
+      constexpr auto U = Conversion::UNSIGNED;
+      switch (desc.stype) {
+        case SType::INT16:
+          return decode_fixed<int32_t, int16_t, U>(decoder, out, row0, scale);
+        case SType::INT32:
+          return decode_fixed<int32_t, int32_t, U>(decoder, out, row0, scale);
+        case SType::INT64:
+          return decode_fixed<int32_t, int64_t, U>(decoder, out, row0, scale);
+        case SType::FLOAT64:
+          return decode_fixed<int64_t, double, U>(decoder, out, row0, scale);
+        default: break;
+      }
+      break;
+    }
+    case Conversion::DECIMAL: {
+      constexpr auto D = Conversion::DECIMAL;
+      if (desc.ptype == PhysicalType::INT32) {
+        return decode_fixed<int32_t, double, D>(decoder, out, row0, scale);
+      }
+      if (desc.ptype == PhysicalType::INT64) {
+        return decode_fixed<int64_t, double, D>(decoder, out, row0, scale);
+      }
+      if (desc.ptype == PhysicalType::FIXED_LEN_BYTE_ARRAY) {
+        DecimalBytesSink sink(static_cast<double*>(out.xptr()) + row0, scale,
+                              static_cast<size_t>(desc.type_length));
+        return decoder.run(sink);
+      }
+      throw unsupported() << "decimal column `" << desc.name << "` is "
+          "stored in a format that is not supported";
+    }
+    case Conversion::INT96:
+      return decode_fixed<Int96, int64_t, Conversion::INT96>(
+                decoder, out, row0, scale);
+  }
+  throw RuntimeError() << "Unexpected column type";  // LCOV_EXCL_LINE
+}
+
+
+struct StringChunk {
+  std::vector<uint64_t> ends;
+  std::vector<char> chars;
+};
+
+
+// Concatenate the chunks of a string column decoded from all row groups
+template <typename U>
+static Column assemble_strings(std::vector<StringChunk>& chunks,
+                               size_t nrows, size_t total_size)
+{
+  const U NA = GETNA<U>();
+  std::vector<size_t> char_offsets(chunks.size() + 1, 0);
+  std::vector<size_t> row_offsets(chunks.size() + 1, 0);
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    char_offsets[i + 1] = char_offsets[i] + chunks[i].chars.size();
+    row_offsets[i + 1] = row_offsets[i] + chunks[i].ends.size();
+  }
+  xassert(char_offsets.back() == total_size);
+  xassert(row_offsets.back() == nrows);
+  Buffer offsets = Buffer::mem((nrows + 1) * sizeof(U));
+  Buffer strdata = Buffer::mem(total_size);
+  U* offs = static_cast<U*>(offsets.xptr());
+  char* chars = static_cast<char*>(strdata.xptr());
+  offs[0] = 0;
+  dt::parallel_for_dynamic(chunks.size(),
+    [&](size_t i) {
+      StringChunk& chunk = chunks[i];
+      size_t base = char_offsets[i];
+      U* out = offs + 1 + row_offsets[i];
+      if (!chunk.chars.empty()) {
+        std::memcpy(chars + base, chunk.chars.data(), chunk.chars.size());
+      }
+      for (size_t k = 0; k < chunk.ends.size(); ++k) {
+        uint64_t e = chunk.ends[k];
+        U off = static_cast<U>(base + (e & ~STR_NA));
+        out[k] = (e & STR_NA)? (off | NA) : off;
+      }
+      std::vector<uint64_t>().swap(chunk.ends);
+      std::vector<char>().swap(chunk.chars);
+    });
+  return Column::new_string_column(nrows, std::move(offsets),
+                                   std::move(strdata));
+}
+
+
+static DataTable* open_parquet(const uint8_t* ptr, size_t size) {
+  if (size < 12 || std::memcmp(ptr, "PAR1", 4) != 0 ||
+                   std::memcmp(ptr + size - 4, "PAR1", 4) != 0) {
+    throw invalid_file() << "the file signature is missing";
+  }
+  uint32_t footer_size;
+  std::memcpy(&footer_size, ptr + size - 8, 4);
+  if (footer_size > size - 12) {
+    throw invalid_file() << "the footer is out of bounds";
+  }
+  FileMeta meta = read_file_meta(ptr + size - 8 - footer_size, footer_size);
+
+  const SchemaElement& root = meta.schema[0];
+  if (root.num_children < 0 ||
+      static_cast<size_t>(root.num_children) + 1 != meta.schema.size()) {
+    throw unsupported() << "nested schemas are not supported";
+  }
+  size_t ncols = meta.schema.size() - 1;
+  std::vector<ColumnDesc> descs;
+  strvec names;
+  for (size_t j = 0; j < ncols; ++j) {
+    descs.push_back(make_column_desc(meta.schema[j + 1]));
+    names.push_back(descs.back().name);
+  }
+
+  size_t nrg = meta.row_groups.size();
+  std::vector<size_t> row_offsets(nrg + 1, 0);
+  for (size_t g = 0; g < nrg; ++g) {
+    const RowGroupInfo& rg = meta.row_groups[g];
+    if (rg.columns.size() != ncols) {
+      throw invalid_file() << "row group " << g << " has " << rg.columns.size()
+          << " columns, while the schema has " << ncols;
+    }
+    row_offsets[g + 1] = row_offsets[g] + static_cast<size_t>(rg.num_rows);
+  }
+  size_t nrows = row_offsets[nrg];
+  if (nrows != static_cast<size_t>(meta.num_rows)) {
+    throw invalid_file() << "the number of rows in the row groups ("
+        << nrows << ") differs from the number of rows in the file ("
+        << meta.num_rows << ")";
+  }
+
+  // Fixed-width columns are decoded directly into their final buffers,
+  // while the string columns are decoded into per-chunk buffers first.
+  std::vector<Buffer> buffers(ncols);
+  std::vector<std::vector<StringChunk>> strings(ncols);
+  for (size_t j = 0; j < ncols; ++j) {
+    SType stype = descs[j].stype;
+    if (stype == SType::VOID) continue;
+    if (stype == SType::STR32) strings[j].resize(nrg);
+    else buffers[j] = Buffer::mem(nrows * stype_elemsize(stype));
+  }
+
+  std::vector<std::atomic<bool>> uint64_overflow(ncols);
+  dt::parallel_for_dynamic(nrg * ncols,
+    [&](size_t i) {
+      size_t g = i / ncols;
+      size_t j = i % ncols;
+      const ColumnDesc& desc = descs[j];
+      if (desc.stype == SType::VOID) return;
+      size_t row0 = row_offsets[g];
+      ChunkDecoder decoder(ptr, size, meta.row_groups[g].columns[j], desc,
+                           row_offsets[g + 1] - row0);
+      if (desc.stype == SType::STR32) {
+        StringChunk& chunk = strings[j][g];
+        chunk.ends.reserve(row_offsets[g + 1] - row0);
+        StringSink sink(chunk.ends, chunk.chars);
+        decoder.run(sink);
+      } else if (desc.stype == SType::BOOL) {
+        BoolSink sink(static_cast<int8_t*>(buffers[j].xptr()) + row0);
+        decoder.run(sink);
+      } else if (desc.conversion == Conversion::UNSIGNED &&
+                 desc.ptype == PhysicalType::INT64) {
+        Uint64Sink sink(static_cast<int64_t*>(buffers[j].xptr()) + row0);
+        decoder.run(sink);
+        if (sink.overflow()) uint64_overflow[j] = true;
+      } else {
+        decode_chunk(decoder, desc, buffers[j], row0);
+      }
+    });
+
+  // Same as with the Arrow arrays, uint64 columns are read as int64
+  // when all their values fit, and as float64 otherwise.
+  for (size_t j = 0; j < ncols; ++j) {
+    if (!uint64_overflow[j]) continue;
+    ColumnDesc& desc = descs[j];
+    desc.stype = SType::FLOAT64;
+    buffers[j] = Buffer::mem(nrows * sizeof(double));
+    dt::parallel_for_dynamic(nrg,
+      [&](size_t g) {
+        size_t row0 = row_offsets[g];
+        ChunkDecoder decoder(ptr, size, meta.row_groups[g].columns[j], desc,
+                             row_offsets[g + 1] - row0);
+        decode_chunk(decoder, desc, buffers[j], row0);
+      });
+  }
+
+  colvec columns;
+  for (size_t j = 0; j < ncols; ++j) {
+    SType stype = descs[j].stype;
+    if (stype == SType::VOID) {
+      columns.push_back(Column::new_na_column(nrows, SType::BOOL));
+    }
+    else if (stype == SType::STR32) {
+      size_t total_size = 0;
+      for (const StringChunk& chunk : strings[j]) {
+        total_size += chunk.chars.size();
+      }
+      if (total_size <= Column::MAX_ARR32_SIZE &&
+          nrows <= Column::MAX_ARR32_SIZE) {
+        columns.push_back(assemble_strings<uint32_t>(strings[j], nrows,
+                                                     total_size));
+      } else {
+        columns.push_back(assemble_strings<uint64_t>(strings[j], nrows,
+                                                     total_size));
+      }
+    }
+    else {
+      columns.push_back(Column::new_mbuf_column(nrows, stype,
+                                                std::move(buffers[j])));
+    }
+  }
+  return new DataTable(std::move(columns), names);
+}
+
+
+}}  // namespace dt::parquet
+
+
+
+DataTable* open_parquet_from_mbuf(const Buffer& mbuf) {
+  return dt::parquet::open_parquet(static_cast<const uint8_t*>(mbuf.rptr()),
+                                   mbuf.size());
+}
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_PARQUET_PARQUET_h
+#define dt_PARQUET_PARQUET_h
+#include <cstddef>      // size_t
+#include <cstdint>      // int32_t, uint8_t, uint32_t
+#include <vector>       // std::vector
+namespace dt {
+namespace parquet {
+
+// The constants in this file coincide with the enums in the Parquet
+// format definition (parquet.thrift), and must not be renumbered.
+
+enum class PhysicalType : int32_t {
+  BOOLEAN              = 0,
+  INT32                = 1,
+  INT64                = 2,
+  INT96                = 3,
+  FLOAT                = 4,
+  DOUBLE               = 5,
+  BYTE_ARRAY           = 6,
+  FIXED_LEN_BYTE_ARRAY = 7,
+};
+
+enum class ConvertedType : int32_t {
+  NONE             = -1,  // not a Parquet value: the field is absent
+  UTF8             = 0,
+  DECIMAL          = 5,
+  DATE             = 6,
+  TIMESTAMP_MILLIS = 9,
+  TIMESTAMP_MICROS = 10,
+  UINT_8           = 11,
+  UINT_16          = 12,
+  UINT_32          = 13,
+  UINT_64          = 14,
+  INT_8            = 15,
+  INT_16           = 16,
+  INT_32           = 17,
+  INT_64           = 18,
+};
+
+enum class Repetition : int32_t {
+  REQUIRED = 0,
+  OPTIONAL = 1,
+  REPEATED = 2,
+};
+
+enum class Encoding : int32_t {
+  PLAIN                   = 0,
+  PLAIN_DICTIONARY        = 2,
+  RLE                     = 3,
+  BIT_PACKED              = 4,
+  DELTA_BINARY_PACKED     = 5,
+  DELTA_LENGTH_BYTE_ARRAY = 6,
+  DELTA_BYTE_ARRAY        = 7,
+  RLE_DICTIONARY          = 8,
+  BYTE_STREAM_SPLIT       = 9,
+};
+
+enum class Codec : int32_t {
+  UNCOMPRESSED = 0,
+  SNAPPY       = 1,
+  GZIP         = 2,
+  LZO          = 3,
+  BROTLI       = 4,
+  LZ4          = 5,
+  ZSTD         = 6,
+  LZ4_RAW      = 7,
+};
+
+enum class PageType : int32_t {
+  DATA_PAGE       = 0,
+  INDEX_PAGE      = 1,
+  DICTIONARY_PAGE = 2,
+  DATA_PAGE_V2    = 3,
+};
+
+// Field ids of the members of the LogicalType union
+enum class LogicalType : int16_t {
+  NONE      = 0,
+  STRING    = 1,
+  DECIMAL   = 5,
+  DATE      = 6,
+  TIMESTAMP = 8,
+  INTEGER   = 10,
+  UNKNOWN   = 11,  // "null" type, i.e. a column where all values are NA
+};
+
+const char* codec_name(Codec);
+const char* encoding_name(Encoding);
+
+
+
+
+//------------------------------------------------------------------------------
+// RLE / bit-packing hybrid encoding
+//------------------------------------------------------------------------------
+
+/**
+  * Number of bits needed to store values in the range `[0; maxvalue]`.
+  */
+int bit_width(uint32_t maxvalue);
+
+
+/**
+  * Encode `n` values into the RLE / bit-packing hybrid encoding, and
+  * append the result to `out`. This encoding is used for definition
+  * levels and dictionary indices.
+  *
+  * The values are consumed in groups of 8: a group that starts a run
+  * of 8 or more equal values is written as an RLE run (covering the
+  * whole run), otherwise the group is added to the current bit-packed
+  * run. The last group may be padded with zeros, which is allowed
+  * since the number of values is always stored separately.
+  */
+void rle_encode(const uint32_t* values, size_t n, int bit_width,
+                std::vector<uint8_t>& out);
+
+
+/**
+  * Decode exactly `n` values from the RLE / bit-packing hybrid data
+  * `[ptr, ptr + size)` into `out`. An IOError is thrown if the data
+  * is malformed or contains fewer than `n` values.
+  */
+void rle_decode(const uint8_t* ptr, size_t size, int bit_width,
+                uint32_t* out, size_t n);
+
+
+
+}}  // namespace dt::parquet
+#endif
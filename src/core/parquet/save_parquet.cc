@@ -0,0 +1,821 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>            // std::min, std::max
+#include <cstring>              // std::memcpy
+#include <limits>               // std::numeric_limits
+#include <memory>               // std::unique_ptr
+#include <string>               // std::string
+#include <vector>               // std::vector
+#include "column/categorical.h"
+#include "frame/py_frame.h"
+#include "parallel/api.h"
+#include "parquet/parquet.h"
+#include "parquet/thrift.h"
+#include "python/_all.h"
+#include "python/string.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+#include "utils/lz4.h"
+#include "utils/snappy.h"
+#include "write/zlib_writer.h"
+#include "datatable.h"
+#include "stype.h"
+#include "writebuf.h"
+namespace dt {
+namespace parquet {
+
+// Each data page contains at most this many rows, and no more than
+// (approximately) PAGE_SIZE bytes of encoded values.
+static constexpr size_t PAGE_NROWS = 1 << 16;
+static constexpr size_t PAGE_SIZE = 1 << 20;
+
+// String columns with at most this many distinct values are written
+// with dictionary encoding.
+static constexpr size_t MAX_DICTIONARY_SIZE = 1 << 16;
+
+static constexpr size_t NO_OFFSET = size_t(-1);
+
+using bytes = std::vector<uint8_t>;
+
+
+/**
+  * How the column of the frame is going to be stored in the file.
+  */
+struct ColumnPlan {
+  Column column;
+  Column codes;    // int32 dictionary codes, if dictionary-encoded
+  Column dict;     // the dictionary, if dictionary-encoded
+  std::string name;
+  SType stype;
+  PhysicalType ptype;
+  ConvertedType ctype;
+  LogicalType ltype;
+  int8_t int_bits;
+  size_t : 40;
+};
+
+
+/**
+  * Encoded data of a single column chunk (i.e. a column within a row
+  * group), and the information that goes into the footer. The chunks
+  * are encoded in parallel, and then written into the file in order;
+  * the `data` is released as soon as it is written out.
+  */
+struct ChunkMeta {
+  bytes data;
+  size_t offset;                   // position of the chunk within the file
+  size_t dictionary_page_offset;   // relative to `offset`, or NO_OFFSET
+  size_t data_page_offset;         // relative to `offset`
+  size_t uncompressed_size;
+  size_t compressed_size;
+  size_t nrows;
+  size_t null_count;
+  std::string min_value;
+  std::string max_value;
+  bool has_minmax;
+  size_t : 56;
+};
+
+
+
+//------------------------------------------------------------------------------
+// Value encoders
+//------------------------------------------------------------------------------
+
+template <typename T>
+static void append_le(bytes& out, T value) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+static std::string to_plain(T value) {
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+
+/**
+  * Encode rows `[row0, row1)` of a fixed-width column, where `T` is
+  * the column's element type and `P` is the corresponding Parquet
+  * physical type. The definition levels go into `defs`, and the
+  * PLAIN-encoded non-NA values into `out`.
+  */
+template <typename T, typename P>
+static void encode_fixed(const Column& col, size_t row0, size_t row1,
+                         std::vector<uint32_t>& defs, bytes& out,
+                         ChunkMeta& meta)
+{
+  auto data = static_cast<const T*>(col.get_data_readonly());
+  P vmin = std::numeric_limits<P>::max();
+  P vmax = std::numeric_limits<P>::lowest();
+  size_t nvalid = 0;
+  out.reserve(out.size() + (row1 - row0) * sizeof(P));
+  for (size_t i = row0; i < row1; ++i) {
+    T x = data[i];
+    bool valid = !ISNA<T>(x);
+    defs.push_back(valid);
+    if (!valid) continue;
+    P p = static_cast<P>(x);
+    append_le<P>(out, p);
+    if (p < vmin) vmin = p;
+    if (p > vmax) vmax = p;
+    nvalid++;
+  }
+  meta.null_count += (row1 - row0) - nvalid;
+  if (nvalid) {
+    if (!meta.has_minmax || vmin < *reinterpret_cast<const P*>(
+                                      meta.min_value.data())) {
+      meta.min_value = to_plain<P>(vmin);
+    }
+    if (!meta.has_minmax || vmax > *reinterpret_cast<const P*>(
+                                      meta.max_value.data())) {
+      meta.max_value = to_plain<P>(vmax);
+    }
+    meta.has_minmax = true;
+  }
+}
+
+
+static void encode_bool(const Column& col, size_t row0, size_t row1,
+                        std::vector<uint32_t>& defs, bytes& out,
+                        ChunkMeta& meta)
+{
+  auto data = static_cast<const int8_t*>(col.get_data_readonly());
+  uint8_t acc = 0;
+  int nbits = 0;
+  for (size_t i = row0; i < row1; ++i) {
+    int8_t x = data[i];
+    bool valid = !ISNA<int8_t>(x);
+    defs.push_back(valid);
+    if (!valid) {
+      meta.null_count++;
+      continue;
+    }
+    acc |= static_cast<uint8_t>((x & 1) << nbits);
+    if (++nbits == 8) {
+      out.push_back(acc);
+      acc = 0;
+      nbits = 0;
+    }
+  }
+  if (nbits) out.push_back(acc);
+}
+
+
+// Returns the row where the encoding stopped (which is less than `row1`
+// if the page is full).
+static size_t encode_string(const Column& col, size_t row0, size_t row1,
+                            std::vector<uint32_t>& defs, bytes& out,
+                            ChunkMeta& meta)
+{
+  CString value;
+  size_t i = row0;
+  for (; i < row1 && out.size() < PAGE_SIZE; ++i) {
+    bool valid = col.get_element(i, &value);
+    defs.push_back(valid);
+    if (!valid) {
+      meta.null_count++;
+      continue;
+    }
+    size_t len = value.size();
+    if (len > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      throw ValueError() << "String of size " << len << " cannot be "
+          "saved into a Parquet file";
+    }
+    append_le<uint32_t>(out, static_cast<uint32_t>(len));
+    auto p = reinterpret_cast<const uint8_t*>(value.data());
+    out.insert(out.end(), p, p + len);
+  }
+  return i;
+}
+
+
+static void encode_dict_indices(const Column& codes, size_t row0, size_t row1,
+                                int width, std::vector<uint32_t>& defs,
+                                bytes& out, ChunkMeta& meta)
+{
+  auto data = static_cast<const int32_t*>(codes.get_data_readonly());
+  std::vector<uint32_t> indices;
+  indices.reserve(row1 - row0);
+  for (size_t i = row0; i < row1; ++i) {
+    int32_t x = data[i];
+    bool valid = !ISNA<int32_t>(x);
+    defs.push_back(valid);
+    if (valid) indices.push_back(static_cast<uint32_t>(x));
+  }
+  meta.null_count += (row1 - row0) - indices.size();
+  out.push_back(static_cast<uint8_t>(width));
+  rle_encode(indices.data(), indices.size(), width, out);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// ParquetWriter
+//------------------------------------------------------------------------------
+
+class ParquetWriter {
+  private:
+    DataTable* dt_;
+    Codec codec_;
+    size_t : 32;
+    size_t row_group_size_;
+    size_t nrowgroups_;
+    std::vector<ColumnPlan> columns_;
+    std::vector<ChunkMeta> chunks_;
+
+  public:
+    ParquetWriter(DataTable* dt, Codec codec, size_t row_group_size);
+    void write(WritableBuffer* wb);
+
+  private:
+    void prepare_columns();
+    void encode_chunk(size_t i);
+    void write_page(PageType type, const bytes& body, size_t num_values,
+                    Encoding encoding, ChunkMeta& meta,
+                    std::unique_ptr<dt::write::zlib_writer>& zwriter) const;
+    void write_footer(WritableBuffer* wb) const;
+    void write_schema_element(ThriftWriter& tw, const ColumnPlan&) const;
+};
+
+
+ParquetWriter::ParquetWriter(DataTable* dt, Codec codec,
+                             size_t row_group_size)
+  : dt_(dt),
+    codec_(codec),
+    row_group_size_(row_group_size)
+{
+  size_t nrows = dt->nrows();
+  nrowgroups_ = nrows? 1 + (nrows - 1) / row_group_size_ : 0;
+}
+
+
+void ParquetWriter::prepare_columns() {
+  const strvec& names = dt_->get_names();
+  size_t nrows = dt_->nrows();
+  for (size_t i = 0; i < dt_->ncols(); ++i) {
+    const Column& col = dt_->get_column(i);
+    ColumnPlan plan;
+    plan.name = names[i];
+    plan.stype = col.stype();
+    plan.ctype = ConvertedType::NONE;
+    plan.ltype = LogicalType::NONE;
+    plan.int_bits = 0;
+    switch (plan.stype) {
+      case SType::VOID:
+        plan.ptype = PhysicalType::INT32;
+        plan.ltype = LogicalType::UNKNOWN;
+        break;
+      case SType::BOOL:    plan.ptype = PhysicalType::BOOLEAN; break;
+      case SType::INT8:
+        plan.ptype = PhysicalType::INT32;
+        plan.ctype = ConvertedType::INT_8;
+        plan.ltype = LogicalType::INTEGER;
+        plan.int_bits = 8;
+        break;
+      case SType::INT16:
+        plan.ptype = PhysicalType::INT32;
+        plan.ctype = ConvertedType::INT_16;
+        plan.ltype = LogicalType::INTEGER;
+        plan.int_bits = 16;
+        break;
+      case SType::INT32:   plan.ptype = PhysicalType::INT32; break;
+      case SType::INT64:   plan.ptype = PhysicalType::INT64; break;
+      case SType::FLOAT32: plan.ptype = PhysicalType::FLOAT; break;
+      case SType::FLOAT64: plan.ptype = PhysicalType::DOUBLE; break;
+      case SType::STR32:
+      case SType::STR64:
+        plan.ptype = PhysicalType::BYTE_ARRAY;
+        plan.ctype = ConvertedType::UTF8;
+        plan.ltype = LogicalType::STRING;
+        break;
+      default: {
+        auto w = DatatableWarning();
+        w << "Column `" << plan.name << "` of type "
+          << stype_name(plan.stype) << " was not saved";
+        w.emit_warning();
+        continue;
+      }
+    }
+    plan.column = col;
+    if (plan.ptype == PhysicalType::BYTE_ARRAY) {
+      // Columns that are already dictionary-encoded in memory reuse
+      // their dictionary; other string columns are encoded if they
+      // have few distinct values.
+      Column dictcol;
+      if (!col.get_categorical(nullptr)) {
+        size_t max_categories = std::min(MAX_DICTIONARY_SIZE, nrows / 2);
+        if (max_categories) {
+          dictcol = Categorical_ColumnImpl::encode(col, max_categories);
+        }
+      } else {
+        dictcol = col;
+      }
+      if (dictcol && dictcol.get_categorical(&plan.codes, &plan.dict)) {
+        plan.codes.cast_inplace(SType::INT32);
+        plan.codes.materialize();
+      }
+    }
+    else if (plan.stype != SType::VOID) {
+      plan.column.materialize();
+    }
+    columns_.push_back(std::move(plan));
+  }
+  chunks_.resize(nrowgroups_ * columns_.size());
+}
+
+
+void ParquetWriter::write(WritableBuffer* wb) {
+  prepare_columns();
+  wb->write(4, "PAR1");
+
+  class OTask : public OrderedTask {
+    private:
+      ParquetWriter* writer_;
+      WritableBuffer* wb_;
+      size_t write_at_;
+
+    public:
+      OTask(ParquetWriter* writer, WritableBuffer* wb)
+        : writer_(writer), wb_(wb), write_at_(0) {}
+
+      void start(size_t i) override {
+        writer_->encode_chunk(i);
+      }
+
+      void order(size_t i) override {
+        ChunkMeta& meta = writer_->chunks_[i];
+        write_at_ = wb_->prepare_write(meta.data.size(), meta.data.data());
+        meta.offset = write_at_;
+        meta.compressed_size = meta.data.size();
+      }
+
+      void finish(size_t i) override {
+        ChunkMeta& meta = writer_->chunks_[i];
+        wb_->write_at(write_at_, meta.data.size(), meta.data.data());
+        bytes().swap(meta.data);
+      }
+  };
+
+  dt::parallel_for_ordered(chunks_.size(), NThreads(),
+    [&] {
+      return std::make_unique<OTask>(this, wb);
+    });
+
+  write_footer(wb);
+  wb->finalize();
+}
+
+
+void ParquetWriter::encode_chunk(size_t i) {
+  size_t ncols = columns_.size();
+  const ColumnPlan& plan = columns_[i % ncols];
+  size_t row0 = (i / ncols) * row_group_size_;
+  size_t row1 = std::min(row0 + row_group_size_, dt_->nrows());
+  ChunkMeta& meta = chunks_[i];
+  meta.dictionary_page_offset = NO_OFFSET;
+  meta.uncompressed_size = 0;
+  meta.nrows = row1 - row0;
+  meta.null_count = 0;
+  meta.has_minmax = false;
+
+  std::unique_ptr<dt::write::zlib_writer> zwriter;
+  bytes body;
+  bytes values;
+  std::vector<uint32_t> defs;
+
+  bool use_dict = bool(plan.dict);
+  int dict_width = 0;
+  if (use_dict) {
+    CString value;
+    size_t ndict = plan.dict.nrows();
+    for (size_t k = 0; k < ndict; ++k) {
+      plan.dict.get_element(k, &value);
+      append_le<uint32_t>(body, static_cast<uint32_t>(value.size()));
+      auto p = reinterpret_cast<const uint8_t*>(value.data());
+      body.insert(body.end(), p, p + value.size());
+    }
+    meta.dictionary_page_offset = 0;
+    write_page(PageType::DICTIONARY_PAGE, body, ndict, Encoding::PLAIN,
+               meta, zwriter);
+    dict_width = bit_width(ndict? static_cast<uint32_t>(ndict - 1) : 0);
+  }
+  meta.data_page_offset = meta.data.size();
+
+  size_t row = row0;
+  do {
+    size_t page_end = std::min(row + PAGE_NROWS, row1);
+    defs.clear();
+    values.clear();
+    Encoding encoding = Encoding::PLAIN;
+    switch (plan.stype) {
+      case SType::VOID:
+        defs.resize(page_end - row, 0);
+        meta.null_count += page_end - row;
+        break;
+      case SType::BOOL:
+        encode_bool(plan.column, row, page_end, defs, values, meta);
+        break;
+      case SType::INT8:
+        encode_fixed<int8_t, int32_t>(plan.column, row, page_end,
+                                      defs, values, meta);
+        break;
+      case SType::INT16:
+        encode_fixed<int16_t, int32_t>(plan.column, row, page_end,
+                                       defs, values, meta);
+        break;
+      case SType::INT32:
+        encode_fixed<int32_t, int32_t>(plan.column, row, page_end,
+                                       defs, values, meta);
+        break;
+      case SType::INT64:
+        encode_fixed<int64_t, int64_t>(plan.column, row, page_end,
+                                       defs, values, meta);
+        break;
+      case SType::FLOAT32:
+        encode_fixed<float, float>(plan.column, row, page_end,
+                                   defs, values, meta);
+        break;
+      case SType::FLOAT64:
+        encode_fixed<double, double>(plan.column, row, page_end,
+                                     defs, values, meta);
+        break;
+      default:
+        if (use_dict) {
+          encoding = Encoding::RLE_DICTIONARY;
+          encode_dict_indices(plan.codes, row, page_end, dict_width,
+                              defs, values, meta);
+        } else {
+          page_end = encode_string(plan.column, row, page_end,
+                                   defs, values, meta);
+        }
+    }
+    // All columns are written as OPTIONAL, so that each data page
+    // starts with the definition levels (with the max level of 1),
+    // prefixed by their byte length.
+    body.clear();
+    body.resize(4);
+    rle_encode(defs.data(), defs.size(), 1, body);
+    uint32_t defs_size = static_cast<uint32_t>(body.size() - 4);
+    std::memcpy(body.data(), &defs_size, 4);
+    body.insert(body.end(), values.begin(), values.end());
+    write_page(PageType::DATA_PAGE, body, page_end - row, encoding,
+               meta, zwriter);
+    row = page_end;
+  } while (row < row1);
+}
+
+
+void ParquetWriter::write_page(
+    PageType type, const bytes& body, size_t num_values, Encoding encoding,
+    ChunkMeta& meta, std::unique_ptr<dt::write::zlib_writer>& zwriter) const
+{
+  bytes compressed;
+  const uint8_t* pagedata = body.data();
+  size_t pagesize = body.size();
+  switch (codec_) {
+    case Codec::SNAPPY: {
+      compressed.resize(snappy::max_compressed_size(body.size()));
+      pagesize = snappy::compress(body.data(), body.size(),
+                                  compressed.data());
+      pagedata = compressed.data();
+      break;
+    }
+    case Codec::LZ4_RAW: {
+      compressed.resize(body.size() + body.size() / 255 + 16);
+      pagesize = lz4::compress(body.data(), body.size(),
+                               compressed.data(), compressed.size());
+      xassert(pagesize);
+      pagedata = compressed.data();
+      break;
+    }
+    case Codec::GZIP: {
+      if (!zwriter) {
+        zwriter = std::make_unique<dt::write::zlib_writer>(
+                        Z_DEFAULT_COMPRESSION, 15);
+      }
+      CString inout(reinterpret_cast<const char*>(body.data()), body.size());
+      zwriter->compress(inout);
+      pagedata = reinterpret_cast<const uint8_t*>(inout.data());
+      pagesize = inout.size();
+      break;
+    }
+    default: break;
+  }
+  constexpr size_t MAXSIZE = size_t(std::numeric_limits<int32_t>::max());
+  if (body.size() > MAXSIZE || pagesize > MAXSIZE) {
+    throw ValueError() << "Parquet page is too large: " << body.size();
+  }
+
+  ThriftWriter tw;
+  tw.begin_struct();
+  tw.field_i32(1, static_cast<int32_t>(type));
+  tw.field_i32(2, static_cast<int32_t>(body.size()));
+  tw.field_i32(3, static_cast<int32_t>(pagesize));
+  if (type == PageType::DATA_PAGE) {
+    tw.field_struct(5);
+    tw.field_i32(1, static_cast<int32_t>(num_values));
+    tw.field_i32(2, static_cast<int32_t>(encoding));
+    tw.field_i32(3, static_cast<int32_t>(Encoding::RLE));
+    tw.field_i32(4, static_cast<int32_t>(Encoding::RLE));
+    tw.end_struct();
+  } else {
+    tw.field_struct(7);
+    tw.field_i32(1, static_cast<int32_t>(num_values));
+    tw.field_i32(2, static_cast<int32_t>(encoding));
+    tw.field_bool(3, true);
+    tw.end_struct();
+  }
+  tw.end_struct();
+
+  meta.data.insert(meta.data.end(), tw.data(), tw.data() + tw.size());
+  meta.data.insert(meta.data.end(), pagedata, pagedata + pagesize);
+  meta.uncompressed_size += tw.size() + body.size();
+}
+
+
+void ParquetWriter::write_schema_element(ThriftWriter& tw,
+                                         const ColumnPlan& plan) const
+{
+  tw.begin_struct();
+  tw.field_i32(1, static_cast<int32_t>(plan.ptype));
+  tw.field_i32(3, static_cast<int32_t>(Repetition::OPTIONAL));
+  tw.field_string(4, plan.name);
+  if (plan.ctype != ConvertedType::NONE) {
+    tw.field_i32(6, static_cast<int32_t>(plan.ctype));
+  }
+  if (plan.ltype != LogicalType::NONE) {
+    tw.field_struct(10);
+    tw.field_struct(static_cast<int16_t>(plan.ltype));
+    if (plan.ltype == LogicalType::INTEGER) {
+      tw.field_i8(1, plan.int_bits);
+      tw.field_bool(2, true);
+    }
+    tw.end_struct();
+    tw.end_struct();
+  }
+  tw.end_struct();
+}
+
+
+void ParquetWriter::write_footer(WritableBuffer* wb) const {
+  size_t ncols = columns_.size();
+  ThriftWriter tw;
+  tw.begin_struct();
+  tw.field_i32(1, 1);  // version
+  // Schema: the root element followed by one element per column
+  tw.field_list(2, TType::STRUCT, ncols + 1);
+  tw.begin_struct();
+  tw.field_string(4, "schema");
+  tw.field_i32(5, static_cast<int32_t>(ncols));
+  tw.end_struct();
+  for (const ColumnPlan& plan : columns_) {
+    write_schema_element(tw, plan);
+  }
+  tw.field_i64(3, static_cast<int64_t>(dt_->nrows()));
+  // Row groups
+  size_t ngroups = ncols? nrowgroups_ : 0;
+  tw.field_list(4, TType::STRUCT, ngroups);
+  for (size_t g = 0; g < ngroups; ++g) {
+    size_t total_uncompressed = 0;
+    size_t total_compressed = 0;
+    const ChunkMeta& first = chunks_[g * ncols];
+    tw.begin_struct();
+    tw.field_list(1, TType::STRUCT, ncols);
+    for (size_t j = 0; j < ncols; ++j) {
+      const ColumnPlan& plan = columns_[j];
+      const ChunkMeta& meta = chunks_[g * ncols + j];
+      total_uncompressed += meta.uncompressed_size;
+      total_compressed += meta.compressed_size;
+
+      tw.begin_struct();  // ColumnChunk
+      tw.field_i64(2, static_cast<int64_t>(meta.offset));
+      tw.field_struct(3);  // ColumnMetaData
+      tw.field_i32(1, static_cast<int32_t>(plan.ptype));
+      bool dict = (meta.dictionary_page_offset != NO_OFFSET);
+      tw.field_list(2, TType::I32, dict? 3 : 2);
+      tw.value_i32(static_cast<int32_t>(Encoding::PLAIN));
+      tw.value_i32(static_cast<int32_t>(Encoding::RLE));
+      if (dict) tw.value_i32(static_cast<int32_t>(Encoding::RLE_DICTIONARY));
+      tw.field_list(3, TType::BINARY, 1);
+      tw.value_string(plan.name);
+      tw.field_i32(4, static_cast<int32_t>(codec_));
+      tw.field_i64(5, static_cast<int64_t>(meta.nrows));
+      tw.field_i64(6, static_cast<int64_t>(meta.uncompressed_size));
+      tw.field_i64(7, static_cast<int64_t>(meta.compressed_size));
+      tw.field_i64(9, static_cast<int64_t>(meta.offset +
+                                           meta.data_page_offset));
+      if (dict) {
+        tw.field_i64(11, static_cast<int64_t>(meta.offset +
+                                              meta.dictionary_page_offset));
+      }
+      tw.field_struct(12);  // Statistics
+      tw.field_i64(3, static_cast<int64_t>(meta.null_count));
+      if (meta.has_minmax) {
+        tw.field_binary(5, meta.max_value.data(), meta.max_value.size());
+        tw.field_binary(6, meta.min_value.data(), meta.min_value.size());
+      }
+      tw.end_struct();
+      tw.end_struct();
+      tw.end_struct();
+    }
+    tw.field_i64(2, static_cast<int64_t>(total_uncompressed));
+    tw.field_i64(3, static_cast<int64_t>(first.nrows));
+    tw.field_i64(5, static_cast<int64_t>(first.offset));
+    tw.field_i64(6, static_cast<int64_t>(total_compressed));
+    tw.field_i32(7, static_cast<int32_t>(g));  // ordinal (an i16)
+    tw.end_struct();
+  }
+  tw.field_string(6, "datatable");
+  // Declare that min/max statistics use the natural ordering of each
+  // type, otherwise the readers are allowed to ignore them.
+  tw.field_list(7, TType::STRUCT, ncols);
+  for (size_t j = 0; j < ncols; ++j) {
+    tw.begin_struct();     // ColumnOrder
+    tw.field_struct(1);    // TypeDefinedOrder
+    tw.end_struct();
+    tw.end_struct();
+  }
+  tw.end_struct();
+
+  xassert(tw.size() <= std::numeric_limits<uint32_t>::max());
+  uint32_t footer_size = static_cast<uint32_t>(tw.size());
+  wb->write(tw.size(), tw.data());
+  wb->write(4, &footer_size);
+  wb->write(4, "PAR1");
+}
+
+
+}}  // namespace dt::parquet
+
+
+
+
+//------------------------------------------------------------------------------
+// Save DataTable
+//------------------------------------------------------------------------------
+
+void DataTable::save_parquet(const std::string& path,
+                             WritableBuffer::Strategy wstrategy,
+                             int codec, size_t row_group_size)
+{
+  size_t sizehint = (wstrategy == WritableBuffer::Strategy::Auto)
+                    ? memory_footprint() : 0;
+  auto wb = WritableBuffer::create_target(path, sizehint, wstrategy);
+  dt::parquet::ParquetWriter writer(
+      this, static_cast<dt::parquet::Codec>(codec), row_group_size);
+  writer.write(wb.get());
+}
+
+
+Buffer DataTable::save_parquet(int codec, size_t row_group_size) {
+  auto wb = std::unique_ptr<MemoryWritableBuffer>(
+                new MemoryWritableBuffer(memory_footprint()));
+  dt::parquet::ParquetWriter writer(
+      this, static_cast<dt::parquet::Codec>(codec), row_group_size);
+  writer.write(wb.get());
+  return wb->get_mbuf();
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// py::Frame interface
+//------------------------------------------------------------------------------
+namespace py {
+
+static const char* doc_to_parquet =
+R"(to_parquet(self, path=None, method='auto', compression=None,
+       row_group_size=None)
+--
+
+Save this frame into a file in the `Apache Parquet`_ format, which can
+be read by most of the data processing tools (Spark, Arrow, pandas,
+etc), and by :func:`fread()`.
+
+All columns are written as "optional" (i.e. nullable) flat columns.
+Boolean, integer and float columns are stored using the PLAIN
+encoding; string columns with few distinct values use the dictionary
+encoding (reusing the column's dictionary if it is already
+dictionary-encoded in memory), and the rest are stored as PLAIN too.
+The column chunks of all row groups are encoded and compressed in
+parallel.
+
+.. _`Apache Parquet`: https://parquet.apache.org/
+
+Parameters
+----------
+path: str | None
+    The destination file name. If the file exists, it will be
+    overwritten. If this argument is omitted, the file will be created
+    in memory instead, and returned as a `bytes` object.
+
+method: 'mmap' | 'write' | 'auto'
+    Which method to use for writing the file to disk. This parameter
+    has no effect when `path` is omitted.
+
+compression: None | 'snappy' | 'gzip' | 'lz4'
+    Compression codec for the data pages. The "lz4" option corresponds
+    to Parquet's LZ4_RAW codec.
+
+row_group_size: None | int
+    The maximum number of rows in each row group. The default is
+    1048576.
+
+return: None | bytes
+    If the `path` parameter is given, this method returns nothing.
+    However, if `path` was omitted, the return value is a `bytes`
+    object containing the encoded frame's data.
+)";
+
+static PKArgs args_to_parquet(
+  1, 0, 3, false, false,
+  {"path", "method", "compression", "row_group_size"},
+  "to_parquet",
+  doc_to_parquet);
+
+
+oobj Frame::to_parquet(const PKArgs& args) {
+  using dt::parquet::Codec;
+  // path
+  oobj path = args[0].to<oobj>(ostring(""));
+  if (!path.is_string()) {
+    throw TypeError() << "Parameter `path` in Frame.to_parquet() should be "
+        "a string, instead got " << path.typeobj();
+  }
+  path = oobj::import("os", "path", "expanduser").call({path});
+  std::string filename = path.to_string();
+
+  // method
+  auto str_method = args[1].to<std::string>("auto");
+  auto method = (str_method == "mmap") ? WritableBuffer::Strategy::Mmap :
+                (str_method == "write")? WritableBuffer::Strategy::Write :
+                (str_method == "auto") ? WritableBuffer::Strategy::Auto :
+                                         WritableBuffer::Strategy::Unknown;
+  if (method == WritableBuffer::Strategy::Unknown) {
+    throw TypeError() << "Parameter `method` in Frame.to_parquet() should be "
+        "one of 'mmap', 'write' or 'auto'; instead got '" << str_method << "'";
+  }
+
+  // compression
+  Codec codec = Codec::UNCOMPRESSED;
+  if (!args[2].is_none_or_undefined()) {
+    auto str_compression = args[2].to_string();
+    if (str_compression == "snappy") codec = Codec::SNAPPY;
+    else if (str_compression == "gzip") codec = Codec::GZIP;
+    else if (str_compression == "lz4") codec = Codec::LZ4_RAW;
+    else {
+      throw ValueError() << "Parameter `compression` in Frame.to_parquet() "
+          "should be one of None, 'snappy', 'gzip' or 'lz4'; instead got '"
+          << str_compression << "'";
+    }
+  }
+
+  // row_group_size
+  size_t row_group_size = 1 << 20;
+  if (!args[3].is_none_or_undefined()) {
+    row_group_size = args[3].to_size_t();
+    if (row_group_size == 0) {
+      throw ValueError() << "Parameter `row_group_size` in Frame.to_parquet() "
+          "should be positive";
+    }
+  }
+
+  if (filename.empty()) {
+    Buffer mr = dt->save_parquet(static_cast<int>(codec), row_group_size);
+    auto data = static_cast<const char*>(mr.xptr());
+    auto size = static_cast<Py_ssize_t>(mr.size());
+    return oobj::from_new_reference(PyBytes_FromStringAndSize(data, size));
+  }
+  dt->save_parquet(filename, method, static_cast<int>(codec), row_group_size);
+  return None();
+}
+
+
+void Frame::_init_parquet(XTypeMaker& xt) {
+  xt.add(METHOD(&Frame::to_parquet, args_to_parquet));
+}
+
+
+} // namespace py
@@ -0,0 +1,297 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include "parquet/thrift.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+namespace dt {
+namespace parquet {
+
+// Protection against maliciously deep nesting of structs / lists
+static constexpr size_t MAX_NESTING_DEPTH = 64;
+
+static Error malformed_error() {
+  return IOError() << "Invalid Parquet file: the metadata is malformed";
+}
+
+
+
+//------------------------------------------------------------------------------
+// ThriftWriter
+//------------------------------------------------------------------------------
+
+ThriftWriter::ThriftWriter() {
+  out_.reserve(1024);
+}
+
+
+void ThriftWriter::begin_struct() {
+  last_field_.push_back(0);
+}
+
+void ThriftWriter::end_struct() {
+  xassert(!last_field_.empty());
+  out_.push_back(static_cast<uint8_t>(TType::STOP));
+  last_field_.pop_back();
+}
+
+
+void ThriftWriter::field_bool(int16_t id, bool value) {
+  write_field_header(id, value? TType::BOOL_TRUE : TType::BOOL_FALSE);
+}
+
+void ThriftWriter::field_i8(int16_t id, int8_t value) {
+  write_field_header(id, TType::BYTE);
+  out_.push_back(static_cast<uint8_t>(value));
+}
+
+void ThriftWriter::field_i32(int16_t id, int32_t value) {
+  write_field_header(id, TType::I32);
+  write_zigzag(value);
+}
+
+void ThriftWriter::field_i64(int16_t id, int64_t value) {
+  write_field_header(id, TType::I64);
+  write_zigzag(value);
+}
+
+void ThriftWriter::field_binary(int16_t id, const void* data, size_t size) {
+  write_field_header(id, TType::BINARY);
+  write_varint(size);
+  auto ptr = static_cast<const uint8_t*>(data);
+  out_.insert(out_.end(), ptr, ptr + size);
+}
+
+void ThriftWriter::field_string(int16_t id, const std::string& value) {
+  field_binary(id, value.data(), value.size());
+}
+
+void ThriftWriter::field_struct(int16_t id) {
+  write_field_header(id, TType::STRUCT);
+  begin_struct();
+}
+
+void ThriftWriter::field_list(int16_t id, TType elemtype, size_t size) {
+  write_field_header(id, TType::LIST);
+  auto etype = static_cast<uint8_t>(elemtype);
+  if (size < 15) {
+    out_.push_back(static_cast<uint8_t>(size << 4) | etype);
+  } else {
+    out_.push_back(0xF0 | etype);
+    write_varint(size);
+  }
+}
+
+
+void ThriftWriter::value_i32(int32_t value) {
+  write_zigzag(value);
+}
+
+void ThriftWriter::value_string(const std::string& value) {
+  write_varint(value.size());
+  out_.insert(out_.end(), value.begin(), value.end());
+}
+
+
+void ThriftWriter::write_field_header(int16_t id, TType type) {
+  xassert(!last_field_.empty());
+  int16_t delta = id - last_field_.back();
+  auto t = static_cast<uint8_t>(type);
+  if (delta > 0 && delta <= 15) {
+    out_.push_back(static_cast<uint8_t>(delta << 4) | t);
+  } else {
+    out_.push_back(t);
+    write_zigzag(id);
+  }
+  last_field_.back() = id;
+}
+
+void ThriftWriter::write_varint(uint64_t value) {
+  while (value >= 0x80) {
+    out_.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out_.push_back(static_cast<uint8_t>(value));
+}
+
+void ThriftWriter::write_zigzag(int64_t value) {
+  write_varint((static_cast<uint64_t>(value) << 1) ^
+               static_cast<uint64_t>(value >> 63));
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// ThriftReader
+//------------------------------------------------------------------------------
+
+ThriftReader::ThriftReader(const void* data, size_t size)
+  : ptr_(static_cast<const uint8_t*>(data)),
+    end_(ptr_ + size),
+    start_(ptr_) {}
+
+
+void ThriftReader::begin_struct() {
+  if (last_field_.size() >= MAX_NESTING_DEPTH) throw malformed_error();
+  last_field_.push_back(0);
+}
+
+
+bool ThriftReader::read_field(int16_t* id, TType* type) {
+  xassert(!last_field_.empty());
+  uint8_t byte = read_byte();
+  if (byte == 0) {
+    last_field_.pop_back();
+    return false;
+  }
+  uint8_t t = byte & 0x0F;
+  uint8_t delta = byte >> 4;
+  if (t > static_cast<uint8_t>(TType::STRUCT)) throw malformed_error();
+  if (delta) {
+    *id = static_cast<int16_t>(last_field_.back() + delta);
+  } else {
+    *id = static_cast<int16_t>(read_zigzag());
+  }
+  *type = static_cast<TType>(t);
+  last_field_.back() = *id;
+  return true;
+}
+
+
+bool ThriftReader::read_bool(TType type) {
+  return type == TType::BOOL_TRUE;
+}
+
+int8_t ThriftReader::read_i8() {
+  return static_cast<int8_t>(read_byte());
+}
+
+int32_t ThriftReader::read_i32() {
+  return static_cast<int32_t>(read_zigzag());
+}
+
+int64_t ThriftReader::read_i64() {
+  return read_zigzag();
+}
+
+std::string ThriftReader::read_string() {
+  uint64_t size = read_varint();
+  if (size > static_cast<uint64_t>(end_ - ptr_)) throw malformed_error();
+  std::string res(reinterpret_cast<const char*>(ptr_),
+                  static_cast<size_t>(size));
+  ptr_ += size;
+  return res;
+}
+
+size_t ThriftReader::read_list(TType* elemtype) {
+  uint8_t byte = read_byte();
+  uint64_t size = byte >> 4;
+  if (size == 15) size = read_varint();
+  // Each element occupies at least one byte
+  if (size > static_cast<uint64_t>(end_ - ptr_)) throw malformed_error();
+  *elemtype = static_cast<TType>(byte & 0x0F);
+  return static_cast<size_t>(size);
+}
+
+
+void ThriftReader::skip(TType type) {
+  switch (type) {
+    case TType::BOOL_TRUE:
+    case TType::BOOL_FALSE: return;
+    case TType::BYTE:       skip_bytes(1); return;
+    case TType::I16:
+    case TType::I32:
+    case TType::I64:        read_varint(); return;
+    case TType::DOUBLE:     skip_bytes(8); return;
+    case TType::BINARY:     skip_bytes(read_varint()); return;
+    case TType::LIST:
+    case TType::SET: {
+      if (last_field_.size() >= MAX_NESTING_DEPTH) throw malformed_error();
+      TType etype;
+      size_t n = read_list(&etype);
+      last_field_.push_back(0);  // guards the nesting depth
+      for (size_t i = 0; i < n; ++i) {
+        // Within lists, booleans are stored as one-byte values
+        if (etype == TType::BOOL_TRUE || etype == TType::BOOL_FALSE) {
+          skip_bytes(1);
+        } else {
+          skip(etype);
+        }
+      }
+      last_field_.pop_back();
+      return;
+    }
+    case TType::MAP: {
+      uint64_t n = read_varint();
+      if (n == 0) return;
+      uint8_t kv = read_byte();
+      if (n > static_cast<uint64_t>(end_ - ptr_)) throw malformed_error();
+      if (last_field_.size() >= MAX_NESTING_DEPTH) throw malformed_error();
+      last_field_.push_back(0);
+      for (uint64_t i = 0; i < n; ++i) {
+        skip(static_cast<TType>(kv >> 4));
+        skip(static_cast<TType>(kv & 0x0F));
+      }
+      last_field_.pop_back();
+      return;
+    }
+    case TType::STRUCT: {
+      begin_struct();
+      int16_t id;
+      TType ftype;
+      while (read_field(&id, &ftype)) skip(ftype);
+      return;
+    }
+    default:
+      throw malformed_error();
+  }
+}
+
+
+uint8_t ThriftReader::read_byte() {
+  if (ptr_ >= end_) throw malformed_error();
+  return *ptr_++;
+}
+
+uint64_t ThriftReader::read_varint() {
+  uint64_t res = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = read_byte();
+    res |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return res;
+  }
+  throw malformed_error();
+}
+
+int64_t ThriftReader::read_zigzag() {
+  uint64_t u = read_varint();
+  return static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+}
+
+void ThriftReader::skip_bytes(size_t n) {
+  if (n > static_cast<size_t>(end_ - ptr_)) throw malformed_error();
+  ptr_ += n;
+}
+
+
+
+}}  // namespace dt::parquet
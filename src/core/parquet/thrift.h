@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_PARQUET_THRIFT_h
+#define dt_PARQUET_THRIFT_h
+#include <cstddef>      // size_t
+#include <cstdint>      // int16_t, int32_t, int64_t, uint8_t
+#include <string>       // std::string
+#include <vector>       // std::vector
+namespace dt {
+namespace parquet {
+
+
+/**
+  * Type codes of Thrift's "compact protocol", which is used to
+  * serialize all metadata structures in a Parquet file (the file
+  * footer and the page headers).
+  */
+enum class TType : uint8_t {
+  STOP       = 0,
+  BOOL_TRUE  = 1,
+  BOOL_FALSE = 2,
+  BYTE       = 3,
+  I16        = 4,
+  I32        = 5,
+  I64        = 6,
+  DOUBLE     = 7,
+  BINARY     = 8,
+  LIST       = 9,
+  SET        = 10,
+  MAP        = 11,
+  STRUCT     = 12,
+};
+
+
+
+/**
+  * Serializer for the Thrift compact protocol. The structures are
+  * written field-by-field: the caller opens a struct with
+  * `begin_struct()` (or `field_struct()` for a nested struct), writes
+  * the fields in the increasing order of their ids, and then closes
+  * the struct with `end_struct()`.
+  *
+  * Lists are written by calling `field_list()` with the number of
+  * elements, followed by exactly that many `value_*()` calls (or
+  * `begin_struct()` / `end_struct()` pairs for lists of structs).
+  */
+class ThriftWriter {
+  private:
+    std::vector<uint8_t> out_;
+    std::vector<int16_t> last_field_;
+
+  public:
+    ThriftWriter();
+
+    void begin_struct();
+    void end_struct();
+
+    void field_bool(int16_t id, bool value);
+    void field_i8(int16_t id, int8_t value);
+    void field_i32(int16_t id, int32_t value);
+    void field_i64(int16_t id, int64_t value);
+    void field_binary(int16_t id, const void* data, size_t size);
+    void field_string(int16_t id, const std::string& value);
+    void field_struct(int16_t id);
+    void field_list(int16_t id, TType elemtype, size_t size);
+
+    void value_i32(int32_t value);
+    void value_string(const std::string& value);
+
+    const uint8_t* data() const { return out_.data(); }
+    size_t size() const { return out_.size(); }
+
+  private:
+    void write_field_header(int16_t id, TType type);
+    void write_varint(uint64_t value);
+    void write_zigzag(int64_t value);
+};
+
+
+
+/**
+  * Deserializer for the Thrift compact protocol. The input is
+  * untrusted: every read is bounds-checked, and an IOError is thrown
+  * if the data is malformed.
+  *
+  * A struct is read as follows:
+  *
+  *     reader.begin_struct();
+  *     int16_t id;
+  *     TType type;
+  *     while (reader.read_field(&id, &type)) {
+  *       switch (id) {
+  *         case 1: x = reader.read_i32(); break;
+  *         ...
+  *         default: reader.skip(type);
+  *       }
+  *     }
+  *
+  * Boolean fields carry their value in the field's type, and should
+  * be decoded with `read_bool(type)`.
+  */
+class ThriftReader {
+  private:
+    const uint8_t* ptr_;
+    const uint8_t* end_;
+    const uint8_t* start_;
+    std::vector<int16_t> last_field_;
+
+  public:
+    ThriftReader(const void* data, size_t size);
+
+    void begin_struct();
+    bool read_field(int16_t* id, TType* type);
+
+    bool read_bool(TType type);
+    int8_t read_i8();
+    int32_t read_i32();
+    int64_t read_i64();
+    std::string read_string();
+    size_t read_list(TType* elemtype);
+    void skip(TType type);
+
+    // Number of bytes consumed so far
+    size_t position() const { return static_cast<size_t>(ptr_ - start_); }
+
+  private:
+    uint8_t read_byte();
+    uint64_t read_varint();
+    int64_t read_zigzag();
+    void skip_bytes(size_t n);
+};
+
+
+
+}}  // namespace dt::parquet
+#endif
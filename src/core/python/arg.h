@@ -51,6 +51,7 @@ class Arg : public _obj::error_manager {
     void set(PyObject* value);
 
     //---- Type checks -----------------
+    bool is_arrow_object() const;
     bool is_auto() const;  // check for string "auto"
     bool is_bool() const;
     bool is_bytes() const;
@@ -221,6 +221,13 @@ bool _obj::is_range()         const noexcept { return v && PyRange_Check(v); }
 bool _obj::is_slice()         const noexcept { return v && PySlice_Check(v); }
 bool _obj::is_generator()     const noexcept { return v && PyGen_Check(v); }
 
+// An object implementing the Arrow PyCapsule protocol
+bool _obj::is_arrow_object() const noexcept {
+  return v && !PyType_Check(v) &&
+         (PyObject_HasAttrString(v, "__arrow_c_stream__") ||
+          PyObject_HasAttrString(v, "__arrow_c_array__"));
+}
+
 bool _obj::is_iterable() const noexcept {
   return v && (v->ob_type->tp_iter || PySequence_Check(v));
 }
@@ -23,6 +23,7 @@
 #include "csv/reader_fread.h"      // FreadReader
 #include "read/fread/fread_thread_context.h"
 #include "read/parallel_reader.h"  // ChunkCoordinates
+#include "read/row_filter.h"       // RowFilter
 #include "utils/misc.h"            // wallclock
 #include "encodings.h"             // check_escaped_string, decode_escaped_csv_string
 #include "py_encodings.h"          // decode_win1252
@@ -35,6 +36,7 @@ FreadThreadContext::FreadThreadContext(
     size_t bcols, size_t brows, FreadReader& f, PT* types
   ) : ThreadContext(bcols, brows, f.preframe),
       global_types_(types),
+      row_filter_(f.row_filter.get()),
       freader(f),
       parsers(ParserLibrary::get_parser_fns())
 {
@@ -243,11 +245,24 @@ void FreadThreadContext::read_chunk(
   }
 
   if (local_types_.empty()) {
+    // Rows rejected by the filter are removed from the thread buffer
+    // here, so that they never reach the output columns. If there was
+    // a type bump, the chunk will be re-read anyways.
+    if (row_filter_) {
+      used_nrows = row_filter_->apply(
+          tbuf.data(), tbuf_ncols, used_nrows, types,
+          static_cast<const char*>(parse_ctx_.strbuf.rptr()), filter_mask_);
+    }
     preorder();
   }
 
   // Tell the caller where we finished reading the chunk. This is why
   // the parameter `actual_cc` was passed to this function.
+  // When reading in chunks, the reader needs to know how many physical
+  // lines were consumed, so that it could report correct line numbers
+  // in the next batch.
+  nlines_ = freader.chunk_nrows? parse_ctx_.count_lines(cc.get_start(), tch)
+                               : 0;
   actual_cc.set_end_exact(tch);
   if (verbose) ttime_read += wallclock() - t0;
 }
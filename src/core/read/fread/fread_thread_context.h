@@ -27,6 +27,8 @@
 namespace dt {
 namespace read {
 
+class RowFilter;
+
 
 /**
  *
@@ -48,6 +50,8 @@ class FreadThreadContext : public ThreadContext
     double ttime_read;
     PT* global_types_;
     std::vector<PT> local_types_;
+    const RowFilter* row_filter_;
+    std::vector<int8_t> filter_mask_;
 
     FreadReader& freader;
     const ParserFnPtr* parsers;
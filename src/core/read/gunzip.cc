@@ -0,0 +1,820 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>           // std::max, std::min
+#include <cstring>             // std::memcpy, std::memset, std::memchr
+#include <vector>              // std::vector
+#include "lib/zlib/zlib.h"     // zlib::crc32
+#include "parallel/api.h"      // dt::parallel_for_static
+#include "python/obj.h"
+#include "python/int.h"
+#include "python/tuple.h"
+#include "read/gunzip.h"
+#include "utils/alloc.h"       // dt::realloc, dt::free
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+namespace dt {
+namespace read {
+
+// See RFC-1951 (DEFLATE) and RFC-1952 (GZIP) for the description of
+// the formats decoded here.
+
+static constexpr size_t MAX_CODE_BITS = 15;
+static constexpr size_t MAX_MATCH_LENGTH = 258;
+static constexpr size_t NUM_LITLEN_SYMBOLS = 288;
+static constexpr size_t NUM_DIST_SYMBOLS = 32;
+
+static constexpr uint8_t FLAG_HCRC = 2;
+static constexpr uint8_t FLAG_EXTRA = 4;
+static constexpr uint8_t FLAG_NAME = 8;
+static constexpr uint8_t FLAG_COMMENT = 16;
+
+static const uint16_t LENGTH_BASE[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+  67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t LENGTH_EXTRA[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+  4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t DIST_BASE[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+  513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t DIST_EXTRA[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7,
+  8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t CODELEN_ORDER[19] = {
+  16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+
+static Error gzip_error() {
+  return IOError() << "Invalid gzip data: ";
+}
+
+static inline uint32_t read_u32le(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) |
+         (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static inline uint64_t read_u64le(const uint8_t* p) {
+  uint64_t x;
+  std::memcpy(&x, p, sizeof(x));  // assumes little-endian platform
+  return x;
+}
+
+
+
+//------------------------------------------------------------------------------
+// HuffmanTable
+//------------------------------------------------------------------------------
+
+/**
+  * Lookup table for decoding canonical Huffman codes. The bits of the
+  * input are looked up `primary_bits_` at a time; the codes that are
+  * longer than that are resolved through a second-level subtable.
+  *
+  * Each entry of the table is a 32-bit value:
+  *   bits 0-7   the length of the code, or 0 if the code is invalid;
+  *   bit  8     if set, the entry is a link to a subtable, and bits
+  *              0-7 contain the number of index bits in that subtable;
+  *   bits 16-31 the decoded symbol, or the offset of the subtable.
+  */
+class HuffmanTable {
+  private:
+    static constexpr uint32_t SUBTABLE = 0x100;
+    std::vector<uint32_t> entries_;
+    size_t primary_bits_;
+
+  public:
+    HuffmanTable() : primary_bits_(0) {}
+
+    // Returns false if the code lengths are over-subscribed.
+    bool build(const uint8_t* lengths, size_t n, size_t primary_bits);
+
+    inline uint32_t lookup(uint64_t bits) const {
+      uint32_t e = entries_[bits & ((size_t(1) << primary_bits_) - 1)];
+      if (e & SUBTABLE) {
+        size_t mask = (size_t(1) << (e & 0xFF)) - 1;
+        e = entries_[(e >> 16) + ((bits >> primary_bits_) & mask)];
+      }
+      return e;
+    }
+};
+
+
+bool HuffmanTable::build(const uint8_t* lengths, size_t n,
+                         size_t primary_bits)
+{
+  size_t count[MAX_CODE_BITS + 1] = {0};
+  for (size_t i = 0; i < n; ++i) count[lengths[i]]++;
+  count[0] = 0;
+
+  int64_t left = 1;
+  size_t maxlen = 0;
+  for (size_t len = 1; len <= MAX_CODE_BITS; ++len) {
+    left = 2*left - static_cast<int64_t>(count[len]);
+    if (left < 0) return false;
+    if (count[len]) maxlen = len;
+  }
+
+  uint32_t next_code[MAX_CODE_BITS + 1];
+  uint32_t code = 0;
+  for (size_t len = 1; len <= MAX_CODE_BITS; ++len) {
+    code = (code + static_cast<uint32_t>(count[len - 1])) << 1;
+    next_code[len] = code;
+  }
+
+  size_t psize = size_t(1) << primary_bits;
+  size_t sbits = maxlen > primary_bits? maxlen - primary_bits : 0;
+  primary_bits_ = primary_bits;
+  entries_.assign(psize, 0);
+  for (size_t sym = 0; sym < n; ++sym) {
+    size_t len = lengths[sym];
+    if (!len) continue;
+    // Deflate stores Huffman codes starting from the most significant
+    // bit, so the table is indexed by the bit-reversed codes.
+    uint32_t c = next_code[len]++;
+    size_t rev = 0;
+    for (size_t i = 0; i < len; ++i) {
+      rev = (rev << 1) | ((c >> i) & 1);
+    }
+    uint32_t entry = static_cast<uint32_t>((sym << 16) | len);
+    if (len <= primary_bits) {
+      for (size_t i = rev; i < psize; i += size_t(1) << len) {
+        entries_[i] = entry;
+      }
+    } else {
+      size_t pindex = rev & (psize - 1);
+      if (!(entries_[pindex] & SUBTABLE)) {
+        size_t offset = entries_.size();
+        entries_.resize(offset + (size_t(1) << sbits), 0);
+        entries_[pindex] = static_cast<uint32_t>((offset << 16) | SUBTABLE | sbits);
+      }
+      size_t offset = entries_[pindex] >> 16;
+      for (size_t i = rev >> primary_bits; i < (size_t(1) << sbits);
+           i += size_t(1) << (len - primary_bits)) {
+        entries_[offset + i] = entry;
+      }
+    }
+  }
+  return true;
+}
+
+
+struct FixedTables {
+  HuffmanTable litlen;
+  HuffmanTable dist;
+
+  FixedTables() {
+    uint8_t lengths[NUM_LITLEN_SYMBOLS];
+    std::memset(lengths,       8, 144);
+    std::memset(lengths + 144, 9, 112);
+    std::memset(lengths + 256, 7, 24);
+    std::memset(lengths + 280, 8, 8);
+    litlen.build(lengths, NUM_LITLEN_SYMBOLS, 10);
+    std::memset(lengths, 5, NUM_DIST_SYMBOLS);
+    dist.build(lengths, NUM_DIST_SYMBOLS, 8);
+  }
+};
+
+static const FixedTables& fixed_tables() {
+  static FixedTables tables;
+  return tables;
+}
+
+
+
+//------------------------------------------------------------------------------
+// OutputBuffer
+//------------------------------------------------------------------------------
+
+/**
+  * Growable memory region where the decompressed data is written.
+  */
+struct OutputBuffer {
+  uint8_t* data;
+  size_t size;
+  size_t capacity;
+
+  OutputBuffer() : data(nullptr), size(0), capacity(0) {}
+  OutputBuffer(const OutputBuffer&) = delete;
+  OutputBuffer(OutputBuffer&& o) noexcept
+    : data(o.data), size(o.size), capacity(o.capacity)
+  {
+    o.data = nullptr;
+    o.size = o.capacity = 0;
+  }
+  ~OutputBuffer() { dt::free(data); }
+
+  void reserve(size_t n) {
+    if (n <= capacity) return;
+    n = std::max(n, capacity * 2);
+    data = dt::realloc(data, n);
+    capacity = n;
+  }
+
+  Buffer release() {
+    if (size == 0) return Buffer();
+    data = dt::realloc(data, size);
+    auto res = Buffer::acquire(data, size);
+    data = nullptr;
+    size = capacity = 0;
+    return res;
+  }
+};
+
+
+
+//------------------------------------------------------------------------------
+// GzipDecoder
+//------------------------------------------------------------------------------
+
+// Parse the header of a gzip member at offset `pos` within the input,
+// and return the offset where the compressed data begins.
+static size_t read_header(const uint8_t* start, const uint8_t* end,
+                          size_t pos)
+{
+  const uint8_t* p = start + pos;
+  size_t avail = static_cast<size_t>(end - p);
+  if (avail < 10 || p[0] != 0x1F || p[1] != 0x8B || p[2] != 8 ||
+      (p[3] & 0xE0)) {
+    throw gzip_error() << "incorrect header";
+  }
+  uint8_t flags = p[3];
+  size_t i = 10;
+  if ((flags & FLAG_EXTRA) && i + 2 <= avail) {
+    i += 2 + (static_cast<size_t>(p[i]) | (static_cast<size_t>(p[i+1]) << 8));
+  }
+  if (flags & FLAG_NAME) {
+    while (i < avail && p[i]) i++;
+    i++;
+  }
+  if (flags & FLAG_COMMENT) {
+    while (i < avail && p[i]) i++;
+    i++;
+  }
+  if (flags & FLAG_HCRC) i += 2;
+  if (i > avail) {
+    throw gzip_error() << "unexpected end of input";
+  }
+  return pos + i;
+}
+
+
+static uint32_t update_crc32(uint32_t crc, const uint8_t* data, size_t n) {
+  zlib::uLong res = crc;
+  while (n) {
+    auto chunk = static_cast<zlib::uInt>(std::min<size_t>(n, 1 << 30));
+    res = zlib::crc32(res, data, chunk);
+    data += chunk;
+    n -= chunk;
+  }
+  return static_cast<uint32_t>(res);
+}
+
+
+
+class GzipDecoder {
+  private:
+    const uint8_t* start_;
+    const uint8_t* end_;
+    const uint8_t* in_;
+    // Number of (virtual) zero bytes loaded into the bit buffer after
+    // the input was exhausted
+    size_t overrun_;
+    uint64_t bitbuf_;
+    size_t bitcnt_;
+    OutputBuffer& out_;
+    size_t member_start_;  // offset in `out_` where the current member begins
+    HuffmanTable litlen_;
+    HuffmanTable dist_;
+    HuffmanTable codelen_;
+
+  public:
+    GzipDecoder(const uint8_t* start, const uint8_t* end, OutputBuffer& out)
+      : start_(start), end_(end), in_(start), overrun_(0),
+        bitbuf_(0), bitcnt_(0), out_(out), member_start_(0) {}
+
+    size_t decode_member(size_t pos);
+
+  private:
+    void decode_stored_block();
+    void read_dynamic_tables();
+    void decode_huffman_block(const HuffmanTable& litlen,
+                              const HuffmanTable& dist);
+
+    // Ensure that the bit buffer has at least 56 bits
+    inline void refill() {
+      if (end_ - in_ >= 8) {
+        bitbuf_ |= read_u64le(in_) << bitcnt_;
+        in_ += (63 - bitcnt_) >> 3;
+        bitcnt_ |= 56;
+      } else {
+        while (bitcnt_ <= 56) {
+          if (in_ < end_) {
+            bitbuf_ |= static_cast<uint64_t>(*in_++) << bitcnt_;
+          } else {
+            if (++overrun_ > 8) throw gzip_error() << "unexpected end of input";
+          }
+          bitcnt_ += 8;
+        }
+      }
+    }
+
+    inline size_t bits(size_t n) const {
+      return static_cast<size_t>(bitbuf_ & ((uint64_t(1) << n) - 1));
+    }
+
+    inline void consume(size_t n) {
+      bitbuf_ >>= n;
+      bitcnt_ -= n;
+    }
+
+    // Discard the bits up to the next byte boundary, and return the
+    // offset of the current byte within the input.
+    size_t align_to_byte() {
+      consume(bitcnt_ & 7);
+      size_t pos = static_cast<size_t>(in_ - start_) + overrun_ - bitcnt_/8;
+      if (pos > static_cast<size_t>(end_ - start_)) {
+        throw gzip_error() << "unexpected end of input";
+      }
+      in_ = start_ + pos;
+      overrun_ = 0;
+      bitbuf_ = 0;
+      bitcnt_ = 0;
+      return pos;
+    }
+};
+
+
+/**
+  * Decode a single gzip member starting at offset `pos` within the
+  * input, appending the uncompressed data to `out_`. Returns the
+  * offset of the first byte after the member.
+  */
+size_t GzipDecoder::decode_member(size_t pos) {
+  in_ = start_ + read_header(start_, end_, pos);
+  overrun_ = 0;
+  bitbuf_ = 0;
+  bitcnt_ = 0;
+  member_start_ = out_.size;
+
+  bool last_block;
+  do {
+    refill();
+    last_block = bitbuf_ & 1;
+    size_t type = (bitbuf_ >> 1) & 3;
+    consume(3);
+    switch (type) {
+      case 0: decode_stored_block(); break;
+      case 1: decode_huffman_block(fixed_tables().litlen, fixed_tables().dist); break;
+      case 2: read_dynamic_tables();
+              decode_huffman_block(litlen_, dist_); break;
+      default: throw gzip_error() << "invalid block type";
+    }
+  } while (!last_block);
+
+  size_t end = align_to_byte();
+  if (end_ - in_ < 8) {
+    throw gzip_error() << "unexpected end of input";
+  }
+  uint32_t crc_expected = read_u32le(in_);
+  uint32_t size_expected = read_u32le(in_ + 4);
+  size_t n = out_.size - member_start_;
+  if (size_expected != static_cast<uint32_t>(n)) {
+    throw gzip_error() << "incorrect length of uncompressed data";
+  }
+  uint32_t crc = update_crc32(0, out_.data + member_start_, n);
+  if (crc != crc_expected) {
+    throw gzip_error() << "CRC check failed";
+  }
+  return end + 8;
+}
+
+
+void GzipDecoder::decode_stored_block() {
+  align_to_byte();
+  if (end_ - in_ < 4) {
+    throw gzip_error() << "unexpected end of input";
+  }
+  size_t len = static_cast<size_t>(in_[0]) | (static_cast<size_t>(in_[1]) << 8);
+  size_t nlen = static_cast<size_t>(in_[2]) | (static_cast<size_t>(in_[3]) << 8);
+  if (len != (~nlen & 0xFFFF)) {
+    throw gzip_error() << "invalid stored block length";
+  }
+  in_ += 4;
+  if (static_cast<size_t>(end_ - in_) < len) {
+    throw gzip_error() << "unexpected end of input";
+  }
+  out_.reserve(out_.size + len);
+  std::memcpy(out_.data + out_.size, in_, len);
+  out_.size += len;
+  in_ += len;
+}
+
+
+void GzipDecoder::read_dynamic_tables() {
+  refill();
+  size_t hlit = bits(5) + 257;   consume(5);
+  size_t hdist = bits(5) + 1;    consume(5);
+  size_t hclen = bits(4) + 4;    consume(4);
+  if (hlit > 286 || hdist > 30) {
+    throw gzip_error() << "too many length or distance symbols";
+  }
+
+  uint8_t lengths[NUM_LITLEN_SYMBOLS + NUM_DIST_SYMBOLS] = {0};
+  for (size_t i = 0; i < hclen; ++i) {
+    refill();
+    lengths[CODELEN_ORDER[i]] = static_cast<uint8_t>(bits(3));
+    consume(3);
+  }
+  if (!codelen_.build(lengths, 19, 7)) {
+    throw gzip_error() << "invalid code lengths set";
+  }
+
+  size_t n = hlit + hdist;
+  size_t i = 0;
+  while (i < n) {
+    refill();
+    uint32_t e = codelen_.lookup(bitbuf_);
+    if (!(e & 0xFF)) throw gzip_error() << "invalid code lengths set";
+    consume(e & 0xFF);
+    uint8_t sym = static_cast<uint8_t>(e >> 16);
+    if (sym < 16) {
+      lengths[i++] = sym;
+      continue;
+    }
+    uint8_t value = 0;
+    size_t repeat;
+    if (sym == 16) {
+      if (i == 0) throw gzip_error() << "invalid bit length repeat";
+      value = lengths[i - 1];
+      repeat = 3 + bits(2);  consume(2);
+    } else if (sym == 17) {
+      repeat = 3 + bits(3);  consume(3);
+    } else {
+      repeat = 11 + bits(7); consume(7);
+    }
+    if (i + repeat > n) throw gzip_error() << "invalid bit length repeat";
+    std::memset(lengths + i, value, repeat);
+    i += repeat;
+  }
+  if (lengths[256] == 0) {
+    throw gzip_error() << "missing end-of-block code";
+  }
+  if (!litlen_.build(lengths, hlit, 10)) {
+    throw gzip_error() << "invalid literal/lengths set";
+  }
+  if (!dist_.build(lengths + hlit, hdist, 8)) {
+    throw gzip_error() << "invalid distances set";
+  }
+}
+
+
+void GzipDecoder::decode_huffman_block(const HuffmanTable& litlen,
+                                       const HuffmanTable& dist)
+{
+  // Leave enough room for the longest match, plus the 8-byte overshoot
+  // of the match copying loop below.
+  constexpr size_t MARGIN = MAX_MATCH_LENGTH + 8;
+  uint8_t* out = out_.data + out_.size;
+  uint8_t* out_end = out_.data + out_.capacity;
+
+  for (;;) {
+    if (static_cast<size_t>(out_end - out) < MARGIN) {
+      out_.size = static_cast<size_t>(out - out_.data);
+      out_.reserve(out_.size + (1 << 16));
+      out = out_.data + out_.size;
+      out_end = out_.data + out_.capacity;
+    }
+    // A single refill is sufficient for one literal/length code (up to
+    // 15 + 5 bits) and one distance code (up to 15 + 13 bits).
+    refill();
+    uint32_t e = litlen.lookup(bitbuf_);
+    size_t nbits = e & 0xFF;
+    if (!nbits) throw gzip_error() << "invalid literal/length code";
+    consume(nbits);
+    size_t sym = e >> 16;
+    if (sym < 256) {
+      *out++ = static_cast<uint8_t>(sym);
+      continue;
+    }
+    if (sym == 256) break;
+    sym -= 257;
+    if (sym >= 29) throw gzip_error() << "invalid literal/length code";
+    size_t length = LENGTH_BASE[sym] + bits(LENGTH_EXTRA[sym]);
+    consume(LENGTH_EXTRA[sym]);
+
+    e = dist.lookup(bitbuf_);
+    nbits = e & 0xFF;
+    if (!nbits) throw gzip_error() << "invalid distance code";
+    consume(nbits);
+    sym = e >> 16;
+    if (sym >= 30) throw gzip_error() << "invalid distance code";
+    size_t distance = DIST_BASE[sym] + bits(DIST_EXTRA[sym]);
+    consume(DIST_EXTRA[sym]);
+    if (distance > static_cast<size_t>(out - out_.data) - member_start_) {
+      throw gzip_error() << "invalid distance too far back";
+    }
+
+    const uint8_t* src = out - distance;
+    if (distance >= 8) {
+      uint8_t* dst = out;
+      uint8_t* dst_end = out + length;
+      do {
+        std::memcpy(dst, src, 8);
+        dst += 8;
+        src += 8;
+      } while (dst < dst_end);
+    } else if (distance == 1) {
+      std::memset(out, *src, length);
+    } else {
+      for (size_t i = 0; i < length; ++i) out[i] = src[i];
+    }
+    out += length;
+  }
+  out_.size = static_cast<size_t>(out - out_.data);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Public API
+//------------------------------------------------------------------------------
+
+bool is_gzip(const char* ptr, size_t size) {
+  auto p = reinterpret_cast<const uint8_t*>(ptr);
+  return size >= 18 && p[0] == 0x1F && p[1] == 0x8B && p[2] == 8 &&
+         (p[3] & 0xE0) == 0;
+}
+
+
+// A stricter version of `is_gzip()`, used to find candidates for the
+// starts of members when scanning the compressed data.
+static bool looks_like_member(const uint8_t* p, size_t avail) {
+  return is_gzip(reinterpret_cast<const char*>(p), avail) &&
+         (p[8] == 0 || p[8] == 2 || p[8] == 4) &&   // XFL
+         (p[9] <= 13 || p[9] == 255);               // OS
+}
+
+
+// Members may be followed by zero padding, which is skipped the same
+// way as the `gzip` utility does.
+static size_t skip_padding(const uint8_t* start, size_t pos, size_t size) {
+  while (pos < size && start[pos] == 0) pos++;
+  if (pos < size && !is_gzip(reinterpret_cast<const char*>(start + pos),
+                             size - pos)) {
+    throw gzip_error() << "trailing garbage after the end of compressed data";
+  }
+  return pos;
+}
+
+
+namespace {
+struct Region {
+  size_t start;     // offset of the first member decoded in this region
+  size_t end;       // offset after the last member decoded
+  size_t nmembers;
+  bool ok;
+  size_t : 56;
+  OutputBuffer out;
+};
+}
+
+
+/**
+  * Decode the members in the input `[start, start + size)` in parallel,
+  * passing the decompressed data to the `sink`. The input is processed
+  * in windows of `MIN_REGION_SIZE` compressed bytes per thread, and the
+  * output of each window is released as soon as it was passed to the
+  * sink, so that the memory usage does not depend on the size of the
+  * input. Returns the number of members decoded.
+  */
+static size_t gunzip_members(const uint8_t* start, size_t size,
+                             size_t nthreads, const GunzipSink& sink)
+{
+  constexpr size_t MIN_REGION_SIZE = 1 << 20;
+  size_t nmembers = 0;
+  size_t pos = 0;
+  while (pos < size) {
+    size_t wstart = pos;
+    size_t wsize = std::min(size - wstart, nthreads * MIN_REGION_SIZE);
+    size_t nregions = std::max<size_t>(1,
+                          std::min(nthreads, wsize / MIN_REGION_SIZE));
+    std::vector<Region> regions(nregions);
+    auto region_start = [&](size_t k) {
+      return wstart + wsize / nregions * k;
+    };
+    auto region_end = [&](size_t k) {
+      return (k + 1 == nregions)? wstart + wsize : region_start(k + 1);
+    };
+
+    // Decode the members that start within region `k`. The first region
+    // begins with a member; any other region scans for the first member
+    // that can be decoded successfully. Errors in regions other than the
+    // first one are not final: they will be re-encountered (if real) in
+    // the next window, which starts where the verified regions end.
+    auto decode_region = [&](size_t k) {
+      Region& r = regions[k];
+      size_t rend = region_end(k);
+      r.out.reserve(std::min<size_t>(4 * (wsize / nregions + 1),
+                                     size_t(1) << 26));
+      GzipDecoder decoder(start, start + size, r.out);
+      size_t ipos = region_start(k);
+      r.start = r.end = size_t(-1);
+      r.nmembers = 0;
+      r.ok = false;
+      if (k == 0) {
+        r.start = ipos;
+      } else {
+        for (; ipos < rend; ipos++) {
+          auto p = static_cast<const uint8_t*>(
+                      std::memchr(start + ipos, 0x1F, rend - ipos));
+          if (!p) break;
+          ipos = static_cast<size_t>(p - start);
+          if (!looks_like_member(p, size - ipos)) continue;
+          try {
+            size_t next = decoder.decode_member(ipos);
+            r.start = ipos;
+            r.nmembers = 1;
+            ipos = skip_padding(start, next, size);
+            break;
+          } catch (const Error&) {
+            r.out.size = 0;
+          }
+        }
+        if (r.start == size_t(-1)) return;
+      }
+      try {
+        while (ipos < rend && ipos < size) {
+          ipos = decoder.decode_member(ipos);
+          ipos = skip_padding(start, ipos, size);
+          r.nmembers++;
+        }
+        r.end = ipos;
+        r.ok = true;
+      } catch (const Error&) {
+        if (k == 0) throw;
+      }
+    };
+    if (nregions == 1) {
+      decode_region(0);
+    } else {
+      dt::parallel_for_static(nregions, NThreads(nregions), decode_region);
+    }
+
+    // Pass the regions to the sink in order, as long as each region
+    // begins exactly where the previous one ended. The remaining regions
+    // are discarded, and the next window starts after the last region
+    // that was used.
+    for (size_t k = 0; k < nregions; ++k) {
+      Region& r = regions[k];
+      if (k && pos >= region_end(k)) continue;
+      if (!r.ok || r.start != pos) break;
+      if (r.out.size) {
+        sink(reinterpret_cast<const char*>(r.out.data), r.out.size);
+      }
+      OutputBuffer done = std::move(r.out);
+      pos = r.end;
+      nmembers += r.nmembers;
+    }
+  }
+  return nmembers;
+}
+
+
+/**
+  * Inflate the first gzip member in the input with zlib, passing the
+  * decompressed data to the `sink` in pieces of at most `OUTPUT_CHUNK`
+  * bytes. Returns the offset of the first byte after the member.
+  *
+  * The bundled zlib library contains only the deflate side, so the
+  * inflater of Python's `zlib` module is used. Only the raw DEFLATE
+  * stream is handed to zlib: the gzip header and trailer are verified
+  * here, in the same way as for the members decoded natively.
+  */
+static size_t inflate_member(const uint8_t* start, size_t size,
+                             const GunzipSink& sink)
+{
+  constexpr size_t INPUT_CHUNK = 1 << 20;
+  constexpr size_t OUTPUT_CHUNK = 1 << 24;
+  size_t pos = read_header(start, start + size, 0);
+  uint32_t crc = 0;
+  size_t total = 0;
+
+  auto decompressobj = py::oobj::import("zlib", "decompressobj")
+                           .call(py::otuple{py::oint(-15)});
+  auto decompress = decompressobj.get_attr("decompress");
+  py::oobj pending = py::oobj::from_new_reference(
+                         PyBytes_FromStringAndSize(nullptr, 0));
+  size_t pending_size = 0;
+  bool progress = true;
+  while (!decompressobj.get_attr("eof").to_bool_strict()) {
+    if (pending_size == 0) {
+      if (pos < size) {
+        size_t n = std::min(INPUT_CHUNK, size - pos);
+        pending = py::oobj::from_new_reference(PyMemoryView_FromMemory(
+            reinterpret_cast<char*>(const_cast<uint8_t*>(start + pos)),
+            static_cast<Py_ssize_t>(n), PyBUF_READ));
+        pending_size = n;
+        pos += n;
+      } else if (!progress) {
+        throw gzip_error() << "unexpected end of input";
+      }
+    }
+    py::oobj out;
+    try {
+      out = decompress.call(py::otuple(pending, py::oint(OUTPUT_CHUNK)));
+    } catch (const Error& e) {
+      // Errors raised by zlib are reported in the same way as those
+      // of the native decoder
+      if (e.is_keyboard_interrupt()) throw;
+      throw gzip_error() << e.to_string();
+    }
+    PyObject* outptr = out.to_borrowed_ref();
+    auto data = reinterpret_cast<const uint8_t*>(PyBytes_AS_STRING(outptr));
+    auto n = static_cast<size_t>(PyBytes_GET_SIZE(outptr));
+    progress = (n > 0);
+    if (n) {
+      crc = update_crc32(crc, data, n);
+      total += n;
+      sink(reinterpret_cast<const char*>(data), n);
+    }
+    pending = decompressobj.get_attr("unconsumed_tail");
+    pending_size = static_cast<size_t>(
+        PyBytes_GET_SIZE(pending.to_borrowed_ref()));
+  }
+  // The input that was passed to zlib after the end of the DEFLATE
+  // stream is returned in `unused_data`.
+  auto unused = decompressobj.get_attr("unused_data");
+  pos -= pending_size +
+         static_cast<size_t>(PyBytes_GET_SIZE(unused.to_borrowed_ref()));
+
+  if (size - pos < 8) {
+    throw gzip_error() << "unexpected end of input";
+  }
+  if (read_u32le(start + pos + 4) != static_cast<uint32_t>(total)) {
+    throw gzip_error() << "incorrect length of uncompressed data";
+  }
+  if (read_u32le(start + pos) != crc) {
+    throw gzip_error() << "CRC check failed";
+  }
+  return pos + 8;
+}
+
+
+size_t gunzip(const char* ptr, size_t size, size_t nthreads,
+              const GunzipSink& sink)
+{
+  auto start = reinterpret_cast<const uint8_t*>(ptr);
+  size_t pos = inflate_member(start, size, sink);
+  pos = skip_padding(start, pos, size);
+  size_t nmembers = 1;
+  if (pos < size) {
+    nmembers += gunzip_members(start + pos, size - pos,
+                               std::max<size_t>(nthreads, 1), sink);
+  }
+  return nmembers;
+}
+
+
+Buffer gunzip(const char* ptr, size_t size, size_t* nmembers) {
+  auto start = reinterpret_cast<const uint8_t*>(ptr);
+  OutputBuffer out;
+  GzipDecoder decoder(start, start + size, out);
+  size_t pos = 0;
+  *nmembers = 0;
+  do {
+    pos = decoder.decode_member(pos);
+    pos = skip_padding(start, pos, size);
+    ++*nmembers;
+  } while (pos < size);
+  return out.release();
+}
+
+
+
+}}  // namespace dt::read
@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_READ_GUNZIP_h
+#define dt_READ_GUNZIP_h
+#include <cstddef>      // size_t
+#include <functional>   // std::function
+#include "buffer.h"     // Buffer
+namespace dt {
+namespace read {
+
+
+/**
+  * Return true if the data in the memory region `[ptr, ptr + size)`
+  * looks like the beginning of a GZIP file (RFC-1952).
+  */
+bool is_gzip(const char* ptr, size_t size);
+
+
+using GunzipSink = std::function<void(const char*, size_t)>;
+
+
+/**
+  * Decompress a GZIP input in memory region `[ptr, ptr + size)`,
+  * passing the uncompressed data to the `sink` in consecutive pieces.
+  * The uncompressed data is never accumulated in memory as a whole.
+  *
+  * The first member of the input is inflated with zlib. A GZIP file
+  * may also consist of multiple "members", each compressed
+  * independently, and whose uncompressed contents are concatenated
+  * (this is the kind of file produced, for example, by `to_csv()`
+  * with compression, or by the BGZF tools). The members after the
+  * first one are decompressed in parallel using up to `nthreads`
+  * threads: the input is split into regions, and each thread looks
+  * for the first member header within its region. The starting
+  * points found this way are only guesses; they are verified against
+  * the actual ends of the members decoded by the preceding threads.
+  *
+  * This function uses Python's `zlib` module, and therefore must be
+  * called from the main thread. Returns the number of members decoded.
+  */
+size_t gunzip(const char* ptr, size_t size, size_t nthreads,
+              const GunzipSink& sink);
+
+
+/**
+  * Decompress a GZIP input in memory region `[ptr, ptr + size)` in
+  * the current thread, and return the uncompressed data as a new
+  * Buffer. This function may be called from within a parallel region.
+  *
+  * On return, `*nmembers` contains the number of members decoded.
+  */
+Buffer gunzip(const char* ptr, size_t size, size_t* nmembers);
+
+
+
+}}  // namespace dt::read
+#endif
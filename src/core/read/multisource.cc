@@ -332,7 +332,10 @@ py::oobj MultiSource::read_next(const GenericReader& reader)
       }
     }
   }
-  SourcePtr next = src->continuation();
+  // A source read in chunks hands over the rest of its input to a
+  // new Source object, stored in the reader
+  SourcePtr next = new_reader.continuation_? std::move(new_reader.continuation_)
+                                           : src->continuation();
   if (next) {
     sources_[iteration_index] = std::move(next);
   } else {
@@ -171,6 +171,16 @@ Column OutputColumn::to_column() {
 
 
 
+void OutputColumn::reset() {
+  databuf_ = Buffer();
+  strbuf_ = nullptr;
+  chunks_.clear();
+  nrows_in_chunks_ = 0;
+  nrows_allocated_ = 0;
+  reset_colinfo();
+}
+
+
 void OutputColumn::set_stype(SType stype) {
   xassert(!databuf_);
   stype_ = stype;
@@ -99,6 +99,11 @@ class OutputColumn
     //
     Column to_column();
 
+    // Remove all data from this column (both archived and not), so
+    // that it can be used to receive a new batch of rows.
+    //
+    void reset();
+
     void merge_chunk_stats(const ColInfo& info);
 
     void set_stype(SType stype);
@@ -36,6 +36,7 @@ ParallelReader::ParallelReader(GenericReader& reader, double meanLineLen)
     input_start(reader.sof),
     input_end(reader.eof),
     end_of_last_chunk(input_start),
+    nlines_of_data(0),
     approximate_line_length(meanLineLen),
     g(reader),
     preframe(reader.preframe),
@@ -51,7 +52,9 @@ ParallelReader::~ParallelReader() {}
 
 void ParallelReader::determine_chunking_strategy() {
   size_t input_size = static_cast<size_t>(input_end - input_start);
-  size_t nrows_max = g.max_nrows;
+  // With a row filter, `max_nrows` limits the number of rows that pass
+  // the filter, which says nothing about the size of the input needed.
+  size_t nrows_max = g.row_filter? size_t(-1) : g.max_nrows;
 
   double maxrows_size = static_cast<double>(nrows_max) * approximate_line_length;
   bool input_size_reduced = false;
@@ -215,6 +218,7 @@ void ParallelReader::read_all()
         if (tctx->handle_typebumps(this)) return;
 
         rdr->end_of_last_chunk = tacc.get_end();
+        rdr->nlines_of_data += tctx->get_nlines();
         size_t chunk_nrows = tctx->get_nrows();
         size_t new_nrows = tctx->ensure_output_nrows(chunk_nrows, i, this);
         if (new_nrows != chunk_nrows) {
@@ -236,13 +240,23 @@ void ParallelReader::read_all()
   );
 
   // Check that all input was read (unless interrupted early because of
-  // nrows_max).
-  if (preframe.nrows_written() < g.max_nrows) {
+  // nrows_max or batch_nrows).
+  if (preframe.nrows_written() < std::min(g.max_nrows, g.batch_nrows)) {
     xassert(end_of_last_chunk == input_end);
   }
 }
 
 
+const char* ParallelReader::get_end_of_data() const {
+  return end_of_last_chunk;
+}
+
+
+size_t ParallelReader::get_nlines_of_data() const {
+  return nlines_of_data;
+}
+
+
 
 
 
@@ -41,6 +41,7 @@ class ParallelReader
     const char* input_start;
     const char* input_end;
     const char* end_of_last_chunk;
+    size_t nlines_of_data;
     double approximate_line_length;
 
   protected:
@@ -57,6 +58,15 @@ class ParallelReader
 
     virtual void read_all();
 
+    // Position in the input where the data read by `read_all()`
+    // ended. This is the end of the input, unless the reading was
+    // stopped early because of `max_nrows` or `batch_nrows`.
+    const char* get_end_of_data() const;
+
+    // Number of physical lines in the data read by `read_all()`, as
+    // counted by the thread contexts (see `ThreadContext::nlines_`).
+    size_t get_nlines_of_data() const;
+
   protected:
     /**
      * This method can be overridden in derived classes in order to implement
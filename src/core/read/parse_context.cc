@@ -144,6 +144,25 @@ bool ParseContext::skip_eol() const {
 }
 
 
+/**
+ * Count the newlines within the range [start, end) of the input, using
+ * the same definition of a newline as `skip_eol()`. The range should
+ * end at a line boundary. The current parsing location is not changed.
+ */
+size_t ParseContext::count_lines(const char* start, const char* end) const {
+  const char* ch0 = ch;
+  size_t nlines = 0;
+  ch = start;
+  while (ch < end) {
+    char c = *ch;
+    if ((c == '\n' || c == '\r') && skip_eol()) nlines++;
+    else ch++;
+  }
+  ch = ch0;
+  return nlines;
+}
+
+
 /**
  * Return true iff the tokenizer's current position `ch` is a valid field
  * terminator (either a `sep` or a newline). This does not advance the tokenizer
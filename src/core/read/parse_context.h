@@ -97,6 +97,7 @@ struct ParseContext
     bool is_na_string(const char* start, const char* end) const;
     int countfields() const;
     bool skip_eol() const;
+    size_t count_lines(const char* start, const char* end) const;
 
     bool next_good_line_start(
       const ChunkCoordinates& cc, int ncols, bool fill,
@@ -24,6 +24,7 @@
 #include "csv/reader_parsers.h"
 #include "read/field64.h"                // field64
 #include "read/parse_context.h"          // ParseContext
+#include "read/parsers/simd_scan.h"      // find_end_of_unquoted_field, find_either_char
 #include "utils/assert.h"
 #include "_dt.h"
 #include "encodings.h"
@@ -198,6 +199,8 @@ static void parse_string_unquoted(const ParseContext& ctx) {
   }
   const char* field_start = ch;
   while (ch < end) {
+    ch = find_end_of_unquoted_field<QUOTES_FORBIDDEN>(ch, end, sep, quote);
+    if (ch == end) break;
     char c = *ch;
     if (c == sep) break;  // end of field
     if (static_cast<uint8_t>(c) <= 13) {  // probably a newline
@@ -256,6 +259,8 @@ static void parse_string_quoted(const ParseContext& ctx) {
     const char* field_start = ch;
     size_t n_escapes = 0;
     while (ch < end) {
+      ch = find_either_char(ch, end, quote, MODE == ESCAPED? '\\' : quote);
+      if (ch == end) break;
       if (*ch == quote) {
         if (MODE == DOUBLED && ch + 1 < end && ch[1] == quote) {
           ch++;
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_READ_PARSERS_SIMD_SCAN_h
+#define dt_READ_PARSERS_SIMD_SCAN_h
+#include <cstdint>
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+namespace dt {
+namespace read {
+
+
+/**
+  * Helpers for scanning the input for "structural" characters: field
+  * separators, quotes and line terminators. The string parsers spend
+  * most of their time looking for the end of the field, and for
+  * typical fields those characters are rare, so it pays off to
+  * examine 16 bytes of input at a time: each block is compared with
+  * all structural characters at once, producing a bitmask of their
+  * positions, and only the first set bit of that mask needs to be
+  * examined by the (scalar) parser.
+  *
+  * When SSE2 is not available, the functions fall back to the plain
+  * scalar loop.
+  */
+
+#if defined(__SSE2__)
+  // Mask of positions of bytes with codes <= 13 (this includes '\n'
+  // and '\r') within block `x`.
+  inline __m128i control_chars_mask(__m128i x) {
+    return _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(13)), x);
+  }
+#endif
+
+
+/**
+  * Return the pointer to the first character within `[ch, end)` which
+  * is either `sep`, or a control character (code <= 13), or, when
+  * `CHECK_QUOTE` is true, `quote`. If there are no such characters,
+  * returns `end`.
+  */
+template <bool CHECK_QUOTE>
+inline const char* find_end_of_unquoted_field(
+    const char* ch, const char* end, char sep, char quote)
+{
+  #if defined(__SSE2__)
+    const __m128i vsep = _mm_set1_epi8(sep);
+    const __m128i vquote = _mm_set1_epi8(quote);
+    while (end - ch >= 16) {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ch));
+      __m128i m = _mm_or_si128(_mm_cmpeq_epi8(x, vsep), control_chars_mask(x));
+      if (CHECK_QUOTE) m = _mm_or_si128(m, _mm_cmpeq_epi8(x, vquote));
+      auto mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+      if (mask) return ch + __builtin_ctz(mask);
+      ch += 16;
+    }
+  #endif
+  for (; ch < end; ch++) {
+    char c = *ch;
+    if (c == sep || static_cast<uint8_t>(c) <= 13) break;
+    if (CHECK_QUOTE && c == quote) break;
+  }
+  return ch;
+}
+
+
+/**
+  * Return the pointer to the first occurrence of either `c1` or `c2`
+  * within `[ch, end)`, or `end` if there are none.
+  */
+inline const char* find_either_char(
+    const char* ch, const char* end, char c1, char c2)
+{
+  #if defined(__SSE2__)
+    const __m128i v1 = _mm_set1_epi8(c1);
+    const __m128i v2 = _mm_set1_epi8(c2);
+    while (end - ch >= 16) {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ch));
+      __m128i m = _mm_or_si128(_mm_cmpeq_epi8(x, v1), _mm_cmpeq_epi8(x, v2));
+      auto mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+      if (mask) return ch + __builtin_ctz(mask);
+      ch += 16;
+    }
+  #endif
+  for (; ch < end; ch++) {
+    if (*ch == c1 || *ch == c2) break;
+  }
+  return ch;
+}
+
+
+
+}}  // namespace dt::read
+#endif
@@ -19,12 +19,14 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include "column/categorical.h"
 #include "csv/reader.h"              // GenericReader
 #include "csv/reader_parsers.h"
 #include "read/preframe.h"
 #include "utils/temporary_file.h"    // TemporaryFile
 #include "column.h"
 #include "datatable.h"
+#include "ltype.h"
 namespace dt {
 namespace read {
 
@@ -139,6 +141,9 @@ size_t PreFrame::ensure_output_nrows(size_t nrows_in_chunk0, size_t ichunk,
                                       * static_cast<double>(nchunks)
                                       / static_cast<double>(ichunk + 1))
       ));
+      // When reading in batches, the estimate is bounded by the batch size
+      nrows_new = std::max(std::min(nrows_new, g_->batch_nrows),
+                           nrows_written_ + nrows_in_chunk);
     }
 
     xassert(nrows_new >= nrows_in_chunk + nrows_written_);
@@ -177,7 +182,8 @@ size_t PreFrame::ensure_output_nrows(size_t nrows_in_chunk0, size_t ichunk,
     nrows_allocated_ = nrows_new;
   }
 
-  if (nrows_new == nrows_max) {
+  if (nrows_new == nrows_max ||
+      nrows_written_ + nrows_in_chunk >= g_->batch_nrows) {
     otask->set_num_iterations(ichunk + 1);
   }
   nrows_written_ += nrows_in_chunk;
@@ -206,6 +212,21 @@ void PreFrame::archive_column_chunks(size_t expected_nrows) {
 }
 
 
+/**
+  * Discard all data stored in the output columns, so that the
+  * PreFrame can be used for reading another batch of rows. The
+  * column names and types are retained.
+  */
+void PreFrame::reset_output() {
+  for (auto& col : columns_) {
+    col.outcol().reset();
+  }
+  nrows_allocated_ = 0;
+  nrows_written_ = 0;
+  tempfile_ = nullptr;
+}
+
+
 void PreFrame::init_tempfile() {
   tempfile_ = std::shared_ptr<TemporaryFile>(new TemporaryFile());
   if (g_->get_verbose()) {
@@ -370,11 +391,26 @@ dtptr PreFrame::to_datatable() && {
     col.outcol().archive_data(nrows_written_, tempfile_);
     names.push_back(col.get_name());
     ccols.push_back(outcol.to_column());
+    maybe_encode_categorical(ccols.back());
   }
   return dtptr(new DataTable(std::move(ccols), std::move(names)));
 }
 
 
+/**
+  * Dictionary-encode a string column if it has few enough distinct
+  * values, see option `fread.categorical_threshold`.
+  */
+void PreFrame::maybe_encode_categorical(::Column& col) const {
+  if (col.ltype() != LType::STRING) return;
+  double threshold = g_->categorical_threshold_;
+  if (threshold <= 0) return;
+  auto max_categories = static_cast<size_t>(threshold * double(col.nrows()));
+  ::Column encoded = Categorical_ColumnImpl::encode(col, max_categories);
+  if (encoded) col = std::move(encoded);
+}
+
+
 
 
 }}  // namespace dt::read
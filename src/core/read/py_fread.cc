@@ -40,12 +40,12 @@ R"(fread(anysource=None, *, file=None, text=None, cmd=None, url=None,
          skip_to_string=None, skip_to_line=0, skip_blank_lines=False,
          strip_whitespace=True, quotechar='"', tempdir=None,
          nthreads=None, logger=None, multiple_sources="warn",
-         memory_limit=None)
+         memory_limit=None, filter=None)
 --
 
 This function is capable of reading data from a variety of input formats,
 producing a :class:`Frame` as the result. The recognized formats are:
-CSV, Jay, XLSX, and plain text. In addition, the data may be inside an
+CSV, Jay, Parquet, XLSX, and plain text. In addition, the data may be inside an
 archive such as ``.tar``, ``.gz``, ``.zip``, ``.gz2``, and ``.tgz``.
 
 
@@ -211,6 +211,23 @@ memory_limit: int
     or filter and materialize the frame (if not the performance may
     be slow).
 
+filter: FExpr | None
+    A boolean f-expression selecting which rows of the input should
+    be kept, for example ``filter=(f.price > 100) & (f.region == "EU")``.
+    The result is the same as ``DT[filter, :]`` applied to the Frame
+    that would have been read otherwise; however the rows that do not
+    pass the filter are discarded while parsing, and thus never
+    occupy memory in the output.
+
+    The filter may contain comparisons of a column with a literal
+    value (``==``, ``!=``, ``<``, ``<=``, ``>``, ``>=``), boolean
+    columns, and their combinations via operators ``&``, ``|`` and
+    ``~``. The columns are referred to by their names or indices in
+    the output Frame (i.e. after `columns` are applied).
+
+    When combined with `max_nrows`, the latter limits the number of
+    rows that pass the filter.
+
 (return): Frame
     A single :class:`Frame` object is always returned.
 
@@ -227,12 +244,13 @@ See Also
 )";
 
 static py::PKArgs args_fread(
-  1, 0, 23, false, false,
+  1, 0, 24, false, false,
   {"anysource", "file", "text", "cmd", "url",
    "columns", "sep", "dec", "max_nrows", "header", "na_strings",
    "verbose", "fill", "encoding", "skip_to_string", "skip_to_line",
    "skip_blank_lines", "strip_whitespace", "quotechar",
-   "tempdir", "nthreads", "logger", "multiple_sources", "memory_limit"
+   "tempdir", "nthreads", "logger", "multiple_sources", "memory_limit",
+   "filter"
    },
   "fread", doc_fread);
 
@@ -257,6 +275,7 @@ static py::oobj fread(const py::PKArgs& args) {
   const py::Arg& arg_logger     = args[k++];
   const py::Arg& arg_multisrc   = args[k++];
   const py::Arg& arg_memlimit   = args[k++];
+  const py::Arg& arg_filter     = args[k++];
 
   GenericReader rdr;
   rdr.init_logger(arg_logger, arg_verbose);
@@ -279,6 +298,7 @@ static py::oobj fread(const py::PKArgs& args) {
     rdr.init_multisource(arg_multisrc);
     rdr.init_memorylimit(arg_memlimit);
     rdr.init_encoding(   arg_encoding);
+    rdr.init_filter(     arg_filter);
   }
 
   MultiSource multisource(args, rdr);
@@ -298,13 +318,14 @@ R"(iread(anysource=None, *, file=None, text=None, cmd=None, url=None,
          skip_to_string=None, skip_to_line=None, skip_blank_lines=False,
          strip_whitespace=True, quotechar='"',
          tempdir=None, nthreads=None, logger=None, errors="warn",
-         memory_limit=None)
+         memory_limit=None, chunk_nrows=None, filter=None)
 --
 
 This function is similar to :func:`fread()`, but allows reading
 multiple sources at once. For example, this can be used when the
 input is a list of files, or a glob pattern, or a multi-file archive,
-or multi-sheet XLSX file, etc.
+or multi-sheet XLSX file, etc. It can also be used to read a single
+large CSV file in pieces, see parameter `chunk_nrows`.
 
 
 Parameters
@@ -337,6 +358,24 @@ errors: "warn" | "raise" | "ignore" | "store"
     If the `errors` parameter is `"store"` then the iterator may
     produce either Frames or exception objects.
 
+chunk_nrows: int | None
+    If given, each CSV input will be split into several Frames with
+    `chunk_nrows` rows each (the last Frame of each input may have
+    fewer rows). The data is still parsed in parallel, but only
+    approximately `chunk_nrows` rows are read from the input at a time,
+    so that a file much larger than the available memory can be
+    processed Frame-by-Frame.
+
+    The parse settings and the column names are detected once, from
+    the beginning of the input, and then reused for all subsequent
+    Frames. The column types are also carried over; however, if a
+    later portion of the file contains values that do not fit into the
+    detected type, the column will be "bumped" to a wider type starting
+    from the Frame that contains such values.
+
+    When used together with `filter`, each Frame contains `chunk_nrows`
+    rows that passed the filter.
+
 
 See Also
 --------
@@ -344,12 +383,13 @@ See Also
 )";
 
 static py::PKArgs args_iread(
-  1, 0, 23, false, false,
+  1, 0, 25, false, false,
   {"anysource", "file", "text", "cmd", "url",
    "columns", "sep", "dec", "max_nrows", "header", "na_strings",
    "verbose", "fill", "encoding", "skip_to_string", "skip_to_line",
    "skip_blank_lines", "strip_whitespace", "quotechar",
-   "tempdir", "nthreads", "logger", "errors", "memory_limit"
+   "tempdir", "nthreads", "logger", "errors", "memory_limit",
+   "chunk_nrows", "filter"
    },
   "iread", doc_iread);
 
@@ -374,6 +414,8 @@ static py::oobj iread(const py::PKArgs& args) {
   const py::Arg& arg_logger     = args[k++];
   const py::Arg& arg_errors     = args[k++];
   const py::Arg& arg_memlimit   = args[k++];
+  const py::Arg& arg_chunknrows = args[k++];
+  const py::Arg& arg_filter     = args[k++];
 
   auto rdr = std::make_unique<GenericReader>();
   rdr->init_logger(arg_logger, arg_verbose);
@@ -396,6 +438,8 @@ static py::oobj iread(const py::PKArgs& args) {
     rdr->init_errors(     arg_errors);
     rdr->init_memorylimit(arg_memlimit);
     rdr->init_encoding(   arg_encoding);
+    rdr->init_chunknrows( arg_chunknrows);
+    rdr->init_filter(     arg_filter);
   }
 
   auto ms = std::make_unique<MultiSource>(args, *rdr);
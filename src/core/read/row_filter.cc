@@ -0,0 +1,546 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <cstring>                         // std::memmove
+#include "cstring.h"                       // CString
+#include "expr/expr.h"                     // OldExpr
+#include "expr/fbinary/fexpr_binaryop.h"   // FExpr_BinaryOp
+#include "expr/fexpr.h"                    // FExpr
+#include "expr/fexpr_column.h"             // FExpr_ColumnAsAttr, FExpr_ColumnAsArg
+#include "expr/head_func.h"                // Head_Func_Unary, Head_Func_Binary
+#include "expr/op.h"                       // Op
+#include "read/input_column.h"
+#include "read/preframe.h"
+#include "read/row_filter.h"
+#include "stype.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"
+namespace dt {
+namespace read {
+
+using expr::Kind;
+using expr::Op;
+
+static constexpr int8_t NA_MASK = NA_I1;
+
+
+/**
+  * Parsed data of a single chunk, as seen by the FilterNodes. The
+  * data is in row-major order, `stride` fields per row.
+  */
+struct FilterInput {
+  const field64* data;
+  size_t stride;
+  size_t nrows;
+  const PT* types;
+  const char* strbuf;
+};
+
+
+/**
+  * Node in the compiled filter's tree. Each node evaluates into a
+  * boolean mask with values 0, 1 or NA_MASK for every row of input.
+  */
+class FilterNode {
+  public:
+    virtual ~FilterNode();
+    virtual void evaluate(const FilterInput&, int8_t* out) const = 0;
+};
+
+FilterNode::~FilterNode() {}
+
+using NodePtr = std::unique_ptr<FilterNode>;
+
+
+
+//------------------------------------------------------------------------------
+// Logical nodes
+//------------------------------------------------------------------------------
+
+// Operators `&` and `|` on boolean columns follow the Kleene logic:
+// `False & NA` is False, and `True | NA` is True.
+class And_FilterNode : public FilterNode {
+  private:
+    NodePtr lhs_, rhs_;
+
+  public:
+    And_FilterNode(NodePtr&& lhs, NodePtr&& rhs)
+      : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    void evaluate(const FilterInput& in, int8_t* out) const override {
+      std::vector<int8_t> tmp(in.nrows);
+      lhs_->evaluate(in, out);
+      rhs_->evaluate(in, tmp.data());
+      for (size_t i = 0; i < in.nrows; ++i) {
+        int8_t x = out[i], y = tmp[i];
+        out[i] = (x == 0 || y == 0)? 0 :
+                 (x == NA_MASK || y == NA_MASK)? NA_MASK : 1;
+      }
+    }
+};
+
+
+class Or_FilterNode : public FilterNode {
+  private:
+    NodePtr lhs_, rhs_;
+
+  public:
+    Or_FilterNode(NodePtr&& lhs, NodePtr&& rhs)
+      : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    void evaluate(const FilterInput& in, int8_t* out) const override {
+      std::vector<int8_t> tmp(in.nrows);
+      lhs_->evaluate(in, out);
+      rhs_->evaluate(in, tmp.data());
+      for (size_t i = 0; i < in.nrows; ++i) {
+        int8_t x = out[i], y = tmp[i];
+        out[i] = (x == 1 || y == 1)? 1 :
+                 (x == NA_MASK || y == NA_MASK)? NA_MASK : 0;
+      }
+    }
+};
+
+
+class Not_FilterNode : public FilterNode {
+  private:
+    NodePtr arg_;
+
+  public:
+    explicit Not_FilterNode(NodePtr&& arg)
+      : arg_(std::move(arg)) {}
+
+    void evaluate(const FilterInput& in, int8_t* out) const override {
+      arg_->evaluate(in, out);
+      for (size_t i = 0; i < in.nrows; ++i) {
+        if (out[i] != NA_MASK) out[i] = !out[i];
+      }
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Boolean column
+//------------------------------------------------------------------------------
+
+static SType _stype_of(const FilterInput& in, size_t icol) {
+  return ParserLibrary::info(in.types[icol]).stype;
+}
+
+
+class Column_FilterNode : public FilterNode {
+  private:
+    size_t icol_;
+
+  public:
+    explicit Column_FilterNode(size_t i) : icol_(i) {}
+
+    void evaluate(const FilterInput& in, int8_t* out) const override {
+      SType stype = _stype_of(in, icol_);
+      if (stype != SType::BOOL) {
+        throw TypeError() << "Filter expression must be boolean, instead it "
+            "was of type " << stype;
+      }
+      const field64* p = in.data + icol_;
+      for (size_t i = 0; i < in.nrows; ++i, p += in.stride) {
+        out[i] = p->int8;
+      }
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Comparison of a column with a literal
+//------------------------------------------------------------------------------
+
+enum class CmpOp : uint8_t { EQ, NE, LT, LE, GT, GE };
+
+static CmpOp _flip(CmpOp op) {
+  switch (op) {
+    case CmpOp::LT: return CmpOp::GT;
+    case CmpOp::LE: return CmpOp::GE;
+    case CmpOp::GT: return CmpOp::LT;
+    case CmpOp::GE: return CmpOp::LE;
+    default:        return op;
+  }
+}
+
+
+template <typename T> inline T _value(const field64&);
+template <> inline int8_t  _value(const field64& f) { return f.int8; }
+template <> inline int32_t _value(const field64& f) { return f.int32; }
+template <> inline int64_t _value(const field64& f) { return f.int64; }
+template <> inline float   _value(const field64& f) { return f.float32; }
+template <> inline double  _value(const field64& f) { return f.float64; }
+
+
+// Same semantics as in FExpr__eq__ & co: the result is never NA; a
+// missing value is not equal to any valid value, and is not less or
+// greater than anything.
+template <CmpOp OP, typename V>
+static inline int8_t _cmp(const V& x, const V& y) {
+  switch (OP) {
+    case CmpOp::EQ: return (x == y);
+    case CmpOp::NE: return !(x == y);
+    case CmpOp::LT: return (x < y);
+    case CmpOp::LE: return (x <= y);
+    case CmpOp::GT: return (x > y);
+    case CmpOp::GE: return (x >= y);
+  }
+  return 0;
+}
+
+template <typename T, typename V, CmpOp OP>
+static void _compare_num(const FilterInput& in, size_t icol, V y, int8_t* out) {
+  const field64* p = in.data + icol;
+  for (size_t i = 0; i < in.nrows; ++i, p += in.stride) {
+    T x = _value<T>(*p);
+    out[i] = ISNA<T>(x)? (OP == CmpOp::NE)
+                       : _cmp<OP, V>(static_cast<V>(x), y);
+  }
+}
+
+template <CmpOp OP>
+static void _compare_str(const FilterInput& in, size_t icol,
+                         const CString& y, int8_t* out)
+{
+  const field64* p = in.data + icol;
+  CString x;
+  for (size_t i = 0; i < in.nrows; ++i, p += in.stride) {
+    int32_t len = p->str32.length;
+    if (len == NA_I4) {
+      out[i] = (OP == CmpOp::NE);
+    } else {
+      x.set(in.strbuf + p->str32.offset, static_cast<size_t>(len));
+      out[i] = _cmp<OP, CString>(x, y);
+    }
+  }
+}
+
+template <typename T, typename V>
+static void _compare_num(CmpOp op, const FilterInput& in, size_t icol,
+                         V y, int8_t* out)
+{
+  switch (op) {
+    case CmpOp::EQ: return _compare_num<T, V, CmpOp::EQ>(in, icol, y, out);
+    case CmpOp::NE: return _compare_num<T, V, CmpOp::NE>(in, icol, y, out);
+    case CmpOp::LT: return _compare_num<T, V, CmpOp::LT>(in, icol, y, out);
+    case CmpOp::LE: return _compare_num<T, V, CmpOp::LE>(in, icol, y, out);
+    case CmpOp::GT: return _compare_num<T, V, CmpOp::GT>(in, icol, y, out);
+    case CmpOp::GE: return _compare_num<T, V, CmpOp::GE>(in, icol, y, out);
+  }
+}
+
+
+class Compare_FilterNode : public FilterNode {
+  private:
+    size_t icol_;
+    CmpOp op_;
+    Kind kind_;    // kind of the literal: None, Bool, Int, Float or Str
+    int64_t ivalue_;
+    double fvalue_;
+    std::string svalue_;
+    std::string opname_;
+
+  public:
+    Compare_FilterNode(size_t icol, CmpOp op, const expr::FExpr* literal,
+                       const std::string& opname)
+      : icol_(icol), op_(op), ivalue_(0), fvalue_(0), opname_(opname)
+    {
+      kind_ = literal->get_expr_kind();
+      switch (kind_) {
+        case Kind::Bool:  ivalue_ = literal->evaluate_bool(); break;
+        case Kind::Int:   ivalue_ = literal->evaluate_int(); break;
+        case Kind::Float: fvalue_ = literal->evaluate_float(); break;
+        case Kind::Str:   svalue_ = literal->evaluate_pystr().to_string(); break;
+        default: break;
+      }
+      if (kind_ != Kind::Float) fvalue_ = static_cast<double>(ivalue_);
+    }
+
+    void evaluate(const FilterInput& in, int8_t* out) const override {
+      SType stype = _stype_of(in, icol_);
+      if (kind_ == Kind::None) return evaluate_none(in, stype, out);
+
+      bool is_str = (stype == SType::STR32 || stype == SType::STR64);
+      if (is_str != (kind_ == Kind::Str)) {
+        throw TypeError() << "Operator `" << opname_ << "` cannot be applied "
+            "to columns with types `" << stype << "` and `" << literal_stype()
+            << "`";
+      }
+      bool int_literal = (kind_ == Kind::Int || kind_ == Kind::Bool);
+      switch (stype) {
+        case SType::BOOL:
+          if (int_literal) return _compare_num<int8_t>(op_, in, icol_, ivalue_, out);
+          else             return _compare_num<int8_t>(op_, in, icol_, fvalue_, out);
+        case SType::INT32:
+          if (int_literal) return _compare_num<int32_t>(op_, in, icol_, ivalue_, out);
+          else             return _compare_num<int32_t>(op_, in, icol_, fvalue_, out);
+        case SType::INT64:
+          if (int_literal) return _compare_num<int64_t>(op_, in, icol_, ivalue_, out);
+          else             return _compare_num<int64_t>(op_, in, icol_, fvalue_, out);
+        case SType::FLOAT32:
+          return _compare_num<float>(op_, in, icol_, fvalue_, out);
+        case SType::FLOAT64:
+          return _compare_num<double>(op_, in, icol_, fvalue_, out);
+        case SType::STR32:
+        case SType::STR64: return evaluate_str(in, out);
+        default:
+          throw RuntimeError() << "Unexpected column type " << stype
+                               << " in fread filter";  // LCOV_EXCL_LINE
+      }
+    }
+
+  private:
+    // `x == None` is the same as `isna(x)`, and `x != None` is its
+    // negation; other comparisons with None are always false.
+    void evaluate_none(const FilterInput& in, SType stype, int8_t* out) const {
+      if (!(op_ == CmpOp::EQ || op_ == CmpOp::NE)) {
+        std::memset(out, 0, in.nrows);
+        return;
+      }
+      int8_t eq = (op_ == CmpOp::EQ);
+      const field64* p = in.data + icol_;
+      for (size_t i = 0; i < in.nrows; ++i, p += in.stride) {
+        bool isna = false;
+        switch (stype) {
+          case SType::BOOL:    isna = ISNA<int8_t>(p->int8); break;
+          case SType::INT32:   isna = ISNA<int32_t>(p->int32); break;
+          case SType::INT64:   isna = ISNA<int64_t>(p->int64); break;
+          case SType::FLOAT32: isna = ISNA<float>(p->float32); break;
+          case SType::FLOAT64: isna = ISNA<double>(p->float64); break;
+          default:             isna = (p->str32.length == NA_I4); break;
+        }
+        out[i] = isna? eq : !eq;
+      }
+    }
+
+    void evaluate_str(const FilterInput& in, int8_t* out) const {
+      CString y(svalue_);
+      switch (op_) {
+        case CmpOp::EQ: return _compare_str<CmpOp::EQ>(in, icol_, y, out);
+        case CmpOp::NE: return _compare_str<CmpOp::NE>(in, icol_, y, out);
+        case CmpOp::LT: return _compare_str<CmpOp::LT>(in, icol_, y, out);
+        case CmpOp::LE: return _compare_str<CmpOp::LE>(in, icol_, y, out);
+        case CmpOp::GT: return _compare_str<CmpOp::GT>(in, icol_, y, out);
+        case CmpOp::GE: return _compare_str<CmpOp::GE>(in, icol_, y, out);
+      }
+    }
+
+    const char* literal_stype() const {
+      return (kind_ == Kind::Bool)? "bool8" :
+             (kind_ == Kind::Int)? "int64" :
+             (kind_ == Kind::Float)? "float64" : "str32";
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Compiling the filter
+//------------------------------------------------------------------------------
+
+static NodePtr _compile(const expr::FExpr*, const PreFrame&);
+
+static Error _unsupported(const std::string& repr) {
+  return NotImplError()
+      << "Filter expression `" << repr << "` cannot be applied in fread(): "
+         "only comparisons of a column with a literal value, boolean "
+         "columns, and their combinations via operators `&`, `|` and `~` "
+         "are supported";
+}
+
+
+static size_t _find_column(const PreFrame& preframe, const std::string& name) {
+  size_t i = 0;
+  for (const auto& col : preframe) {
+    if (!col.is_dropped() && col.get_name() == name) return i;
+    ++i;
+  }
+  throw KeyError() << "Column `" << name << "` does not exist in the Frame";
+}
+
+
+static size_t _find_column(const PreFrame& preframe, int64_t index) {
+  int64_t ncols = static_cast<int64_t>(preframe.n_columns_in_output());
+  if (index < -ncols || index >= ncols) {
+    throw ValueError()
+        << "Column index `" << index << "` is invalid for a Frame with "
+        << ncols << " column" << (ncols == 1? "" : "s");
+  }
+  size_t k = static_cast<size_t>(index < 0? index + ncols : index);
+  size_t i = 0;
+  for (const auto& col : preframe) {
+    if (!col.is_dropped()) {
+      if (k == 0) return i;
+      k--;
+    }
+    ++i;
+  }
+  throw RuntimeError();  // LCOV_EXCL_LINE
+}
+
+
+// If `e` is a column reference such as `f.A` or `f[0]`, then return
+// true and store the index of the column within the preframe.
+static bool _is_column(const expr::FExpr* e, const PreFrame& preframe,
+                       size_t* icol)
+{
+  auto colattr = dynamic_cast<const expr::FExpr_ColumnAsAttr*>(e);
+  auto colarg = dynamic_cast<const expr::FExpr_ColumnAsArg*>(e);
+  if (!colattr && !colarg) return false;
+  size_t ns = colattr? colattr->get_namespace() : colarg->get_namespace();
+  if (ns != 0) {
+    throw ValueError() << "Filter expression in fread() may only refer to "
+        "columns of the Frame being read, via the `f.` namespace";
+  }
+  if (colattr) {
+    *icol = _find_column(preframe, colattr->get_pyname().to_string());
+    return true;
+  }
+  auto arg = colarg->get_arg();
+  switch (arg->get_expr_kind()) {
+    case Kind::Int: *icol = _find_column(preframe, arg->evaluate_int()); break;
+    case Kind::Str: *icol = _find_column(preframe, arg->evaluate_pystr().to_string()); break;
+    default: throw _unsupported(e->repr());
+  }
+  return true;
+}
+
+
+static bool _is_literal(const expr::FExpr* e) {
+  auto kind = e->get_expr_kind();
+  return (kind == Kind::None || kind == Kind::Bool || kind == Kind::Int ||
+          kind == Kind::Float || kind == Kind::Str);
+}
+
+
+// Logical operators `&`, `|` and `~` are not yet ported to the FExpr
+// framework, and thus they appear in the tree as `OldExpr` nodes with
+// a unary/binary function head.
+static NodePtr _compile_logical(const expr::OldExpr* e,
+                                const PreFrame& preframe)
+{
+  const auto& inputs = e->get_inputs();
+  auto unop = dynamic_cast<const expr::Head_Func_Unary*>(e->get_head());
+  auto binop = dynamic_cast<const expr::Head_Func_Binary*>(e->get_head());
+  if (unop && unop->get_op() == Op::UINVERT && inputs.size() == 1) {
+    return NodePtr(new Not_FilterNode(_compile(inputs[0].get(), preframe)));
+  }
+  if (binop && binop->get_op() == Op::AND && inputs.size() == 2) {
+    return NodePtr(new And_FilterNode(_compile(inputs[0].get(), preframe),
+                                      _compile(inputs[1].get(), preframe)));
+  }
+  if (binop && binop->get_op() == Op::OR && inputs.size() == 2) {
+    return NodePtr(new Or_FilterNode(_compile(inputs[0].get(), preframe),
+                                     _compile(inputs[1].get(), preframe)));
+  }
+  throw _unsupported(e->repr());
+}
+
+
+static NodePtr _compile_comparison(const expr::FExpr_BinaryOp* e,
+                                   const PreFrame& preframe)
+{
+  std::string name = e->name();
+  CmpOp op;
+  if      (name == "==") op = CmpOp::EQ;
+  else if (name == "!=") op = CmpOp::NE;
+  else if (name == "<")  op = CmpOp::LT;
+  else if (name == "<=") op = CmpOp::LE;
+  else if (name == ">")  op = CmpOp::GT;
+  else if (name == ">=") op = CmpOp::GE;
+  else throw _unsupported(e->repr());
+
+  size_t icol;
+  const expr::FExpr* lhs = e->get_lhs().get();
+  const expr::FExpr* rhs = e->get_rhs().get();
+  if (_is_literal(rhs) && _is_column(lhs, preframe, &icol)) {
+    return NodePtr(new Compare_FilterNode(icol, op, rhs, name));
+  }
+  if (_is_literal(lhs) && _is_column(rhs, preframe, &icol)) {
+    return NodePtr(new Compare_FilterNode(icol, _flip(op), lhs, name));
+  }
+  throw _unsupported(e->repr());
+}
+
+
+static NodePtr _compile(const expr::FExpr* e, const PreFrame& preframe) {
+  size_t icol;
+  if (_is_column(e, preframe, &icol)) {
+    return NodePtr(new Column_FilterNode(icol));
+  }
+  if (auto binop = dynamic_cast<const expr::FExpr_BinaryOp*>(e)) {
+    return _compile_comparison(binop, preframe);
+  }
+  if (auto oldexpr = dynamic_cast<const expr::OldExpr*>(e)) {
+    return _compile_logical(oldexpr, preframe);
+  }
+  throw _unsupported(e->repr());
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// RowFilter
+//------------------------------------------------------------------------------
+
+RowFilter::RowFilter(py::robj expr, const PreFrame& preframe) {
+  xassert(expr.is_dtexpr() || expr.is_fexpr());
+  repr_ = expr.repr().to_string();
+  root_ = _compile(expr::as_fexpr(expr).get(), preframe);
+}
+
+RowFilter::~RowFilter() {}
+
+
+const std::string& RowFilter::repr() const noexcept {
+  return repr_;
+}
+
+
+size_t RowFilter::apply(field64* data, size_t stride, size_t nrows,
+                        const PT* types, const char* strbuf,
+                        std::vector<int8_t>& mask) const
+{
+  if (nrows == 0) return 0;
+  mask.resize(nrows);
+  FilterInput input { data, stride, nrows, types, strbuf };
+  root_->evaluate(input, mask.data());
+
+  size_t rowsize = stride * sizeof(field64);
+  size_t k = 0;
+  for (size_t i = 0; i < nrows; ++i) {
+    if (mask[i] != 1) continue;
+    if (k != i) {
+      std::memmove(data + k * stride, data + i * stride, rowsize);
+    }
+    k++;
+  }
+  return k;
+}
+
+
+
+
+}}  // namespace dt::read
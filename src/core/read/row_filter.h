@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_READ_ROW_FILTER_h
+#define dt_READ_ROW_FILTER_h
+#include <memory>              // std::unique_ptr
+#include <string>              // std::string
+#include <vector>              // std::vector
+#include "csv/reader_parsers.h"  // PT
+#include "read/field64.h"      // field64
+#include "python/obj.h"        // py::robj
+#include "_dt.h"
+namespace dt {
+namespace read {
+
+class FilterNode;
+class PreFrame;
+
+
+/**
+  * Row filter that is pushed down into fread: the predicate is
+  * evaluated on each chunk of parsed data inside the thread context,
+  * right after the chunk was tokenized and before it is committed
+  * into the PreFrame's output columns. Thus the rows that do not
+  * pass the filter never reach the output buffers.
+  *
+  * The filter is compiled from an f-expression, which may contain
+  * comparisons (`==`, `!=`, `<`, `<=`, `>`, `>=`) between a column
+  * and a literal value, boolean columns, and their combinations via
+  * operators `&`, `|` and `~`. The semantics of each operation is
+  * the same as when the expression is used in `DT[filter, :]`; in
+  * particular, a row is selected only when the filter evaluates to
+  * True (not False or NA).
+  *
+  * The column types are resolved each time the filter is applied,
+  * since they may change during reading because of type bumps.
+  */
+class RowFilter
+{
+  private:
+    std::unique_ptr<FilterNode> root_;
+    std::string repr_;
+
+  public:
+    RowFilter(py::robj expr, const PreFrame& preframe);
+    RowFilter(const RowFilter&) = delete;
+    ~RowFilter();
+
+    const std::string& repr() const noexcept;
+
+    // Evaluate the filter on `nrows` rows of parsed data, stored in
+    // row-major order in the `data` buffer (with `stride` fields per
+    // row), and keep only those rows for which the filter is true,
+    // moving them to the beginning of the buffer. The types of the
+    // fields are given by `types`, and `strbuf` is the buffer where
+    // the string data is stored. Returns the number of rows kept.
+    // The vector `mask` is used as a temporary storage.
+    //
+    size_t apply(field64* data, size_t stride, size_t nrows,
+                 const PT* types, const char* strbuf,
+                 std::vector<int8_t>& mask) const;
+};
+
+
+
+
+}}  // namespace dt::read
+#endif
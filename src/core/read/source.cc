@@ -20,9 +20,13 @@
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
 #include "csv/reader.h"     // GenericReader
+#include "csv/reader_fread.h"  // FreadReader
+#include "frame/py_frame.h"    // py::Frame
 #include "python/string.h"
 #include "python/xobject.h"
 #include "read/source.h"    // Source
+#include "datatable.h"
+#include "rowindex.h"
 #include "utils/macros.h"
 #include "utils/misc.h"
 #include "utils/temporary_file.h"
@@ -238,4 +242,95 @@ py::oobj Source_Url::read(GenericReader& reader) {
 
 
 
+
+
+
+//------------------------------------------------------------------------------
+// Source_Chunked
+//------------------------------------------------------------------------------
+
+Source_Chunked::Source_Chunked(const std::string& name,
+                               std::unique_ptr<FreadReader>&& freader,
+                               dtptr&& pending)
+  : Source(name),
+    freader_(std::move(freader)),
+    pending_(std::move(pending))
+{
+  xassert(freader_ && freader_->chunk_nrows > 0);
+}
+
+Source_Chunked::~Source_Chunked() {}
+
+
+bool Source_Chunked::has_more() const {
+  return freader_ && ((pending_ && pending_->nrows()) ||
+                      freader_->has_more_data());
+}
+
+
+/**
+  * Return the next Frame of exactly `chunk_nrows` rows (or fewer, if
+  * this is the last Frame of the input). New batches of data are read
+  * only when there are not enough pending rows; each batch is parsed
+  * in parallel, and stops at the first chunk boundary after the
+  * requested number of rows, so that the memory used stays
+  * proportional to `chunk_nrows` regardless of the input size.
+  *
+  * The types of the columns may only widen from one batch to the
+  * next (they are carried over from the previous batch), so that the
+  * pending rows can always be combined with the newly read ones.
+  */
+py::oobj Source_Chunked::read(GenericReader&) {
+  xassert(freader_);
+  size_t nrows = freader_->chunk_nrows;
+  freader_->source_name = &name_;
+  try {
+    while (freader_->has_more_data()) {
+      size_t npending = pending_? pending_->nrows() : 0;
+      if (npending >= nrows) break;
+      freader_->batch_nrows = nrows - npending;
+      dtptr batch = freader_->read_next_batch();
+      if (!pending_ || pending_->nrows() == 0) {
+        pending_ = std::move(batch);
+      }
+      else if (batch->nrows()) {
+        size_t ncols = pending_->ncols();
+        std::vector<sztvec> colindices(ncols);
+        for (size_t i = 0; i < ncols; ++i) {
+          colindices[i].push_back(i);
+        }
+        pending_->rbind({batch.get()}, colindices);
+      }
+    }
+  } catch (...) {
+    // The reader cannot be resumed after an error
+    freader_ = nullptr;
+    pending_ = nullptr;
+    throw;
+  }
+  freader_->source_name = nullptr;
+
+  xassert(pending_);
+  size_t npending = pending_->nrows();
+  dtptr res;
+  if (npending <= nrows) {
+    res = std::move(pending_);
+  } else {
+    res = dtptr(new DataTable(*pending_));
+    res->apply_rowindex(RowIndex(0, nrows, 1));
+    pending_->apply_rowindex(RowIndex(nrows, npending - nrows, 1));
+  }
+  return py::Frame::oframe(res.release());
+}
+
+
+std::unique_ptr<Source> Source_Chunked::continuation() {
+  if (!has_more()) return nullptr;
+  return std::unique_ptr<Source>(
+      new Source_Chunked(name_, std::move(freader_), std::move(pending_)));
+}
+
+
+
+
 }}  // namespace dt::read
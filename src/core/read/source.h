@@ -24,6 +24,8 @@
 #include <memory>            // std::unique_ptr
 #include <string>            // std::string
 #include "python/_all.h"     // py::oobj
+#include "_dt.h"             // dtptr
+class FreadReader;
 namespace dt {
 namespace read {
 
@@ -117,6 +119,34 @@ class Source_Url : public Source
 
 
 
+/**
+  * Continuation of a CSV source that is being read in chunks of
+  * `chunk_nrows` rows. The FreadReader here has already detected
+  * all parse settings, and is positioned at the start of the next
+  * unread batch of data. Rows that were parsed but not returned yet
+  * (because the parallel reader always stops at a chunk boundary)
+  * are kept in `pending_`.
+  */
+class Source_Chunked : public Source
+{
+  private:
+    std::unique_ptr<FreadReader> freader_;
+    dtptr pending_;
+
+  public:
+    Source_Chunked(const std::string& name,
+                   std::unique_ptr<FreadReader>&& freader,
+                   dtptr&& pending);
+    ~Source_Chunked() override;
+    py::oobj read(GenericReader&) override;
+    std::unique_ptr<Source> continuation() override;
+
+  private:
+    bool has_more() const;
+};
+
+
+
 
 }}  // namespace dt::read
 #endif
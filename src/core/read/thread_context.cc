@@ -39,6 +39,7 @@ ThreadContext::ThreadContext(size_t ncols, size_t nrows, PreFrame& preframe)
     tbuf_nrows(nrows),
     used_nrows(0),
     row0_(0),
+    nlines_(0),
     preframe_(preframe) {}
 
 
@@ -60,6 +61,11 @@ size_t ThreadContext::get_nrows() const {
 }
 
 
+size_t ThreadContext::get_nlines() const {
+  return nlines_;
+}
+
+
 void ThreadContext::set_nrows(size_t n) {
   xassert(n <= used_nrows);
   used_nrows = n;
@@ -63,6 +63,11 @@ namespace read {
   * row0
   *   Starting row index within the PreFrame for the current data
   *   chunk.
+  *
+  * nlines
+  *   Number of physical lines in the current data chunk, which may
+  *   be larger than `used_nrows` when fields contain newlines. The
+  *   derived classes fill this only if the line count is needed.
   */
 class ThreadContext    // TODO: rename
 {
@@ -73,6 +78,7 @@ class ThreadContext    // TODO: rename
     size_t tbuf_nrows;
     size_t used_nrows;
     size_t row0_;
+    size_t nlines_;
 
     PreFrame& preframe_;
     ParseContext parse_ctx_;
@@ -88,6 +94,7 @@ class ThreadContext    // TODO: rename
     virtual bool handle_typebumps(OrderedTask*) { return false; }
 
     size_t get_nrows() const;
+    size_t get_nlines() const;
     void set_nrows(size_t n);
     void set_row0();
     void allocate_tbuf(size_t ncols, size_t nrows);
@@ -63,7 +63,8 @@
 //    For integers, this transformation is merely subtracting the min value and
 //    relocating NA to the beginning of the range. For floats, we perform a
 //    more complicated bit twiddling (see description below). For strings the
-//    data cannot be prepared "fully", so we merely map the first byte into `x`.
+//    data cannot be prepared "fully", so we map the first 7 bytes of each
+//    string (together with its length) into a 64-bit key in `x`.
 //
 // 2. Build histogram.
 //
@@ -85,17 +86,17 @@
 //    computed in the previous step. Also, update values of `x` if further
 //    sorting is needed. Here "updating" involves removing the initial radix
 //    prefix (which was already sorted), sometimes also reducing the elemsize
-//    of `x`. For strings we copy the next character of each string into the
-//    buffer `x`.
+//    of `x`. For strings, once the key is exhausted, the rows whose keys were
+//    equal get new keys made from the next 7 bytes of each string.
 //
 // 4. Recursion.
 //
 //    At this point the data is already stably-sorted according to its most
-//    significant `nradixbits` (or for strings, by their first characters), and
-//    the values in `x` are properly transformed for further sorting. Also, the
-//    `histogram` matrix from step 2 carries information about where each
-//    pre-sorted group is located. All we need to do is to sort values within
-//    each of those groups, and the job will be done.
+//    significant `nradixbits`, and the values in `x` are properly transformed
+//    for further sorting. Also, the `histogram` matrix from step 2 carries
+//    information about where each pre-sorted group is located. All we need
+//    to do is to sort values within each of those groups, and the job will
+//    be done.
 //
 //    Each sub-group that needs to be sorted will have a different size, and we
 //    process each such group taking into account its size: for small groups
@@ -123,9 +124,9 @@
 //
 //------------------------------------------------------------------------------
 #include <algorithm>  // std::min
-#include <atomic>     // std::atomic_flag
 #include <cstdlib>    // std::abs
 #include <cstring>    // std::memset, std::memcpy
+#include <mutex>      // std::mutex, std::lock_guard
 #include <vector>     // std::vector
 #include "column/view.h"
 #include "expr/py_sort.h"
@@ -377,6 +378,54 @@ void sort_init_options() {
 
 
 
+//------------------------------------------------------------------------------
+// String keys
+//------------------------------------------------------------------------------
+
+// Number of characters of a string that are cached in a single sort key.
+static constexpr size_t STR_KEY_CHARS = 7;
+
+/**
+ * Compute the sort key for string at `row` in the `column`, starting from
+ * character `start`. The key is a 64-bit number that contains the characters
+ * `[start; start + 7)` of the string in big-endian order, followed by a byte
+ * that encodes the length of the remaining part of the string:
+ *
+ *     key = ch[0] ch[1] ch[2] ch[3] ch[4] ch[5] ch[6] len
+ *
+ * Here `len` is `min(L, 7) + 1` where `L` is the number of characters left
+ * in the string after `start`, or `9` if `L > 7`. A string that is shorter
+ * than `start` is considered empty. Missing characters are padded with 0.
+ * NA strings map to key 0, so they sort before the empty string.
+ *
+ * Comparing such keys as integers is the same as comparing the corresponding
+ * fragments of the strings. Moreover, if two keys are equal, then the strings
+ * are either equal, or both have `len == 9` and must be compared further
+ * starting from character `start + 7`.
+ *
+ * For descending sort the bits of the key are inverted (but NA still maps
+ * to 0, since NAs are always placed first).
+ */
+template <bool ASC>
+static inline uint64_t string_key(const Column& column, size_t row,
+                                  size_t start)
+{
+  dt::CString value;
+  bool isvalid = column.get_element(row, &value);
+  if (!isvalid) return 0;
+  size_t len = value.size();
+  size_t nchars = len > start? std::min(len - start, STR_KEY_CHARS) : 0;
+  uint64_t key = (len > start + STR_KEY_CHARS)? STR_KEY_CHARS + 2 : nchars + 1;
+  for (size_t i = 0; i < nchars; ++i) {
+    auto ch = static_cast<uint8_t>(value[start + i]);
+    key |= static_cast<uint64_t>(ch) << (56 - 8*i);
+  }
+  return ASC? key : ~key;
+}
+
+
+
+
 //------------------------------------------------------------------------------
 // SortContext
 //------------------------------------------------------------------------------
@@ -412,11 +461,9 @@ void sort_init_options() {
  *   true when sorting strings, false otherwise
  *
  * strstart
- *   For string columns only, this is the position within the string that is
- *   currently being tested. More specifically, at the beginning of a
- *   radix_sort() call, `strstart` will indicate the offset within each string
- *   starting from each we need to sort. The assertion being that all prefixes
- *   before position `strstart` are already properly sorted.
+ *   For string columns only, this is the position within the string from
+ *   which the keys in `x` were computed. The assertion being that all
+ *   prefixes before position `strstart` are already properly sorted.
  *
  * nsigbits
  *   Number of significant bits in the elements of `x`. This cannot exceed
@@ -591,7 +638,6 @@ class SortContext {
     } else {
       _prepare_data_for_column<true>();
     }
-    if (is_string) strstart--;
     // Make sure that `xx` has enough storage capacity. Previous column may
     // have had smaller `elemsize` than this, in which case `xx` will need
     // to be expanded.
@@ -838,50 +884,62 @@ class SortContext {
 
 
   /**
-   * For strings, we fill array `x` with the values of the first character in
-   * each string. We also set up auxiliary variables `strstart` and `is_string`.
-   *
-   * More specifically, for each string item, if it is NA then we map it to 0;
-   * if it is an empty string we map it to 1, otherwise we map it to `ch[i] + 2`
-   * where `ch[i]` is the i-th character of the string. This doesn't overflow
-   * because in UTF-8 the largest legal byte is 0xF7.
+   * For strings, we fill array `x` with the keys computed from the first 7
+   * characters of each string (see `string_key()`), and subtract the smallest
+   * key so as to reduce the number of significant bits. We also set up
+   * auxiliary variables `strstart` and `is_string`.
    */
   template <bool ASC>
   void _initS() {
     is_string = true;
     strstart = 0;
-    nsigbits = 8;
-    elemsize = 1;
+    elemsize = 8;
     allocate_x();
-    uint8_t* xo = x.data<uint8_t>();
-
-    // `flong` is a flag that checks whether there is any string with len>1.
-    std::atomic_flag flong = ATOMIC_FLAG_INIT;
+    nsigbits = _fill_string_keys<ASC>(x.data<uint64_t>(),
+                                      use_order? o : nullptr, n, 0);
+  }
 
+  /**
+   * Fill array `xo` with string keys starting from character `start`, for
+   * rows `ordering[0], ..., ordering[nrows - 1]` (or `0, ..., nrows - 1` if
+   * `ordering` is nullptr). The smallest key is then subtracted from all
+   * elements of `xo`, and the number of significant bits in the resulting
+   * array is returned.
+   */
+  template <bool ASC>
+  uint8_t _fill_string_keys(uint64_t* xo, const int32_t* ordering,
+                            size_t nrows, size_t start)
+  {
+    uint64_t min = ~uint64_t(0);
+    uint64_t max = 0;
+    std::mutex mutex;
     dt::parallel_region(
       dt::NThreads(nth),
       [&] {
-        bool len_gt_1 = false;
-        dt::nested_for_static(n, dt::ChunkSize(1024),
+        uint64_t t_min = ~uint64_t(0);
+        uint64_t t_max = 0;
+        dt::nested_for_static(nrows, dt::ChunkSize(1024),
           [&](size_t j) {
-            size_t k = use_order? static_cast<size_t>(o[j]) : j;
-            dt::CString value;
-            bool isvalid = column.get_element(k, &value);
-            if (isvalid) {
-              if (value.size()) {
-                xo[j] = ASC? static_cast<uint8_t>(*value.data()) + 2
-                           : 0xFE - static_cast<uint8_t>(*value.data());
-                len_gt_1 |= (value.size() > 1);
-              } else {
-                xo[j] = ASC? 1 : 0xFF;  // empty string
-              }
-            } else {
-              xo[j] = 0;    // NA string
-            }
+            size_t k = ordering? static_cast<size_t>(ordering[j]) : j;
+            uint64_t key = string_key<ASC>(column, k, start);
+            xo[j] = key;
+            if (key < t_min) t_min = key;
+            if (key > t_max) t_max = key;
           });
-        if (len_gt_1) flong.test_and_set();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (t_min < min) min = t_min;
+        if (t_max > max) max = t_max;
       });
-    next_elemsize = flong.test_and_set();
+    if (min) {
+      dt::parallel_for_static(nrows,
+        [=](size_t j) {
+          xo[j] -= min;
+        });
+    }
+    // If all keys are equal, then keep 1 significant bit anyways: a single
+    // radix pass will then collect all rows into the same range.
+    uint64_t range = max - min;
+    return range? static_cast<uint8_t>(64 - dt::nlz(range)) : 1;
   }
 
 
@@ -918,8 +976,10 @@ class SortContext {
     nradixes = size_t(1) << nradixbits;
 
     // The remaining number of sig.bits is `shift`. Thus, this value will
-    // determine the `next_elemsize`.
-    next_elemsize = is_string? 1 :
+    // determine the `next_elemsize`. String keys are never narrowed, so that
+    // each range of rows with equal keys keeps enough space in `x` and `xx`
+    // for the keys of the next 7 characters.
+    next_elemsize = is_string? (shift? 8 : 0) :
                     shift > 32? 8 :
                     shift > 16? 4 :
                     shift > 0? 2 : 0;
@@ -1004,12 +1064,9 @@ class SortContext {
     if (!xx && next_elemsize) allocate_xx();
     if (!next_o) allocate_oo();
     if (is_string) {
-      if (xx) {
-        if (descending) _reorder_str<false>();
-        else            _reorder_str<true>();
-      } else {
-        _reorder_impl<uint8_t, char, false>();
-      }
+      xassert(elemsize == 8);
+      if (next_elemsize) _reorder_impl<uint64_t, uint64_t, true>();
+      else               _reorder_impl<uint64_t, uint8_t, false>();
     } else {
       switch (elemsize) {
         case 8:
@@ -1065,47 +1122,6 @@ class SortContext {
     xassert(histogram[nchunks * nradixes - 1] == n);
   }
 
-  template <bool ASC>
-  void _reorder_str() {
-    uint8_t* xi = x.data<uint8_t>();
-    uint8_t* xo = xx.data<uint8_t>();
-    const size_t sstart = static_cast<size_t>(strstart) + 1;
-    std::atomic_flag flong = ATOMIC_FLAG_INIT;
-
-    dt::parallel_region(dt::NThreads(nth),
-      [&] {
-        bool tlong = false;
-        dt::nested_for_static(nchunks, dt::ChunkSize(1),
-          [&](size_t i) {
-            size_t j0 = i * chunklen;
-            size_t j1 = std::min(j0 + chunklen, n);
-            size_t* tcounts = histogram + (nradixes * i);
-            for (size_t j = j0; j < j1; ++j) {
-              size_t k = tcounts[xi[j]]++;
-              xassert(k < n);
-              size_t w = use_order? static_cast<size_t>(o[j]) : j;
-              dt::CString value;
-              bool isvalid = column.get_element(w, &value);
-              if (isvalid) {
-                if (value.size() > sstart) {
-                  xo[k] = ASC? static_cast<uint8_t>(value[sstart] + 2)
-                             : static_cast<uint8_t>(0xFE - value[sstart]);
-                  tlong = true;
-                } else {
-                  xo[k] = ASC? 1 : 0xFF;  // string is shorter than sstart
-                }
-              } else {
-                xo[k] = 0;
-              }
-              next_o[k] = static_cast<int32_t>(w);
-            }
-          });
-        if (tlong) flong.test_and_set();
-      });
-    next_elemsize = flong.test_and_set();
-    xassert(histogram[nchunks * nradixes - 1] == n);
-  }
-
 
 
   //============================================================================
@@ -1128,13 +1144,26 @@ class SortContext {
       // If after reordering there are still unsorted elements in `x`, then
       // sort them recursively.
       uint8_t _nsigbits = nsigbits;
-      nsigbits = is_string? 8 : shift;
+      nsigbits = shift;
       auto rrmap = std::unique_ptr<radix_range[]>(new radix_range[nradixes]);
       radix_range* rrmap_ptr = rrmap.get();
       _fill_rrmap_from_histogram(rrmap_ptr);
       _radix_recurse<make_groups>(rrmap_ptr);
       nsigbits = _nsigbits;
     }
+    else if (is_string) {
+      // The string keys are exhausted, however the strings within each
+      // range of equal keys may still differ in their subsequent
+      // characters. Note that if `xx` was never allocated, then the
+      // `reorder_data()` step has moved the original keys into `xx`.
+      if (!x) swap(x, xx);
+      elemsize = 8;
+      if (!xx) allocate_xx();
+      auto rrmap = std::unique_ptr<radix_range[]>(new radix_range[nradixes]);
+      radix_range* rrmap_ptr = rrmap.get();
+      _fill_rrmap_from_histogram(rrmap_ptr);
+      _radix_recurse<make_groups>(rrmap_ptr, /* next_key = */ true);
+    }
     else if (make_groups) {
       // Otherwise groups can be computed directly from the histogram
       gg.from_histogram(histogram, nchunks, nradixes);
@@ -1189,9 +1218,14 @@ class SortContext {
    * by array `o` which carries the original row numbers of each
    * value. Once we sort `o` by the values of `x` within each
    * radix range, our job will be complete.
+   *
+   * For string columns, if `next_key` is true, then the keys within
+   * each range are fully equal, and the ranges must be sorted by the
+   * next 7 characters of each string. The keys for those characters
+   * are computed here, overwriting the content of `x`.
    */
   template <bool make_groups>
-  void _radix_recurse(radix_range* rrmap) {
+  void _radix_recurse(radix_range* rrmap, bool next_key = false) {
     xassert(x && xx && o && next_o);
     // Save some of the variables in SortContext that we will be modifying
     // in order to perform the recursion.
@@ -1203,6 +1237,7 @@ class SortContext {
     uint8_t  _elemsize = elemsize;
     size_t   _nradixes = nradixes;
     size_t   _strstart = strstart;
+    uint8_t  _nsigbits = nsigbits;
     int32_t  ggoff0    = make_groups? gg.cumulative_size() : 0;
     int32_t* ggdata0   = make_groups? gg.data() : nullptr;
 
@@ -1230,18 +1265,45 @@ class SortContext {
     size_t rrlarge = sort_insert_method_threshold;  // for now
     xassert(GROUPED > rrlarge);
 
-    strstart = _strstart + 1;
+    // Position within the strings from which the keys for each range
+    // are computed.
+    size_t sstart = next_key? _strstart + STR_KEY_CHARS : _strstart;
+    strstart = sstart;
 
     for (size_t rri = 0; rri < _nradixes; ++rri) {
       size_t sz = rrmap[rri].size;
+      size_t off = rrmap[rri].offset;
+      if (next_key && sz) {
+        // If the strings in this range end before `sstart`, then they
+        // are all equal and need no further sorting.
+        bool done = (sz == 1);
+        if (!done) {
+          dt::CString value;
+          bool isvalid = column.get_element(static_cast<size_t>(_o[off]), &value);
+          done = !isvalid || value.size() <= sstart;
+        }
+        if (done) {
+          if (make_groups) {
+            ggdata0[off] = ggoff0 + static_cast<int32_t>(off + sz);
+            rrmap[rri].size = 1 | GROUPED;
+          } else {
+            rrmap[rri].size = 0;
+          }
+          continue;
+        }
+      }
       if (sz > rrlarge) {
-        size_t off = rrmap[rri].offset;
         elemsize = _elemsize;
         n = sz;
         x = rmem(_x, off * elemsize, n * elemsize);
         xx = rmem(_xx, off * elemsize, n * elemsize);
         o = _o + off;
         next_o = _next_o + off;
+        if (next_key) {
+          nsigbits = descending
+            ? _fill_string_keys<false>(x.data<uint64_t>(), o, n, sstart)
+            : _fill_string_keys<true>(x.data<uint64_t>(), o, n, sstart);
+        }
         if (make_groups) {
           gg.init(ggdata0 + off, ggoff0 + static_cast<int32_t>(off));
           radix_psort<true>();
@@ -1262,6 +1324,7 @@ class SortContext {
     next_o = _next_o;
     elemsize = _elemsize;
     nradixes = _nradixes;
+    nsigbits = _nsigbits;
     strstart = _strstart;
     gg.init(ggdata0, ggoff0);
 
@@ -1301,7 +1364,16 @@ class SortContext {
                 tgg.init(ggdata0 + off, static_cast<int32_t>(off) + ggoff0);
               }
               if (is_string) {
-                insert_sort_keys_str(column, _strstart + 1, to, oo, tn, tgg, descending);
+                uint64_t* tkeys = tx.data<uint64_t>();
+                if (next_key) {
+                  for (size_t j = 0; j < zn; ++j) {
+                    auto row = static_cast<size_t>(to[j]);
+                    tkeys[j] = descending? string_key<false>(column, row, sstart)
+                                         : string_key<true>(column, row, sstart);
+                  }
+                }
+                insert_sort_keys_str(column, sstart + STR_KEY_CHARS, tkeys,
+                                     to, oo, tn, tgg, descending);
               } else {
                 switch (elemsize) {
                   case 1: insert_sort_keys<>(tx.data<uint8_t>(), to, oo, tn, tgg); break;
@@ -1341,7 +1413,8 @@ class SortContext {
     int32_t* tmp = tmparr.get();
     int32_t nn = static_cast<int32_t>(n);
     if (is_string) {
-      insert_sort_keys_str(column, 0, o, tmp, nn, gg, descending);
+      insert_sort_keys_str(column, STR_KEY_CHARS, x.data<uint64_t>(),
+                           o, tmp, nn, gg, descending);
     } else {
       switch (elemsize) {
         case 1: _insert_sort_keys<uint8_t >(tmp); break;
@@ -1355,7 +1428,8 @@ class SortContext {
   void vinsert_sort() {
     if (is_string) {
       int32_t nn = static_cast<int32_t>(n);
-      insert_sort_values_str(column, 0, o, nn, gg, descending);
+      insert_sort_values_str(column, STR_KEY_CHARS, x.data<uint64_t>(),
+                             o, nn, gg, descending);
     } else {
       switch (elemsize) {
         case 1: _insert_sort_values<uint8_t >(); break;
@@ -1386,14 +1460,20 @@ class SortContext {
 // Main sorting routines
 //==============================================================================
 
-RiGb group(const std::vector<Column>& columns,
+RiGb group(const std::vector<Column>& columns_in,
            const std::vector<SortFlag>& flags)
 {
   RiGb result;
-  size_t n = columns.size();
+  size_t n = columns_in.size();
   xassert(n > 0);
   xassert(n == flags.size());
 
+  std::vector<Column> columns;
+  columns.reserve(n);
+  for (const Column& col : columns_in) {
+    columns.push_back(col.unwrap_categorical_codes());
+  }
+
   const Column& col0 = columns[0];
 
   size_t nrows = col0.nrows();
@@ -1415,6 +1495,13 @@ RiGb group(const std::vector<Column>& columns,
     return result;
   }
 
+  // If the data is too large to be sorted in memory, sort it in runs
+  // and merge (see sort_external.cc).
+  size_t max_rows = sort_max_rows_in_memory(columns);
+  if (nrows > max_rows) {
+    return group_external(columns, flags, max_rows);
+  }
+
   if (sort_new) {
     if (n == 1) {
       bool sort_only = (flags[0] & SortFlag::SORT_ONLY);
@@ -51,8 +51,38 @@ RiGb group(const std::vector<Column>& columns,
 
 
 
+// Hash-based grouping (see sort_hash.cc). Returns the same result as
+// `group()`, or false if the hash-based approach is not applicable to
+// the given columns, or would not be beneficial.
+bool group_hashed(const std::vector<Column>& columns,
+                  const std::vector<SortFlag>& flags, RiGb* out);
+
+
+// Top-k sorting (see sort_topk.cc). Produces the first `k` rows of each
+// group in sorted order, where the groups are formed by the first
+// `ngroupcols` columns, and the rows within each group are sorted by the
+// remaining columns. Returns false if the top-k approach is not
+// applicable or would not be beneficial, in which case the caller
+// should use the regular `group()`.
+bool group_topk(const std::vector<Column>& columns,
+                const std::vector<SortFlag>& flags,
+                size_t ngroupcols, size_t k, RiGb* out);
+
+
+// External sorting (see sort_external.cc). When the number of rows in
+// the columns exceeds `sort_max_rows_in_memory()`, function `group()`
+// sorts the data in runs of `run_size` rows, which are spilled to disk
+// and then merged.
+size_t sort_max_rows_in_memory(const std::vector<Column>& columns);
+RiGb group_external(const std::vector<Column>& columns,
+                    const std::vector<SortFlag>& flags,
+                    size_t run_size);
+
+
 // Called during module initialization
 void sort_init_options();
+void sort_hash_init_options();
+void sort_external_init_options();
 
 
 /**
@@ -149,10 +179,10 @@ template <typename T, typename V>
 void insert_sort_values(const T* x, V* o, int n, GroupGatherer& gg);
 
 template <typename V>
-void insert_sort_keys_str(const Column&, size_t, V*, V*, int, GroupGatherer&, bool);
+void insert_sort_keys_str(const Column&, size_t, const uint64_t*, V*, V*, int, GroupGatherer&, bool);
 
 template <typename V>
-void insert_sort_values_str(const Column&, size_t, V*, int, GroupGatherer&, bool);
+void insert_sort_values_str(const Column&, size_t, const uint64_t*, V*, int, GroupGatherer&, bool);
 
 template <int R>
 int compare_strings(const dt::CString& a, bool a_isna,
@@ -169,8 +199,8 @@ extern template void insert_sort_values(const uint16_t*, int32_t*, int, GroupGat
 extern template void insert_sort_values(const uint32_t*, int32_t*, int, GroupGatherer&);
 extern template void insert_sort_values(const uint64_t*, int32_t*, int, GroupGatherer&);
 
-extern template void insert_sort_keys_str(const Column&, size_t, int32_t*, int32_t*, int, GroupGatherer&, bool);
-extern template void insert_sort_values_str(const Column&, size_t, int32_t*, int, GroupGatherer&, bool);
+extern template void insert_sort_keys_str(const Column&, size_t, const uint64_t*, int32_t*, int32_t*, int, GroupGatherer&, bool);
+extern template void insert_sort_values_str(const Column&, size_t, const uint64_t*, int32_t*, int, GroupGatherer&, bool);
 
 extern template int compare_strings<1>(const dt::CString&, bool, const dt::CString&, bool, size_t);
 extern template int compare_strings<-1>(const dt::CString&, bool, const dt::CString&, bool, size_t);
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+// Copyright 2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_SORT_ROW_COMPARATOR_h
+#define dt_SORT_ROW_COMPARATOR_h
+#include <cstring>           // std::memcpy
+#include <memory>            // std::unique_ptr
+#include <vector>            // std::vector
+#include "column.h"
+#include "cstring.h"
+#include "sort.h"            // SortFlag, compare_strings
+#include "stype.h"
+namespace dt {
+namespace sort {
+
+
+/**
+  * Compares the values in two rows `i` and `j` of a column, returning
+  * a negative number if row `i` sorts before row `j`, a positive number
+  * if it sorts after, and 0 if the two values are equal. The ordering
+  * is the same as the one produced by the radix sort in `group()`: NAs
+  * come first regardless of the sort direction.
+  *
+  * These comparators are used by the algorithms that only need to
+  * order a small subset of the rows (merging of sorted runs, top-k
+  * selection), where preparing the radix keys for the whole column
+  * would be wasteful.
+  */
+class ColumnComparator {
+  public:
+    virtual ~ColumnComparator() {}
+    virtual int compare(size_t i, size_t j) const = 0;
+};
+
+
+template <typename T, bool ASC>
+class IntColumnComparator : public ColumnComparator {
+  private:
+    Column column_;
+
+  public:
+    explicit IntColumnComparator(const Column& col) : column_(col) {}
+
+    int compare(size_t i, size_t j) const override {
+      T a, b;
+      bool a_valid = column_.get_element(i, &a);
+      bool b_valid = column_.get_element(j, &b);
+      if (!(a_valid && b_valid)) return a_valid - b_valid;
+      if (a == b) return 0;
+      return ((a < b) == ASC)? -1 : 1;
+    }
+};
+
+
+// Floats are compared via their bit representations, transformed in
+// the same way as in the radix sort (see `SortContext::_initF()`), so
+// that, for example, -0.0 sorts before 0.0.
+template <typename T, typename U, bool ASC>
+class FloatColumnComparator : public ColumnComparator {
+  private:
+    Column column_;
+    static constexpr int SHIFT = sizeof(U) * 8 - 1;
+    static constexpr U SBT = static_cast<U>(U(1) << SHIFT);
+
+  public:
+    explicit FloatColumnComparator(const Column& col) : column_(col) {}
+
+    int compare(size_t i, size_t j) const override {
+      T a, b;
+      bool a_valid = column_.get_element(i, &a);
+      bool b_valid = column_.get_element(j, &b);
+      if (!(a_valid && b_valid)) return a_valid - b_valid;
+      U ka = key(a), kb = key(b);
+      if (ka == kb) return 0;
+      return ((ka < kb) == ASC)? -1 : 1;
+    }
+
+  private:
+    static U key(T value) {
+      U t;
+      std::memcpy(&t, &value, sizeof(U));
+      return t ^ (SBT | (0 - (t >> SHIFT)));
+    }
+};
+
+
+template <bool ASC>
+class StringColumnComparator : public ColumnComparator {
+  private:
+    Column column_;
+
+  public:
+    explicit StringColumnComparator(const Column& col) : column_(col) {}
+
+    int compare(size_t i, size_t j) const override {
+      dt::CString a, b;
+      bool a_valid = column_.get_element(i, &a);
+      bool b_valid = column_.get_element(j, &b);
+      return -compare_strings<ASC? 1 : -1>(a, a_valid, b, b_valid, 0);
+    }
+};
+
+
+template <bool ASC>
+ColumnComparator* make_column_comparator(const Column& col) {
+  switch (col.stype()) {
+    case SType::BOOL:
+    case SType::INT8:    return new IntColumnComparator<int8_t, ASC>(col);
+    case SType::INT16:   return new IntColumnComparator<int16_t, ASC>(col);
+    case SType::INT32:   return new IntColumnComparator<int32_t, ASC>(col);
+    case SType::INT64:   return new IntColumnComparator<int64_t, ASC>(col);
+    case SType::FLOAT32: return new FloatColumnComparator<float, uint32_t, ASC>(col);
+    case SType::FLOAT64: return new FloatColumnComparator<double, uint64_t, ASC>(col);
+    case SType::STR32:
+    case SType::STR64:   return new StringColumnComparator<ASC>(col);
+    default:
+      throw NotImplError() << "Unable to sort Column of stype " << col.stype();
+  }
+}
+
+
+
+/**
+  * Lexicographic comparator of rows by several columns, each with its
+  * own sort direction. Method `compare(i, j, k)` compares the rows by
+  * the first `k` columns only.
+  */
+class RowComparator {
+  private:
+    std::vector<std::unique_ptr<ColumnComparator>> columns_;
+
+  public:
+    RowComparator(const std::vector<Column>& columns,
+                  const std::vector<SortFlag>& flags)
+    {
+      xassert(columns.size() == flags.size());
+      columns_.reserve(columns.size());
+      for (size_t i = 0; i < columns.size(); ++i) {
+        columns_.emplace_back(
+          (flags[i] & SortFlag::DESCENDING)
+              ? make_column_comparator<false>(columns[i])
+              : make_column_comparator<true>(columns[i]));
+      }
+    }
+
+    size_t ncols() const noexcept {
+      return columns_.size();
+    }
+
+    int compare(size_t i, size_t j, size_t k) const {
+      for (size_t c = 0; c < k; ++c) {
+        int cmp = columns_[c]->compare(i, j);
+        if (cmp) return cmp;
+      }
+      return 0;
+    }
+
+    int compare(size_t i, size_t j) const {
+      return compare(i, j, columns_.size());
+    }
+};
+
+
+
+
+}} // namespace dt::sort
+#endif
@@ -0,0 +1,560 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+// External (out-of-core) sorting.
+//
+// The regular `group()` function needs the full sorting key and several
+// ordering buffers of the same length in memory at once. When the amount
+// of memory required for that exceeds option `sort.memory_limit`, the
+// function `group_external()` is used instead, which proceeds as follows:
+//
+//   1. The rows of the frame are split into contiguous "runs", each small
+//      enough to be sorted within the memory limit. The runs are sorted
+//      one after another with the regular in-memory `group()`, so that
+//      each run is sorted by all available threads, while the peak
+//      memory usage stays bounded by the size of a single run.
+//
+//   2. The rows of each run are spilled in the sorted order into a
+//      temporary file on disk (in the directory given by option
+//      `sort.tempdir`), and the memory used for sorting the run is
+//      released. Each row is stored as a record of its normalized key
+//      (a sequence of 64-bit words that compare in the same order as the
+//      row's values), followed by the row's index.
+//
+//   3. The spilled runs are memory-mapped back and combined with a k-way
+//      merge, which reads each run sequentially. The records are compared
+//      by their keys; only when two strings share a prefix longer than
+//      what fits into the key, the rows are compared by their values in
+//      the original columns. Ties are resolved in favor of the run that
+//      comes earlier in the frame, which makes the external sort stable,
+//      and its result identical to that of the in-memory sort. Group
+//      boundaries (if needed) are detected during the merge by comparing
+//      each record with the previous one.
+//
+//   4. The resulting ordering and group offsets are written out into
+//      temporary files as they are produced, instead of being kept in
+//      memory. The returned RowIndex and Groupby are backed by these
+//      files, which are removed once the buffers are released.
+//
+// The external sort is also used for frames with more than 2^31 rows,
+// which the in-memory sort cannot order by itself.
+//------------------------------------------------------------------------------
+#include <algorithm>  // std::min, std::max, std::fill, std::make_heap
+#include <cstring>    // std::memcpy
+#include <memory>     // std::shared_ptr, std::unique_ptr
+#include <vector>     // std::vector
+#include "parallel/api.h"
+#include "python/arg.h"
+#include "python/int.h"
+#include "python/string.h"
+#include "sort/row_comparator.h"
+#include "utils/assert.h"
+#include "utils/temporary_file.h"
+#include "buffer.h"
+#include "column.h"
+#include "groupby.h"
+#include "options.h"
+#include "rowindex.h"
+#include "sort.h"
+#include "stype.h"
+#include "writebuf.h"
+
+
+static const char* doc_sort_memory_limit =
+R"(
+Maximum amount of memory (in bytes) that may be used for the temporary
+buffers when sorting or grouping a frame.
+
+If sorting a frame would require more memory than this limit, the
+frame will be sorted in several runs that fit within the limit; the
+sorted runs are spilled to temporary files on disk and then merged.
+This allows sorting frames that are comparable in size to, or larger
+than, the amount of available RAM (for example, frames memory-mapped
+from Jay files).
+
+The default value of 0 means that the memory is not limited.
+)";
+
+static const char* doc_sort_tempdir =
+R"(
+Directory where the temporary files are created when a frame is
+sorted in external mode (see option ``sort.memory_limit``). If None,
+the system's default temporary directory is used.
+)";
+
+static size_t sort_memory_limit = 0;
+static std::string sort_tempdir;
+
+void sort_external_init_options() {
+  dt::register_option(
+    "sort.memory_limit",
+    []{ return py::oint(sort_memory_limit); },
+    [](const py::Arg& value) {
+      int64_t n = value.to_int64_strict();
+      if (n < 0) n = 0;
+      sort_memory_limit = static_cast<size_t>(n);
+    },
+    doc_sort_memory_limit
+  );
+
+  dt::register_option(
+    "sort.tempdir",
+    []{ return sort_tempdir.empty()? py::None() : py::ostring(sort_tempdir); },
+    [](const py::Arg& value) {
+      sort_tempdir = value.is_none()? std::string() : value.to_string();
+    },
+    doc_sort_tempdir
+  );
+}
+
+
+// Approximate number of bytes per row needed by the in-memory sort for
+// its own buffers: the ordering vectors `o` and `next_o` (4 bytes each),
+// the keys `x` and `next_x` (up to 8 bytes each), and the group offsets
+// (4 bytes). In addition, the sorted columns get materialized.
+static constexpr size_t SORT_BYTES_PER_ROW = 28;
+
+// Runs cannot be too small, otherwise the merge step becomes inefficient.
+static constexpr size_t MIN_RUN_SIZE = 1 << 12;
+
+// The in-memory sort produces 32-bit orderings.
+static constexpr size_t MAX_RUN_SIZE = static_cast<size_t>(INT32_MAX);
+
+
+size_t sort_max_rows_in_memory(const std::vector<Column>& columns) {
+  if (!sort_memory_limit) return MAX_RUN_SIZE;
+  size_t row_size = SORT_BYTES_PER_ROW;
+  for (const Column& col : columns) {
+    row_size += stype_elemsize(col.stype());
+  }
+  size_t nrows = sort_memory_limit / row_size;
+  return std::min(std::max(nrows, MIN_RUN_SIZE), MAX_RUN_SIZE);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Normalized keys
+//------------------------------------------------------------------------------
+
+// Number of 64-bit words in the normalized key of a string column. The
+// key holds the first STRING_KEY_BYTES bytes of the string, followed by
+// a "marker" byte: the length of the string plus one, or
+// STRING_TRUNCATED if the string does not fit into the key.
+static constexpr size_t STRING_KEY_WORDS = 3;
+static constexpr size_t STRING_KEY_BYTES = 8 * STRING_KEY_WORDS - 1;
+static constexpr uint64_t STRING_TRUNCATED = STRING_KEY_BYTES + 2;
+
+// Number of records encoded / written out at a time.
+static constexpr size_t BLOCK_NROWS = 1 << 16;
+
+
+/**
+ * Encodes the values of a column into normalized keys: sequences of
+ * 64-bit words such that comparing the keys of two rows word by word,
+ * as unsigned integers, orders the rows in the same way as the
+ * `dt::sort::RowComparator`. NAs are encoded with zero words, and all
+ * valid values with nonzero keys, so that NAs come first regardless of
+ * the sort direction.
+ */
+class KeyEncoder {
+  public:
+    virtual ~KeyEncoder() = default;
+    virtual size_t nwords() const noexcept { return 1; }
+    virtual void encode(size_t row, uint64_t* out) const = 0;
+
+    // Returns true if the values of two rows may be different even
+    // though their keys are both equal to `key`.
+    virtual bool truncated(const uint64_t*) const noexcept { return false; }
+};
+
+using encoderptr = std::unique_ptr<KeyEncoder>;
+
+
+// Integers are shifted into the range [1; 2^64-1].
+template <typename T, bool ASC>
+class IntKeyEncoder : public KeyEncoder {
+  private:
+    Column column_;
+
+  public:
+    explicit IntKeyEncoder(const Column& col) : column_(col) {}
+
+    void encode(size_t row, uint64_t* out) const override {
+      T value;
+      bool valid = column_.get_element(row, &value);
+      uint64_t u = static_cast<uint64_t>(static_cast<int64_t>(value))
+                   ^ (uint64_t(1) << 63);
+      *out = valid? (ASC? u : 0 - u) : 0;
+    }
+};
+
+
+// Floats are transformed in the same way as in the radix sort. The
+// transformed value can only be 0 for a NaN, which is an NA.
+template <typename T, typename U, bool ASC>
+class FloatKeyEncoder : public KeyEncoder {
+  private:
+    Column column_;
+    static constexpr int SHIFT = sizeof(U) * 8 - 1;
+    static constexpr U SBT = static_cast<U>(U(1) << SHIFT);
+
+  public:
+    explicit FloatKeyEncoder(const Column& col) : column_(col) {}
+
+    void encode(size_t row, uint64_t* out) const override {
+      T value;
+      bool valid = column_.get_element(row, &value);
+      U t;
+      std::memcpy(&t, &value, sizeof(U));
+      uint64_t u = static_cast<uint64_t>(t ^ (SBT | (0 - (t >> SHIFT))));
+      *out = valid? (ASC? u : 0 - u) : 0;
+    }
+};
+
+
+// Strings are stored big-endian, so that the words compare in the same
+// way as the bytes. For the descending order all bits are inverted.
+template <bool ASC>
+class StringKeyEncoder : public KeyEncoder {
+  private:
+    Column column_;
+
+  public:
+    explicit StringKeyEncoder(const Column& col) : column_(col) {}
+
+    size_t nwords() const noexcept override {
+      return STRING_KEY_WORDS;
+    }
+
+    void encode(size_t row, uint64_t* out) const override {
+      std::fill(out, out + STRING_KEY_WORDS, 0);
+      dt::CString value;
+      if (!column_.get_element(row, &value)) return;
+      size_t len = value.size();
+      size_t n = std::min(len, STRING_KEY_BYTES);
+      auto bytes = reinterpret_cast<const uint8_t*>(value.data());
+      for (size_t i = 0; i < n; ++i) {
+        out[i / 8] |= static_cast<uint64_t>(bytes[i]) << (56 - 8 * (i % 8));
+      }
+      out[STRING_KEY_WORDS - 1] |= (len > STRING_KEY_BYTES)? STRING_TRUNCATED
+                                                            : len + 1;
+      if (!ASC) {
+        for (size_t w = 0; w < STRING_KEY_WORDS; ++w) out[w] = ~out[w];
+      }
+    }
+
+    bool truncated(const uint64_t* key) const noexcept override {
+      uint64_t last = ASC? key[STRING_KEY_WORDS - 1]
+                         : ~key[STRING_KEY_WORDS - 1];
+      return (last & 0xFF) == STRING_TRUNCATED;
+    }
+};
+
+
+template <bool ASC>
+static KeyEncoder* make_key_encoder(const Column& col) {
+  switch (col.stype()) {
+    case dt::SType::BOOL:
+    case dt::SType::INT8:    return new IntKeyEncoder<int8_t, ASC>(col);
+    case dt::SType::INT16:   return new IntKeyEncoder<int16_t, ASC>(col);
+    case dt::SType::INT32:   return new IntKeyEncoder<int32_t, ASC>(col);
+    case dt::SType::INT64:   return new IntKeyEncoder<int64_t, ASC>(col);
+    case dt::SType::FLOAT32: return new FloatKeyEncoder<float, uint32_t, ASC>(col);
+    case dt::SType::FLOAT64: return new FloatKeyEncoder<double, uint64_t, ASC>(col);
+    case dt::SType::STR32:
+    case dt::SType::STR64:   return new StringKeyEncoder<ASC>(col);
+    default:
+      throw NotImplError() << "Unable to sort Column of stype " << col.stype();
+  }
+}
+
+
+
+/**
+ * Sorting key of a frame. Each row is represented by a "record" of
+ * `record_size()` words: the normalized keys of all columns, followed
+ * by the index of the row in the frame.
+ *
+ * The records are compared by their words, and only when the keys of
+ * a string column are equal but truncated, the rows are compared by
+ * their values in the original columns.
+ */
+class SortKey {
+  private:
+    std::vector<encoderptr> encoders_;
+    std::vector<size_t> offsets_;  // word offset of each column's key
+    dt::sort::RowComparator comparator_;
+
+  public:
+    SortKey(const std::vector<Column>& columns,
+            const std::vector<SortFlag>& flags)
+      : comparator_(columns, flags)
+    {
+      offsets_.push_back(0);
+      for (size_t i = 0; i < columns.size(); ++i) {
+        encoders_.emplace_back(
+          (flags[i] & SortFlag::DESCENDING)
+              ? make_key_encoder<false>(columns[i])
+              : make_key_encoder<true>(columns[i]));
+        offsets_.push_back(offsets_.back() + encoders_.back()->nwords());
+      }
+    }
+
+    size_t record_size() const noexcept {
+      return offsets_.back() + 1;
+    }
+
+    void encode(size_t row, uint64_t* record) const {
+      for (size_t i = 0; i < encoders_.size(); ++i) {
+        encoders_[i]->encode(row, record + offsets_[i]);
+      }
+      record[offsets_.back()] = row;
+    }
+
+    // Compare two records by the first `k` columns
+    int compare(const uint64_t* a, const uint64_t* b, size_t k) const {
+      for (size_t i = 0; i < k; ++i) {
+        for (size_t w = offsets_[i]; w < offsets_[i + 1]; ++w) {
+          if (a[w] != b[w]) return (a[w] < b[w])? -1 : 1;
+        }
+        if (encoders_[i]->truncated(a + offsets_[i])) {
+          size_t rowid = offsets_.back();
+          return comparator_.compare(a[rowid], b[rowid], k);
+        }
+      }
+      return 0;
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Sorted runs
+//------------------------------------------------------------------------------
+
+static std::shared_ptr<TemporaryFile> make_temporary_file() {
+  return sort_tempdir.empty()? std::make_shared<TemporaryFile>()
+                             : std::make_shared<TemporaryFile>(sort_tempdir);
+}
+
+
+/**
+ * A contiguous range of rows of the frame, whose records were sorted by
+ * the in-memory sort and then written into a temporary file, which is
+ * read back sequentially during the merge.
+ */
+struct SortedRun {
+  std::shared_ptr<TemporaryFile> file;
+  const uint64_t* records;
+  size_t size;
+  size_t pos;
+};
+
+
+static SortedRun sort_run(const std::vector<Column>& columns,
+                          const std::vector<SortFlag>& flags,
+                          const SortKey& key, size_t start, size_t size)
+{
+  std::vector<Column> run_columns;
+  run_columns.reserve(columns.size());
+  for (const Column& col : columns) {
+    Column run_col(col);
+    run_col.apply_rowindex(RowIndex(start, size, 1));
+    run_columns.push_back(std::move(run_col));
+  }
+
+  SortedRun run;
+  run.size = size;
+  run.pos = 0;
+  run.records = nullptr;
+  run.file = make_temporary_file();
+  {
+    RowIndex ordering = group(run_columns, flags).first;
+    xassert(ordering.size() == size);
+    xassert(ordering.type() == RowIndexType::ARR32);
+    const int32_t* indices = ordering.indices32();
+    size_t recsize = key.record_size();
+    std::vector<uint64_t> block(std::min(size, BLOCK_NROWS) * recsize);
+    WritableBuffer* wb = run.file->data_w();
+    for (size_t k0 = 0; k0 < size; k0 += BLOCK_NROWS) {
+      size_t n = std::min(BLOCK_NROWS, size - k0);
+      dt::parallel_for_static(n,
+        [&](size_t k) {
+          size_t row = start + static_cast<size_t>(indices[k0 + k]);
+          key.encode(row, block.data() + k * recsize);
+        });
+      wb->write(n * recsize * sizeof(uint64_t), block.data());
+    }
+  }
+  return run;
+}
+
+
+/**
+ * Buffered writer of a sequence of values of type `T` into a temporary
+ * file. The result is returned as a Buffer backed by that file.
+ */
+template <typename T>
+class SpilledArray {
+  private:
+    std::shared_ptr<TemporaryFile> file_;
+    std::vector<T> block_;
+    size_t size_;
+
+  public:
+    SpilledArray() : file_(make_temporary_file()), size_(0) {
+      block_.reserve(BLOCK_NROWS);
+    }
+
+    void push_back(T value) {
+      block_.push_back(value);
+      if (block_.size() == BLOCK_NROWS) flush();
+    }
+
+    Buffer to_buffer() {
+      flush();
+      return Buffer::tmp(file_, 0, size_ * sizeof(T));
+    }
+
+  private:
+    void flush() {
+      if (block_.empty()) return;
+      file_->data_w()->write(block_.size() * sizeof(T), block_.data());
+      size_ += block_.size();
+      block_.clear();
+    }
+};
+
+
+
+
+//------------------------------------------------------------------------------
+// Main external sorting routine
+//------------------------------------------------------------------------------
+
+template <typename T>
+static RiGb merge_runs(const SortKey& key,
+                       const std::vector<SortFlag>& flags,
+                       std::vector<SortedRun>& runs,
+                       size_t nrows)
+{
+  size_t ncols = flags.size();
+  size_t recsize = key.record_size();
+
+  // The groups are computed on the leading columns that are not SORT_ONLY,
+  // same as in the in-memory `group()`.
+  size_t ngroupcols = 0;
+  while (ngroupcols < ncols && !(flags[ngroupcols] & SortFlag::SORT_ONLY)) {
+    ngroupcols++;
+  }
+  if (ngroupcols && nrows > MAX_RUN_SIZE) {
+    throw NotImplError() << "Cannot group a frame with more than "
+        << MAX_RUN_SIZE << " rows";
+  }
+
+  for (SortedRun& run : runs) {
+    run.records = static_cast<const uint64_t*>(run.file->data_r());
+  }
+  auto current = [&](size_t r) {
+    return runs[r].records + runs[r].pos * recsize;
+  };
+  // `std::*_heap` functions maintain a max-heap, so the comparator must
+  // return true when run `a` comes *after* run `b`.
+  auto run_after = [&](size_t a, size_t b) {
+    int cmp = key.compare(current(a), current(b), ncols);
+    return cmp? (cmp > 0) : (a > b);
+  };
+  std::vector<size_t> heap;
+  heap.reserve(runs.size());
+  for (size_t r = 0; r < runs.size(); ++r) heap.push_back(r);
+  std::make_heap(heap.begin(), heap.end(), run_after);
+
+  // The ordering and the group offsets are written out into temporary
+  // files as they are produced. The record of the previous row is kept
+  // for detecting the group boundaries, since its run may already be
+  // closed.
+  SpilledArray<T> ordering;
+  SpilledArray<int32_t> group_offsets;
+  std::vector<uint64_t> prev(recsize);
+  size_t ngroups = 0;
+  for (size_t k = 0; k < nrows; ++k) {
+    std::pop_heap(heap.begin(), heap.end(), run_after);
+    SortedRun& run = runs[heap.back()];
+    const uint64_t* record = current(heap.back());
+    if (ngroupcols && (k == 0 || key.compare(prev.data(), record, ngroupcols))) {
+      group_offsets.push_back(static_cast<int32_t>(k));
+      ngroups++;
+    }
+    ordering.push_back(static_cast<T>(record[recsize - 1]));
+    std::memcpy(prev.data(), record, recsize * sizeof(uint64_t));
+    run.pos++;
+    if (run.pos < run.size) {
+      std::push_heap(heap.begin(), heap.end(), run_after);
+    } else {
+      heap.pop_back();
+      run.file = nullptr;  // remove the temporary file early
+    }
+  }
+  xassert(heap.empty());
+
+  RiGb result;
+  result.first = RowIndex(ordering.to_buffer(),
+                          sizeof(T) == 4? RowIndex::ARR32 : RowIndex::ARR64);
+  if (ngroupcols) {
+    group_offsets.push_back(static_cast<int32_t>(nrows));
+    result.second = Groupby(ngroups, group_offsets.to_buffer());
+  }
+  return result;
+}
+
+
+RiGb group_external(const std::vector<Column>& columns,
+                    const std::vector<SortFlag>& flags,
+                    size_t run_size)
+{
+  xassert(!columns.empty());
+  xassert(run_size > 0 && run_size <= MAX_RUN_SIZE);
+  size_t nrows = columns[0].nrows();
+  size_t nruns = (nrows + run_size - 1) / run_size;
+  SortKey key(columns, flags);
+
+  // Groups are not needed within the runs: they are recomputed during
+  // the merge.
+  std::vector<SortFlag> run_flags;
+  for (SortFlag flag : flags) {
+    run_flags.push_back(flag | SortFlag::SORT_ONLY);
+  }
+  std::vector<SortedRun> runs;
+  runs.reserve(nruns);
+  for (size_t r = 0; r < nruns; ++r) {
+    size_t start = r * run_size;
+    size_t size = std::min(run_size, nrows - start);
+    runs.push_back(sort_run(columns, run_flags, key, start, size));
+  }
+
+  if (nrows <= MAX_RUN_SIZE) {
+    return merge_runs<int32_t>(key, flags, runs, nrows);
+  } else {
+    return merge_runs<int64_t>(key, flags, runs, nrows);
+  }
+}
@@ -0,0 +1,576 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+// Hash-based grouping.
+//
+// Function `group_hashed()` produces exactly the same result as `group()`
+// (for the case when no columns are SORT_ONLY), but instead of radix-sorting
+// all rows of the frame, it proceeds as follows:
+//
+//   1. The rows are split into contiguous chunks, one per thread. Each
+//      thread assigns a local group id to every row in its chunk, using a
+//      thread-local hash table. The "representative" of each group is the
+//      first row where the group was encountered.
+//
+//   2. The thread-local tables are merged into a global table. The global
+//      table is split into partitions by the high bits of the hash, and the
+//      partitions are filled in parallel. Since within each partition the
+//      chunks are merged in order, the representative of each global group
+//      is the first row of that group in the frame.
+//
+//   3. The representative rows (one per group) are sorted with the regular
+//      `group()` function, which determines the order of the groups.
+//
+//   4. Finally, each row is scattered into its position in the output
+//      ordering. Within each group the rows retain their original order,
+//      which makes the result identical to the stable radix sort.
+//
+// Thus, the sort is only performed on the unique values of the key, and
+// the rest of the work is linear in the number of rows. This is beneficial
+// when the number of groups is considerably smaller than the number of
+// rows. Whether this is the case is estimated up front from a sample of
+// rows; if the estimate turns out to be wrong (which may happen when the
+// distribution of values is very skewed), then the hashing stage is
+// aborted early. In both cases the caller should fall back to the regular
+// `group()`.
+//------------------------------------------------------------------------------
+#include <algorithm>  // std::min, std::max
+#include <atomic>     // std::atomic
+#include <cmath>      // std::isnan
+#include <cstring>    // std::memcmp, std::memcpy
+#include <memory>     // std::unique_ptr
+#include <vector>     // std::vector
+#include "models/murmurhash.h"
+#include "parallel/api.h"
+#include "python/arg.h"
+#include "python/int.h"
+#include "utils/assert.h"
+#include "utils/misc.h"
+#include "buffer.h"
+#include "column.h"
+#include "cstring.h"
+#include "groupby.h"
+#include "options.h"
+#include "rowindex.h"
+#include "sort.h"
+#include "stats.h"
+#include "stype.h"
+
+
+static const char* doc_sort_hash_groupby_threshold =
+R"(
+Internal
+)";
+
+// Minimum number of rows in a frame for the hash-based grouping to be
+// attempted.
+static size_t sort_hash_groupby_threshold = 1 << 16;
+
+void sort_hash_init_options() {
+  dt::register_option(
+    "sort.hash_groupby_threshold",
+    []{ return py::oint(sort_hash_groupby_threshold); },
+    [](const py::Arg& value) {
+      int64_t n = value.to_int64_strict();
+      if (n < 0) n = 0;
+      sort_hash_groupby_threshold = static_cast<size_t>(n);
+    },
+    doc_sort_hash_groupby_threshold
+  );
+}
+
+// Number of rows whose hashes are computed at once.
+static constexpr size_t BLOCK_SIZE = 1024;
+
+// The hash-based grouping is not attempted if the estimated number of
+// groups exceeds `nrows / MAX_GROUPS_RATIO`. The hashing stage is aborted
+// if the number of groups within a chunk exceeds
+// `chunk_size / MAX_GROUPS_RATIO`.
+static constexpr size_t MAX_GROUPS_RATIO = 16;
+
+// Number of rows sampled in order to estimate the number of groups.
+static constexpr size_t SAMPLE_SIZE = 4096;
+
+// Integer keys whose combined range of values fits into this many bits are
+// radix-sorted in just one or two passes, which is faster than hashing.
+static constexpr int MAX_RADIX_KEY_BITS = 32;
+
+static constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+static constexpr uint64_t NA_STRING_HASH = 0x5BD1E9955BD1E995ULL;
+
+
+
+
+//------------------------------------------------------------------------------
+// Column hashers
+//------------------------------------------------------------------------------
+
+/**
+ * Helper class that computes hashes of the values in a single column, and
+ * compares the values in two rows of the column for equality. Two values
+ * are considered equal if and only if they would be placed into the same
+ * group by the `group()` function. In particular, all NAs are equal to
+ * each other, whereas 0.0 and -0.0 are distinct.
+ */
+class ColumnHasher {
+  public:
+    virtual ~ColumnHasher() = default;
+
+    // Combine the hashes of rows `[i0; i0 + n)` into `hashes[0..n-1]`
+    virtual void hash(size_t i0, size_t n, uint64_t* hashes) const = 0;
+    virtual bool equal(size_t i, size_t j) const = 0;
+};
+
+using hasherptr = std::unique_ptr<ColumnHasher>;
+
+
+
+template <typename T>
+class FwColumnHasher : public ColumnHasher {
+  private:
+    Column column_;
+    const T* data_;
+
+  public:
+    explicit FwColumnHasher(const Column& col)
+      : column_(col)
+    {
+      column_.materialize();
+      data_ = static_cast<const T*>(column_.get_data_readonly());
+    }
+
+    void hash(size_t i0, size_t n, uint64_t* hashes) const override {
+      const T* data = data_ + i0;
+      for (size_t k = 0; k < n; ++k) {
+        hashes[k] = (hashes[k] ^ fmix64(_key(data[k]))) * HASH_MULTIPLIER;
+      }
+    }
+
+    bool equal(size_t i, size_t j) const override {
+      return _key(data_[i]) == _key(data_[j]);
+    }
+
+  private:
+    static uint64_t _key(T value) {
+      return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+};
+
+template <>
+uint64_t FwColumnHasher<float>::_key(float value) {
+  if (std::isnan(value)) return uint64_t(-1);
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(float));
+  return bits;
+}
+
+template <>
+uint64_t FwColumnHasher<double>::_key(double value) {
+  if (std::isnan(value)) return uint64_t(-1);  // not a valid double bitmask
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(double));
+  return bits;
+}
+
+
+
+class StringColumnHasher : public ColumnHasher {
+  private:
+    Column column_;
+
+  public:
+    explicit StringColumnHasher(const Column& col)
+      : column_(col) {}
+
+    void hash(size_t i0, size_t n, uint64_t* hashes) const override {
+      dt::CString value;
+      for (size_t k = 0; k < n; ++k) {
+        bool valid = column_.get_element(i0 + k, &value);
+        uint64_t h = valid? hash_murmur2(value.data(), value.size())
+                          : NA_STRING_HASH;
+        hashes[k] = (hashes[k] ^ h) * HASH_MULTIPLIER;
+      }
+    }
+
+    bool equal(size_t i, size_t j) const override {
+      dt::CString vi, vj;
+      bool valid_i = column_.get_element(i, &vi);
+      bool valid_j = column_.get_element(j, &vj);
+      if (!valid_i || !valid_j) return valid_i == valid_j;
+      return vi.size() == vj.size() &&
+             (vi.size() == 0 ||
+              std::memcmp(vi.data(), vj.data(), vi.size()) == 0);
+    }
+};
+
+
+// Number of significant bits in an integer column, as computed by the
+// radix sort, or -1 if the column is not integer.
+static int _integer_key_bits(const Column& col) {
+  switch (col.stype()) {
+    case dt::SType::BOOL: return 2;
+    case dt::SType::INT8:
+    case dt::SType::INT16:
+    case dt::SType::INT32:
+    case dt::SType::INT64: {
+      bool valid;
+      int64_t min = col.stats()->min_int(&valid);
+      int64_t max = col.stats()->max_int(&valid);
+      if (!valid) return 1;  // all values are NA
+      // The difference is computed in unsigned arithmetic, since
+      // `max - min` may overflow int64 for wide ranges
+      uint64_t span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+      if (span == UINT64_MAX) return 64;  // full range: `span + 1` wraps to 0
+      return 64 - static_cast<int>(dt::nlz(span + 1));
+    }
+    default: return -1;
+  }
+}
+
+
+// Returns nullptr if the column cannot be hashed
+static hasherptr _make_hasher(const Column& col) {
+  switch (col.stype()) {
+    case dt::SType::BOOL:
+    case dt::SType::INT8:    return hasherptr(new FwColumnHasher<int8_t>(col));
+    case dt::SType::INT16:   return hasherptr(new FwColumnHasher<int16_t>(col));
+    case dt::SType::INT32:   return hasherptr(new FwColumnHasher<int32_t>(col));
+    case dt::SType::INT64:   return hasherptr(new FwColumnHasher<int64_t>(col));
+    case dt::SType::FLOAT32: return hasherptr(new FwColumnHasher<float>(col));
+    case dt::SType::FLOAT64: return hasherptr(new FwColumnHasher<double>(col));
+    case dt::SType::STR32:
+    case dt::SType::STR64:   return hasherptr(new StringColumnHasher(col));
+    default:                 return nullptr;
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// GroupTable
+//------------------------------------------------------------------------------
+
+/**
+ * Open-addressing hash table that maps rows of a frame into group ids.
+ * Groups are numbered consecutively in the order in which they were
+ * added into the table. For each group we store its hash, the first
+ * row where it was encountered (the group's representative), and the
+ * number of rows in the group.
+ */
+class GroupTable {
+  private:
+    const std::vector<hasherptr>& hashers_;
+    std::vector<int32_t> slots_;  // group id, or -1 if the slot is empty
+    size_t mask_;
+
+  public:
+    std::vector<uint64_t> hashes;
+    std::vector<int32_t> rows;
+    std::vector<int32_t> counts;
+
+    explicit GroupTable(const std::vector<hasherptr>& hashers)
+      : hashers_(hashers),
+        slots_(1024, -1),
+        mask_(1023) {}
+
+    size_t size() const noexcept {
+      return rows.size();
+    }
+
+    // Find the group of `row` whose hash is `h`, inserting a new group if
+    // necessary. Returns the id of the group.
+    int32_t find_or_insert(uint64_t h, size_t row) {
+      size_t islot = _slot(h);
+      while (true) {
+        int32_t g = slots_[islot];
+        if (g < 0) break;
+        size_t ig = static_cast<size_t>(g);
+        if (hashes[ig] == h && _rows_equal(row, static_cast<size_t>(rows[ig]))) {
+          return g;
+        }
+        islot = (islot + 1) & mask_;
+      }
+      int32_t g = static_cast<int32_t>(rows.size());
+      slots_[islot] = g;
+      hashes.push_back(h);
+      rows.push_back(static_cast<int32_t>(row));
+      counts.push_back(0);
+      if (2 * rows.size() > slots_.size()) _rehash();
+      return g;
+    }
+
+  private:
+    size_t _slot(uint64_t h) const noexcept {
+      return static_cast<size_t>(h ^ (h >> 29)) & mask_;
+    }
+
+    bool _rows_equal(size_t i, size_t j) const {
+      for (const auto& hasher : hashers_) {
+        if (!hasher->equal(i, j)) return false;
+      }
+      return true;
+    }
+
+    void _rehash() {
+      size_t n = 2 * slots_.size();
+      slots_.assign(n, -1);
+      mask_ = n - 1;
+      for (size_t g = 0; g < hashes.size(); ++g) {
+        size_t islot = _slot(hashes[g]);
+        while (slots_[islot] >= 0) islot = (islot + 1) & mask_;
+        slots_[islot] = static_cast<int32_t>(g);
+      }
+    }
+};
+
+
+
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+// Estimate from a sample of rows whether the number of groups is at most
+// `nrows / MAX_GROUPS_RATIO`. If there are `D` groups of equal size, then
+// a sample of `s` rows contains about `s(s-1)/(2D)` pairs of rows that
+// belong to the same group, which gives the estimate of `D`. For skewed
+// distributions the number of groups is underestimated, and the check in
+// the hashing stage is then the last line of defense.
+static bool _few_groups_expected(const std::vector<hasherptr>& hashers,
+                                 size_t nrows)
+{
+  if (nrows <= SAMPLE_SIZE) return true;
+  GroupTable table(hashers);
+  for (size_t k = 0; k < SAMPLE_SIZE; ++k) {
+    size_t row = k * nrows / SAMPLE_SIZE;
+    uint64_t h = 0;
+    for (const auto& hasher : hashers) {
+      hasher->hash(row, 1, &h);
+    }
+    table.counts[static_cast<size_t>(table.find_or_insert(h, row))]++;
+  }
+  double npairs = 0;
+  for (int32_t c : table.counts) {
+    npairs += 0.5 * c * (c - 1);
+  }
+  double s = static_cast<double>(SAMPLE_SIZE);
+  return 2.0 * npairs * static_cast<double>(nrows)
+         >= s * (s - 1) * static_cast<double>(MAX_GROUPS_RATIO);
+}
+
+
+bool group_hashed(const std::vector<Column>& columns_in,
+                  const std::vector<SortFlag>& flags, RiGb* out)
+{
+  xassert(!columns_in.empty());
+  xassert(columns_in.size() == flags.size());
+  size_t nrows = columns_in[0].nrows();
+  if (nrows < 2 || nrows < sort_hash_groupby_threshold) return false;
+  if (nrows > static_cast<size_t>(INT32_MAX)) return false;
+  // Frames that do not fit into the sorting memory limit are grouped
+  // by the external sort instead.
+  if (nrows > sort_max_rows_in_memory(columns_in)) return false;
+  for (SortFlag flag : flags) {
+    if (flag & SortFlag::SORT_ONLY) return false;
+  }
+  std::vector<Column> columns;
+  columns.reserve(columns_in.size());
+  for (const Column& col : columns_in) {
+    columns.push_back(col.unwrap_categorical_codes());
+  }
+  int total_bits = 0;
+  for (const Column& col : columns) {
+    int bits = _integer_key_bits(col);
+    if (bits < 0) { total_bits = -1; break; }
+    total_bits += bits;
+  }
+  if (total_bits >= 0 && total_bits <= MAX_RADIX_KEY_BITS) return false;
+
+  std::vector<hasherptr> hashers;
+  for (const Column& col : columns) {
+    hashers.push_back(_make_hasher(col));
+    if (!hashers.back()) return false;
+  }
+  if (!_few_groups_expected(hashers, nrows)) return false;
+
+  // Stage 1: thread-local hash tables
+  size_t nchunks = std::min(dt::num_threads_in_pool(),
+                            std::max(nrows / (4 * BLOCK_SIZE), size_t(1)));
+  std::vector<GroupTable> tables(nchunks, GroupTable(hashers));
+  Buffer gids_buf = Buffer::mem(nrows * sizeof(int32_t));
+  int32_t* gids = static_cast<int32_t*>(gids_buf.xptr());
+  std::atomic<bool> aborted { false };
+
+  dt::parallel_region(dt::NThreads(nchunks),
+    [&] {
+      size_t ith = dt::this_thread_index();
+      size_t nth = dt::num_threads_in_team();
+      for (size_t ichunk = ith; ichunk < nchunks; ichunk += nth) {
+        size_t i0 = nrows * ichunk / nchunks;
+        size_t i1 = nrows * (ichunk + 1) / nchunks;
+        size_t max_groups = std::max((i1 - i0) / MAX_GROUPS_RATIO, BLOCK_SIZE);
+        GroupTable& table = tables[ichunk];
+        uint64_t hashes[BLOCK_SIZE];
+        for (size_t b0 = i0; b0 < i1; b0 += BLOCK_SIZE) {
+          if (aborted.load(std::memory_order_relaxed)) return;
+          size_t n = std::min(BLOCK_SIZE, i1 - b0);
+          std::fill(hashes, hashes + n, 0);
+          for (const auto& hasher : hashers) {
+            hasher->hash(b0, n, hashes);
+          }
+          for (size_t k = 0; k < n; ++k) {
+            int32_t g = table.find_or_insert(hashes[k], b0 + k);
+            table.counts[static_cast<size_t>(g)]++;
+            gids[b0 + k] = g;
+          }
+          if (table.size() > max_groups) {
+            aborted.store(true, std::memory_order_relaxed);
+            return;
+          }
+        }
+      }
+    });
+  if (aborted.load()) return false;
+
+  // Stage 2: merge the thread-local tables into the global table, which
+  // consists of `nparts` partitions. First, the groups of each local table
+  // are distributed into buckets by partition: `buckets[t * nparts + p]`
+  // is the list of ids of groups in table `t` that belong to partition
+  // `p`. Then each partition merges its buckets in the order of chunks.
+  // Vector `local2global[t]` maps group ids in table `t` into the ids of
+  // the groups within their partitions.
+  size_t nparts = nchunks;
+  auto partition = [=](uint64_t h) -> size_t {
+    return static_cast<size_t>(h >> 40) % nparts;
+  };
+  std::vector<std::vector<int32_t>> buckets(nchunks * nparts);
+  std::vector<std::vector<int32_t>> local2global(nchunks);
+  dt::parallel_for_dynamic(nchunks,
+    [&](size_t t) {
+      const GroupTable& table = tables[t];
+      local2global[t].resize(table.size());
+      for (size_t l = 0; l < table.size(); ++l) {
+        size_t p = partition(table.hashes[l]);
+        buckets[t * nparts + p].push_back(static_cast<int32_t>(l));
+      }
+    });
+  std::vector<GroupTable> parts(nparts, GroupTable(hashers));
+  dt::parallel_for_dynamic(nparts,
+    [&](size_t p) {
+      GroupTable& part = parts[p];
+      for (size_t t = 0; t < nchunks; ++t) {
+        const GroupTable& table = tables[t];
+        auto& mapping = local2global[t];
+        for (int32_t l : buckets[t * nparts + p]) {
+          size_t il = static_cast<size_t>(l);
+          int32_t g = part.find_or_insert(table.hashes[il],
+                                          static_cast<size_t>(table.rows[il]));
+          part.counts[static_cast<size_t>(g)] += table.counts[il];
+          mapping[il] = g;
+        }
+      }
+    });
+
+  // The global id of a group is its id within the partition plus the
+  // offset of the partition.
+  std::vector<size_t> part_offsets(nparts + 1);
+  part_offsets[0] = 0;
+  for (size_t p = 0; p < nparts; ++p) {
+    part_offsets[p + 1] = part_offsets[p] + parts[p].size();
+  }
+  size_t ngroups = part_offsets[nparts];
+  Buffer reps_buf = Buffer::mem(ngroups * sizeof(int32_t));
+  int32_t* reps_data = static_cast<int32_t*>(reps_buf.xptr());
+  std::vector<int32_t> counts(ngroups);
+  dt::parallel_for_dynamic(nparts,
+    [&](size_t p) {
+      const GroupTable& part = parts[p];
+      std::copy(part.rows.begin(), part.rows.end(),
+                reps_data + part_offsets[p]);
+      std::copy(part.counts.begin(), part.counts.end(),
+                counts.data() + part_offsets[p]);
+    });
+
+  // Stage 3: sort the representatives of all groups. Since the keys of
+  // different groups are distinct, the order of the representatives does
+  // not affect the result.
+  RowIndex reps(std::move(reps_buf), RowIndex::ARR32);
+  std::vector<Column> repcols;
+  repcols.reserve(columns.size());
+  for (const Column& col : columns) {
+    repcols.push_back(col);
+    repcols.back().apply_rowindex(reps);
+  }
+  RiGb repgroups = group(repcols, flags);
+  xassert(repgroups.second.size() == ngroups);
+
+  // Compute the offsets of all groups in the sorted order, and the
+  // position where each group starts in the output (`cursor`).
+  Buffer offsets_buf = Buffer::mem((ngroups + 1) * sizeof(int32_t));
+  int32_t* offsets = static_cast<int32_t*>(offsets_buf.xptr());
+  std::vector<int32_t> cursor(ngroups);
+  offsets[0] = 0;
+  for (size_t k = 0; k < ngroups; ++k) {
+    size_t g;
+    bool valid = repgroups.first.get_element(k, &g);
+    xassert(valid && g < ngroups); (void) valid;
+    cursor[g] = offsets[k];
+    offsets[k + 1] = offsets[k] + counts[g];
+  }
+  xassert(static_cast<size_t>(offsets[ngroups]) == nrows);
+
+  // Stage 4: scatter the rows into the output ordering. Each local group
+  // receives a range of positions within its global group; the ranges are
+  // assigned in the order of chunks, which preserves the original order of
+  // rows within each group. The ranges are assigned by partitions in
+  // parallel, since each global group belongs to exactly one partition.
+  dt::parallel_for_dynamic(nparts,
+    [&](size_t p) {
+      int32_t* pcursor = cursor.data() + part_offsets[p];
+      for (size_t t = 0; t < nchunks; ++t) {
+        const GroupTable& table = tables[t];
+        auto& mapping = local2global[t];
+        for (int32_t l : buckets[t * nparts + p]) {
+          size_t il = static_cast<size_t>(l);
+          size_t g = static_cast<size_t>(mapping[il]);
+          mapping[il] = pcursor[g];
+          pcursor[g] += table.counts[il];
+        }
+      }
+    });
+  Buffer order_buf = Buffer::mem(nrows * sizeof(int32_t));
+  int32_t* order = static_cast<int32_t*>(order_buf.xptr());
+  dt::parallel_for_dynamic(nchunks,
+    [&](size_t t) {
+      size_t i0 = nrows * t / nchunks;
+      size_t i1 = nrows * (t + 1) / nchunks;
+      auto& positions = local2global[t];
+      for (size_t i = i0; i < i1; ++i) {
+        size_t l = static_cast<size_t>(gids[i]);
+        order[positions[l]++] = static_cast<int32_t>(i);
+      }
+    });
+
+  out->first = RowIndex(std::move(order_buf), RowIndex::ARR32);
+  out->second = Groupby(ngroups, std::move(offsets_buf));
+  return true;
+}
@@ -145,41 +145,77 @@ void insert_sort_keys(const T* x, V* o, V* tmp, int n, GroupGatherer& gg)
 // Insertion sort of string arrays
 //==============================================================================
 
-// For the string sorting procedure `insert_sort_?_str` the argument `x` is
-// replaced with a triple `strdata`, `stroffs`, `strstart`. The first is a
-// pointer to a memory buffer containing the string data. The `stroffs` is an
-// array of offsets within `strdata` (each `stroffs[i]` gives the end of
-// string `i`; the beginning of the first string is at offset `stroffs[-1]`).
-// Finally, parameter `strstart` instructs to compare the strings starting from
-// that byte.
+// For the string sorting procedures `insert_sort_?_str` the array `x` contains
+// the sort keys of the strings in `column` (see `string_key()` in "sort.cc").
+// Each key encodes several characters of a string, so the strings are compared
+// by their keys first. Only when two keys are equal, the strings themselves
+// are looked up in the `column` and compared starting from byte `strstart`
+// (i.e. the first byte that is not included in the key).
+//
+// The array `rows`, if given, maps the indices of elements in `x` into the row
+// numbers within `column`. If `rows` is nullptr, the identity mapping is
+// assumed.
 //
 template <typename V>
-void insert_sort_keys_str(
-    const Column& column, size_t strstart, V* o, V* tmp, int n,
-    GroupGatherer& gg, bool descending)
+static void _insert_sort_str(
+    const Column& column, size_t strstart, const uint64_t* x, const V* rows,
+    V* o, int n, GroupGatherer& gg, bool descending)
 {
-  dt::CString i_value, k_value;
-  bool i_valid, k_valid;
   auto compfn = descending? compare_strings<-1> : compare_strings<1>;
-  int j;
-  tmp[0] = 0;
+  auto row = [&](V i) -> size_t {
+    return static_cast<size_t>(rows? rows[i] : i);
+  };
+  dt::CString i_value, k_value;
+  bool i_valid = false, k_valid;
+  o[0] = 0;
   for (int i = 1; i < n; ++i) {
-    i_valid = column.get_element(static_cast<size_t>(o[i]), &i_value);
-    for (j = i; j > 0; --j) {
-      auto k = tmp[j - 1];
-      k_valid = column.get_element(static_cast<size_t>(o[k]), &k_value);
-      int cmp = compfn(i_value, i_valid, k_value, k_valid, strstart);
-      if (cmp != 1) break;
-      tmp[j] = tmp[j-1];
+    uint64_t xival = x[i];
+    bool i_fetched = false;
+    int j = i;
+    for (; j > 0; --j) {
+      auto k = o[j - 1];
+      if (xival > x[k]) break;
+      if (xival == x[k]) {
+        if (!i_fetched) {
+          i_valid = column.get_element(row(static_cast<V>(i)), &i_value);
+          i_fetched = true;
+        }
+        k_valid = column.get_element(row(k), &k_value);
+        int cmp = compfn(i_value, i_valid, k_value, k_valid, strstart);
+        if (cmp != 1) break;
+      }
+      o[j] = o[j - 1];
+    }
+    o[j] = static_cast<V>(i);
+  }
+  if (gg) {
+    int last = 0;
+    for (int i = 1; i < n; ++i) {
+      bool same = (x[o[i]] == x[o[last]]);
+      if (same) {
+        i_valid = column.get_element(row(o[i]), &i_value);
+        k_valid = column.get_element(row(o[last]), &k_value);
+        same = !compfn(i_value, i_valid, k_value, k_valid, strstart);
+      }
+      if (!same) {
+        gg.push(static_cast<size_t>(i - last));
+        last = i;
+      }
     }
-    tmp[j] = static_cast<V>(i);
+    gg.push(static_cast<size_t>(n - last));
   }
+}
+
+
+template <typename V>
+void insert_sort_keys_str(
+    const Column& column, size_t strstart, const uint64_t* x, V* o, V* tmp,
+    int n, GroupGatherer& gg, bool descending)
+{
+  _insert_sort_str<V>(column, strstart, x, o, tmp, n, gg, descending);
   for (int i = 0; i < n; ++i) {
     tmp[i] = o[tmp[i]];
   }
-  if (gg) {
-    gg.from_data(column, tmp, static_cast<size_t>(n));
-  }
   xassert(o);
   std::memcpy(o, tmp, static_cast<size_t>(n) * sizeof(V));
 }
@@ -187,28 +223,10 @@ void insert_sort_keys_str(
 
 template <typename V>
 void insert_sort_values_str(
-    const Column& column, size_t strstart, V* o, int n,
+    const Column& column, size_t strstart, const uint64_t* x, V* o, int n,
     GroupGatherer& gg, bool descending)
 {
-  dt::CString i_value, k_value;
-  bool i_valid, k_valid;
-  auto compfn = descending? compare_strings<-1> : compare_strings<1>;
-  int j;
-  o[0] = 0;
-  for (int i = 1; i < n; ++i) {
-    i_valid = column.get_element(static_cast<size_t>(i), &i_value);
-    for (j = i; j > 0; j--) {
-      auto k = o[j - 1];
-      k_valid = column.get_element(static_cast<size_t>(k), &k_value);
-      int cmp = compfn(i_value, i_valid, k_value, k_valid, strstart);
-      if (cmp != 1) break;
-      o[j] = o[j-1];
-    }
-    o[j] = static_cast<V>(i);
-  }
-  if (gg) {
-    gg.from_data(column, o, static_cast<size_t>(n));
-  }
+  _insert_sort_str<V>(column, strstart, x, nullptr, o, n, gg, descending);
 }
 
 
@@ -227,8 +245,8 @@ template void insert_sort_values(const uint16_t*, int32_t*, int, GroupGatherer&)
 template void insert_sort_values(const uint32_t*, int32_t*, int, GroupGatherer&);
 template void insert_sort_values(const uint64_t*, int32_t*, int, GroupGatherer&);
 
-template void insert_sort_keys_str(const Column&, size_t, int32_t*, int32_t*, int, GroupGatherer&, bool);
-template void insert_sort_values_str(const Column&, size_t, int32_t*, int, GroupGatherer&, bool);
+template void insert_sort_keys_str(const Column&, size_t, const uint64_t*, int32_t*, int32_t*, int, GroupGatherer&, bool);
+template void insert_sort_values_str(const Column&, size_t, const uint64_t*, int32_t*, int, GroupGatherer&, bool);
 
 template int compare_strings<1>(const dt::CString&, bool, const dt::CString&, bool, size_t);
 template int compare_strings<-1>(const dt::CString&, bool, const dt::CString&, bool, size_t);
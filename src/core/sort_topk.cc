@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+// Copyright 2021 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+// Top-k sorting.
+//
+// Queries such as `DT[:k, :, sort(f.A)]` ("k smallest rows") or
+// `DT[:k, :, by(f.G), sort(-f.T)]` ("k most recent rows per group") only
+// need the first `k` rows of each group in sorted order. Function
+// `group_topk()` produces exactly these rows, without sorting the rest
+// of the data:
+//
+//   - Without `by()`, the rows are split into chunks, one per thread.
+//     Each thread selects the `k` smallest rows of its chunk using a
+//     bounded max-heap, so that only O(k) extra memory per thread is
+//     needed. The candidates from all threads are then sorted, and the
+//     first `k` of them are returned.
+//
+//   - With `by()`, the rows are first grouped by the `by()` columns only
+//     (using the hash-based grouping when possible), and then the first
+//     `k` rows of each group are selected with the same bounded-heap
+//     procedure, processing the groups in parallel.
+//
+// The rows are compared with `dt::sort::RowComparator`, and ties are
+// broken by the row index, so that the result is identical to that of
+// the stable radix sort in `group()`.
+//------------------------------------------------------------------------------
+#include <algorithm>  // std::sort, std::make_heap, std::push_heap, std::min
+#include <cstring>    // std::memcpy
+#include <vector>     // std::vector
+#include "parallel/api.h"
+#include "sort/row_comparator.h"
+#include "utils/assert.h"
+#include "buffer.h"
+#include "column.h"
+#include "groupby.h"
+#include "rowindex.h"
+#include "sort.h"
+#include "stype.h"
+
+
+// Top-k selection is only used when the number of selected rows is
+// sufficiently smaller than the total number of rows; otherwise the
+// regular radix sort is faster.
+static constexpr size_t TOPK_RATIO = 16;
+
+
+static bool _can_compare(const Column& col) {
+  switch (col.stype()) {
+    case dt::SType::BOOL:
+    case dt::SType::INT8:
+    case dt::SType::INT16:
+    case dt::SType::INT32:
+    case dt::SType::INT64:
+    case dt::SType::FLOAT32:
+    case dt::SType::FLOAT64:
+    case dt::SType::STR32:
+    case dt::SType::STR64: return true;
+    default: return false;
+  }
+}
+
+
+/**
+  * Bounded max-heap that keeps the `k` smallest of the rows pushed into
+  * it (according to comparator `less`), using the externally provided
+  * storage `data` for `k` elements. After all rows were pushed, method
+  * `finish()` sorts the selected rows and returns their count.
+  */
+template <typename Less>
+class TopkHeap {
+  private:
+    int32_t* data_;
+    size_t k_;
+    size_t n_;
+    Less less_;
+
+  public:
+    TopkHeap(int32_t* data, size_t k, Less less)
+      : data_(data), k_(k), n_(0), less_(less) {}
+
+    void push(int32_t row) {
+      if (n_ < k_) {
+        data_[n_++] = row;
+        if (n_ == k_) std::make_heap(data_, data_ + k_, less_);
+      }
+      else if (less_(row, data_[0])) {
+        // `data_[0]` is the largest of the rows selected so far
+        std::pop_heap(data_, data_ + k_, less_);
+        data_[k_ - 1] = row;
+        std::push_heap(data_, data_ + k_, less_);
+      }
+    }
+
+    size_t finish() {
+      if (n_ < k_) std::sort(data_, data_ + n_, less_);
+      else         std::sort_heap(data_, data_ + k_, less_);
+      return n_;
+    }
+};
+
+template <typename Less>
+static TopkHeap<Less> make_topk_heap(int32_t* data, size_t k, Less less) {
+  return TopkHeap<Less>(data, k, less);
+}
+
+
+
+bool group_topk(const std::vector<Column>& columns_in,
+                const std::vector<SortFlag>& flags,
+                size_t ngroupcols, size_t k, RiGb* out)
+{
+  xassert(columns_in.size() == flags.size());
+  xassert(ngroupcols < columns_in.size());
+  size_t nrows = columns_in[0].nrows();
+  if (k == 0 || nrows < 2) return false;
+  if (nrows > static_cast<size_t>(INT32_MAX)) return false;
+  if (k > nrows / TOPK_RATIO) return false;
+
+  std::vector<Column> group_columns, sort_columns;
+  std::vector<SortFlag> group_flags, sort_flags;
+  for (size_t i = 0; i < columns_in.size(); ++i) {
+    Column col = columns_in[i].unwrap_categorical_codes();
+    if (!_can_compare(col)) return false;
+    if (i < ngroupcols) {
+      group_columns.push_back(std::move(col));
+      group_flags.push_back(flags[i]);
+    } else {
+      sort_columns.push_back(std::move(col));
+      sort_flags.push_back(flags[i]);
+    }
+  }
+  dt::sort::RowComparator comparator(sort_columns, sort_flags);
+  auto less = [&](int32_t a, int32_t b) {
+    int cmp = comparator.compare(static_cast<size_t>(a), static_cast<size_t>(b));
+    return cmp? (cmp < 0) : (a < b);
+  };
+
+  if (ngroupcols == 0) {
+    // Each chunk contains at least `k` rows
+    size_t nchunks = std::min(dt::num_threads_in_pool(), nrows / k);
+    std::vector<int32_t> candidates(nchunks * k);
+    dt::parallel_for_dynamic(nchunks,
+      [&](size_t c) {
+        size_t row0 = c * nrows / nchunks;
+        size_t row1 = (c + 1) * nrows / nchunks;
+        auto heap = make_topk_heap(candidates.data() + c * k, k, less);
+        for (size_t i = row0; i < row1; ++i) {
+          heap.push(static_cast<int32_t>(i));
+        }
+        size_t nselected = heap.finish();
+        xassert(nselected == k);  (void) nselected;
+      });
+
+    // Since the candidates from each chunk are already sorted, the final
+    // ordering could also be obtained via a k-way merge; however, the
+    // number of candidates is small, so a regular sort is good enough.
+    std::sort(candidates.begin(), candidates.end(), less);
+    Buffer ribuf = Buffer::mem(k * sizeof(int32_t));
+    std::memcpy(ribuf.xptr(), candidates.data(), k * sizeof(int32_t));
+    out->first = RowIndex(std::move(ribuf), RowIndex::ARR32);
+    out->second = Groupby::single_group(k);
+    return true;
+  }
+
+  // Group by the `by()` columns only
+  RiGb grouping;
+  if (!group_hashed(group_columns, group_flags, &grouping)) {
+    grouping = group(group_columns, group_flags);
+  }
+  const Groupby& gb = grouping.second;
+  size_t ngroups = gb.size();
+  const int32_t* offsets = gb.offsets_r();
+  xassert(grouping.first.type() == RowIndexType::ARR32);
+  const int32_t* rows = grouping.first.indices32();
+
+  Buffer out_offsets = Buffer::mem((ngroups + 1) * sizeof(int32_t));
+  int32_t* new_offsets = static_cast<int32_t*>(out_offsets.xptr());
+  new_offsets[0] = 0;
+  for (size_t g = 0; g < ngroups; ++g) {
+    size_t size = static_cast<size_t>(offsets[g + 1] - offsets[g]);
+    new_offsets[g + 1] = new_offsets[g] + static_cast<int32_t>(std::min(size, k));
+  }
+  size_t nout = static_cast<size_t>(new_offsets[ngroups]);
+  Buffer ribuf = Buffer::mem(nout * sizeof(int32_t));
+  int32_t* out_rows = static_cast<int32_t*>(ribuf.xptr());
+
+  // Within each group produced by the stable grouping the rows are in
+  // increasing order, so that the ties are resolved in the same way as
+  // in the stable sort.
+  dt::parallel_for_dynamic(ngroups,
+    [&](size_t g) {
+      int32_t* dest = out_rows + new_offsets[g];
+      size_t nselect = static_cast<size_t>(new_offsets[g + 1] - new_offsets[g]);
+      auto heap = make_topk_heap(dest, nselect, less);
+      for (int32_t i = offsets[g]; i < offsets[g + 1]; ++i) {
+        heap.push(rows[i]);
+      }
+      heap.finish();
+    });
+
+  out->first = RowIndex(std::move(ribuf), RowIndex::ARR32);
+  out->second = Groupby(ngroups, std::move(out_offsets));
+  return true;
+}
@@ -19,9 +19,10 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>    // std::min
 #include <errno.h>      // errno
 #include <fcntl.h>      // open, posix_fallocate[?]
-#include <stdio.h>      // remove
+#include <stdio.h>      // remove, rename
 #include <string.h>     // strerror
 #include <sys/stat.h>   // fstat
 #include "utils/file.h"
@@ -32,9 +33,13 @@
   #include <Windows.h>
   #include <io.h>               // close, write, _chsize
   #define FTRUNCATE _chsize
+  #define LSEEK _lseeki64
+  #define WRITE _write
 #else
   #include <unistd.h>           // access, close, write, ftruncate
   #define FTRUNCATE ftruncate
+  #define LSEEK lseek
+  #define WRITE write
 #endif
 
 
@@ -155,6 +160,27 @@ void File::resize(size_t newsize) {
 }
 
 
+// Write `n` bytes from `src` into the file at position `pos`. The file
+// is extended if necessary.
+void File::write_at(size_t pos, const void* src, size_t n) {
+  if (LSEEK(fd, static_cast<off_t>(pos), SEEK_SET) == -1) {
+    throw IOError() << "Unable to seek to position " << pos << " in file "
+                    << name << ": " << Errno;
+  }
+  auto ptr = static_cast<const char*>(src);
+  while (n) {
+    size_t chunk = std::min(n, size_t(1) << 30);
+    auto r = WRITE(fd, ptr, static_cast<unsigned int>(chunk));
+    if (r <= 0) {
+      throw IOError() << "Cannot write to file " << name << ": " << Errno;
+    }
+    ptr += r;
+    n -= static_cast<size_t>(r);
+  }
+  statbuf.st_size = -1;  // force reload stats on next request
+}
+
+
 void File::assert_is_not_dir() const {
   load_stats();
   #if DT_OS_WINDOWS
@@ -190,6 +216,24 @@ void File::remove(const std::string& name, bool except) {
 }
 
 
+/**
+  * Rename file `from` into `to`, replacing the file `to` if it
+  * already exists.
+  */
+void File::rename(const std::string& from, const std::string& to) {
+  #if DT_OS_WINDOWS
+    bool ok = MoveFileEx(from.c_str(), to.c_str(),
+                         MOVEFILE_REPLACE_EXISTING);
+  #else
+    bool ok = (::rename(from.c_str(), to.c_str()) == 0);
+  #endif
+  if (!ok) {
+    throw IOError() << "Unable to rename file " << from << " into "
+                    << to << ": " << Errno;
+  }
+}
+
+
 bool File::exists(const std::string& name) noexcept {
   #if DT_OS_WINDOWS
     DWORD attrs = GetFileAttributes(name.c_str());
@@ -39,10 +39,12 @@ public:
   size_t size() const;
   static size_t asize(const std::string& filename);
   void resize(size_t newsize);
+  void write_at(size_t pos, const void* src, size_t n);
   void assert_is_not_dir() const;
   const char* cname() const;
 
   static void remove(const std::string& name, bool except = false);
+  static void rename(const std::string& from, const std::string& to);
 
   static bool exists(const std::string& name) noexcept;
   static bool nonempty(const std::string& name) noexcept;
@@ -0,0 +1,269 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <cstdint>            // uint8_t, uint32_t, uint64_t
+#include <cstring>            // std::memcpy
+#include <memory>             // std::unique_ptr
+#if defined(_MSC_VER)
+  #include <intrin.h>         // _BitScanForward64
+#endif
+#include "utils/exceptions.h"
+#include "utils/lz4.h"
+namespace dt {
+namespace lz4 {
+
+static constexpr size_t MIN_MATCH = 4;
+// The last 5 bytes of the input are always encoded as literals
+static constexpr size_t LAST_LITERALS = 5;
+// The last match must start at least 12 bytes before the end of input
+static constexpr size_t MF_LIMIT = 12;
+static constexpr size_t MAX_DISTANCE = 65535;
+static constexpr int HASH_LOG = 16;
+
+
+static inline uint32_t read_u32(const uint8_t* p) {
+  uint32_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+static inline uint64_t read_u64(const uint8_t* p) {
+  uint64_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+// Number of trailing zero bits in `x`, which must be non-zero
+static inline int count_trailing_zeros(uint64_t x) {
+  #if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+  #else
+    return __builtin_ctzll(x);
+  #endif
+}
+
+static inline uint32_t hash_u32(uint32_t x) {
+  return (x * 2654435761U) >> (32 - HASH_LOG);
+}
+
+static Error lz4_error() {
+  return IOError() << "Invalid LZ4 data: ";
+}
+
+
+
+//------------------------------------------------------------------------------
+// Compression
+//------------------------------------------------------------------------------
+
+// Write the variable-length extension of a literal/match length
+static inline uint8_t* write_length(uint8_t* op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = static_cast<uint8_t>(len);
+  return op;
+}
+
+
+// Length of the common prefix of `p` and `q`, not extending past `limit`
+static inline size_t match_length(const uint8_t* p, const uint8_t* q,
+                                  const uint8_t* limit)
+{
+  const uint8_t* p0 = p;
+  while (p + 8 <= limit) {
+    uint64_t diff = read_u64(p) ^ read_u64(q);
+    if (diff) {
+      return static_cast<size_t>(p - p0) +
+             static_cast<size_t>(count_trailing_zeros(diff) >> 3);
+    }
+    p += 8;
+    q += 8;
+  }
+  while (p < limit && *p == *q) {
+    p++;
+    q++;
+  }
+  return static_cast<size_t>(p - p0);
+}
+
+
+size_t compress(const void* src, size_t n, void* dst, size_t capacity) {
+  const uint8_t* const istart = static_cast<const uint8_t*>(src);
+  const uint8_t* const iend = istart + n;
+  const uint8_t* ip = istart;
+  const uint8_t* anchor = istart;
+  uint8_t* op = static_cast<uint8_t*>(dst);
+  uint8_t* const oend = op + capacity;
+
+  if (n > MF_LIMIT) {
+    std::unique_ptr<uint32_t[]> table(new uint32_t[size_t(1) << HASH_LOG]());
+    const uint8_t* const mflimit = iend - MF_LIMIT;
+    const uint8_t* const matchlimit = iend - LAST_LITERALS;
+    ip++;
+    while (ip <= mflimit) {
+      uint32_t seq = read_u32(ip);
+      uint32_t h = hash_u32(seq);
+      const uint8_t* ref = istart + table[h];
+      table[h] = static_cast<uint32_t>(ip - istart);
+      if (ref >= ip || static_cast<size_t>(ip - ref) > MAX_DISTANCE ||
+          read_u32(ref) != seq) {
+        // Skip faster over the regions where no matches are found
+        ip += 1 + (static_cast<size_t>(ip - anchor) >> 6);
+        continue;
+      }
+      // Extend the match backwards
+      while (ip > anchor && ref > istart && ip[-1] == ref[-1]) {
+        ip--;
+        ref--;
+      }
+      size_t litlen = static_cast<size_t>(ip - anchor);
+      size_t mlen = match_length(ip + MIN_MATCH, ref + MIN_MATCH, matchlimit);
+      size_t needed = 1 + litlen/255 + 1 + litlen + 2 + mlen/255 + 1;
+      if (needed > static_cast<size_t>(oend - op)) return 0;
+
+      uint8_t* token = op++;
+      if (litlen >= 15) {
+        *token = 15 << 4;
+        op = write_length(op, litlen - 15);
+      } else {
+        *token = static_cast<uint8_t>(litlen << 4);
+      }
+      std::memcpy(op, anchor, litlen);
+      op += litlen;
+      size_t distance = static_cast<size_t>(ip - ref);
+      op[0] = static_cast<uint8_t>(distance);
+      op[1] = static_cast<uint8_t>(distance >> 8);
+      op += 2;
+      if (mlen >= 15) {
+        *token |= 15;
+        op = write_length(op, mlen - 15);
+      } else {
+        *token |= static_cast<uint8_t>(mlen);
+      }
+      ip += mlen + MIN_MATCH;
+      anchor = ip;
+      // Make the position just before the end of the match findable too
+      if (ip <= mflimit) {
+        table[hash_u32(read_u32(ip - 2))] = static_cast<uint32_t>(ip - 2 - istart);
+      }
+    }
+  }
+
+  // The final sequence contains only literals
+  size_t litlen = static_cast<size_t>(iend - anchor);
+  size_t needed = 1 + (litlen >= 15? 1 + (litlen - 15)/255 : 0) + litlen;
+  if (needed > static_cast<size_t>(oend - op)) return 0;
+  if (litlen >= 15) {
+    *op++ = 15 << 4;
+    op = write_length(op, litlen - 15);
+  } else {
+    *op++ = static_cast<uint8_t>(litlen << 4);
+  }
+  std::memcpy(op, anchor, litlen);
+  op += litlen;
+  return static_cast<size_t>(op - static_cast<uint8_t*>(dst));
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Decompression
+//------------------------------------------------------------------------------
+
+// Read the variable-length extension of a literal/match length
+static inline size_t read_length(const uint8_t*& ip, const uint8_t* iend) {
+  size_t len = 0;
+  uint8_t b;
+  do {
+    if (ip == iend) throw lz4_error() << "unexpected end of input";
+    b = *ip++;
+    len += b;
+  } while (b == 255);
+  return len;
+}
+
+
+void decompress(const void* src, size_t n, void* dst, size_t dstsize) {
+  const uint8_t* ip = static_cast<const uint8_t*>(src);
+  const uint8_t* const iend = ip + n;
+  uint8_t* const ostart = static_cast<uint8_t*>(dst);
+  uint8_t* op = ostart;
+  uint8_t* const oend = ostart + dstsize;
+
+  for (;;) {
+    if (ip == iend) throw lz4_error() << "unexpected end of input";
+    size_t token = *ip++;
+
+    size_t litlen = token >> 4;
+    if (litlen == 15) litlen += read_length(ip, iend);
+    if (litlen > static_cast<size_t>(iend - ip) ||
+        litlen > static_cast<size_t>(oend - op)) {
+      throw lz4_error() << "literal run out of bounds";
+    }
+    std::memcpy(op, ip, litlen);
+    op += litlen;
+    ip += litlen;
+    if (ip == iend) break;  // the last sequence has no match part
+
+    if (iend - ip < 2) throw lz4_error() << "unexpected end of input";
+    size_t distance = static_cast<size_t>(ip[0]) |
+                      (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    if (distance == 0 || distance > static_cast<size_t>(op - ostart)) {
+      throw lz4_error() << "invalid match distance";
+    }
+    size_t mlen = token & 15;
+    if (mlen == 15) mlen += read_length(ip, iend);
+    mlen += MIN_MATCH;
+    if (mlen > static_cast<size_t>(oend - op)) {
+      throw lz4_error() << "match out of bounds";
+    }
+
+    const uint8_t* match = op - distance;
+    if (distance >= 8 && static_cast<size_t>(oend - op) >= mlen + 8) {
+      // Non-overlapping 8-byte chunks; may write up to 7 bytes past the
+      // end of the match, which will be overwritten later.
+      uint8_t* mend = op + mlen;
+      while (op < mend) {
+        std::memcpy(op, match, 8);
+        op += 8;
+        match += 8;
+      }
+      op = mend;
+    } else {
+      for (size_t i = 0; i < mlen; ++i) op[i] = match[i];
+      op += mlen;
+    }
+  }
+  if (op != oend) {
+    throw lz4_error() << "expected " << dstsize << " bytes of output, got "
+        << static_cast<size_t>(op - ostart);
+  }
+}
+
+
+
+}}  // namespace dt::lz4
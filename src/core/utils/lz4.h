@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_UTILS_LZ4_h
+#define dt_UTILS_LZ4_h
+#include <cstddef>      // size_t
+namespace dt {
+namespace lz4 {
+
+
+/**
+  * Simple LZ4 codec for compressing individual blocks of data. The
+  * compressed data follows the LZ4 "block format" (i.e. without the
+  * frame headers), and thus can be read by other LZ4 decoders. The
+  * compression is greedy with a single-entry hash table, which is the
+  * same trade-off as LZ4's "fast" mode: the compression ratio is
+  * modest, but both compression and especially decompression are
+  * very fast.
+  *
+  * compress(src, n, dst, capacity)
+  *   Compress `n` bytes at `src` into the buffer `dst` of size
+  *   `capacity`. Returns the size of the compressed data, or 0 if
+  *   the compressed data would not fit into `capacity` bytes. Thus,
+  *   passing `capacity = n` allows the caller to detect the blocks
+  *   that are not compressible and store them as-is.
+  *
+  * decompress(src, n, dst, dstsize)
+  *   Decompress `n` bytes of compressed data at `src` into the buffer
+  *   `dst`. The size of the uncompressed data must be exactly
+  *   `dstsize`, otherwise an IOError is thrown. The input is fully
+  *   validated, so malformed data results in an exception too.
+  */
+size_t compress(const void* src, size_t n, void* dst, size_t capacity);
+
+void decompress(const void* src, size_t n, void* dst, size_t dstsize);
+
+
+
+}}  // namespace dt::lz4
+#endif
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>          // std::min
+#include <cstdint>            // uint8_t, uint32_t, uint64_t
+#include <cstring>            // std::memcpy
+#include <memory>             // std::unique_ptr
+#include "utils/exceptions.h"
+#include "utils/snappy.h"
+namespace dt {
+namespace snappy {
+
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t MAX_COPY_LENGTH = 64;
+static constexpr size_t MAX_DISTANCE = 65535;
+static constexpr int HASH_LOG = 14;
+
+static constexpr uint8_t TAG_LITERAL = 0;
+static constexpr uint8_t TAG_COPY1 = 1;
+static constexpr uint8_t TAG_COPY2 = 2;
+static constexpr uint8_t TAG_COPY4 = 3;
+
+
+static inline uint32_t read_u32(const uint8_t* p) {
+  uint32_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+static inline uint32_t hash_u32(uint32_t x) {
+  return (x * 0x1E35A7BDU) >> (32 - HASH_LOG);
+}
+
+static Error snappy_error() {
+  return IOError() << "Invalid Snappy data: ";
+}
+
+
+
+//------------------------------------------------------------------------------
+// Compression
+//------------------------------------------------------------------------------
+
+size_t max_compressed_size(size_t n) {
+  return 32 + n + n/6;
+}
+
+
+static inline uint8_t* write_literal(uint8_t* op, const uint8_t* src,
+                                     size_t len)
+{
+  size_t n = len - 1;
+  if (n < 60) {
+    *op++ = static_cast<uint8_t>(n << 2) | TAG_LITERAL;
+  } else {
+    uint8_t* tag = op++;
+    int nbytes = 0;
+    while (n) {
+      *op++ = static_cast<uint8_t>(n);
+      n >>= 8;
+      nbytes++;
+    }
+    *tag = static_cast<uint8_t>((59 + nbytes) << 2) | TAG_LITERAL;
+  }
+  std::memcpy(op, src, len);
+  return op + len;
+}
+
+
+static inline uint8_t* write_copy(uint8_t* op, size_t distance, size_t len) {
+  while (len > 0) {
+    // Avoid leaving a tail shorter than 4 bytes, which could not be
+    // encoded with the 1-byte-offset copy form
+    size_t n = (len > MAX_COPY_LENGTH && len < MAX_COPY_LENGTH + 4)
+               ? MAX_COPY_LENGTH - 4
+               : std::min(len, MAX_COPY_LENGTH);
+    if (n >= 4 && n < 12 && distance < 2048) {
+      *op++ = static_cast<uint8_t>(((distance >> 8) << 5) | ((n - 4) << 2)) |
+              TAG_COPY1;
+      *op++ = static_cast<uint8_t>(distance);
+    } else {
+      *op++ = static_cast<uint8_t>((n - 1) << 2) | TAG_COPY2;
+      *op++ = static_cast<uint8_t>(distance);
+      *op++ = static_cast<uint8_t>(distance >> 8);
+    }
+    len -= n;
+  }
+  return op;
+}
+
+
+size_t compress(const void* src, size_t n, void* dst) {
+  const uint8_t* const istart = static_cast<const uint8_t*>(src);
+  const uint8_t* const iend = istart + n;
+  const uint8_t* ip = istart;
+  const uint8_t* anchor = istart;
+  uint8_t* op = static_cast<uint8_t*>(dst);
+
+  // Preamble: the length of the uncompressed data as a varint
+  size_t len = n;
+  while (len >= 0x80) {
+    *op++ = static_cast<uint8_t>(len) | 0x80;
+    len >>= 7;
+  }
+  *op++ = static_cast<uint8_t>(len);
+
+  if (n >= MIN_MATCH + 4) {
+    std::unique_ptr<uint32_t[]> table(new uint32_t[size_t(1) << HASH_LOG]());
+    const uint8_t* const ilimit = iend - MIN_MATCH;
+    ip++;
+    while (ip <= ilimit) {
+      uint32_t seq = read_u32(ip);
+      uint32_t h = hash_u32(seq);
+      const uint8_t* ref = istart + table[h];
+      table[h] = static_cast<uint32_t>(ip - istart);
+      if (ref >= ip || static_cast<size_t>(ip - ref) > MAX_DISTANCE ||
+          read_u32(ref) != seq) {
+        ip += 1 + (static_cast<size_t>(ip - anchor) >> 5);
+        continue;
+      }
+      if (ip > anchor) {
+        op = write_literal(op, anchor, static_cast<size_t>(ip - anchor));
+      }
+      const uint8_t* p = ip + MIN_MATCH;
+      const uint8_t* q = ref + MIN_MATCH;
+      while (p < iend && *p == *q) {
+        p++;
+        q++;
+      }
+      op = write_copy(op, static_cast<size_t>(ip - ref),
+                      static_cast<size_t>(p - ip));
+      ip = p;
+      anchor = ip;
+    }
+  }
+  if (anchor < iend) {
+    op = write_literal(op, anchor, static_cast<size_t>(iend - anchor));
+  }
+  return static_cast<size_t>(op - static_cast<uint8_t*>(dst));
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Decompression
+//------------------------------------------------------------------------------
+
+void decompress(const void* src, size_t n, void* dst, size_t dstsize) {
+  const uint8_t* ip = static_cast<const uint8_t*>(src);
+  const uint8_t* const iend = ip + n;
+  uint8_t* const ostart = static_cast<uint8_t*>(dst);
+  uint8_t* op = ostart;
+  uint8_t* const oend = ostart + dstsize;
+
+  uint64_t expected = 0;
+  for (int shift = 0; ; shift += 7) {
+    if (ip == iend || shift > 63) {
+      throw snappy_error() << "invalid length preamble";
+    }
+    uint8_t b = *ip++;
+    expected |= static_cast<uint64_t>(b & 0x7F) << shift;
+    if (!(b & 0x80)) break;
+  }
+  if (expected != dstsize) {
+    throw snappy_error() << "expected " << dstsize << " bytes of output, "
+        "but the data contains " << expected;
+  }
+
+  while (ip < iend) {
+    uint8_t tag = *ip++;
+    size_t len, distance;
+    switch (tag & 3) {
+      case TAG_LITERAL: {
+        len = tag >> 2;
+        if (len >= 60) {
+          size_t nbytes = len - 59;
+          if (nbytes > static_cast<size_t>(iend - ip)) {
+            throw snappy_error() << "unexpected end of input";
+          }
+          len = 0;
+          for (size_t i = 0; i < nbytes; ++i) {
+            len |= static_cast<size_t>(ip[i]) << (8 * i);
+          }
+          ip += nbytes;
+        }
+        len += 1;
+        if (len > static_cast<size_t>(iend - ip) ||
+            len > static_cast<size_t>(oend - op)) {
+          throw snappy_error() << "literal out of bounds";
+        }
+        std::memcpy(op, ip, len);
+        op += len;
+        ip += len;
+        continue;
+      }
+      case TAG_COPY1: {
+        if (ip == iend) throw snappy_error() << "unexpected end of input";
+        len = 4 + ((tag >> 2) & 7);
+        distance = (static_cast<size_t>(tag >> 5) << 8) | *ip++;
+        break;
+      }
+      case TAG_COPY2: {
+        if (iend - ip < 2) throw snappy_error() << "unexpected end of input";
+        len = 1 + (tag >> 2);
+        distance = static_cast<size_t>(ip[0]) |
+                   (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        break;
+      }
+      default: {
+        if (iend - ip < 4) throw snappy_error() << "unexpected end of input";
+        len = 1 + (tag >> 2);
+        distance = read_u32(ip);
+        ip += 4;
+        break;
+      }
+    }
+    if (distance == 0 || distance > static_cast<size_t>(op - ostart)) {
+      throw snappy_error() << "invalid copy offset";
+    }
+    if (len > static_cast<size_t>(oend - op)) {
+      throw snappy_error() << "copy out of bounds";
+    }
+    const uint8_t* match = op - distance;
+    for (size_t i = 0; i < len; ++i) op[i] = match[i];
+    op += len;
+  }
+  if (op != oend) {
+    throw snappy_error() << "expected " << dstsize << " bytes of output, got "
+        << static_cast<size_t>(op - ostart);
+  }
+}
+
+
+
+}}  // namespace dt::snappy
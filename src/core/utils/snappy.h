@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_UTILS_SNAPPY_h
+#define dt_UTILS_SNAPPY_h
+#include <cstddef>      // size_t
+namespace dt {
+namespace snappy {
+
+
+/**
+  * Simple codec for the Snappy "raw" format (i.e. without the framing
+  * used by the `.sz` files), which is the format of the Snappy-
+  * compressed pages in Parquet files. The compressor uses the same
+  * greedy single-entry hash table approach as our LZ4 codec.
+  *
+  * max_compressed_size(n)
+  *   Upper bound of the size of the compressed data for an input of
+  *   `n` bytes.
+  *
+  * compress(src, n, dst)
+  *   Compress `n` bytes at `src` into the buffer `dst`, which must
+  *   have at least `max_compressed_size(n)` bytes of capacity.
+  *   Returns the size of the compressed data.
+  *
+  * decompress(src, n, dst, dstsize)
+  *   Decompress `n` bytes of compressed data at `src` into the buffer
+  *   `dst`. The size of the uncompressed data must be exactly
+  *   `dstsize`, otherwise an IOError is thrown. The input is fully
+  *   validated, so malformed data results in an exception too.
+  */
+size_t max_compressed_size(size_t n);
+
+size_t compress(const void* src, size_t n, void* dst);
+
+void decompress(const void* src, size_t n, void* dst, size_t dstsize);
+
+
+
+}}  // namespace dt::snappy
+#endif
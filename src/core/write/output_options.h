@@ -21,6 +21,7 @@
 //------------------------------------------------------------------------------
 #ifndef dt_WRITE_OUTPUT_OPTIONS_h
 #define dt_WRITE_OUTPUT_OPTIONS_h
+#include <cstddef>   // size_t
 #include <cstdint>   // int8_t
 namespace dt {
 namespace write {
@@ -46,6 +47,11 @@ struct output_options {
   bool bom;
   Quoting quoting_mode;
   size_t : 56;
+  // zlib compression level (0-9), or -1 for zlib's default level
+  int compression_level;
+  size_t : 32;
+  // target amount of uncompressed data per gzip member, or 0 for auto
+  size_t compression_member_size;
 
   output_options()
     : compress_zlib(false),
@@ -56,7 +62,9 @@ struct output_options {
       strings_always_quote(false),
       strings_escape_quotes(false),
       bom(false),
-      quoting_mode(Quoting::MINIMAL) {}
+      quoting_mode(Quoting::MINIMAL),
+      compression_level(-1),
+      compression_member_size(0) {}
 };
 
 
@@ -79,6 +79,14 @@ void write_manager::set_compression(bool f) {
   options.compress_zlib = f;
 }
 
+void write_manager::set_compression_level(int level) {
+  options.compression_level = level;
+}
+
+void write_manager::set_compression_member_size(size_t size) {
+  options.compression_member_size = size;
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -136,8 +144,10 @@ void write_manager::write_rows()
 
     public:
       OTask(size_t nrows, size_t nch, size_t rowsize,
-            write_manager* wm, WritableBuffer* wbuf, bool compress)
-        : ctx_(rowsize, nrows / nch, compress),
+            write_manager* wm, WritableBuffer* wbuf,
+            const output_options& opts)
+        : ctx_(rowsize, nrows / nch, opts.compress_zlib,
+               opts.compression_level),
           wb_(wbuf),
           wmanager_(wm),
           nrows_(nrows),
@@ -171,7 +181,7 @@ void write_manager::write_rows()
   parallel_for_ordered(nchunks, NThreads(),
     [&] {
       return std::make_unique<OTask>(nrows, nchunks, fixed_size_per_row,
-                                     this, wb.get(), options.compress_zlib);
+                                     this, wb.get(), options);
     });
 }
 
@@ -209,6 +219,12 @@ void write_manager::create_output_target() {
  * This function depends only on parameters `bytes_total`, `nrows` and
  * `nthreads`. Its effect is to fill in values `rows_per_chunk`, 'nchunks' and
  * `bytes_per_chunk`.
+ *
+ * When the output is compressed, each chunk becomes a separate gzip member
+ * compressed independently by its own thread. In this case the user may
+ * request the approximate (uncompressed) size of each member via
+ * `compression_member_size`: larger members compress slightly better,
+ * whereas smaller ones allow more parallelism.
  */
 void write_manager::determine_chunking_strategy()
 {
@@ -218,11 +234,17 @@ void write_manager::determine_chunking_strategy()
   const double bytes_per_row = static_cast<double>(estimated_output_size) /
                                static_cast<double>(nrows);
 
-  static constexpr size_t max_chunk_size = 1024 * 1024;
+  static constexpr size_t default_max_chunk_size = 1024 * 1024;
   static constexpr size_t min_chunk_size = 1024;
 
   size_t nthreads = dt::num_threads_in_pool();
   size_t min_nchunks_for_threadpool = (nthreads == 1) ? 1 : nthreads*2;
+  size_t max_chunk_size = default_max_chunk_size;
+  if (options.compress_zlib && options.compression_member_size) {
+    max_chunk_size = std::max(options.compression_member_size,
+                              min_chunk_size);
+    min_nchunks_for_threadpool = 1;
+  }
 
   nchunks = std::max(1 + (estimated_output_size - 1) / max_chunk_size,
                      min_nchunks_for_threadpool);
@@ -106,6 +106,8 @@ class write_manager {
     void set_bom(bool);
     void set_quoting(int);
     void set_compression(bool);
+    void set_compression_level(int);
+    void set_compression_member_size(size_t);
 
     void write_main();
     py::oobj get_result();
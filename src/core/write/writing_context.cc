@@ -29,14 +29,14 @@ namespace write {
 
 
 writing_context::writing_context(
-  size_t size_per_row, size_t nrows, bool compress)
+  size_t size_per_row, size_t nrows, bool compress, int compression_level)
 {
   fixed_size_per_row = size_per_row;
   ch = nullptr;
   end = nullptr;
   buffer = nullptr;
   buffer_capacity = 0;
-  zwriter = compress? new zlib_writer : nullptr;
+  zwriter = compress? new zlib_writer(compression_level) : nullptr;
   allocate_buffer(size_per_row * nrows * 2);
 }
 
@@ -56,7 +56,10 @@ class writing_context {
     zlib_writer* zwriter;
 
   public:
-    writing_context(size_t size_per_row, size_t nrows, bool compress = false);
+    // If `compress` is true, each buffer is compressed into a separate
+    // gzip member with the given `compression_level`.
+    writing_context(size_t size_per_row, size_t nrows, bool compress = false,
+                    int compression_level = -1);
     ~writing_context();
 
     void ensure_buffer_capacity(size_t sz);
@@ -37,7 +37,13 @@ class zlib_writer {
     size_t buffer_capacity;
 
   public:
-    zlib_writer() {
+    // The default `window_bits` of 10 keeps the memory footprint of
+    // each writer small; larger windows find more distant repeats at
+    // the cost of 2^(window_bits + 2) bytes of additional memory.
+    // The `level` is either -1 (zlib's default), or a number from 0
+    // (no compression) to 9 (best compression).
+    explicit zlib_writer(int level = Z_DEFAULT_COMPRESSION,
+                         int window_bits = 10) {
       buffer = nullptr;
       buffer_capacity = 0;
       using z_stream = zlib::z_stream;  // for deflateInit2() macro
@@ -45,11 +51,10 @@ class zlib_writer {
       stream.zfree = nullptr;
       stream.opaque = nullptr;
       stream.data_type = Z_TEXT;
-      // TODO: expose <compression_level> as a global option
       int r = zlib::deflateInit2(&stream,
-                                 Z_DEFAULT_COMPRESSION,  // compression level
+                                 level,  // compression level
                                  Z_DEFLATED,  // method
-                                 10 + 16,  // windowBits, +16 for gzip headers
+                                 window_bits + 16,  // +16 for gzip headers
                                  8,  // memLevel (default = 8)
                                  Z_DEFAULT_STRATEGY);  // strategy
       if (r != Z_OK) {
@@ -103,6 +103,11 @@ size_t WritableBuffer::size() const {
 FileWritableBuffer::FileWritableBuffer(const std::string& path, bool append) {
   file_ = new File(path, append? File::APPEND
                                : File::OVERWRITE);
+  // Same as in MmapWritableBuffer, the positions within an appended
+  // file are counted from the beginning of that file.
+  if (append) {
+    bytes_written_ = file_->size();
+  }
 }
 
 FileWritableBuffer::~FileWritableBuffer() {
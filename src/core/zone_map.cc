@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <limits>             // std::numeric_limits
+#include "column/column_impl.h"
+#include "column.h"
+#include "parallel/api.h"     // dt::parallel_for_dynamic
+#include "ltype.h"
+#include "stype.h"
+#include "utils/assert.h"
+#include "zone_map.h"
+namespace dt {
+
+
+ZoneMap::ZoneMap(size_t nrows, size_t chunk_nrows, bool is_float)
+  : is_float_(is_float)
+{
+  xassert(chunk_nrows > 0);
+  size_t nchunks = (nrows + chunk_nrows - 1) / chunk_nrows;
+  zones_.resize(nchunks);
+  offsets_.resize(nchunks + 1);
+  for (size_t i = 0; i < nchunks; ++i) {
+    offsets_[i] = i * chunk_nrows;
+  }
+  offsets_[nchunks] = nrows;
+}
+
+
+std::shared_ptr<ZoneMap> ZoneMap::concat(
+    const std::vector<const ZoneMap*>& parts)
+{
+  xassert(!parts.empty());
+  auto res = std::make_shared<ZoneMap>(0, 1, parts[0]->is_float());
+  for (const ZoneMap* zm : parts) {
+    xassert(zm->is_float() == res->is_float());
+    size_t offset0 = res->nrows();
+    for (size_t i = 0; i < zm->nchunks(); ++i) {
+      res->zones_.push_back(zm->zones_[i]);
+      res->offsets_.push_back(offset0 + zm->offsets_[i + 1]);
+    }
+  }
+  return res;
+}
+
+
+bool ZoneMap::same_layout(const ZoneMap& other) const noexcept {
+  return offsets_ == other.offsets_;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Computing the zone map
+//------------------------------------------------------------------------------
+
+template <typename T, typename V>
+static void _compute_zone(const Column& col, size_t i0, size_t i1,
+                          V* pmin, V* pmax, size_t* pnacount)
+{
+  V vmin = std::numeric_limits<V>::max();
+  V vmax = std::numeric_limits<V>::lowest();
+  size_t nacount = 0;
+  T value;
+  for (size_t i = i0; i < i1; ++i) {
+    bool isvalid = col.get_element(i, &value);
+    if (!isvalid) { nacount++; continue; }
+    V x = static_cast<V>(value);
+    if (x < vmin) vmin = x;
+    if (x > vmax) vmax = x;
+  }
+  *pmin = vmin;
+  *pmax = vmax;
+  *pnacount = nacount;
+}
+
+
+template <typename T>
+static void _compute_zones(const Column& col, ZoneMap* zm) {
+  dt::parallel_for_dynamic(zm->nchunks(),
+    NThreads(col.allow_parallel_access()),
+    [&](size_t j) {
+      auto& z = zm->zone(j);
+      size_t i0 = zm->chunk_start(j), i1 = zm->chunk_end(j);
+      if (zm->is_float()) {
+        _compute_zone<T, double>(col, i0, i1, &z.fmin, &z.fmax, &z.nacount);
+        z.imin = z.imax = 0;
+      } else {
+        _compute_zone<T, int64_t>(col, i0, i1, &z.imin, &z.imax, &z.nacount);
+        z.fmin = z.fmax = 0;
+      }
+    });
+}
+
+
+std::shared_ptr<ZoneMap> ZoneMap::compute(const Column& col,
+                                          size_t chunk_nrows)
+{
+  std::shared_ptr<ZoneMap> zm;
+  bool is_float = (col.ltype() == LType::REAL);
+  switch (col.stype()) {
+    case SType::BOOL:
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:
+    case SType::FLOAT32:
+    case SType::FLOAT64:
+      zm = std::make_shared<ZoneMap>(col.nrows(), chunk_nrows, is_float);
+      break;
+    default:
+      return nullptr;
+  }
+  switch (col.stype()) {
+    case SType::BOOL:
+    case SType::INT8:    _compute_zones<int8_t>(col, zm.get()); break;
+    case SType::INT16:   _compute_zones<int16_t>(col, zm.get()); break;
+    case SType::INT32:   _compute_zones<int32_t>(col, zm.get()); break;
+    case SType::INT64:   _compute_zones<int64_t>(col, zm.get()); break;
+    case SType::FLOAT32: _compute_zones<float>(col, zm.get()); break;
+    case SType::FLOAT64: _compute_zones<double>(col, zm.get()); break;
+    default: break;
+  }
+  return zm;
+}
+
+
+
+}  // namespace dt
+//------------------------------------------------------------------------------
+// Column API
+//------------------------------------------------------------------------------
+
+
+const dt::ZoneMap* Column::get_zone_map() const noexcept {
+  return impl_->zone_map_.get();
+}
+
+
+void Column::set_zone_map(std::shared_ptr<const dt::ZoneMap> zm) {
+  xassert(!zm || zm->nrows() == nrows());
+  impl_->zone_map_ = std::move(zm);
+}
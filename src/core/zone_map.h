@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// Copyright 2018-2020 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_ZONE_MAP_h
+#define dt_ZONE_MAP_h
+#include <memory>       // std::shared_ptr
+#include <vector>       // std::vector
+#include "_dt.h"
+namespace dt {
+
+
+/**
+  * Zone map: a summary of a column split into "row groups" of
+  * `chunk_nrows` consecutive rows each (the last group may be
+  * shorter). For every row group we record the min/max of its
+  * non-NA values and the number of NAs.
+  *
+  * Zone maps of several columns may also be concatenated, when
+  * these columns are rbound together; the row groups of such a map
+  * are no longer of the same size.
+  *
+  * The min/max are stored as `int64_t` for boolean and integer
+  * columns, and as `double` for float columns (`is_float()`). Other
+  * column types do not have zone maps. If a group consists of NAs
+  * only, then its min/max are undefined.
+  *
+  * Zone maps are stored in Jay files, and are attached to the
+  * columns of the Frame when it is opened. They are used to skip
+  * row groups that cannot satisfy a filter `DT[f.x > c, :]`, see
+  * "expr/zone_filter.h".
+  */
+class ZoneMap {
+  public:
+    struct Zone {
+      int64_t imin, imax;
+      double  fmin, fmax;
+      size_t  nacount;
+    };
+
+  private:
+    sztvec offsets_;   // row groups' boundaries, size nchunks + 1
+    std::vector<Zone> zones_;
+    bool is_float_;
+    size_t : 56;
+
+  public:
+    ZoneMap(size_t nrows, size_t chunk_nrows, bool is_float);
+
+    // Compute the zone map for a boolean, integer or float column;
+    // returns nullptr for columns of any other type.
+    static std::shared_ptr<ZoneMap> compute(const Column& col,
+                                            size_t chunk_nrows);
+
+    // Zone map of the rbind of columns with the given zone maps; all
+    // of them must be either float or non-float.
+    static std::shared_ptr<ZoneMap> concat(
+        const std::vector<const ZoneMap*>& parts);
+
+    size_t nrows() const noexcept { return offsets_.back(); }
+    size_t nchunks() const noexcept { return zones_.size(); }
+    bool is_float() const noexcept { return is_float_; }
+
+    // Whether the two zone maps have the same boundaries of their
+    // row groups.
+    bool same_layout(const ZoneMap& other) const noexcept;
+
+    size_t chunk_start(size_t i) const noexcept { return offsets_[i]; }
+    size_t chunk_end(size_t i) const noexcept { return offsets_[i + 1]; }
+    Zone& zone(size_t i) { return zones_[i]; }
+    const Zone& zone(size_t i) const { return zones_[i]; }
+};
+
+
+
+}  // namespace dt
+#endif
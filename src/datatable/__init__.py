@@ -35,6 +35,7 @@ from .lib._datatable import (
     iread,
     join,
     Namespace,
+    open_jay_dataset,
     qcut,
     rbind,
     repeat,
@@ -104,6 +105,7 @@ __all__ = (
     "mean",
     "median",
     "obj64",
+    "open_jay_dataset",
     "options",
     "qcut",
     "rbind",
@@ -40,6 +40,45 @@ extern "C" {
 #define DtStype_STR64    12
 #define DtStype_OBJ      21
 
+
+/**
+ * Structures of the Arrow C data interface, see
+ * https://arrow.apache.org/docs/format/CDataInterface.html
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif  /* ARROW_C_DATA_INTERFACE */
+
 /**
  * Return the ABI version of the currently linked datatable library. The ABI
  * version will be increased every time new functions are added to this header
@@ -115,6 +154,34 @@ void* DtFrame_ColumnDataW(PyObject* pydt, size_t i);
 const char* DtFrame_ColumnStringDataR(PyObject* pydt, size_t i);
 
 
+/**
+ * Export Frame `pydt` into the Arrow C data interface structures `schema`
+ * and `array`, which must be allocated by the caller. The frame is exported
+ * as a struct array whose children are the frame's columns. The data buffers
+ * are shared with the frame whenever possible, and remain valid until the
+ * `array` is released, even if the frame itself is deleted. The caller is
+ * responsible for calling the `release` callbacks of both structures.
+ *
+ * Returns 0 on success, or -1 if an error occurs (in which case a Python
+ * exception is set, and the structures are left unmodified).
+ */
+int DtFrame_ToArrow(PyObject* pydt, struct ArrowSchema* schema,
+                    struct ArrowArray* array);
+
+
+/**
+ * Create a new Frame from an Arrow array described by the `schema`. If the
+ * array is a struct array, its children become the columns of the Frame;
+ * otherwise the Frame will have a single column. The content of `array` is
+ * moved into the Frame (and `array->release` is set to NULL), whereas the
+ * `schema` remains owned by the caller.
+ *
+ * Returns a new reference to the Frame, or NULL if an error occurs.
+ */
+PyObject* DtFrame_FromArrow(const struct ArrowSchema* schema,
+                            struct ArrowArray* array);
+
+
 
 
 
@@ -296,13 +296,9 @@ def _resolve_archive(filename, subpath, tempfiles):
             return (None, None, None, None), extracted_files
 
     elif ext == ".gz":
-        import gzip
-        zf = gzip.GzipFile(filename, mode="rb")
-        if logger:
-            logger.debug("Extracting %s into memory" % filename)
-        out_text = zf.read()
-        if logger:
-            logger.debug("Extracted: size = %d" % len(out_text))
+        # Gzip-compressed files are decompressed natively by fread (in
+        # parallel, if the file consists of multiple gzip members)
+        out_file = filename
 
     elif ext == ".bz2":
         import bz2
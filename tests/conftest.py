@@ -98,6 +98,19 @@ def numpy():
         pytest.skip("Numpy module is required for this test")
 
 
+@pytest.fixture(scope="session")
+def pyarrow():
+    """
+    This fixture returns pyarrow module, or if unavailable marks test as
+    skipped.
+    """
+    try:
+        import pyarrow as pa
+        return pa
+    except ImportError:
+        pytest.skip("Pyarrow module is required for this test")
+
+
 @pytest.fixture(scope="session")
 def h2o():
     """
@@ -134,6 +147,15 @@ def tempfile_jay():
         os.unlink(fname)
 
 
+@pytest.fixture(scope="function")
+def tempfile_parquet():
+    fd, fname = mod_tempfile.mkstemp(suffix=".parquet")
+    os.close(fd)
+    yield fname
+    if os.path.exists(fname):
+        os.unlink(fname)
+
+
 @pytest.fixture(scope="function")
 def tempdir():
     dirname = mod_tempfile.mkdtemp()
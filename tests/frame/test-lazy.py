@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#-------------------------------------------------------------------------------
+# Copyright 2018-2020 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#-------------------------------------------------------------------------------
+import datatable as dt
+import pytest
+import random
+from datatable import f, g, by, sort, join, mean, sum
+from datatable.internal import frame_integrity_check
+from tests import assert_equals
+
+
+@pytest.fixture()
+def DT():
+    random.seed(17)
+    n = 200
+    return dt.Frame(A=[random.randint(0, 9) for _ in range(n)],
+                    B=[random.random() for _ in range(n)],
+                    C=[random.choice(["x", "y", "z", None]) for _ in range(n)])
+
+
+def nsteps(LF):
+    return len(LF.explain().splitlines())
+
+
+def check(LF, expected, n):
+    res = LF.to_frame()
+    frame_integrity_check(res)
+    assert_equals(res, expected)
+    assert nsteps(LF) == n
+
+
+
+def test_lazy_empty(DT):
+    LF = DT.lazy()
+    assert repr(LF) == "<LazyFrame: 0 steps>"
+    res = LF.to_frame()
+    assert_equals(res, DT)
+    assert res is not DT
+    check(LF[:, :], DT, 0)
+
+
+def test_lazy_is_immutable(DT):
+    LF1 = DT.lazy()[f.A > 3, :]
+    LF2 = LF1[:, "B"]
+    assert repr(LF1) == "<LazyFrame: 1 step>"
+    assert repr(LF2) == "<LazyFrame: 2 steps>"
+    assert_equals(LF1.to_frame(), DT[f.A > 3, :])
+    assert_equals(LF2.to_frame(), DT[f.A > 3, "B"])
+
+
+def test_lazy_source_modified(DT):
+    LF = DT.lazy()[:, "A"]
+    expected = DT[:, "A"]
+    DT[:, "A"] = 0
+    assert_equals(LF.to_frame(), expected)
+
+
+def test_lazy_single_selectors(DT):
+    check(DT.lazy()["B"], DT["B"], 1)
+    check(DT.lazy()[2, "B"], DT[2:3, "B"], 1)
+    check(DT.lazy()[:, [f.B, f.A * 2]], DT[:, [f.B, f.A * 2]], 1)
+
+
+def test_lazy_filters_merged(DT):
+    LF = DT.lazy()[f.A > 2, :][(f.B < 0.7) | (f.C == "x"), :][f.A <= 8, :]
+    check(LF, DT[f.A > 2, :][(f.B < 0.7) | (f.C == "x"), :][f.A <= 8, :], 1)
+    LF2 = LF[:, {"S": f.A + f.B}]
+    check(LF2, DT[(f.A > 2) & ((f.B < 0.7) | (f.C == "x")) & (f.A <= 8),
+                  {"S": f.A + f.B}], 1)
+
+
+def test_lazy_filter_after_slice(DT):
+    LF = DT.lazy()[10:150:2, :][f.A != 5, :][:, ["C", "A"]]
+    check(LF, DT[10:150:2, :][f.A != 5, :][:, ["C", "A"]], 1)
+
+
+def test_lazy_filters_not_merged(DT):
+    # the conditions with reducers depend on the rows that they see
+    LF = DT.lazy()[f.B > mean(f.B), :][f.A > mean(f.A), :]
+    check(LF, DT[f.B > mean(f.B), :][f.A > mean(f.A), :], 2)
+    # the filter refers to a column created in the previous step
+    LF = DT.lazy()[:, {"D": f.A * 2}][f.D > 5, :]
+    check(LF, DT[:, {"D": f.A * 2}][f.D > 5, :], 2)
+    # filters are not merged into the steps with by()
+    LF = DT.lazy()[f.A > 3, :][:, sum(f.B), by(f.C)]
+    check(LF, DT[f.A > 3, :][:, sum(f.B), by(f.C)], 2)
+
+
+def test_lazy_sort_topk(DT):
+    check(DT.lazy()[:, :, sort(f.B)][:7, :], DT[:7, :, sort(f.B)], 1)
+    check(DT.lazy()[:, :, sort(-f.A, f.B)][-3:, ["A", "B"]],
+          DT[:, :, sort(-f.A, f.B)][-3:, ["A", "B"]], 1)
+    check(DT.lazy()[:, :, sort(f.B)][f.A > 3, :],
+          DT[:, :, sort(f.B)][f.A > 3, :], 2)
+
+
+def test_lazy_join(DT):
+    X = dt.Frame(C=["x", "y"], W=[10, 20])
+    X.key = "C"
+    LF = DT.lazy()[f.A > 1, :][:, [f.A, g.W], join(X)]
+    check(LF, DT[f.A > 1, :][:, [f.A, g.W], join(X)], 2)
+
+
+def test_lazy_from_jay(DT, tempfile_jay):
+    DT.to_jay(tempfile_jay)
+    DTJ = dt.fread(tempfile_jay)
+    LF = DTJ.lazy()[f.A < 4, :][f.C == "y", :][:, "B"]
+    check(LF, DT[(f.A < 4) & (f.C == "y"), "B"], 1)
+
+
+def test_lazy_errors(DT):
+    with pytest.raises(ValueError, match="Invalid tuple of size 1"):
+        DT.lazy()[(1,)]
+    LF = DT.lazy()[f.A, :][f.B > 0, :]
+    with pytest.raises(TypeError, match="Filter expression must be boolean"):
+        LF.to_frame()
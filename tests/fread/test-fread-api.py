@@ -259,10 +259,82 @@ def test_fread_gz_file(tempfile, capsys):
     assert d0.source == gzfile
     assert d0.to_list() == [[10, 20, 30]]
     assert not err
-    assert ("Extracting %s into memory" % gzfile) in out
+    assert "Input is gzip-compressed: 1 member" in out
     os.unlink(gzfile)
 
 
+def test_fread_gz_multiple_members(tempfile, capsys):
+    import gzip
+    gzfile = tempfile + ".gz"
+    text = "A,B\n" + "".join("%d,%d.25\n" % (i, i % 17) for i in range(400000))
+    data = text.encode()
+    step = 50000
+    with open(gzfile, "wb") as out:
+        for i in range(0, len(data), step):
+            out.write(gzip.compress(data[i:i + step], i % 10))
+        out.write(b"\0" * 10)  # zero padding after the last member
+    try:
+        RES = dt.fread(text=text)
+        for nthreads in [1, 2, 4]:
+            DT = dt.fread(gzfile, nthreads=nthreads, verbose=True)
+            out, err = capsys.readouterr()
+            frame_integrity_check(DT)
+            assert_equals(DT, RES)
+            assert ("Input is gzip-compressed: %d members"
+                    % ((len(data) - 1) // step + 1)) in out
+    finally:
+        os.unlink(gzfile)
+
+
+def test_fread_gz_member_spanning_regions(tempfile):
+    # The first member is larger than the regions into which the input is
+    # split for parallel decoding, so that the regions that begin inside
+    # that member contribute nothing to the output
+    import gzip
+    gzfile = tempfile + ".gz"
+    text = "A\n" + "".join("%d\n" % i for i in range(800000))
+    data = text.encode()
+    with open(gzfile, "wb") as out:
+        out.write(gzip.compress(data[:4000000], 0))
+        for i in range(4000000, len(data), 1000):
+            out.write(gzip.compress(data[i:i + 1000], 0))
+    try:
+        RES = dt.fread(text=text)
+        for nthreads in [1, 4, 8]:
+            DT = dt.fread(gzfile, nthreads=nthreads)
+            frame_integrity_check(DT)
+            assert_equals(DT, RES)
+    finally:
+        os.unlink(gzfile)
+
+
+def test_fread_gz_text():
+    import gzip
+    DT = dt.fread(text=gzip.compress(b"A,B\nfoo,1\nbar,2\n"))
+    assert DT.to_list() == [["foo", "bar"], [1, 2]]
+
+
+def test_fread_gz_tocsv_roundtrip():
+    DT = dt.Frame(A=range(300000), B=["alpha", "beta", "delta", "gamma"] * 75000)
+    data = DT.to_csv(compression="gzip")
+    for nthreads in [1, 3]:
+        assert_equals(dt.fread(text=data, nthreads=nthreads), DT)
+
+
+def test_fread_gz_corrupted():
+    import gzip
+    data = gzip.compress(b"A\n" + b"12345\n" * 10000)
+    with pytest.raises(IOError, match="Invalid gzip data: unexpected end "
+                                      "of input"):
+        dt.fread(text=data[:len(data) // 2])
+    with pytest.raises(IOError, match="Invalid gzip data: trailing garbage"):
+        dt.fread(text=data + b"abc")
+    bad = bytearray(data)
+    bad[-8] ^= 1
+    with pytest.raises(IOError, match="Invalid gzip data: CRC check failed"):
+        dt.fread(text=bytes(bad))
+
+
 def test_fread_bz2_file(tempfile, capsys):
     import bz2
     bzfile = tempfile + ".bz2"
@@ -486,6 +558,89 @@ def test_iread_tar_gz(tempfile):
         assert DT.to_list()[0] == list(range(3*i + 1, 3*i + 4))
 
 
+def test_iread_chunk_nrows():
+    text = "A,B,C\n" + "".join("%d,x%d,%d.5\n" % (i, i, i)
+                               for i in range(100000))
+    DTs = list(dt.iread(text=text, chunk_nrows=7000))
+    assert len(DTs) == 15
+    for i, DT in enumerate(DTs):
+        frame_integrity_check(DT)
+        assert DT.source == "<text>"
+        assert DT.names == ("A", "B", "C")
+        assert DT.nrows == (7000 if i < 14 else 2000)
+    assert_equals(dt.rbind(DTs), dt.fread(text=text))
+
+
+def test_iread_chunk_nrows_small():
+    DTs = list(dt.iread(text="A,B\n1,2\n3,4\n5,6\n", chunk_nrows=2))
+    assert len(DTs) == 2
+    assert DTs[0].to_list() == [[1, 3], [2, 4]]
+    assert DTs[1].to_list() == [[5], [6]]
+
+
+def test_iread_chunk_nrows_empty():
+    DTs = list(dt.iread(text="A,B\n", chunk_nrows=5))
+    assert len(DTs) == 1
+    assert DTs[0].shape == (0, 2)
+    assert DTs[0].names == ("A", "B")
+
+
+def test_iread_chunk_nrows_typebump():
+    n = 200000
+    text = "A,B\n" + "".join("%d,%d\n" % (i, i) for i in range(n))
+    text += "x,1.5\n"
+    DTs = list(dt.iread(text=text, chunk_nrows=50000))
+    assert [DT.nrows for DT in DTs] == [50000] * 4 + [1]
+    assert DTs[0].stypes == (dt.int32, dt.int32)
+    assert DTs[-1].stypes == (dt.str32, dt.float64)
+    assert DTs[-1].to_list() == [["x"], [1.5]]
+    RES = dt.rbind(DTs)
+    assert RES[:-1, :].to_list() == [[str(i) for i in range(n)],
+                                     list(range(n))]
+
+
+def test_iread_chunk_nrows_max_nrows():
+    text = "A\n" + "".join("%d\n" % i for i in range(100000))
+    DTs = list(dt.iread(text=text, chunk_nrows=7000, max_nrows=20000))
+    assert [DT.nrows for DT in DTs] == [7000, 7000, 6000]
+    assert dt.rbind(DTs).to_list() == [list(range(20000))]
+
+
+def test_iread_chunk_nrows_multiple_sources():
+    sources = ["A\n1\n2\n3\n", "B\n4\n5\n6\n7\n8\n"]
+    DTs = list(dt.iread(sources, chunk_nrows=2))
+    assert [DT.names for DT in DTs] == [("A",)] * 2 + [("B",)] * 3
+    assert [DT.to_list() for DT in DTs] == [[[1, 2]], [[3]], [[4, 5]],
+                                            [[6, 7]], [[8]]]
+
+
+def test_iread_chunk_nrows_error_line():
+    # The quoted field spans 3 lines, so the malformed line at the end
+    # is line n + 4 of the input, even though it is only row n + 1
+    n = 100000
+    text = ('A,B\n0,"x\ny\nz"\n' + "".join("%d,b\n" % i for i in range(1, n))
+            + "1,d,e\n")
+    msg = "Too many fields on line %d: expected 2" % (n + 4)
+    with pytest.raises(IOError, match=msg):
+        list(dt.iread(text=text, chunk_nrows=30000, errors="raise"))
+
+
+def test_iread_chunk_nrows_error_line_cr():
+    # A standalone '\r' is not a newline when the input contains '\n's
+    n = 100000
+    text = ("A,B\n" + "".join("%d,b\rc\n" % i for i in range(n))
+            + "1,d,e\n")
+    msg = "Too many fields on line %d: expected 2" % (n + 2)
+    with pytest.raises(IOError, match=msg):
+        list(dt.iread(text=text, chunk_nrows=30000, errors="raise"))
+
+
+def test_iread_chunk_nrows_bad():
+    msg = "Parameter chunk_nrows in iread\\(\\) should be positive"
+    with pytest.raises(ValueError, match=msg):
+        list(dt.iread(text="A\n1\n", chunk_nrows=0))
+
+
 
 #-------------------------------------------------------------------------------
 # `columns`
@@ -1015,6 +1170,110 @@ def test_fread_max_nrows_correct_types():
 
 
 
+#-------------------------------------------------------------------------------
+# `filter`
+#-------------------------------------------------------------------------------
+
+def _filter_text():
+    return "A,B,C,D\n" + "".join(
+                "%s,%s,%s,%s\n" % ("" if i % 11 == 0 else i,
+                                   i * 0.25,
+                                   "" if i % 13 == 0 else "s%d" % (i % 7),
+                                   "" if i % 5 == 0 else i % 3 == 0)
+                for i in range(20000))
+
+
+@pytest.mark.parametrize("filter", [
+    "f.A > 19990", "f.A == None", "f.A != None", "f.A < 100.5",
+    "f.B <= 1.75", "f.B == 3", "1000 >= f.A", "f.C == 's3'",
+    "f.C != 's3'", "f.C < 's2'", "f.C == None", "f.D", "~f.D",
+    "f.D == False", "(f.A > 100) & (f.C == 's1')",
+    "(f.A < 10) | f.D", "~((f.A > 5) & f.D)", "f[0] > 19990",
+    "f[-1] | (f['C'] >= 's5')"])
+def test_fread_filter(filter):
+    from datatable import f
+    text = _filter_text()
+    expr = eval(filter)
+    DT = dt.fread(text=text, filter=expr)
+    frame_integrity_check(DT)
+    assert_equals(DT, dt.fread(text=text)[expr, :])
+
+
+def test_fread_filter_with_columns():
+    from datatable import f
+    text = _filter_text()
+    DT = dt.fread(text=text, columns={"A": "X", "C": "Y", "D": None},
+                  filter=(f.Y == "s2") & (f[0] < 1000))
+    frame_integrity_check(DT)
+    assert DT.names == ("X", "B", "Y")
+    RES = dt.fread(text=text, columns={"A": "X", "C": "Y", "D": None})
+    assert_equals(DT, RES[(f.Y == "s2") & (f.X < 1000), :])
+
+
+def test_fread_filter_typebump():
+    from datatable import f
+    text = "A,B\n" + "1,2\n" * 5000 + "x,3\n" + "2,7\n" * 5000
+    DT = dt.fread(text=text, filter=f.B > 2)
+    frame_integrity_check(DT)
+    assert DT.stypes == (stype.str32, stype.int32)
+    assert DT.to_list() == [["x"] + ["2"] * 5000, [3] + [7] * 5000]
+
+
+def test_fread_filter_none_pass():
+    from datatable import f
+    DT = dt.fread("A,B\n1,a\n2,b\n3,c\n", filter=f.A > 10)
+    frame_integrity_check(DT)
+    assert DT.names == ("A", "B")
+    assert DT.shape == (0, 2)
+
+
+def test_fread_filter_max_nrows():
+    from datatable import f
+    text = "A\n" + "".join("%d\n" % i for i in range(100000))
+    DT = dt.fread(text=text, filter=f.A >= 99990, max_nrows=5)
+    frame_integrity_check(DT)
+    assert DT.to_list() == [[99990, 99991, 99992, 99993, 99994]]
+
+
+def test_iread_filter_chunk_nrows():
+    from datatable import f
+    text = "A,B\n" + "".join("%d,%d\n" % (i, i % 10) for i in range(50000))
+    DTs = list(dt.iread(text=text, chunk_nrows=1000, filter=f.B == 3))
+    assert len(DTs) == 5
+    for DT in DTs:
+        frame_integrity_check(DT)
+        assert DT.nrows == 1000
+    assert_equals(dt.rbind(DTs), dt.fread(text=text)[f.B == 3, :])
+
+
+def test_fread_filter_unsupported():
+    from datatable import f
+    msg = r"Filter expression .* cannot be applied in fread\(\)"
+    with pytest.raises(NotImplementedError, match=msg):
+        dt.fread("A,B\n1,2\n", filter=f.A > f.B)
+    with pytest.raises(NotImplementedError, match=msg):
+        dt.fread("A,B\n1,2\n", filter=(f.A + 1 > 0))
+
+
+def test_fread_filter_bad():
+    from datatable import f
+    with pytest.raises(TypeError, match="Parameter filter in fread"):
+        dt.fread("A,B\n1,2\n", filter="A > 1")
+    with pytest.raises(KeyError, match="Column C does not exist"):
+        dt.fread("A,B\n1,2\n", filter=f.C == 1)
+    with pytest.raises(KeyError, match="Column B does not exist"):
+        dt.fread("A,B\n1,2\n", columns={"A"}, filter=f.B == 1)
+    with pytest.raises(ValueError, match="Column index 2 is invalid for a "
+                                         "Frame with 2 columns"):
+        dt.fread("A,B\n1,2\n", filter=f[2] == 1)
+    with pytest.raises(TypeError, match="Operator == cannot be applied to "
+                                        "columns with types int32 and str32"):
+        dt.fread("A,B\n10,2\n", filter=f.A == "1")
+    with pytest.raises(TypeError, match="Filter expression must be boolean"):
+        dt.fread("A,B\n10,2\n", filter=f.A)
+
+
+
 #-------------------------------------------------------------------------------
 # `logger`
 #-------------------------------------------------------------------------------
@@ -1150,6 +1409,92 @@ def test_anonymize2(capsys):
 
 
 
+#-------------------------------------------------------------------------------
+# `categorical_threshold`
+#-------------------------------------------------------------------------------
+
+def _categorical_source(n):
+    words = ["alpha", "beta", None, "gamma", "delta"]
+    lines = ["A,B"] + ["%s,%d" % (words[i % 5] or "", i) for i in range(n)]
+    return "\n".join(lines)
+
+
+def test_categorical_threshold_default():
+    # Dictionary encoding is opt-in
+    assert dt.options.fread.categorical_threshold == 0
+    src = _categorical_source(10000)
+    DT0 = dt.fread(src)
+    with dt.options.fread.context(categorical_threshold=0.05):
+        DT = dt.fread(src)
+    frame_integrity_check(DT)
+    assert_equals(DT, DT0)
+    assert DT.__sizeof__() < DT0.__sizeof__()
+
+
+def test_categorical_threshold_too_many_categories():
+    src = "A\n" + "\n".join("x%d" % (i % 1000) for i in range(10000))
+    with dt.options.fread.context(categorical_threshold=0.05):
+        DT = dt.fread(src)
+    with dt.options.fread.context(categorical_threshold=0.5):
+        DT1 = dt.fread(src)
+    assert_equals(DT, DT1)
+    assert DT.__sizeof__() > DT1.__sizeof__()
+
+
+def test_categorical_threshold_many_chunks():
+    # Each of the 8 chunks has fewer distinct values than the limit, but
+    # all together they have more
+    n = 600000
+    src = "A\n" + "\n".join("x%d" % (i % 100000) for i in range(n))
+    with dt.options.context(nthreads=8):
+        DT0 = dt.fread(src)
+        with dt.options.fread.context(categorical_threshold=0.15):
+            DT1 = dt.fread(src)
+        with dt.options.fread.context(categorical_threshold=0.2):
+            DT2 = dt.fread(src)
+    assert_equals(DT1, DT0)
+    assert_equals(DT2, DT0)
+    assert DT1.__sizeof__() == DT0.__sizeof__()
+    assert DT2.__sizeof__() < DT0.__sizeof__()
+
+
+def test_categorical_operations():
+    src = _categorical_source(10000)
+    DT0 = dt.fread(src)
+    with dt.options.fread.context(categorical_threshold=0.05):
+        DT = dt.fread(src)
+    assert_equals(DT.sort("A"), DT0.sort("A"))
+    assert_equals(DT.sort(-dt.f.A, dt.f.B), DT0.sort(-dt.f.A, dt.f.B))
+    assert_equals(DT[:, dt.count(), dt.by("A")],
+                  DT0[:, dt.count(), dt.by("A")])
+    assert_equals(DT[::-3, :], DT0[::-3, :])
+    assert_equals(DT[dt.f.A == "beta", :], DT0[dt.f.A == "beta", :])
+    assert_equals(dt.rbind(DT, DT0), dt.rbind(DT0, DT))
+
+
+def test_categorical_join():
+    src = _categorical_source(5000)
+    J = dt.Frame(A=["beta", "delta", "omega"], C=[1, 2, 3])
+    J.key = "A"
+    DT0 = dt.fread(src)
+    with dt.options.fread.context(categorical_threshold=0.05):
+        DT = dt.fread(src)
+        DTJ = dt.fread("A,D\n" + "delta,7\ngamma,8\nbeta,9\n" * 50)[:3, :]
+    DTJ.key = "A"
+    assert_equals(DT[:, :, dt.join(J)], DT0[:, :, dt.join(J)])
+    assert_equals(DT[:, :, dt.join(DTJ)], DT0[:, :, dt.join(DTJ)])
+
+
+def test_categorical_threshold_bad():
+    msg = "fread.categorical_threshold should be a number between 0 and 1"
+    with pytest.raises(ValueError, match=msg):
+        dt.options.fread.categorical_threshold = 1.5
+    with pytest.raises(ValueError, match=msg):
+        dt.options.fread.categorical_threshold = -0.1
+    assert dt.options.fread.categorical_threshold == 0
+
+
+
 #-------------------------------------------------------------------------------
 # `encoding`
 #-------------------------------------------------------------------------------
@@ -378,6 +378,35 @@ def test_invalid_float_numbers():
     assert d0.to_list() == [["."], ["+."], [".e"], [".e+"], ["0e"], ["e-3"]]
 
 
+@pytest.mark.parametrize("n", [0, 1, 7, 14, 15, 16, 17, 31, 32, 33, 47])
+def test_long_string_fields(n):
+    # String fields are scanned in blocks of 16 bytes: check that separators,
+    # quotes and newlines are found at every position within a block
+    s = "abcdefghijklmnopqrstuvwxyz0123456789" * 2
+    a = s[:n]
+    b = s[n:] + "\t" + s[:n]
+    c = s[:n] + '""' + s[n:]
+    text = ('A,B,C,D\n' +
+            '%s,%s,"%s",1\r\n' % (a, b, c) +
+            '"%s","%s,",%s,2\n' % (b, a, a) +
+            '%s,%s,%s,3' % (s[:n + 1], a, b))
+    d0 = dt.fread(text)
+    frame_integrity_check(d0)
+    assert d0.names == ("A", "B", "C", "D")
+    assert d0.to_list() == [[a, b, s[:n + 1]],
+                            [b, a + ",", a],
+                            [s[:n] + '"' + s[n:], a, b],
+                            [1, 2, 3]]
+
+
+def test_long_string_fields_escaped():
+    s = "x" * 20
+    d0 = dt.fread('A,B\n"%s\\"%s",1\n"%s",2\n' % (s, s, s * 2),
+                  quotechar='"')
+    frame_integrity_check(d0)
+    assert d0.to_list() == [[s + '"' + s, s * 2], [1, 2]]
+
+
 
 #-------------------------------------------------------------------------------
 # Tiny files
@@ -820,6 +820,38 @@ def test_strXX_large6(st):
     assert dt1.to_list()[0] == sorted(words)
 
 
+@pytest.mark.parametrize("st", [dt.str32, dt.str64])
+def test_strXX_common_prefix(st):
+    # Strings are sorted using keys of 7 characters each, so check
+    # the strings whose lengths are around multiples of 7
+    prefix = "https://www.example.com/"
+    src = [prefix[:i] for i in range(len(prefix) + 1)]
+    src += [prefix + "abcdefghijklmno"[:i] for i in range(16)]
+    src += [prefix + "abcdefg" + c for c in "\0\1aZ"]
+    src *= 20
+    src += [None] * 5
+    random.shuffle(src)
+    DT = dt.Frame(A=src, stype=st)
+    valid = [s for s in src if s is not None]
+    assert DT[:, :, sort(f.A)].to_list()[0] == \
+           [None] * 5 + sorted(valid)
+    assert DT[:, :, sort(-f.A)].to_list()[0] == \
+           [None] * 5 + sorted(valid, reverse=True)
+
+
+def test_group_strings_common_prefix():
+    n = 5000
+    src = ["http://data.test/path/%d/%s" % (i % 37, "x" * (i % 11))
+           for i in range(n)]
+    DT = dt.Frame(A=src, B=range(n))
+    RES = DT[:, {"count": dt.count(), "first": dt.first(f.B)}, by(f.A)]
+    frame_integrity_check(RES)
+    keys = sorted(set(src))
+    assert RES.to_list() == [keys,
+                             [src.count(k) for k in keys],
+                             [src.index(k) for k in keys]]
+
+
 
 #-------------------------------------------------------------------------------
 # Sort by multiple columns
@@ -1095,3 +1127,183 @@ def test_issue2348():
                   dt.Frame([[11], [6]],
                            names=["D", "count"],
                            stypes=[dt.int32, dt.int64]))
+
+
+
+#-------------------------------------------------------------------------------
+# External sort
+#-------------------------------------------------------------------------------
+
+def _sort_external(DT, *args):
+    # Evaluate `DT[:, :, *args]` in memory, and then with a memory limit
+    # small enough for the external sort to be used, and check that the
+    # results are the same
+    expected = DT[(slice(None), slice(None)) + args]
+    with dt.options.sort.context(memory_limit=1):
+        result = DT[(slice(None), slice(None)) + args]
+    frame_integrity_check(result)
+    assert_equals(result, expected)
+    return result
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_external_random(seed):
+    random.seed(seed)
+    n = random.randint(5000, 20000)
+    def rnd(gen):
+        return [None if random.random() < 0.05 else gen() for _ in range(n)]
+    DT = dt.Frame(B=rnd(lambda: random.random() < 0.5),
+                  I=rnd(lambda: random.randint(-100, 100)),
+                  L=rnd(lambda: random.randint(-2**62, 2**62)),
+                  F=rnd(lambda: random.choice([-0.0, 0.0, inf, -inf,
+                                               random.random()])),
+                  S=rnd(lambda: random_string(random.randint(0, 3))))
+    _sort_external(DT, sort(f.I))
+    _sort_external(DT, sort(-f.F))
+    _sort_external(DT, sort(f.S, -f.L))
+    _sort_external(DT, sort(-f.B, f.S, f.F))
+
+
+def test_sort_external_groups():
+    n = 7700
+    DT = dt.Frame(A=[i % 7 for i in range(n)],
+                  B=[str(i % 11) for i in range(n)],
+                  C=range(n))
+    _sort_external(DT, by(f.A))
+    _sort_external(DT, by(f.B, f.A))
+    _sort_external(DT, by(f.A), sort(-f.C))
+    with dt.options.sort.context(memory_limit=1):
+        RES = DT[:, dt.count(), by(f.B, f.A)]
+    assert RES.nrows == 77
+    assert RES["count"].to_list()[0] == [100] * 77
+
+
+def test_sort_external_long_strings():
+    # The strings share prefixes that are longer than the normalized keys,
+    # so that some rows are compared by their original values
+    random.seed(7)
+    n = 9000
+    prefix = "customer-record-identifier-"
+    DT = dt.Frame(S=[None if i % 97 == 0 else
+                     prefix + str(random.randint(0, 500)) for i in range(n)],
+                  T=[random.choice(["", "a", "a\0", "ab", "b" * 30, None])
+                     for _ in range(n)],
+                  X=range(n))
+    _sort_external(DT, sort(f.S))
+    _sort_external(DT, sort(-f.S, f.X))
+    _sort_external(DT, sort(-f.T, -f.S))
+    _sort_external(DT, by(f.S, f.T))
+    with dt.options.sort.context(memory_limit=1):
+        RES = DT[:, dt.count(), by(f.T)]
+    assert RES["T"].to_list()[0] == [None, "", "a", "a\0", "ab", "b" * 30]
+
+
+def test_sort_external_tempdir(tmpdir):
+    DT = dt.Frame(A=range(10000, 0, -1))
+    with dt.options.sort.context(memory_limit=1, tempdir=str(tmpdir)):
+        assert dt.options.sort.tempdir == str(tmpdir)
+        RES = DT.sort("A")
+    assert dt.options.sort.tempdir is None
+    assert RES.to_list() == [list(range(1, 10001))]
+    # The ordering of the result is stored in a temporary file, which is
+    # removed together with the frame
+    del RES
+    assert os.listdir(str(tmpdir)) == []
+
+
+def test_sort_external_bad_tempdir(tmpdir):
+    DT = dt.Frame(A=range(10000))
+    baddir = os.path.join(str(tmpdir), "nonexistent")
+    with dt.options.sort.context(memory_limit=1, tempdir=baddir):
+        with pytest.raises(IOError, match="Cannot create temporary file"):
+            DT.sort("A")
+    # No external sort is needed for small frames
+    with dt.options.sort.context(tempdir=baddir):
+        assert DT.sort("A").to_list() == [list(range(10000))]
+
+
+
+#-------------------------------------------------------------------------------
+# Top-k sort
+#-------------------------------------------------------------------------------
+
+def _random_frame(n):
+    def rnd(gen):
+        return [None if random.random() < 0.05 else gen() for _ in range(n)]
+    return dt.Frame(G=rnd(lambda: random.randint(0, 20)),
+                    I=rnd(lambda: random.randint(-100, 100)),
+                    F=rnd(lambda: random.choice([-0.0, 0.0, inf,
+                                                 random.random()])),
+                    S=rnd(lambda: random_string(random.randint(0, 2))))
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_topk_random(seed):
+    random.seed(seed)
+    DT = _random_frame(random.randint(1000, 5000))
+    for sortexpr in [sort(f.I), sort(-f.F), sort(f.S, -f.I),
+                     sort(-f.G, f.F, f.S)]:
+        FULL = DT[:, :, sortexpr]
+        for i in [slice(10), slice(None, 50), slice(3, 40, 4), 0, 7]:
+            RES = DT[i, :, sortexpr]
+            frame_integrity_check(RES)
+            assert_equals(RES, FULL[i, :])
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_topk_by_random(seed):
+    random.seed(seed)
+    DT = _random_frame(random.randint(1000, 5000))
+    for sortexpr in [sort(-f.I), sort(f.S, f.F)]:
+        FULL = DT[:, :, by(f.G), sortexpr]
+        # Positions of the rows of each group within FULL
+        groups = {}
+        for irow, g in enumerate(FULL["G"].to_list()[0]):
+            groups.setdefault(g, []).append(irow)
+        keys = sorted(groups, key=lambda g: (g is not None, g))
+        for i in [slice(3), slice(1, 10, 3), 0, 2]:
+            rows = []
+            for g in keys:
+                if isinstance(i, slice):
+                    rows += groups[g][i]
+                elif i < len(groups[g]):
+                    rows.append(groups[g][i])
+            RES = DT[i, :, by(f.G), sortexpr]
+            frame_integrity_check(RES)
+            assert_equals(RES, FULL[rows, :])
+
+
+def test_sort_topk_stable():
+    DT = dt.Frame(A=[1, 0, 1, 0, 1] * 100, B=range(500))
+    RES = DT[:5, :, sort(f.A)]
+    assert RES.to_list() == [[0] * 5, [1, 3, 6, 8, 11]]
+    RES = DT[:5, :, sort(-f.A)]
+    assert RES.to_list() == [[1] * 5, [0, 2, 4, 5, 7]]
+
+
+def test_sort_topk_nas():
+    DT = dt.Frame(A=[5, None, 3, None, 1] + list(range(10, 200)))
+    assert DT[:4, :, sort(f.A)].to_list() == [[None, None, 1, 3]]
+    assert DT[:4, :, sort(-f.A)].to_list() == [[None, None, 199, 198]]
+
+
+def test_sort_topk_categorical():
+    src = ["red", "green", None, "blue", "red"] * 40
+    DT = dt.Frame(A=src, B=range(200))
+    with dt.options.fread.context(categorical_threshold=0.5):
+        CAT = dt.fread(text="\n".join(["A,B"] + ["%s,%d" % (x or "NA", i)
+                                                 for i, x in enumerate(src)]))
+    assert CAT.__sizeof__() < DT.__sizeof__()
+    assert_equals(CAT[:6, :, sort(f.A)], DT[:, :, sort(f.A)][:6, :])
+    assert_equals(CAT[:2, :, by(f.A), sort(-f.B)],
+                  DT[:2, :, by(f.A), sort(-f.B)])
+
+
+def test_sort_topk_huge_limit():
+    # The limit is larger than the number of rows
+    DT = dt.Frame(A=[5, 2, None, 7, 1] * 20)
+    expected = DT[:, :, sort(f.A)]
+    assert_equals(DT[:2**62, :, sort(f.A)], expected)
+    assert_equals(DT[:2**60 + 1, :, sort(f.A)], expected)
+    assert_equals(DT[:2**62, :, by(f.A), sort(f.A)],
+                  DT[:, :, by(f.A), sort(f.A)])
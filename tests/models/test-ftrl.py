@@ -716,6 +716,25 @@ def test_ftrl_fit_predict_string():
     assert df_target[1, 1] < epsilon
 
 
+def test_ftrl_fit_predict_multithreaded():
+    # The threads update the model concurrently, each one working on
+    # its own chunks of rows
+    nrows = 50000
+    df_train = dt.Frame(A=[i % 5 for i in range(nrows)],
+                        B=[i % 7 for i in range(nrows)])
+    df_target = dt.Frame([i % 5 < 2 for i in range(nrows)])
+    with dt.options.context(nthreads=4):
+        ft = Ftrl(alpha = 0.1, nepochs = 3)
+        ft.fit(df_train, df_target)
+        p = ft.predict(df_train[:10, :])
+    assert ft.model_type_trained == "binomial"
+    assert p[:, "True"].to_list()[0] == pytest.approx([1, 1, 0, 0, 0] * 2,
+                                                      abs=0.05)
+    fi = ft.feature_importances
+    assert fi[0, 1] == 1
+    assert fi[1, 1] < fi[0, 1]
+
+
 @pytest.mark.parametrize('target',
                          [[True, False],
                          ["yes", "no"],
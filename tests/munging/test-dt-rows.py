@@ -621,6 +621,44 @@ def test_0rows_frame():
     assert dt2.ltypes == (ltype.int, )
 
 
+@pytest.mark.parametrize("seed", [random.getrandbits(63)])
+def test_rows_expr_conjunction(seed):
+    # The conditions of a conjunction may be applied in a different
+    # order, cheapest first; the result must not depend on that.
+    random.seed(seed)
+    n = 200
+    DT = dt.Frame(A=[random.choice([None, 1, 5, 8]) for _ in range(n)],
+                  B=[random.choice([None, 0.5, 2.5]) for _ in range(n)],
+                  S=[random.choice([None, "abc", "bcd", "b"]) for _ in range(n)])
+    filters = [f.S.re_match("b.*") & (f.A > 2),
+               (f.A > 2) & f.S.re_match("b.*") & (f.B < 1),
+               (f.S == "b") & (dt.isna(f.B) | (f.A * f.B > 2))]
+    for filter in filters:
+        with dt.options.fexpr.context(order_filters=True):
+            RES1 = DT[filter, :]
+        with dt.options.fexpr.context(order_filters=False):
+            RES2 = DT[filter, :]
+        frame_integrity_check(RES1)
+        assert_equals(RES1, RES2)
+    A, B, S = DT.to_list()
+    RES = DT[f.S.re_match("b.*") & (f.A > 2), :]
+    assert RES.to_list()[0] == [A[i] for i in range(n)
+                                if S[i] and S[i].startswith("b") and
+                                A[i] is not None and A[i] > 2]
+
+
+def test_rows_expr_conjunction_with_reducer():
+    # A condition with a reducer depends on the rows it sees, so it
+    # must not be evaluated after the other conditions
+    DT = dt.Frame(A=[1, 2, 3, 4, 100, 5, 6], B=[-1, -1, -1, -1, -1, 1, 1])
+    RES = DT[(f.A > dt.mean(f.A)) & (f.B > 0), :]
+    frame_integrity_check(RES)
+    assert RES.shape == (0, 2)
+    assert RES.names == ("A", "B")
+    RES = DT[(f.B > 0) & (f.A > dt.mean(f.A)), :]
+    assert RES.shape == (0, 2)
+
+
 def test_select_wrong_stype():
     dt0 = dt.Frame(A=range(5), B=range(5))
     assert_typeerror(
@@ -0,0 +1,276 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#-------------------------------------------------------------------------------
+# Copyright 2018-2021 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#-------------------------------------------------------------------------------
+import datatable as dt
+import gc
+import pytest
+from datatable.internal import frame_integrity_check, frame_column_data_r
+from tests import assert_equals
+
+
+class ArrowArrayHolder:
+    """
+    Minimal object implementing the Arrow PyCapsule protocol, used to
+    pass the capsules produced by one frame into the constructor of
+    another frame.
+    """
+    def __init__(self, capsules):
+        self.capsules = capsules
+
+    def __arrow_c_array__(self, requested_schema=None):
+        return self.capsules
+
+
+class ArrowStreamHolder:
+    def __init__(self, capsule):
+        self.capsule = capsule
+
+    def __arrow_c_stream__(self, requested_schema=None):
+        return self.capsule
+
+
+def roundtrip(DT):
+    return dt.Frame(ArrowArrayHolder(DT.__arrow_c_array__()))
+
+
+
+#-------------------------------------------------------------------------------
+# Export / import via PyCapsules
+#-------------------------------------------------------------------------------
+
+def test_arrow_capsules():
+    DT = dt.Frame(A=[1, 2, 3])
+    schema, array = DT.__arrow_c_array__()
+    assert type(schema).__name__ == "PyCapsule"
+    assert type(array).__name__ == "PyCapsule"
+    stream = DT.__arrow_c_stream__()
+    assert type(stream).__name__ == "PyCapsule"
+
+
+def test_arrow_roundtrip_all_types():
+    DT = dt.Frame([[True, False, None, True],
+                   [1, None, -3, 127],
+                   [1000, -2, None, 32767],
+                   [None, 1, 2, 3],
+                   [2**40, None, -7, 0],
+                   [1.5, None, -2.25, 1e10],
+                   [3.14159, None, 0.0, -1e300],
+                   ["a", None, "", "dd"],
+                   ["x", "y", None, "zzz"]],
+                  stypes=[dt.bool8, dt.int8, dt.int16, dt.int32, dt.int64,
+                          dt.float32, dt.float64, dt.str32, dt.str64],
+                  names=list("ABCDEFGHI"))
+    RES = roundtrip(DT)
+    frame_integrity_check(RES)
+    assert_equals(RES, DT)
+
+
+def test_arrow_roundtrip_stream():
+    DT = dt.Frame(A=range(10), B=[None, "b"] * 5, C=[0.5] * 10)
+    RES = dt.Frame(ArrowStreamHolder(DT.__arrow_c_stream__()))
+    frame_integrity_check(RES)
+    assert_equals(RES, DT)
+
+
+def test_arrow_roundtrip_view():
+    DT = dt.Frame(A=range(20), B=[str(i) for i in range(20)])[::-3, :]
+    RES = roundtrip(DT)
+    frame_integrity_check(RES)
+    assert RES.to_list() == DT.to_list()
+
+
+def test_arrow_roundtrip_empty():
+    RES = roundtrip(dt.Frame())
+    assert RES.shape == (0, 0)
+    DT = dt.Frame(A=[], B=[], stypes=[dt.int64, dt.str32])
+    RES = roundtrip(DT)
+    assert_equals(RES, DT)
+
+
+def test_arrow_roundtrip_categorical():
+    src = ["red", "green", None, "blue", "red"] * 20
+    DT = dt.Frame(A=src)
+    with dt.options.fread.context(categorical_threshold=0.5):
+        CAT = dt.fread(text="\n".join(["A"] + [x or "NA" for x in src]))
+    assert CAT.__sizeof__() < DT.__sizeof__()
+    RES = roundtrip(CAT)
+    frame_integrity_check(RES)
+    assert_equals(RES, DT)
+
+
+def test_arrow_zero_copy():
+    # Columns without NAs are shared in both directions
+    DT = dt.Frame(A=list(range(1000)), B=[0.5] * 1000, C=["abc"] * 1000)
+    RES = roundtrip(DT)
+    for i in range(3):
+        assert frame_column_data_r(RES, i).value == \
+               frame_column_data_r(DT, i).value
+
+
+def test_arrow_copy_with_nas():
+    DT = dt.Frame(A=[1, None, 3], C=["a", None, "c"])
+    RES = roundtrip(DT)
+    assert frame_column_data_r(RES, 0).value != \
+           frame_column_data_r(DT, 0).value
+    assert_equals(RES, DT)
+
+
+def test_arrow_import_uint64():
+    # There is no uint64 stype, so the frame is exported as int64, and
+    # then the format of the exported array is changed into uint64 ("L")
+    import ctypes
+    get_pointer = ctypes.pythonapi.PyCapsule_GetPointer
+    get_pointer.restype = ctypes.c_void_p
+    get_pointer.argtypes = [ctypes.py_object, ctypes.c_char_p]
+
+    def as_uint64(DT):
+        schema, array = DT.__arrow_c_array__()
+        pschema = get_pointer(schema, b"arrow_schema")
+        children = ctypes.c_void_p.from_address(pschema + 40).value
+        pchild = ctypes.c_void_p.from_address(children).value
+        pformat = ctypes.c_void_p.from_address(pchild).value
+        assert ctypes.string_at(pformat) == b"l"
+        ctypes.memmove(pformat, b"L", 1)
+        return dt.Frame(ArrowArrayHolder((schema, array)))
+
+    RES = as_uint64(dt.Frame(A=[1, None, 2**63 - 1], stype=dt.int64))
+    assert RES.stype == dt.int64
+    assert RES.to_list() == [[1, None, 2**63 - 1]]
+    # values that do not fit into int64 are not wrapped around
+    RES = as_uint64(dt.Frame(A=[1, None, -1, -2**63 + 1], stype=dt.int64))
+    frame_integrity_check(RES)
+    assert RES.stype == dt.float64
+    assert RES.to_list() == [[1.0, None, 2.0**64, 2.0**63]]
+
+
+def test_arrow_lifetime():
+    DT = dt.Frame(A=range(100), B=[str(i) for i in range(100)])
+    expected = DT.to_list()
+    holder = ArrowArrayHolder(DT.__arrow_c_array__())
+    del DT
+    gc.collect()
+    RES = dt.Frame(holder)
+    del holder
+    gc.collect()
+    assert RES.to_list() == expected
+
+
+def test_arrow_names_override():
+    DT = dt.Frame(A=[1], B=[2])
+    RES = dt.Frame(ArrowArrayHolder(DT.__arrow_c_array__()), names=["x", "y"])
+    assert RES.names == ("x", "y")
+
+
+def test_arrow_capsules_not_reusable():
+    DT = dt.Frame(A=[1, 2, 3])
+    holder = ArrowArrayHolder(DT.__arrow_c_array__())
+    dt.Frame(holder)
+    msg = "Invalid Arrow array: the array was already released"
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(holder)
+
+
+def test_arrow_export_obj_column():
+    DT = dt.Frame(A=[1, 2], B=[[1], [2]], stypes=[dt.int32, dt.obj64])
+    msg = "Column B of type obj64 cannot be exported into Arrow format"
+    with pytest.raises(TypeError, match=msg):
+        DT.__arrow_c_array__()
+
+
+def test_arrow_stypes_not_allowed():
+    DT = dt.Frame(A=[1, 2])
+    msg = "Argument stypes is not supported in Frame\\(\\) constructor when " \
+          "creating a Frame from an Arrow object"
+    with pytest.raises(TypeError, match=msg):
+        dt.Frame(ArrowArrayHolder(DT.__arrow_c_array__()), stype=dt.int64)
+
+
+
+#-------------------------------------------------------------------------------
+# Interoperability with pyarrow
+#-------------------------------------------------------------------------------
+
+def test_to_arrow(pyarrow):
+    DT = dt.Frame(A=[1, None, 3], B=[True, False, None], C=["a", None, "ccc"],
+                  D=[1.5, 2.5, None])
+    tbl = DT.to_arrow()
+    assert isinstance(tbl, pyarrow.Table)
+    assert tbl.column_names == ["A", "B", "C", "D"]
+    assert [str(t) for t in tbl.schema.types] == \
+           ["int32", "bool", "string", "double"]
+    assert tbl.to_pydict() == DT.to_dict()
+
+
+def test_pyarrow_from_capsules(pyarrow):
+    if not hasattr(pyarrow, "record_batch"):
+        pytest.skip("pyarrow is too old")
+    DT = dt.Frame(A=range(5), B=list("abcde"))
+    tbl = pyarrow.table(DT)
+    assert tbl.to_pydict() == DT.to_dict()
+
+
+def test_from_pyarrow(pyarrow):
+    tbl = pyarrow.table({
+        "i8": pyarrow.array([1, None, -3], pyarrow.int8()),
+        "u8": pyarrow.array([255, None, 3], pyarrow.uint8()),
+        "u32": pyarrow.array([2**32 - 1, None, 3], pyarrow.uint32()),
+        "f": pyarrow.array([1.5, None, -2.0], pyarrow.float32()),
+        "s": pyarrow.array(["x", "yy", None]),
+        "ls": pyarrow.array(["x", "yy", None], pyarrow.large_string()),
+        "b": pyarrow.array([True, None, False]),
+        "n": pyarrow.nulls(3),
+        "d": pyarrow.array(["q", None, "p"]).dictionary_encode(),
+    })
+    if not hasattr(tbl, "__arrow_c_stream__"):
+        pytest.skip("pyarrow does not support the PyCapsule protocol")
+    DT = dt.Frame(tbl)
+    frame_integrity_check(DT)
+    assert DT.names == ("i8", "u8", "u32", "f", "s", "ls", "b", "n", "d")
+    assert DT.stypes == (dt.int8, dt.int16, dt.int64, dt.float32, dt.str32,
+                         dt.str64, dt.bool8, dt.bool8, dt.str32)
+    assert DT.to_list() == [[1, None, -3], [255, None, 3],
+                            [2**32 - 1, None, 3], [1.5, None, -2.0],
+                            ["x", "yy", None], ["x", "yy", None],
+                            [True, None, False], [None] * 3,
+                            ["q", None, "p"]]
+
+
+def test_from_pyarrow_chunked(pyarrow):
+    tbl = pyarrow.concat_tables([pyarrow.table({"A": [1, 2], "B": ["a", None]}),
+                                 pyarrow.table({"A": [3], "B": ["c"]})])
+    if not hasattr(tbl, "__arrow_c_stream__"):
+        pytest.skip("pyarrow does not support the PyCapsule protocol")
+    DT = dt.Frame(tbl)
+    frame_integrity_check(DT)
+    assert DT.to_list() == [[1, 2, 3], ["a", None, "c"]]
+
+
+def test_from_pyarrow_sliced(pyarrow):
+    arr = pyarrow.array(["a", None, "bb", "ccc", None, "d"])
+    rb = pyarrow.record_batch([arr, pyarrow.array(range(6))],
+                              names=["s", "i"]).slice(1, 4)
+    if not hasattr(rb, "__arrow_c_array__"):
+        pytest.skip("pyarrow does not support the PyCapsule protocol")
+    DT = dt.Frame(rb)
+    frame_integrity_check(DT)
+    assert DT.to_list() == [[None, "bb", "ccc", None], [1, 2, 3, 4]]
@@ -21,10 +21,11 @@
 # FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 # IN THE SOFTWARE.
 #-------------------------------------------------------------------------------
+import math
 import pytest
 import random
 import datatable as dt
-from datatable import f, stype
+from datatable import f, stype, by
 from datatable.internal import frame_integrity_check
 from tests import assert_equals
 
@@ -217,3 +218,129 @@ def test_expr_names():
     # See issue #1963
     DT = dt.Frame(A=range(5), B=range(5))
     assert DT[:, [f.A, f.A + f.B]].names == ("A", "C0")
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(63)])
+def test_nested_expr_batches(seed):
+    # Nested virtual columns are materialized in batches of rows; make sure
+    # that NAs, casts and slices spanning several batches come out right.
+    random.seed(seed)
+    n = 5000
+    srcA = [random.choice([None] + list(range(-50, 50))) for _ in range(n)]
+    srcB = [random.choice([None, 0.5, -2.25, 3.0, 7.5]) for _ in range(n)]
+    srcC = [random.choice([None, True, False]) for _ in range(n)]
+    DT = dt.Frame(A=srcA, B=srcB, C=srcC,
+                  stypes={"A": dt.int32, "B": dt.float64, "C": dt.bool8})
+    RES = DT[:, [f.A * 2 + f.B,
+                 dt.float32(f.A) + f.C,
+                 dt.int64(f.C) * 3,
+                 f.A // 7]]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [
+        [None if a is None or b is None else a * 2 + b
+         for a, b in zip(srcA, srcB)],
+        [None if a is None or c is None else a + c
+         for a, c in zip(srcA, srcC)],
+        [None if c is None else c * 3 for c in srcC],
+        [None if a is None else a // 7 for a in srcA]
+    ]
+    SLICE = DT[100:4900, :][:, f.A - f.B]
+    assert SLICE.to_list()[0] == \
+        [None if a is None or b is None else a - b
+         for a, b in zip(srcA[100:4900], srcB[100:4900])]
+    SLICE = DT[7::3, :][:, f.A + 1]
+    assert SLICE.to_list()[0] == \
+        [None if a is None else a + 1 for a in srcA[7::3]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(63)])
+def test_fused_arithmetic(seed):
+    # Arithmetic expression trees are compiled into fused columns; the
+    # results must be the same as when evaluating them op-by-op.
+    random.seed(seed)
+    n = 300
+    names = ["B", "I8", "I32", "I64", "F32", "F64"]
+    DT = dt.Frame(
+        B=[random.choice([None, True, False]) for _ in range(n)],
+        I8=[random.choice([None, 0, 3, -100, 127]) for _ in range(n)],
+        I32=[random.choice([None, 0, 1, -7, 10**6]) for _ in range(n)],
+        I64=[random.choice([None, 0, 2**40, -5]) for _ in range(n)],
+        F32=[random.choice([None, 0.0, 1.5, -2.25]) for _ in range(n)],
+        F64=[random.choice([None, 0.0, -1.75, 1e10, math.inf]) for _ in range(n)],
+        G=[random.randint(0, 5) for _ in range(n)],
+        stypes={"B": stype.bool8, "I8": stype.int8, "I32": stype.int32,
+                "I64": stype.int64, "F32": stype.float32,
+                "F64": stype.float64})
+
+    def random_expr(depth):
+        if depth == 0 or random.random() < 0.2:
+            if random.random() < 0.2:
+                return random.choice([1, -3, 0.5])
+            return f[random.choice(names)]
+        lhs = random_expr(depth - 1)
+        rhs = random_expr(depth - 1)
+        op = random.choice("+-*/")
+        return (lhs + rhs if op == "+" else
+                lhs - rhs if op == "-" else
+                lhs * rhs if op == "*" else
+                lhs / rhs)
+
+    exprs = [random_expr(4) for _ in range(20)]
+    exprs = [e for e in exprs if isinstance(e, dt.FExpr)]
+    for query in [lambda: DT[:, exprs],
+                  lambda: DT[::2, exprs],
+                  lambda: DT[:, [e + dt.sum(f.I32) for e in exprs], by(f.G)]]:
+        with dt.options.fexpr.context(fuse=True):
+            RES1 = query()
+        with dt.options.fexpr.context(fuse=False):
+            RES2 = query()
+        frame_integrity_check(RES1)
+        assert_equals(RES1, RES2)
+
+
+def test_fused_arithmetic_fallback():
+    DT = dt.Frame(A=range(5), B=[1.5] * 5, S=list("abcde"))
+    RES = DT[:, f[:2] * 2 + f.A]
+    assert RES.to_list() == [[0, 3, 6, 9, 12], [3.0, 4.0, 5.0, 6.0, 7.0]]
+    RES = DT[:, f.S + f.S + "?"]
+    assert RES.to_list() == [["aa?", "bb?", "cc?", "dd?", "ee?"]]
+    RES = DT[:, f.A * None + f.B]
+    assert RES.stypes == (stype.float64,)
+    assert RES.to_list() == [[None] * 5]
+
+
+def test_common_subexpressions():
+    DT = dt.Frame(x=[1, 2, None, 4, 5], y=[2.0, 0.5, 1.0, None, 2.0],
+                  g=[1, 1, 2, 2, 2])
+    ratio = [1/2, 4, None, None, 5/2]
+    RES = DT[:, [f.x / f.y, -(f.x / f.y), (f.x / f.y) * 2]]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [ratio,
+                             [None if r is None else -r for r in ratio],
+                             [None if r is None else r * 2 for r in ratio]]
+    RES = DT[:, {"a": dt.math.abs(f.x), "b": dt.math.abs(f.x) + 1}]
+    assert RES.names == ("a", "b")
+    assert RES.to_list() == [[1, 2, None, 4, 5], [2, 3, None, 5, 6]]
+    RES = DT[:, [dt.sum(f.x * f.y), dt.max(f.x * f.y), f.x * f.y], by(f.g)]
+    assert RES.to_list() == [[1, 1, 2, 2, 2], [3.0, 3.0, 10.0, 10.0, 10.0],
+                             [2.0, 2.0, 10.0, 10.0, 10.0],
+                             [2.0, 1.0, None, None, 10.0]]
+    DT[:, ["p", "q"]] = [f.x * f.y, f.x * f.y + 1]
+    assert DT["p"].to_list() == [[2.0, 1.0, None, None, 10.0]]
+    assert DT["q"].to_list() == [[3.0, 2.0, None, None, 11.0]]
+
+
+def test_deeply_nested_expr():
+    # Each level of a nested virtual column needs its own batch buffers;
+    # these must not be placed on the (limited) C stack
+    DT = dt.Frame(A=range(3000), B=[0.5] * 3000)
+    expr = f.A
+    for _ in range(1000):
+        expr = dt.math.fabs(expr - f.B)
+    RES = DT[:, expr]
+    RES.materialize()
+    frame_integrity_check(RES)
+    expected = list(range(3000))
+    for _ in range(1000):
+        expected = [abs(x - 0.5) for x in expected]
+    assert RES.to_list()[0] == expected
@@ -433,3 +433,92 @@ def test_int_row_with_by():
     assert_equals(DT[-2, :, by(f.A)], dt.Frame(A=[1, 2], B=[3, 1]))
     assert_equals(DT[-3, :, by(f.A)], dt.Frame(A=[1], B=[0], stype=dt.int32))
     assert_equals(DT[-4, :, by(f.A)], dt.Frame(A=[], B=[], stype=dt.int32))
+
+
+
+#-------------------------------------------------------------------------------
+# Hash-based grouping
+#-------------------------------------------------------------------------------
+
+def _group_both_ways(DT, j, byexpr):
+    # Evaluate `DT[:, j, byexpr]` using the sort-based grouping, and then
+    # using the hash-based grouping, and check that the results are equal
+    with dt.options.sort.context(hash_groupby_threshold=1 << 62):
+        expected = DT[:, j, byexpr]
+    with dt.options.sort.context(hash_groupby_threshold=0):
+        result = DT[:, j, byexpr]
+    frame_integrity_check(result)
+    assert_equals(result, expected)
+    return result
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_group_hashed_random_strings(seed):
+    random.seed(seed)
+    n = random.randint(1, 10000)
+    ngroups = random.randint(1, 200)
+    keys = ["k%d" % i for i in range(ngroups)] + [None, ""]
+    DT = dt.Frame(K=[random.choice(keys) for _ in range(n)],
+                  X=[random.random() for _ in range(n)])
+    RES = _group_both_ways(DT, [count(), sum(f.X)], by(f.K))
+    assert RES.nrows == len(set(DT["K"].to_list()[0]))
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_group_hashed_random_wide_ints(seed):
+    random.seed(seed)
+    n = random.randint(1, 10000)
+    keys = [random.getrandbits(62) for _ in range(random.randint(1, 100))]
+    keys.append(None)
+    DT = dt.Frame(K=[random.choice(keys) for _ in range(n)], X=range(n))
+    _group_both_ways(DT, [count(), min(f.X), max(f.X)], by(f.K))
+    # Non-reducer: order of rows within each group must be preserved
+    _group_both_ways(DT, f.X, by(f.K))
+
+
+def test_group_hashed_full_int64_range():
+    # The range max - min does not fit into int64
+    big = 2**63 - 1
+    src = [-big, big, 0, None, big, -big, 1] * 50
+    DT = dt.Frame(K=src, X=range(len(src)), stypes={"K": dt.int64})
+    RES = _group_both_ways(DT, [count(), sum(f.X)], by(f.K))
+    assert RES["K"].to_list()[0] == [None, -big, 0, 1, big]
+    assert RES["count"].to_list()[0] == [50, 100, 50, 50, 100]
+
+
+def test_group_hashed_floats():
+    src = [0.0, -0.0, None, 1.5, float("inf"), -1.5, 1.5, -0.0, None,
+           float("-inf"), 0.0] * 100
+    DT = dt.Frame(K=src, X=range(len(src)))
+    RES = _group_both_ways(DT, [count(), sum(f.X)], by(f.K))
+    assert RES["count"].to_list()[0] == [200, 100, 100, 200, 200, 200, 100]
+
+
+def test_group_hashed_multiple_columns():
+    n = 5000
+    DT = dt.Frame(A=[random.choice(["a", "b", None]) for _ in range(n)],
+                  B=[random.choice([-10**15, 3, 10**15]) for _ in range(n)],
+                  C=[random.random() for _ in range(n)])
+    RES = _group_both_ways(DT, [count(), mean(f.C)], by(f.A, f.B))
+    assert RES.nrows == 9
+
+
+def test_group_hashed_high_cardinality():
+    # All keys are unique: hashing is abandoned in favor of sorting
+    n = 100000
+    keys = ["%x" % random.getrandbits(64) for _ in range(n)]
+    DT = dt.Frame(K=keys, X=range(n))
+    RES = _group_both_ways(DT, sum(f.X), by(f.K))
+    assert RES.nrows == len(set(keys))
+
+
+def test_group_hashed_many_threads():
+    # The local tables are merged in several partitions in parallel;
+    # the keys are skewed, so that some groups span all chunks
+    random.seed(3)
+    n = 100000
+    keys = ["k%d" % int(random.paretovariate(1.0)) for _ in range(n)]
+    DT = dt.Frame(K=keys, X=range(n))
+    with dt.options.context(nthreads=8):
+        _group_both_ways(DT, [count(), min(f.X), max(f.X)], by(f.K))
+        _group_both_ways(DT, f.X, by(f.K))
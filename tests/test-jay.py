@@ -28,6 +28,8 @@ import pickle
 import pytest
 import random
 import shutil
+import struct
+from datatable import f
 from datatable.exceptions import DatatableWarning
 from datatable.internal import frame_integrity_check
 from tests import assert_equals, noop, isview
@@ -210,6 +212,408 @@ def test_jay_rbound_column(tempfile_jay):
 
 
 
+#-------------------------------------------------------------------------------
+# Compression
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("codec", ["lz4", "zlib"])
+def test_jay_compressed_all_types(tempfile_jay, codec):
+    d0 = dt.Frame([[True, False, None, True, True],
+                   [None, 1, -9, 12, 3],
+                   [4, 1346, 999, None, None],
+                   [591, 0, None, -395734, 19384709],
+                   [None, 777, 1093487019384, -384, None],
+                   [2.987, 3.45e-24, -0.189134e+12, 45982.1, None],
+                   [39408.301, 9.459027045e-125, 4.4508e+222, None, 3.14159],
+                   ["Life", "Liberty", "and", "Pursuit of Happiness", None],
+                   ["кохайтеся", "чорнобриві", ",", "та", "не з москалями"]
+                   ],
+                  stypes=[dt.bool8, dt.int8, dt.int16, dt.int32, dt.int64,
+                          dt.float32, dt.float64, dt.str32, dt.str64])
+    d0.to_jay(tempfile_jay, compression=codec)
+    d1 = dt.fread(tempfile_jay)
+    frame_integrity_check(d1)
+    assert_equals(d0, d1)
+
+
+@pytest.mark.parametrize("codec", ["lz4", "zlib"])
+def test_jay_compressed_large(tempfile_jay, codec):
+    # Several blocks per column, some of which are not compressible
+    n = 700000
+    random.seed(n)
+    d0 = dt.Frame(A=range(n),
+                  B=[random.random() for _ in range(n)],
+                  C=["id%d" % (i % 1000) if i % 7 else None for i in range(n)],
+                  D=[i // 1000 for i in range(n)],
+                  stypes={"A": dt.int64, "D": dt.int32})
+    d0.to_jay(tempfile_jay, compression=codec)
+    d1 = dt.fread(tempfile_jay)
+    assert os.path.getsize(tempfile_jay) < d0.__sizeof__()
+    assert_equals(d0, d1)
+    # Bytes objects also support compression
+    assert_equals(dt.fread(d0.to_jay(compression=codec)), d0)
+
+
+def test_jay_compressed_rbound_column(tempfile_jay):
+    data = ["loooooooooooooooooooooooong"] * 10000 + ["A"] * 30000
+    src = "Z\n%s\n" % "\n".join(data)
+    DT = dt.fread(src)
+    assert dt.internal.frame_columns_virtual(DT)[0] is True
+    DT.to_jay(tempfile_jay, compression="lz4")
+    RES = dt.fread(tempfile_jay)
+    frame_integrity_check(RES)
+    assert_equals(RES, dt.Frame(Z=data))
+
+
+def test_jay_compressed_empty():
+    DT = dt.Frame(A=[], B=[], stypes=[dt.int32, dt.str32])
+    assert_equals(dt.fread(DT.to_jay(compression="zlib")), DT)
+
+
+def test_jay_compressed_corrupted():
+    DT = dt.Frame(A=list(range(1000)) * 10)
+    data = bytearray(DT.to_jay(compression="lz4"))
+    assert data[8:16] != bytes(8)
+    data[8:16] = bytes(8)
+    RES = dt.fread(bytes(data))
+    with pytest.raises(IOError, match="Invalid LZ4 data"):
+        RES.to_list()
+
+
+def test_jay_compressed_block_sizes_overflow():
+    # Random data is not compressible, so both blocks are stored as-is;
+    # the sizes of the blocks are then replaced with the values whose sum
+    # wraps around to the correct total length
+    random.seed(17)
+    n = 200000
+    DT = dt.Frame(A=[random.getrandbits(62) for _ in range(n)], stype=dt.int64)
+    data = bytearray(DT.to_jay(compression="lz4"))
+    sizes = struct.pack("<QQ", 1 << 20, 8 * n - (1 << 20))
+    pos = data.find(sizes)
+    assert pos > 0
+    data[pos:pos + 16] = struct.pack("<QQ", 2**64 - 8, 8 * n + 8)
+    with pytest.raises(IOError, match="Invalid Jay file: compressed block 0 "
+                                      "is out of bounds"):
+        dt.fread(bytes(data))
+
+
+def test_jay_compressed_version(tempfile_jay):
+    # Compressed files cannot be read by the version-1 readers, so they
+    # have a different signature
+    DT = dt.Frame(A=range(100))
+    data = DT.to_jay(compression="lz4")
+    assert data[:8] == b"JAY2\x00\x00\x00\x00"
+    assert data[-8:] == b"\x00\x00\x00\x002JAY"
+    assert DT.to_jay()[:8] == b"JAY1\x00\x00\x00\x00"
+    DT.to_jay(tempfile_jay)
+    DT.to_jay(tempfile_jay, append=True)
+    with open(tempfile_jay, "rb") as inp:
+        assert inp.read(8) == b"JAY2\x00\x00\x00\x00"
+    assert_equals(dt.fread(tempfile_jay), dt.rbind(DT, DT))
+    bad = b"JAY3" + data[4:]
+    with pytest.raises(IOError, match="Unsupported Jay file version: 3"):
+        dt.fread(bad)
+
+
+def test_jay_compression_bad():
+    DT = dt.Frame(A=[1, 2, 3])
+    msg = r"Parameter compression in Frame.to_jay\(\) should be one of None, " \
+          r"'lz4' or 'zlib'; instead got 'gzip'"
+    with pytest.raises(ValueError, match=msg):
+        DT.to_jay(compression="gzip")
+
+
+
+#-------------------------------------------------------------------------------
+# Zone maps
+#-------------------------------------------------------------------------------
+
+def test_jay_zone_maps_filter():
+    src = dt.Frame(A=[i % 17 if i % 11 else None for i in range(1000)],
+                   B=[i / 10 if i % 13 else None for i in range(1000)],
+                   C=[i < 300 if i % 7 else None for i in range(1000)],
+                   D=list(range(1000)),
+                   S=[str(i) for i in range(1000)],
+                   stypes={"B": dt.float32})
+    DT = dt.fread(src.to_jay(chunk_nrows=64))
+    frame_integrity_check(DT)
+    assert DT.to_list() == src.to_list()
+    filters = [f.D < 100, f.D >= 950, f.D == 500, f.D != 3, 250 >= f.D,
+               f.D > 2000, f.D <= -1, f.A == 3, f.A == None, f.A != None,
+               f.B > 50, f.B <= 0.1, f.B == 20.5, f.B < 7, f.B == None,
+               f.D > 99.5, f.D < 10.0, f.C, ~f.C, f.C == True, f.C == False,
+               (f.D < 100) | (f.D > 900), (f.D > 100) & (f.D < 200),
+               ~(f.D < 900), (f.C | (f.D > 990)) & (f.A != 5),
+               (f.D > 100) & (f.S == "150"), f[3] >= 999, f["D"] < 5]
+    for flt in filters:
+        assert_equals(DT[flt, :], src[flt, :])
+
+
+def test_jay_zone_maps_skip_row_groups():
+    # The data within the first row group is corrupted in the file,
+    # however the filter never reads it because the zone map tells
+    # that the group contains no values greater than 15
+    src = dt.Frame(A=range(100), stype=dt.int32)
+    data = bytearray(src.to_jay(chunk_nrows=10))
+    assert data[8:12] == b"\0\0\0\0"
+    data[8:12] = (10**6).to_bytes(4, "little")
+    DT = dt.fread(bytes(data))
+    assert DT[0, 0] == 10**6
+    assert_equals(DT[f.A > 15, :], dt.Frame(A=range(16, 100), stype=dt.int32))
+    assert_equals(DT[(f.A > 15) & (f.A < 25), :],
+                  dt.Frame(A=range(16, 25), stype=dt.int32))
+    assert DT[f.A >= 0, :].nrows == 100
+
+
+def test_jay_zone_maps_modified_frame():
+    src = dt.Frame(A=range(100))
+    DT = dt.fread(src.to_jay(chunk_nrows=10))
+    DT[5, "A"] = 1000
+    DT[f.A == 95, "A"] = -1
+    assert_equals(DT[f.A > 100, :], dt.Frame(A=[1000]))
+    assert_equals(DT[f.A < 0, :], dt.Frame(A=[-1]))
+    DT = dt.fread(src.to_jay(chunk_nrows=10))
+    DT.nrows = 150
+    assert DT[f.A == None, :].nrows == 50
+    assert DT[f.A >= 0, :].nrows == 100
+
+
+def test_jay_zone_maps_compressed(tempfile_jay):
+    src = dt.Frame(A=range(10000), B=[i * 0.5 for i in range(10000)])
+    src.to_jay(tempfile_jay, compression="lz4", chunk_nrows=1000)
+    DT = dt.fread(tempfile_jay)
+    assert_equals(DT[f.A >= 9990, :], src[9990:, :])
+    flt = (f.B < 10) | (f.A == 5000)
+    assert_equals(DT[flt, :], src[flt, :])
+
+
+def test_jay_zone_maps_bad():
+    DT = dt.Frame(A=[1, 2, 3])
+    msg = r"Parameter chunk_nrows in Frame.to_jay\(\) should be positive"
+    with pytest.raises(ValueError, match=msg):
+        DT.to_jay(chunk_nrows=0)
+
+
+
+#-------------------------------------------------------------------------------
+# Appending & datasets
+#-------------------------------------------------------------------------------
+
+def test_jay_append(tempfile_jay):
+    DT1 = dt.Frame(A=[1, 2, None], B=["a", None, "ccc"], C=[0.5, 1.5, 2.5])
+    DT2 = dt.Frame(A=[7, 8], B=["dd", "e"], C=[None, 9.0])
+    DT1.to_jay(tempfile_jay)
+    DT2.to_jay(tempfile_jay, append=True)
+    DT = dt.fread(tempfile_jay)
+    frame_integrity_check(DT)
+    assert_equals(DT, dt.rbind(DT1, DT2))
+    assert DT.countna().to_list() == [[1], [1], [1]]
+
+
+def test_jay_append_multiple(tempfile_jay):
+    parts = [dt.Frame(A=range(i * 10, i * 10 + 5 + i),
+                      B=[str(j) * 2 for j in range(5 + i)])
+             for i in range(5)]
+    for i, part in enumerate(parts):
+        codec = [None, "lz4", "zlib"][i % 3]
+        part.to_jay(tempfile_jay, append=True, compression=codec)
+    DT = dt.fread(tempfile_jay)
+    frame_integrity_check(DT)
+    assert_equals(DT, dt.rbind(*parts))
+    assert DT[17, :].to_list() == [[26], ["66"]]
+
+
+def test_jay_append_to_nonexistent_file(tempdir):
+    filename = os.path.join(tempdir, "new.jay")
+    DT = dt.Frame(A=range(5))
+    DT.to_jay(filename, append=True)
+    assert_equals(dt.fread(filename), DT)
+
+
+def test_jay_append_zone_maps(tempfile_jay):
+    DT1 = dt.Frame(A=range(100), stype=dt.int32)
+    DT2 = dt.Frame(A=range(100, 250), stype=dt.int32)
+    DT1.to_jay(tempfile_jay, chunk_nrows=10)
+    # the row groups size of the file is reused for the appended data
+    DT2.to_jay(tempfile_jay, append=True)
+    with open(tempfile_jay, "r+b") as out:
+        out.seek(8)
+        out.write((10**6).to_bytes(4, "little"))
+    DT = dt.fread(tempfile_jay)
+    assert DT[0, 0] == 10**6
+    assert_equals(DT[(f.A > 95) & (f.A < 105), :],
+                  dt.Frame(A=range(96, 105), stype=dt.int32))
+    assert DT[f.A >= 200, :].nrows == 50
+
+
+def test_jay_append_bad(tempfile_jay):
+    dt.Frame(A=[1, 2], B=["x", "y"]).to_jay(tempfile_jay, chunk_nrows=5)
+    msg = r"Cannot append to Jay file .*: the names or types of the columns"
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[1.5], B=["z"]).to_jay(tempfile_jay, append=True)
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[3], C=["z"]).to_jay(tempfile_jay, append=True)
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[3]).to_jay(tempfile_jay, append=True)
+    msg = r"Cannot append to Jay file .* with chunk_nrows=7: the file uses " \
+          r"chunk_nrows=5"
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[3], B=["z"]).to_jay(tempfile_jay, append=True,
+                                        chunk_nrows=7)
+    msg = r"Parameter append in Frame.to_jay\(\) cannot be used when the " \
+          r"path is not given"
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[3]).to_jay(append=True)
+    assert_equals(dt.fread(tempfile_jay), dt.Frame(A=[1, 2], B=["x", "y"]))
+
+
+def test_jay_append_failed(tempfile_jay):
+    # Writing of the appended frame fails half-way through, since its
+    # data cannot be decompressed: the original file must survive
+    DT = dt.Frame(A=list(range(1000)) * 10)
+    data = bytearray(DT.to_jay(compression="lz4"))
+    data[8:16] = bytes(8)
+    BAD = dt.fread(bytes(data))
+    DT1 = dt.Frame(A=[1, 2, 3], stype=DT.stype)
+    DT1.to_jay(tempfile_jay)
+    with open(tempfile_jay, "rb") as inp:
+        original = inp.read()
+    with pytest.raises(IOError, match="Invalid LZ4 data"):
+        BAD.to_jay(tempfile_jay, append=True)
+    with open(tempfile_jay, "rb") as inp:
+        assert inp.read() == original
+    assert_equals(dt.fread(tempfile_jay), DT1)
+
+
+def test_jay_append_to_itself(tempfile_jay):
+    DT0 = dt.Frame(A=range(100), B=["x%d" % i for i in range(100)])
+    DT0.to_jay(tempfile_jay)
+    DT = dt.fread(tempfile_jay)
+    DT.to_jay(tempfile_jay, append=True)
+    assert_equals(DT, DT0)
+    RES = dt.fread(tempfile_jay)
+    frame_integrity_check(RES)
+    assert_equals(RES, dt.rbind(DT0, DT0))
+
+
+def test_jay_dataset(tempdir):
+    parts = [dt.Frame(A=[i * 10 + 5, i, None], B=["p%d" % i, None, "q"])
+             for i in range(4)]
+    # files are concatenated in alphabetical order of their names
+    for i, part in enumerate(parts):
+        part.to_jay(os.path.join(tempdir, "day%02d.jay" % i),
+                    compression=("lz4" if i % 2 else None))
+    with open(os.path.join(tempdir, "README"), "w") as out:
+        out.write("not a jay file")
+    DT = dt.open_jay_dataset(tempdir)
+    frame_integrity_check(DT)
+    assert DT.source == tempdir
+    assert_equals(DT, dt.rbind(*parts))
+    assert DT.countna().to_list() == [[4], [4]]
+
+
+def test_jay_dataset_appended_file(tempdir):
+    DT1 = dt.Frame(A=range(10))
+    DT2 = dt.Frame(A=range(10, 15))
+    DT1.to_jay(os.path.join(tempdir, "a.jay"), chunk_nrows=4)
+    DT2.to_jay(os.path.join(tempdir, "a.jay"), append=True)
+    DT2.to_jay(os.path.join(tempdir, "b.jay"), chunk_nrows=4)
+    DT = dt.open_jay_dataset(tempdir)
+    assert_equals(DT, dt.rbind(DT1, DT2, DT2))
+    assert_equals(DT[f.A > 12, :], dt.Frame(A=[13, 14, 13, 14]))
+
+
+def test_jay_dataset_incompatible(tempdir):
+    dt.Frame(A=[1]).to_jay(os.path.join(tempdir, "1.jay"))
+    dt.Frame(A=["x"]).to_jay(os.path.join(tempdir, "2.jay"))
+    msg = r"Jay file .*2\.jay cannot be opened as part of the dataset: " \
+          r"its columns are different from the columns of file .*1\.jay"
+    with pytest.raises(ValueError, match=msg):
+        dt.open_jay_dataset(tempdir)
+
+
+def test_jay_dataset_list_of_files(tempdir):
+    files = [os.path.join(tempdir, name) for name in ("b.jay", "a.jay")]
+    DT1 = dt.Frame(A=[1, 2], B=["x", "y"])
+    DT2 = dt.Frame(A=[3], B=[None], stypes={"B": dt.str32})
+    DT1.to_jay(files[0])
+    DT2.to_jay(files[1])
+    # files in a list are opened in the given order
+    DT = dt.open_jay_dataset(files)
+    frame_integrity_check(DT)
+    assert_equals(DT, dt.rbind(DT1, DT2))
+    assert_equals(dt.open_jay_dataset(tuple(files[1:])), DT2)
+
+
+def test_jay_dataset_errors(tempdir):
+    with pytest.raises(ValueError, match="contains no Jay files"):
+        dt.open_jay_dataset(tempdir)
+    with pytest.raises(ValueError, match="Jay dataset contains no files"):
+        dt.open_jay_dataset([])
+    with pytest.raises(ValueError, match="is not a directory"):
+        dt.open_jay_dataset(os.path.join(tempdir, "nope"))
+    with pytest.raises(TypeError):
+        dt.open_jay_dataset(5)
+
+
+def test_fread_directory_of_jay_files(tempdir):
+    dt.Frame(A=[1]).to_jay(os.path.join(tempdir, "1.jay"))
+    with pytest.raises(ValueError, match="is not a file"):
+        dt.fread(tempdir)
+
+
+
+#-------------------------------------------------------------------------------
+# Dictionary-encoded columns
+#-------------------------------------------------------------------------------
+
+def _categorical_frame(n):
+    words = ["red", "green", "", "blue"]
+    src = "\n".join(["A,B"] + ["%s,%d" % (words[i % 4], i) for i in range(n)])
+    with dt.options.fread.context(categorical_threshold=0.05):
+        return dt.fread(text=src)
+
+
+def test_jay_plain_by_default():
+    # Without opting into dictionary encoding, the frames read from CSV
+    # are saved in the format that older versions can read
+    DT = dt.fread(text="A\n" + "red\ngreen\n" * 500)
+    assert DT.to_jay()[:4] == b"JAY1"
+    assert _categorical_frame(1000).to_jay()[:4] == b"JAY2"
+
+
+def test_jay_categorical(tempfile_jay):
+    DT = _categorical_frame(1000)
+    DT.to_jay(tempfile_jay)
+    RES = dt.fread(tempfile_jay)
+    assert_equals(RES, DT)
+    plain = dt.Frame(DT.to_list(), names=DT.names, stypes=DT.stypes)
+    assert RES.__sizeof__() < plain.__sizeof__()
+    assert_equals(RES.sort("A"), DT.sort("A"))
+
+
+@pytest.mark.parametrize("codec", ["zlib", "lz4"])
+def test_jay_categorical_compressed(tempfile_jay, codec):
+    DT = _categorical_frame(50000)
+    DT.to_jay(tempfile_jay, compression=codec)
+    assert_equals(dt.fread(tempfile_jay), DT)
+
+
+def test_jay_categorical_bytes():
+    DT = _categorical_frame(100)
+    RES = dt.fread(DT.to_jay())
+    assert_equals(RES, DT)
+    assert RES.countna().to_list() == [[0], [0]]
+
+
+def test_jay_categorical_append(tempfile_jay):
+    DT = _categorical_frame(200)
+    DT.to_jay(tempfile_jay)
+    DT.to_jay(tempfile_jay, append=True)
+    assert_equals(dt.fread(tempfile_jay), dt.rbind(DT, DT))
+
+
+
 #-------------------------------------------------------------------------------
 # pickling
 #-------------------------------------------------------------------------------
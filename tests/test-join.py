@@ -220,6 +220,387 @@ def test_join_multi_random(seed):
     assert joinframe[:, "V"].to_list()[0] == rescol
 
 
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_join_multi_random_hash(seed):
+    # Same as the previous test, but forces the hash-join algorithm
+    with dt.options.join.context(hash_threshold=0):
+        test_join_multi_random(seed)
+
+
+@pytest.mark.parametrize("st", [dt.int8, dt.int32, dt.int64, dt.float32,
+                                dt.float64, dt.str32, dt.str64])
+def test_join_hash(st):
+    with dt.options.join.context(hash_threshold=0):
+        if st in (dt.str32, dt.str64):
+            keys = [None, "", "a", "ab", "abc", "b", "hello"]
+            src = ["abc", "x", None, "", "b", "ab", "hello", "hell", "a"]
+        else:
+            keys = [None, -3, 0, 1, 5, 7, 100]
+            src = [100, 1, None, 0, 2, -3, 5, 7, 8, 1]
+            if st == dt.int8:
+                src[0] = 99
+        J = dt.Frame(K=keys, V=range(len(keys)), stypes={"K": st})
+        J.key = "K"
+        X = dt.Frame(K=src, stype=st)
+        RES = X[:, :, join(J)]
+        frame_integrity_check(RES)
+        vals = dict(zip(*J.to_list()))
+        assert RES.to_list() == [src, [vals.get(x) for x in src]]
+
+
+def test_join_hash_mixed_types():
+    with dt.options.join.context(hash_threshold=0):
+        J = dt.Frame(K=[-0.0, 1.0, 2.5, 3.0], V=list("abcd"))
+        J.key = "K"
+        X = dt.Frame(K=[0, 1, 2, 3, 4, None], stype=dt.int64)
+        RES = X[:, :, join(J)]
+        frame_integrity_check(RES)
+        assert RES.to_list()[1] == ["a", "b", None, "d", None, None]
+
+
+def test_join_hash_large():
+    n = 200000
+    J = dt.Frame(K=range(0, 2 * n, 2), V=range(n))
+    J.key = "K"
+    X = dt.Frame(K=[(i * 7919) % (2 * n + 10) for i in range(n)])
+    RES = X[:, :, join(J)]
+    frame_integrity_check(RES)
+    xs = X.to_list()[0]
+    assert RES.to_list()[1] == [x // 2 if x % 2 == 0 and x < 2 * n else None
+                                for x in xs]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_join_merge_random(seed):
+    # X is sorted, so the merge join is used
+    random.seed(seed)
+    nj = random.randint(1, 1000)
+    nx = random.randint(1, 5000)
+    jkeys = sorted(random.sample(range(3 * nj), nj))
+    xkeys = sorted(random.choice(range(-5, 3 * nj + 5)) for _ in range(nx))
+    if random.random() < 0.5:
+        xkeys = [None] * random.randint(1, 10) + xkeys
+    J = dt.Frame(K=jkeys, V=range(nj))
+    J.key = "K"
+    X = dt.Frame(K=xkeys)
+    RES = X[:, :, join(J)]
+    frame_integrity_check(RES)
+    jdict = dict(zip(jkeys, range(nj)))
+    assert RES.to_list() == [xkeys, [jdict.get(k) for k in xkeys]]
+
+
+@pytest.mark.parametrize("st", [dt.int8, dt.int32, dt.int64, dt.float64,
+                                dt.str32])
+def test_join_merge_stypes(st):
+    if st == dt.str32:
+        jkeys = ["a", "bb", "d", "eee", "x"]
+        xkeys = [None, "a", "a", "b", "bb", "c", "eee", "eee", "y", "z"]
+    else:
+        jkeys = [1, 3, 4, 7, 10]
+        xkeys = [None, 0, 1, 1, 2, 3, 7, 7, 8, 11]
+    J = dt.Frame(K=jkeys, V=range(5), stypes={"K": st})
+    J.key = "K"
+    X = dt.Frame(K=xkeys, stype=st)
+    RES = X[:, :, join(J)]
+    frame_integrity_check(RES)
+    jdict = dict(zip(jkeys, range(5)))
+    assert RES.to_list()[1] == [jdict.get(k) for k in xkeys]
+
+
+def test_join_merge_multi_keyed():
+    # X is keyed by the join columns
+    J = dt.Frame(A=[1, 1, 2, 2, 3], B=["a", "b", "a", "c", "a"], V=range(5))
+    J.key = ["A", "B"]
+    X = dt.Frame(A=[0, 1, 1, 2, 2, 2, 3], B=["a", "a", "c", "a", "b", "c", "z"],
+                 W=range(7))
+    X.key = ["A", "B"]
+    RES = X[:, :, join(J)]
+    frame_integrity_check(RES)
+    assert RES.to_list()[3] == [None, 0, None, 2, None, 3, None]
+
+
+def test_join_merge_large():
+    n = 200000
+    J = dt.Frame(K=range(0, 2 * n, 2), V=range(n))
+    J.key = "K"
+    X = dt.Frame(K=range(-7, 3 * n, 3))
+    RES = X[:, :, join(J)]
+    frame_integrity_check(RES)
+    xs = X.to_list()[0]
+    assert RES.to_list()[1] == [x // 2 if x % 2 == 0 and 0 <= x < 2 * n
+                                else None for x in xs]
+
+
+def test_join_merge_almost_sorted():
+    # A single out-of-order row at the end makes X unsorted
+    J = dt.Frame(K=range(0, 1000, 2), V=range(500))
+    J.key = "K"
+    xkeys = list(range(1000)) + [4]
+    X = dt.Frame(K=xkeys)
+    RES = X[:, :, join(J)]
+    frame_integrity_check(RES)
+    assert RES.to_list()[1] == [k // 2 if k % 2 == 0 else None for k in xkeys]
+
+
+#-------------------------------------------------------------------------------
+# Join kinds
+#-------------------------------------------------------------------------------
+
+def _reference_join(xkeys, xvals, jkeys, jvals, how):
+    # Compute the expected result of `X[:, :, join(J, how=how)]` in pure
+    # python, where X = Frame(K=xkeys, A=xvals) and J = Frame(K=jkeys, V=jvals)
+    jdict = dict(zip(jkeys, jvals))
+    resK, resA, resV = [], [], []
+    for k, a in zip(xkeys, xvals):
+        matched = k in jdict
+        if how in ("inner", "semi", "right") and not matched: continue
+        if how == "anti" and matched: continue
+        resK.append(k)
+        resA.append(a)
+        resV.append(jdict.get(k))
+    if how in ("right", "outer"):
+        xset = set(xkeys)
+        for k, v in zip(jkeys, jvals):
+            if k not in xset:
+                resK.append(k)
+                resA.append(None)
+                resV.append(v)
+    if how in ("semi", "anti"):
+        return [resK, resA]
+    return [resK, resA, resV]
+
+
+@pytest.mark.parametrize("how", ["left", "inner", "semi", "anti",
+                                 "right", "outer"])
+def test_join_kinds_simple(how):
+    X = dt.Frame(K=[1, 2, 3, 2, 7], A=list("abcde"))
+    J = dt.Frame(K=[2, 3, 4, 5], V=["two", "three", "four", "five"])
+    J.key = "K"
+    RES = X[:, :, join(J, how=how)]
+    frame_integrity_check(RES)
+    expected = _reference_join([1, 2, 3, 2, 7], list("abcde"),
+                               [2, 3, 4, 5], ["two", "three", "four", "five"],
+                               how)
+    assert RES.names == ("K", "A", "V")[:len(expected)]
+    assert RES.to_list() == expected
+
+
+@pytest.mark.parametrize("how,seed", [(how, random.getrandbits(32))
+                                      for how in ["inner", "semi", "anti",
+                                                  "right", "outer"]])
+def test_join_kinds_random(how, seed):
+    random.seed(seed)
+    nx = int(random.expovariate(0.005)) + 1
+    nj = int(random.expovariate(0.005)) + 1
+    jkeys = list(set(random.randint(0, 2 * nj) for _ in range(nj)))
+    random.shuffle(jkeys)
+    xkeys = [random.randint(0, 2 * nj) for _ in range(nx)]
+    jvals = [random.random() for _ in jkeys]
+    xvals = [random.randint(-100, 100) for _ in xkeys]
+    J = dt.Frame(K=jkeys, V=jvals)
+    J.key = "K"
+    jkeys, jvals = J.to_list()
+    X = dt.Frame(K=xkeys, A=xvals)
+    expected = _reference_join(xkeys, xvals, jkeys, jvals, how)
+    with dt.options.join.context(hash_threshold=random.choice([0, 1 << 16])):
+        RES = X[:, :, join(J, how=how)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == expected
+
+
+def test_join_kinds_g_columns():
+    X = dt.Frame(K=[1, 2, 3], A=[10, 20, 30])
+    J = dt.Frame(K=[3, 4], V=["x", "y"])
+    J.key = "K"
+    RES = X[:, [f.K, g.K, g.V], join(J, how="outer")]
+    assert RES.to_list() == [[1, 2, 3, None], [None, None, 3, 4],
+                             [None, None, "x", "y"]]
+    RES = X[:, g.V, join(J, how="semi")]
+    assert RES.to_list() == [["x"]]
+
+
+def test_join_inner_with_groupby():
+    X = dt.Frame(K=[1, 2, 3, 2, 1, 5], A=[1, 2, 3, 4, 5, 6])
+    J = dt.Frame(K=[1, 2, 3], W=[100, 200, 300])
+    J.key = "K"
+    RES = X[:, dt.sum(g.W), join(J, how="inner"), dt.by(f.K)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[1, 2, 3], [200, 400, 300]]
+
+
+def test_join_anti_with_filter():
+    X = dt.Frame(K=[1, 2, 3, 2, 7], A=list("abcde"))
+    J = dt.Frame(K=[2, 3], V=[True, False])
+    J.key = "K"
+    RES = X[f.K > 1, :, join(J, how="anti")]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[7], ["e"]]
+
+
+def test_join_kinds_chained():
+    X = dt.Frame(A=[1, 2, 3, 2], B=list("abcd"))
+    J1 = dt.Frame(A=[2, 3, 4], V=["two", "three", "four"])
+    J1.key = "A"
+    J2 = dt.Frame(B=["a", "d", "z"], W=[10, 20, 30])
+    J2.key = "B"
+    RES = X[:, :, join(J1, how="inner"), join(J2, how="outer")]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[2, 3, 2, None, None],
+                             ["b", "c", "d", "a", "z"],
+                             ["two", "three", "two", None, None],
+                             [None, None, 20, 10, 30]]
+
+
+def test_join_kinds_empty():
+    X = dt.Frame(K=[], A=[], stypes=[dt.int32, dt.str32])
+    J = dt.Frame(K=[1, 2], V=[True, False])
+    J.key = "K"
+    assert X[:, :, join(J, how="inner")].shape == (0, 3)
+    assert X[:, :, join(J, how="anti")].shape == (0, 2)
+    assert X[:, :, join(J, how="outer")].to_list() == \
+           [[1, 2], [None, None], [True, False]]
+
+
+@pytest.mark.parametrize("how", ["right", "outer"])
+def test_join_kinds_delete_invalid(how):
+    X = dt.Frame(A=[1, 2, 3], B=[4, 5, 6])
+    J = dt.Frame(A=[2, 7], C=[0, 0])
+    J.key = "A"
+    msg = 'Cannot delete from a Frame joined with how="%s"' % how
+    with pytest.raises(ValueError, match=msg):
+        del X[:, :, join(J, how=how)]
+    with pytest.raises(ValueError, match=msg):
+        del X[:, "B", join(J, how=how)]
+    assert_equals(X, dt.Frame(A=[1, 2, 3], B=[4, 5, 6]))
+
+
+def test_join_kinds_delete():
+    X = dt.Frame(A=[1, 2, 3, 2], B=[4, 5, 6, 7])
+    J = dt.Frame(A=[2, 7], C=[0, 0])
+    J.key = "A"
+    del X[:, :, join(J, how="inner")]
+    assert_equals(X, dt.Frame(A=[1, 3], B=[4, 6]))
+
+
+def test_join_how_property():
+    J = dt.Frame(A=[1])
+    J.key = "A"
+    assert join(J).how == "left"
+    assert join(J, how="anti").how == "anti"
+
+
+def test_join_how_invalid():
+    J = dt.Frame(A=[1])
+    J.key = "A"
+    with pytest.raises(ValueError) as e:
+        join(J, how="cross")
+    assert ("Invalid value cross for parameter how in join()"
+            in str(e.value))
+
+
+
+
+#-------------------------------------------------------------------------------
+# Joins on non-unique columns
+#-------------------------------------------------------------------------------
+
+def _reference_join_multi(xrows, jrows, nkeys, how):
+    # Rows are tuples, whose first `nkeys` elements constitute the key;
+    # the result is a list of rows, each row is a tuple.
+    jgroups = {}
+    for jrow in jrows:
+        jgroups.setdefault(jrow[:nkeys], []).append(jrow)
+    jna = (None,) * (len(jrows[0]) - nkeys if jrows else 0)
+    xna = (None,) * (len(xrows[0]) - nkeys if xrows else 0)
+    res = []
+    for xrow in xrows:
+        matches = jgroups.get(xrow[:nkeys], [])
+        if how == "semi" and matches: res.append(xrow)
+        if how == "anti" and not matches: res.append(xrow)
+        if how in ("semi", "anti"): continue
+        for jrow in matches:
+            res.append(xrow + jrow[nkeys:])
+        if not matches and how in ("left", "outer"):
+            res.append(xrow + jna)
+    if how in ("right", "outer"):
+        xkeys = set(xrow[:nkeys] for xrow in xrows)
+        for key in sorted(jgroups, key=lambda k: [(v is not None, v) for v in k]):
+            if key not in xkeys:
+                for jrow in jgroups[key]:
+                    res.append(jrow[:nkeys] + xna + jrow[nkeys:])
+    return res
+
+
+@pytest.mark.parametrize("how", ["left", "inner", "semi", "anti",
+                                 "right", "outer"])
+def test_join_on_simple(how):
+    X = dt.Frame(id=[1, 2, 3, 2, 7], B=list("abcde"))
+    J = dt.Frame(id=[2, 3, 2, 4, 3, 3], V=list("pqrstu"))
+    RES = X[:, :, join(J, on="id", how=how)]
+    frame_integrity_check(RES)
+    xrows = list(zip(*X.to_list()))
+    jrows = list(zip(*J.to_list()))
+    expected = _reference_join_multi(xrows, jrows, 1, how)
+    assert list(zip(*RES.to_list())) == expected
+
+
+@pytest.mark.parametrize("how,seed", [(how, random.getrandbits(32))
+                                      for how in ["left", "inner", "semi",
+                                                  "anti", "right", "outer"]])
+def test_join_on_random(how, seed):
+    random.seed(seed)
+    nkeys = random.randint(1, 2)
+    nx = int(random.expovariate(0.01)) + 1
+    nj = int(random.expovariate(0.01)) + 1
+    keysrc = [list(range(10)) + [None], list("abcde")]
+    xrows = [tuple(random.choice(keysrc[k]) for k in range(nkeys)) +
+             (random.randint(0, 100),) for _ in range(nx)]
+    jrows = [tuple(random.choice(keysrc[k]) for k in range(nkeys)) +
+             (random.random(),) for _ in range(nj)]
+    names = ["K0", "K1"][:nkeys]
+    X = dt.Frame(xrows, names=names + ["A"])
+    J = dt.Frame(jrows, names=names + ["V"])
+    with dt.options.join.context(hash_threshold=random.choice([0, 1 << 16])):
+        RES = X[:, :, join(J, on=names, how=how)]
+    frame_integrity_check(RES)
+    expected = _reference_join_multi(xrows, jrows, nkeys, how)
+    assert list(zip(*RES.to_list())) == expected
+
+
+def test_join_on_key_columns():
+    X = dt.Frame(id=[1, 2, 3, 2])
+    J = dt.Frame(id=[2, 3], W=[1, 2])
+    J.key = "id"
+    RES = X[:, :, join(J, on="id", how="inner")]
+    assert RES.to_list() == [[2, 3, 2], [1, 2, 1]]
+
+
+def test_join_on_g_columns():
+    X = dt.Frame(id=[1, 2], A=[5, 6])
+    J = dt.Frame(id=[2, 2, 1], V=[7, 8, 9])
+    RES = X[:, [f.A, g.id, g.V, f.A + g.V], join(J, on="id")]
+    assert RES.to_list() == [[5, 6, 6], [1, 2, 2], [9, 7, 8], [14, 13, 14]]
+
+
+def test_join_on_property():
+    J = dt.Frame(A=[1], B=[2])
+    assert join(J, on="A").on == ["A"]
+    assert join(J, on=("B", "A")).on == ["B", "A"]
+
+
+def test_join_on_errors():
+    J = dt.Frame(A=[1], B=[2])
+    with pytest.raises(KeyError):
+        join(J, on="C")
+    with pytest.raises(ValueError):
+        join(J, on=[])
+    with pytest.raises(ValueError) as e:
+        noop(dt.Frame(C=[1])[:, :, join(J, on="A")])
+    assert "Key column A does not exist in the left Frame" in str(e.value)
+
+
+
+
 def test_issue1481():
     DT = dt.Frame(A=range(5))
     with pytest.raises(ValueError) as e:
@@ -34,21 +34,34 @@ def test_options_all():
     assert set(dir(dt.options)) == {
         "nthreads",
         "debug",
+        "fexpr",
         "sort",
         "display",
         "frame",
         "fread",
         "progress",
+        "join",
     }
     assert set(dir(dt.options.sort)) == {
+        "hash_groupby_threshold",
         "insert_method_threshold",
         "max_chunk_length",
         "max_radix_bits",
+        "memory_limit",
         "new",
         "nthreads",
         "over_radix_bits",
+        "tempdir",
         "thread_multiplier",
     }
+    assert set(dir(dt.options.join)) == {
+        "hash_threshold",
+    }
+    assert set(dir(dt.options.fexpr)) == {
+        "cse",
+        "fuse",
+        "order_filters",
+    }
     assert set(dir(dt.options.display)) == {
         "allow_unicode",
         "head_nrows",
@@ -64,6 +77,7 @@ def test_options_all():
     }
     assert set(dir(dt.options.fread)) == {
         "anonymize",
+        "categorical_threshold",
         "log",
     }
     assert set(dir(dt.options.progress)) == {
@@ -0,0 +1,304 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#-------------------------------------------------------------------------------
+# Copyright 2018-2021 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#-------------------------------------------------------------------------------
+import datatable as dt
+import pytest
+import random
+from datatable.exceptions import DatatableWarning, IOError
+from datatable.internal import frame_integrity_check
+from tests import assert_equals
+
+
+
+#-------------------------------------------------------------------------------
+# Writing and reading back
+#-------------------------------------------------------------------------------
+
+def test_parquet_simple(tempfile_parquet):
+    DT = dt.Frame(A=[-1, 7, 10000, 12],
+                  B=[True, None, False, None],
+                  C=["alpha", "beta", None, "delta"])
+    DT.to_parquet(tempfile_parquet)
+    with open(tempfile_parquet, "rb") as inp:
+        data = inp.read()
+    assert data[:4] == b"PAR1"
+    assert data[-4:] == b"PAR1"
+    RES = dt.fread(tempfile_parquet)
+    assert RES.source == tempfile_parquet
+    assert_equals(RES, DT)
+
+
+def test_parquet_bytes_object():
+    DT = dt.Frame(A=range(10), B=list("abcdefghij"))
+    out = DT.to_parquet()
+    assert isinstance(out, bytes)
+    assert_equals(dt.fread(out), DT)
+
+
+def test_parquet_all_types(tempfile_parquet):
+    DT = dt.Frame([[True, False, None, True],
+                   [1, None, -3, 127],
+                   [1000, -2, None, 32767],
+                   [None, 1, 2, 3],
+                   [2**40, None, -7, 0],
+                   [1.5, None, -2.25, 1e10],
+                   [3.14159, None, 0.0, -1e300],
+                   ["a", None, "", "dd"],
+                   ["x", "y", None, "zzz"]],
+                  stypes=[dt.bool8, dt.int8, dt.int16, dt.int32, dt.int64,
+                          dt.float32, dt.float64, dt.str32, dt.str64],
+                  names=list("ABCDEFGHI"))
+    DT.to_parquet(tempfile_parquet)
+    RES = dt.fread(tempfile_parquet)
+    frame_integrity_check(RES)
+    assert RES.names == DT.names
+    # str64 columns are read back as str32
+    assert RES.stypes == DT.stypes[:-1] + (dt.str32,)
+    assert RES.to_list() == DT.to_list()
+
+
+@pytest.mark.parametrize("codec", [None, "snappy", "gzip", "lz4"])
+def test_parquet_compression(tempfile_parquet, codec):
+    n = 50000
+    DT = dt.Frame(A=[random.choice([None, 1, 2, -5]) for _ in range(n)],
+                  B=[random.random() for _ in range(n)],
+                  C=["id" + str(i % 1000) for i in range(n)],
+                  D=["x" * random.randint(0, 20) for _ in range(n)])
+    DT.to_parquet(tempfile_parquet, compression=codec)
+    RES = dt.fread(tempfile_parquet)
+    frame_integrity_check(RES)
+    assert_equals(RES, DT)
+
+
+@pytest.mark.parametrize("codec", ["snappy", "gzip"])
+def test_parquet_compression_ratio(codec):
+    DT = dt.Frame(A=[5] * 100000, B=["abc"] * 100000)
+    plain = DT.to_parquet()
+    compressed = DT.to_parquet(compression=codec)
+    assert len(compressed) < len(plain)
+
+
+def test_parquet_row_groups(tempfile_parquet):
+    DT = dt.Frame(A=range(1000), B=[None, "b", "c", "d"] * 250)
+    DT.to_parquet(tempfile_parquet, row_group_size=77)
+    RES = dt.fread(tempfile_parquet)
+    frame_integrity_check(RES)
+    assert_equals(RES, DT)
+
+
+def test_parquet_multiple_pages():
+    # Columns larger than 65536 rows are split into several data pages
+    n = 200000
+    DT = dt.Frame(A=range(n), B=[str(i) for i in range(n)],
+                  C=[i % 3 == 0 for i in range(n)])
+    RES = dt.fread(DT.to_parquet(compression="snappy"))
+    frame_integrity_check(RES)
+    assert_equals(RES, DT)
+
+
+def test_parquet_categorical():
+    DT = dt.Frame(A=["red", "green", None, "blue"] * 1000)
+    # dictionary encoding is used in the file, but the result is the same
+    # as for the plain encoding
+    RES = dt.fread(DT.to_parquet())
+    assert_equals(RES, DT)
+
+
+def test_parquet_view():
+    DT = dt.Frame(A=range(100), B=[str(i) for i in range(100)])[::-3, :]
+    RES = dt.fread(DT.to_parquet())
+    assert RES.to_list() == DT.to_list()
+
+
+def test_parquet_empty_frame():
+    RES = dt.fread(dt.Frame().to_parquet())
+    assert RES.shape == (0, 0)
+
+
+def test_parquet_zero_rows():
+    DT = dt.Frame(A=[], B=[], stypes=[dt.int32, dt.str32])
+    RES = dt.fread(DT.to_parquet())
+    assert RES.shape == (0, 2)
+    assert RES.names == ("A", "B")
+    assert RES.stypes == (dt.int32, dt.str32)
+
+
+def test_parquet_object_columns():
+    DT = dt.Frame(A=[1, 2, 3], B=[(1,), 2, {}], stypes=[dt.int32, dt.obj64])
+    with pytest.warns(DatatableWarning) as ws:
+        out = DT.to_parquet()
+    assert len(ws) == 1
+    assert "Column `B` of type obj64 was not saved" in ws[0].message.args[0]
+    RES = dt.fread(out)
+    assert RES.names == ("A",)
+    assert RES.to_list() == [[1, 2, 3]]
+
+
+
+#-------------------------------------------------------------------------------
+# Reading files produced by other tools
+#-------------------------------------------------------------------------------
+
+# Written by pyarrow with snappy compression and V2 data pages:
+# columns of types uint8, string (dictionary-encoded), bool,
+# decimal(5, 2) and null.
+PYARROW_V2_FILE = bytes.fromhex(
+    "5041523115041518151c4c150615001200000c2cff00000003000000070000001506150c"
+    "150c5c150815021508151015041500121c36022804ff0000001804030000001111000000"
+    "030d0203240015041516151a4c150415001200000b280100000078020000007979150615"
+    "0a150a5c150815021508151015041500121c3602280279791801781111000000030b0103"
+    "021506151015105c150815021508150615041500121c1801011801001602280101180100"
+    "1111000000030d0200000003051504151215164c15061500120000092000007dfffea200"
+    "00011506150c150c5c150815021508151015041500121c180300007d1803fffea2160228"
+    "0300007d1803fffea21111000000030d020324001504150015024c150015001200000015"
+    "06150615065c150815081508151015041500121c0000000800001504196c350018067363"
+    "68656d61150a00150225021802753825164cac130812000000150c250218017325004c1c"
+    "0000001500250218016200150e150615021803646563250a1504150a2c5c1504150a0000"
+    "001502250218046e756c6c6cbc0000001608191c195c26001c1502193500061019180275"
+    "3815021608169001169401264026081c36022804ff000000180403000000111100192c15"
+    "041500150200150015101502003c29061926020600000026001c150c1935000610191801"
+    "731502160816820116860126d201269c011c360228027979180178111100192c15041500"
+    "150200150015101502003c160819061926020600000026001c1500191506191801621502"
+    "16081660166026a2023c1801011801001602280101180100111100191c15001506150200"
+    "3c29061926020600000026001c150e193500061019180364656315021608169a01169e01"
+    "26b4032682031c180300007d1803fffea21602280300007d1803fffea2111100192c1504"
+    "1500150200150015101502003c29061926020600000026001c150219350006101918046e"
+    "756c6c150216081652165426be0426a004292c15041500150200150015101502003c2906"
+    "1926080000000016de041608260816ec04002820706172717565742d6370702d6172726f"
+    "772076657273696f6e2032362e302e30195c1c00001c00001c00001c00001c0000000002"
+    "000050415231"
+)
+
+
+def test_parquet_read_pyarrow_file():
+    RES = dt.fread(PYARROW_V2_FILE)
+    frame_integrity_check(RES)
+    assert RES.names == ("u8", "s", "b", "dec", "null")
+    assert RES.stypes == (dt.int16, dt.str32, dt.bool8, dt.float64, dt.bool8)
+    assert RES.to_list() == [[255, None, 3, 7],
+                             ["x", "yy", None, "x"],
+                             [True, None, False, True],
+                             [1.25, None, -3.5, 0.01],
+                             [None] * 4]
+
+
+def test_parquet_read_uint64():
+    # Written by pyarrow: a column of type uint64 with values 1, null,
+    # 2**63 and 2**64-1, which do not fit into int64
+    data = bytes.fromhex(
+        "504152311500153c153c2c15081500150615061c36022808ffffffffffffffff18080100"
+        "000000000000111100000002000000030d01000000000000000000000000000080ffffff"
+        "ffffffffff1504192c35001806736368656d61150200150425021803753634251c4cac13"
+        "40120000001608191c191c26001c15041925060019180375363415001608169201169201"
+        "26083c36022808ffffffffffffffff18080100000000000000111100191c150015001502"
+        "003c29061926020600000016920116082608169201002820706172717565742d6370702d"
+        "6172726f772076657273696f6e2032362e302e30191c1c000000a500000050415231"
+    )
+    RES = dt.fread(data)
+    frame_integrity_check(RES)
+    assert RES.names == ("u64",)
+    assert RES.stypes == (dt.float64,)
+    assert RES.to_list() == [[1.0, None, 2.0**63, 2.0**64]]
+
+
+def test_parquet_read_uint64_fits():
+    # Written by pyarrow in row groups of 2 rows: uint64 columns "a"
+    # (dictionary-encoded) with values that fit into int64, and "b"
+    # (plain-encoded) where the last value does not fit
+    data = bytes.fromhex(
+    "504152311504151015104c1502150012000001000000000000001500151215122c150415"
+    "10150615061c360228080100000000000000180801000000000000001111000000020000"
+    "0003010102001500151c151c2c15041500150615061c3602280803000000000000001808"
+    "0300000000000000111100000002000000030103000000000000001504152015204c1504"
+    "1500120000ffffffffffffff7f00000000000000001500151215122c1504151015061506"
+    "1c36002808ffffffffffffff7f1808000000000000000011110000000200000004010103"
+    "021500152c152c2c15041500150615061c36002808000000000000008018080100000000"
+    "0000001111000000020000000401010000000000000000000000000000801504193c3500"
+    "1806736368656d6115040015042502180161251c4cac1340120000001504250218016225"
+    "1c4cac1340120000001608192c192c26001c150419350006101918016115001604169401"
+    "169401263426081c36022808010000000000000018080100000000000000111100192c15"
+    "041500150200150015101502003c29061926020200000026001c15041925060019180162"
+    "1500160416721672269c013c360228080300000000000000180803000000000000001111"
+    "00191c150015001502003c2906192602020000001686021604260816860200192c26001c"
+    "15041935000610191801611500160416a40116a40126ca02268e021c36002808ffffffff"
+    "ffffff7f18080000000000000000111100192c15041500150200150015101502003c2906"
+    "1926000400000026001c150419250600191801621500160416820116820126b2033c3600"
+    "2808000000000000008018080100000000000000111100191c150015001502003c290619"
+    "26000400000016a6021604268e0216a602002820706172717565742d6370702d6172726f"
+    "772076657273696f6e2032362e302e30192c1c00001c000000ab01000050415231"
+    )
+    RES = dt.fread(data)
+    frame_integrity_check(RES)
+    assert RES.names == ("a", "b")
+    assert RES.stypes == (dt.int64, dt.float64)
+    assert RES.to_list() == [[1, None, 2**63 - 1, 0],
+                             [3.0, None, 1.0, 2.0**63]]
+
+
+def test_parquet_corrupted():
+    data = dt.Frame(A=range(10)).to_parquet()
+    bad = data[:8] + b"\xFF" * (len(data) - 16) + data[-8:]
+    with pytest.raises(IOError, match="Invalid Parquet file"):
+        dt.fread(bad)
+
+
+def test_parquet_truncated():
+    data = dt.Frame(A=range(10)).to_parquet()
+    with pytest.raises(IOError, match="Invalid Parquet file"):
+        dt.fread(data[:20] + b"PAR1")
+
+
+def test_parquet_bad_levels_size():
+    # The size of the definition levels in the first data page (V2) is
+    # changed to 24, which is more than the size of the page
+    header = bytes.fromhex("5c15081502150815101504150012")
+    assert header in PYARROW_V2_FILE
+    bad = PYARROW_V2_FILE.replace(
+        header, bytes.fromhex("5c15081502150815101530150012"), 1)
+    with pytest.raises(IOError, match="Invalid Parquet file: size of levels "
+                                      "exceeds the size of a data page"):
+        dt.fread(bad)
+    # Negative sizes (-2)
+    bad = PYARROW_V2_FILE.replace(
+        header, bytes.fromhex("5c15081502150815101503150012"), 1)
+    with pytest.raises(IOError, match="Invalid Parquet file"):
+        dt.fread(bad)
+
+
+
+#-------------------------------------------------------------------------------
+# Parameter checks
+#-------------------------------------------------------------------------------
+
+def test_parquet_bad_compression():
+    msg = r"Parameter compression in Frame.to_parquet\(\) should be one of " \
+          "None, 'snappy', 'gzip' or 'lz4'; instead got 'zstd'"
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[1]).to_parquet(compression="zstd")
+
+
+def test_parquet_bad_row_group_size():
+    msg = r"Parameter row_group_size in Frame.to_parquet\(\) should be " \
+          "positive"
+    with pytest.raises(ValueError, match=msg):
+        dt.Frame(A=[1]).to_parquet(row_group_size=0)
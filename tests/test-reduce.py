@@ -21,6 +21,7 @@
 # FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 # IN THE SOFTWARE.
 #-------------------------------------------------------------------------------
+import builtins
 import math
 import pytest
 import random
@@ -537,3 +538,70 @@ def test_corr_multiple():
     assert_equals(D1, dt.Frame([[1.0], [a], [b], [-b]]))
     assert_equals(D2, dt.Frame([[-b], [-c], [-1.0], [1.0]]))
     assert_equals(D3, dt.Frame([[1.0], [1.0], [1.0], [1.0]]))
+
+
+
+#-------------------------------------------------------------------------------
+# Multiple reducers over the same column
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("st", [dt.bool8, dt.int8, dt.int32, dt.int64,
+                                dt.float64])
+def test_multiple_reducers_same_column(st):
+    # Reducers applied to the same column share a single pass over the
+    # data; check that each of them produces the same result as when
+    # used alone, and as computed in python
+    random.seed(st.value)
+    n = 2000
+    if st == dt.bool8:
+        src = [random.choice([True, False, None]) for _ in range(n)]
+    elif st == dt.float64:
+        src = [random.choice([None, random.random() * 100]) for _ in range(n)]
+    else:
+        src = [random.choice([None, random.randint(-100, 100)])
+               for _ in range(n)]
+    keys = [random.randint(0, 20) for _ in range(n)]
+    DT = dt.Frame(A=keys, X=src, stypes={"X": st})
+    reducers = [sum, mean, dt.sd, dt.min, dt.max, count]
+    RES = DT[:, [r(f.X) for r in reducers], by(f.A)]
+    frame_integrity_check(RES)
+    for i, r in enumerate(reducers):
+        assert RES[:, [0, i + 1]].to_list() == DT[:, r(f.X), by(f.A)].to_list()
+
+    groups = {}
+    for k, x in zip(keys, src):
+        groups.setdefault(k, [])
+        if x is not None:
+            groups[k].append(x)
+    res = RES.to_list()
+    assert res[0] == sorted(groups)
+    for i, k in enumerate(res[0]):
+        vals = groups[k]
+        m = len(vals)
+        assert res[1][i] == pytest.approx(builtins.sum(vals))
+        assert res[6][i] == m
+        if m:
+            assert res[2][i] == pytest.approx(builtins.sum(vals) / m)
+            assert res[4][i] == builtins.min(vals)
+            assert res[5][i] == builtins.max(vals)
+        if m > 1:
+            mu = builtins.sum(vals) / m
+            var = builtins.sum((v - mu)**2 for v in vals) / (m - 1)
+            assert res[3][i] == pytest.approx(math.sqrt(var))
+
+
+def test_multiple_reducers_view():
+    DT = dt.Frame(A=[1, 2, 1, 2, 1, 2, 3], X=[5, 3, None, 8, 1, 1, 0])
+    DT = DT[f.X != 1, :]
+    RES = DT[:, [sum(f.X), mean(f.X), dt.min(f.X), dt.max(f.X), count(f.X)],
+             by(f.A)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[1, 2, 3], [5, 11, 0], [5.0, 5.5, 0.0],
+                             [5, 3, 0], [5, 8, 0], [1, 2, 1]]
+
+
+def test_multiple_reducers_ungrouped():
+    DT = dt.Frame(X=[1.5, None, 2.5, -1.0])
+    RES = DT[:, [sum(f.X), mean(f.X), dt.sd(f.X), count(f.X)]]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[3.0], [1.0], [math.sqrt(3.25)], [3]]
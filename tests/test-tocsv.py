@@ -552,6 +552,79 @@ def test_compress2(tempfile):
         os.unlink(tempfile)
 
 
+def _count_gzip_members(data):
+    import zlib
+    n = 0
+    while data:
+        d = zlib.decompressobj(wbits=31)
+        d.decompress(data)
+        data = d.unused_data
+        n += 1
+    return n
+
+
+@pytest.mark.parametrize("level", [0, 1, 9])
+def test_compress_level(level):
+    DT = dt.Frame(A=range(100000), B=["one", "five", "seven", "t"]*25000)
+    out = DT.to_csv(compression="gzip", compression_level=level)
+    default = DT.to_csv(compression="gzip")
+    if level == 0:
+        assert len(out) > len(default)
+    if level == 9:
+        assert len(out) <= len(default)
+    assert_equals(dt.fread(out), DT)
+
+
+def test_compress_member_size():
+    DT = dt.Frame(A=range(100000), B=["one", "five", "seven", "t"]*25000)
+    size = len(DT.to_csv())
+    out1 = DT.to_csv(compression="gzip", compression_member_size=1 << 30)
+    out2 = DT.to_csv(compression="gzip", compression_member_size=10000)
+    # the header is always a separate gzip member
+    assert _count_gzip_members(out1) == 2
+    assert _count_gzip_members(out2) >= size // 10000
+    assert len(out1) < len(out2)
+    assert_equals(dt.fread(out1), DT)
+    assert_equals(dt.fread(out2), DT)
+
+
+def test_compress_parallel():
+    DT = dt.Frame(A=range(200000), B=[1.5, None, 2.25, -7.0]*50000)
+    nthreads = dt.options.nthreads
+    try:
+        dt.options.nthreads = 1
+        out1 = DT.to_csv(compression="gzip")
+        dt.options.nthreads = 4
+        out4 = DT.to_csv(compression="gzip")
+    finally:
+        dt.options.nthreads = nthreads
+    assert_equals(dt.fread(out1), DT)
+    assert_equals(dt.fread(out4), DT)
+
+
+def test_compress_params_invalid():
+    DT = dt.Frame(A=range(5))
+    msg = r"Parameter compression_level in Frame.to_csv\(\) can only be " \
+          r"used when the output is compressed"
+    with pytest.raises(ValueError, match=msg):
+        DT.to_csv(compression_level=5)
+
+    msg = r"Parameter compression_level in Frame.to_csv\(\) should be an " \
+          r"integer from 0 to 9, instead got 10"
+    with pytest.raises(ValueError, match=msg):
+        DT.to_csv(compression="gzip", compression_level=10)
+
+    msg = r"Parameter compression_member_size in Frame.to_csv\(\) can only " \
+          r"be used when the output is compressed"
+    with pytest.raises(ValueError, match=msg):
+        DT.to_csv(compression_member_size=100000)
+
+    msg = r"Parameter compression_member_size in Frame.to_csv\(\) should " \
+          r"be positive"
+    with pytest.raises(ValueError, match=msg):
+        DT.to_csv(compression="gzip", compression_member_size=0)
+
+
 def test_compress_invalid():
     DT = dt.Frame()
     with pytest.raises(TypeError) as e: